@@ -8,13 +8,21 @@
 #include "../src/IntegratorStrategy.hpp"
 #include "../src/Interpolation2D.hpp"
 #include "../src/LinearSolver.hpp"
+#include "../src/FixedLinearSolver.hpp"
 #include "../src/MathFunctions.hpp"
 #include "../src/MatrixSeries.hpp"
 #include "../src/Series.hpp"
 #include "../src/SquareMatrix.hpp"
+#include "../src/StructuredMatrix.hpp"
+#include "../src/AxisymmetricMatrix.hpp"
+#include "../src/FloatMatrix.hpp"
 #include "../src/State.hpp"
 #include "../src/SurfaceCoating.hpp"
 #include "../src/WavelengthRange.hpp"
+#include "../src/WavelengthGrid.hpp"
+#include "../src/SpectralWeights.hpp"
+#include "../src/ParallelFor.hpp"
+#include "../src/Instrumentation.hpp"
 #include "../src/PolynomialFit.hpp"
 #include "../src/Polynom.hpp"
 #include "../src/mmap.hpp"
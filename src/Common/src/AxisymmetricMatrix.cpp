@@ -0,0 +1,326 @@
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+
+#include "AxisymmetricMatrix.hpp"
+#include "Constants.hpp"
+
+namespace FenestrationCommon
+{
+    namespace
+    {
+        bool isEqual(const double a, const double b)
+        {
+            return std::abs(a - b)
+                   <= ConstantsData::floatErrorTolerance * std::max(std::abs(a), std::abs(b));
+        }
+
+        std::vector<size_t> ringStarts(const std::vector<size_t> & tRingSizes)
+        {
+            std::vector<size_t> result;
+            size_t start = 0;
+            for(const auto ringSize : tRingSizes)
+            {
+                result.push_back(start);
+                start += ringSize;
+            }
+            return result;
+        }
+
+        void checkRings(const AxisymmetricMatrix & first, const AxisymmetricMatrix & second)
+        {
+            if(first.ringSizes() != second.ringSizes())
+            {
+                throw std::runtime_error("Axisymmetric matrices must have identical rings.");
+            }
+        }
+    }   // namespace
+
+    AxisymmetricMatrix::AxisymmetricMatrix(const SquareMatrix & tMatrix,
+                                           const std::vector<size_t> & tRingSizes) :
+        m_RingSizes(tRingSizes),
+        m_Alpha(tRingSizes.size(), 0),
+        m_Beta(tRingSizes.size())
+    {
+        if(!isAxisymmetric(tMatrix, tRingSizes))
+        {
+            throw std::runtime_error("Matrix is not axisymmetric.");
+        }
+
+        const auto starts = ringStarts(m_RingSizes);
+        for(size_t r = 0; r < m_RingSizes.size(); ++r)
+        {
+            for(size_t s = 0; s < m_RingSizes.size(); ++s)
+            {
+                if(r != s)
+                {
+                    m_Beta(r, s) = tMatrix(starts[r], starts[s]);
+                }
+                else if(m_RingSizes[r] == 1)
+                {
+                    m_Alpha[r] = tMatrix(starts[r], starts[r]);
+                }
+                else
+                {
+                    m_Beta(r, r) = tMatrix(starts[r] + 1, starts[r]);
+                    m_Alpha[r] = tMatrix(starts[r], starts[r]) - m_Beta(r, r);
+                }
+            }
+        }
+    }
+
+    AxisymmetricMatrix::AxisymmetricMatrix(const std::vector<size_t> & tRingSizes,
+                                           const std::vector<double> & tRingDiagonal) :
+        AxisymmetricMatrix(tRingSizes, tRingDiagonal, SquareMatrix(tRingSizes.size()))
+    {}
+
+    AxisymmetricMatrix::AxisymmetricMatrix(const std::vector<size_t> & tRingSizes,
+                                           const std::vector<double> & tRingDiagonal,
+                                           const SquareMatrix & tRingMatrix) :
+        m_RingSizes(tRingSizes),
+        m_Alpha(tRingDiagonal),
+        m_Beta(tRingMatrix)
+    {
+        if(m_Alpha.size() != m_RingSizes.size() || m_Beta.size() != m_RingSizes.size())
+        {
+            throw std::runtime_error("Ring data must have same size as number of rings.");
+        }
+    }
+
+    bool AxisymmetricMatrix::isAxisymmetric(const SquareMatrix & tMatrix,
+                                            const std::vector<size_t> & tRingSizes)
+    {
+        const auto starts = ringStarts(tRingSizes);
+        const auto size = starts.empty() ? 0 : starts.back() + tRingSizes.back();
+        if(size != tMatrix.size())
+        {
+            return false;
+        }
+
+        for(size_t r = 0; r < tRingSizes.size(); ++r)
+        {
+            for(size_t s = 0; s < tRingSizes.size(); ++s)
+            {
+                const auto offDiagonal =
+                  (r == s) ? (tRingSizes[r] > 1 ? tMatrix(starts[r] + 1, starts[r]) : 0)
+                           : tMatrix(starts[r], starts[s]);
+                const auto diagonal = tMatrix(starts[r], starts[r]);
+                for(size_t i = starts[r]; i < starts[r] + tRingSizes[r]; ++i)
+                {
+                    for(size_t j = starts[s]; j < starts[s] + tRingSizes[s]; ++j)
+                    {
+                        const auto expected = (i == j) ? diagonal : offDiagonal;
+                        if(!isEqual(tMatrix(i, j), expected))
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    std::size_t AxisymmetricMatrix::size() const
+    {
+        size_t result = 0;
+        for(const auto ringSize : m_RingSizes)
+        {
+            result += ringSize;
+        }
+        return result;
+    }
+
+    std::size_t AxisymmetricMatrix::numberOfRings() const
+    {
+        return m_RingSizes.size();
+    }
+
+    const std::vector<size_t> & AxisymmetricMatrix::ringSizes() const
+    {
+        return m_RingSizes;
+    }
+
+    const std::vector<double> & AxisymmetricMatrix::ringDiagonal() const
+    {
+        return m_Alpha;
+    }
+
+    const SquareMatrix & AxisymmetricMatrix::ringMatrix() const
+    {
+        return m_Beta;
+    }
+
+    SquareMatrix AxisymmetricMatrix::expand() const
+    {
+        const auto starts = ringStarts(m_RingSizes);
+        SquareMatrix result(size());
+        for(size_t r = 0; r < m_RingSizes.size(); ++r)
+        {
+            for(size_t s = 0; s < m_RingSizes.size(); ++s)
+            {
+                for(size_t i = starts[r]; i < starts[r] + m_RingSizes[r]; ++i)
+                {
+                    for(size_t j = starts[s]; j < starts[s] + m_RingSizes[s]; ++j)
+                    {
+                        result(i, j) = m_Beta(r, s);
+                    }
+                }
+            }
+            for(size_t i = starts[r]; i < starts[r] + m_RingSizes[r]; ++i)
+            {
+                result(i, i) += m_Alpha[r];
+            }
+        }
+        return result;
+    }
+
+    AxisymmetricMatrix AxisymmetricMatrix::inverse() const
+    {
+        // Vectors that have zero sum over every ring are only scaled by alpha. Inverse on the
+        // space of ring-constant vectors is inverse of diag(alpha) + beta * diag(ringSizes).
+        const auto numOfRings = m_RingSizes.size();
+        std::vector<double> alphaInv(numOfRings, 0);
+        for(size_t r = 0; r < numOfRings; ++r)
+        {
+            if(m_Alpha[r] != 0)
+            {
+                alphaInv[r] = 1 / m_Alpha[r];
+            }
+            else if(m_RingSizes[r] > 1)
+            {
+                throw std::runtime_error("Axisymmetric matrix is singular.");
+            }
+        }
+
+        SquareMatrix reduced(numOfRings);
+        for(size_t r = 0; r < numOfRings; ++r)
+        {
+            for(size_t s = 0; s < numOfRings; ++s)
+            {
+                reduced(r, s) = m_Beta(r, s) * double(m_RingSizes[s]);
+            }
+            reduced(r, r) += m_Alpha[r];
+        }
+        // LU decomposition in SquareMatrix does not handle single element matrices
+        SquareMatrix reducedInv(numOfRings);
+        if(numOfRings == 1)
+        {
+            reducedInv(0, 0) = 1 / reduced(0, 0);
+        }
+        else
+        {
+            reducedInv = reduced.inverse();
+        }
+
+        SquareMatrix betaInv(numOfRings);
+        for(size_t r = 0; r < numOfRings; ++r)
+        {
+            for(size_t s = 0; s < numOfRings; ++s)
+            {
+                const auto value = (r == s) ? reducedInv(r, s) - alphaInv[r] : reducedInv(r, s);
+                betaInv(r, s) = value / double(m_RingSizes[s]);
+            }
+        }
+
+        return AxisymmetricMatrix(m_RingSizes, alphaInv, betaInv);
+    }
+
+    AxisymmetricMatrix operator*(const AxisymmetricMatrix & first,
+                                 const AxisymmetricMatrix & second)
+    {
+        checkRings(first, second);
+
+        const auto & rings = first.ringSizes();
+        const auto numOfRings = rings.size();
+        const auto & alpha1 = first.ringDiagonal();
+        const auto & alpha2 = second.ringDiagonal();
+        const auto & beta1 = first.ringMatrix();
+        const auto & beta2 = second.ringMatrix();
+
+        std::vector<double> alpha(numOfRings);
+        SquareMatrix beta(numOfRings);
+        for(size_t r = 0; r < numOfRings; ++r)
+        {
+            alpha[r] = alpha1[r] * alpha2[r];
+            for(size_t s = 0; s < numOfRings; ++s)
+            {
+                auto value = alpha1[r] * beta2(r, s) + beta1(r, s) * alpha2[s];
+                for(size_t k = 0; k < numOfRings; ++k)
+                {
+                    value += beta1(r, k) * double(rings[k]) * beta2(k, s);
+                }
+                beta(r, s) = value;
+            }
+        }
+
+        return AxisymmetricMatrix(rings, alpha, beta);
+    }
+
+    AxisymmetricMatrix operator+(const AxisymmetricMatrix & first,
+                                 const AxisymmetricMatrix & second)
+    {
+        checkRings(first, second);
+        std::vector<double> alpha(first.ringDiagonal());
+        for(size_t r = 0; r < alpha.size(); ++r)
+        {
+            alpha[r] += second.ringDiagonal()[r];
+        }
+        return AxisymmetricMatrix(
+          first.ringSizes(), alpha, first.ringMatrix() + second.ringMatrix());
+    }
+
+    AxisymmetricMatrix operator-(const AxisymmetricMatrix & first,
+                                 const AxisymmetricMatrix & second)
+    {
+        checkRings(first, second);
+        std::vector<double> alpha(first.ringDiagonal());
+        for(size_t r = 0; r < alpha.size(); ++r)
+        {
+            alpha[r] -= second.ringDiagonal()[r];
+        }
+        return AxisymmetricMatrix(
+          first.ringSizes(), alpha, first.ringMatrix() - second.ringMatrix());
+    }
+
+    std::vector<double> operator*(const std::vector<double> & first,
+                                  const AxisymmetricMatrix & second)
+    {
+        if(first.size() != second.size())
+        {
+            throw std::runtime_error("Vector and matrix do not have same size.");
+        }
+
+        const auto & rings = second.ringSizes();
+        const auto numOfRings = rings.size();
+        const auto starts = ringStarts(rings);
+
+        // Sum of vector components over every ring
+        std::vector<double> ringSums(numOfRings, 0);
+        for(size_t r = 0; r < numOfRings; ++r)
+        {
+            for(size_t i = starts[r]; i < starts[r] + rings[r]; ++i)
+            {
+                ringSums[r] += first[i];
+            }
+        }
+
+        std::vector<double> res(first.size());
+        for(size_t s = 0; s < numOfRings; ++s)
+        {
+            auto ringValue = 0.0;
+            for(size_t r = 0; r < numOfRings; ++r)
+            {
+                ringValue += ringSums[r] * second.ringMatrix()(r, s);
+            }
+            for(size_t j = starts[s]; j < starts[s] + rings[s]; ++j)
+            {
+                res[j] = ringValue + first[j] * second.ringDiagonal()[s];
+            }
+        }
+
+        return res;
+    }
+
+}   // namespace FenestrationCommon
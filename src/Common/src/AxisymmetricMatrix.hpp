@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+
+#include "SquareMatrix.hpp"
+
+namespace FenestrationCommon
+{
+    // Matrix of rotationally symmetric layer stored per ring of equal theta angles. Block of full
+    // matrix that connects ring r with ring s is given as
+    //     alpha(r) * I + beta(r, s) * J        (if r == s)
+    //     beta(r, s) * J                       (if r != s)
+    // where I is identity and J is matrix of ones. Specular layers have beta = 0, perfectly
+    // diffuse layers have alpha = 0. Matrices of that form are closed under addition,
+    // multiplication and inversion which allows composition of layers in the reduced space of
+    // ring count size.
+    class AxisymmetricMatrix
+    {
+    public:
+        // Reduces full matrix. Throws if matrix is not axisymmetric for given ring sizes.
+        AxisymmetricMatrix(const SquareMatrix & tMatrix, const std::vector<size_t> & tRingSizes);
+        // Diagonal matrix with constant value over each ring
+        AxisymmetricMatrix(const std::vector<size_t> & tRingSizes,
+                           const std::vector<double> & tRingDiagonal);
+        AxisymmetricMatrix(const std::vector<size_t> & tRingSizes,
+                           const std::vector<double> & tRingDiagonal,
+                           const SquareMatrix & tRingMatrix);
+
+        static bool isAxisymmetric(const SquareMatrix & tMatrix,
+                                   const std::vector<size_t> & tRingSizes);
+
+        // Size of full matrix
+        std::size_t size() const;
+        std::size_t numberOfRings() const;
+
+        const std::vector<size_t> & ringSizes() const;
+        const std::vector<double> & ringDiagonal() const;
+        const SquareMatrix & ringMatrix() const;
+
+        SquareMatrix expand() const;
+
+        AxisymmetricMatrix inverse() const;
+
+    private:
+        std::vector<size_t> m_RingSizes;
+        std::vector<double> m_Alpha;
+        SquareMatrix m_Beta;
+    };
+
+    AxisymmetricMatrix operator*(const AxisymmetricMatrix & first,
+                                 const AxisymmetricMatrix & second);
+    AxisymmetricMatrix operator+(const AxisymmetricMatrix & first,
+                                 const AxisymmetricMatrix & second);
+    AxisymmetricMatrix operator-(const AxisymmetricMatrix & first,
+                                 const AxisymmetricMatrix & second);
+
+    std::vector<double> operator*(const std::vector<double> & first,
+                                  const AxisymmetricMatrix & second);
+
+}   // namespace FenestrationCommon
@@ -1,6 +1,9 @@
 #include <algorithm>
-#include <iterator>
-#include <cassert>
+#include <functional>
+#include <queue>
+#include <tuple>
+#include <limits>
+#include <stdexcept>
 
 #include "CommonWavelengths.hpp"
 
@@ -8,62 +11,82 @@
 
 namespace FenestrationCommon {
 
-	CCommonWavelengths::CCommonWavelengths() {
+	CCommonWavelengths::CCommonWavelengths() :
+		m_Tolerance( 0 ),
+		m_MinWavelength( -std::numeric_limits< double >::max() ),
+		m_MaxWavelength( std::numeric_limits< double >::max() ) {
 	}
 
 	void CCommonWavelengths::addWavelength( std::vector< double > const& t_wv ) {
 		m_Wavelengths.push_back( t_wv );
+		if ( !std::is_sorted( m_Wavelengths.back().begin(), m_Wavelengths.back().end() ) ) {
+			std::sort( m_Wavelengths.back().begin(), m_Wavelengths.back().end() );
+		}
 	}
 
-	std::vector< double > CCommonWavelengths::getCombinedWavelengths( const Combine t_Combination ) {
-		std::vector< double > aCombined;
-		for ( auto it = m_Wavelengths.begin(); it < m_Wavelengths.end(); ++it ) {
-			if ( it == m_Wavelengths.begin() ) {
-				aCombined = *it;
-			}
-			else {
-				aCombined = combineWavelegths( aCombined, *it, t_Combination );
-			}
+	void CCommonWavelengths::setTolerance( double const t_Tolerance ) {
+		if ( t_Tolerance < 0 ) {
+			throw std::runtime_error( "Tolerance for common wavelengths must not be negative." );
 		}
-
-		return aCombined;
+		m_Tolerance = t_Tolerance;
 	}
 
-	std::vector< double > CCommonWavelengths::combineWavelegths( std::vector< double > const& t_wv1,
-	                                                        std::vector< double > const& t_wv2, Combine const t_Combination ) const {
-
-		// Set union of two wavelengths without repeating common data
-		std::vector< double > unionWavelengths;
-		std::vector< double > combinedWavelengths;
-
-		set_union( t_wv1.begin(), t_wv1.end(), t_wv2.begin(), t_wv2.end(),
-		           back_inserter( unionWavelengths ) );
+	void CCommonWavelengths::setRange( double const t_MinWavelength, double const t_MaxWavelength ) {
+		m_MinWavelength = t_MinWavelength;
+		m_MaxWavelength = t_MaxWavelength;
+	}
 
+	std::vector< double > CCommonWavelengths::getCombinedWavelengths( const Combine t_Combination ) {
+		// Range of the combined set. Wavelengths are sorted, so range of each set is given by its
+		// first and last element.
+		auto minWV = m_MinWavelength;
+		auto maxWV = m_MaxWavelength;
 		if ( t_Combination == Combine::Interpolate ) {
 			// Remove extrapolated data. It is incorrect to have extrapolated wavelengths from one sample
-			auto min1 = *min_element( t_wv1.begin(), t_wv1.end() );
-			auto min2 = *min_element( t_wv2.begin(), t_wv2.end() );
-			auto minWV = std::max( min1, min2 );
-
-			auto max2 = *max_element( t_wv2.begin(), t_wv2.end() );
-			auto max1 = *max_element( t_wv1.begin(), t_wv1.end() );
-			auto maxWV = std::min( max1, max2 );
-
-			for ( auto val : unionWavelengths ) {
-				if ( ( val >= minWV ) && ( val <= maxWV ) ) {
-					combinedWavelengths.push_back( val );
+			for ( const auto & wv : m_Wavelengths ) {
+				if ( !wv.empty() ) {
+					minWV = std::max( minWV, wv.front() );
+					maxWV = std::min( maxWV, wv.back() );
 				}
 			}
-
 		}
-		else if ( t_Combination == Combine::Extrapolate ) {
-			combinedWavelengths = unionWavelengths;
+
+		// k-way merge of sorted sets. Heap keeps next wavelength of every set together with set
+		// index and position in the set.
+		using Item = std::tuple< double, size_t, size_t >;
+		std::priority_queue< Item, std::vector< Item >, std::greater< Item > > heap;
+		size_t totalSize = 0;
+		for ( size_t i = 0; i < m_Wavelengths.size(); ++i ) {
+			const auto & wv = m_Wavelengths[ i ];
+			totalSize += wv.size();
+			// Wavelengths below range are skipped before merging
+			const auto first = std::lower_bound( wv.begin(), wv.end(), minWV );
+			if ( first != wv.end() ) {
+				heap.emplace( *first, i, size_t( std::distance( wv.begin(), first ) ) );
+			}
 		}
-		else {
-			assert("Incorrect method for combining common wavelengths.");
+
+		std::vector< double > aCombined;
+		aCombined.reserve( totalSize );
+		while ( !heap.empty() ) {
+			const auto item = heap.top();
+			heap.pop();
+			const auto value = std::get< 0 >( item );
+			if ( value > maxWV ) {
+				// All remaining wavelengths are out of range as well
+				break;
+			}
+			if ( aCombined.empty() || value - aCombined.back() > m_Tolerance ) {
+				aCombined.push_back( value );
+			}
+			const auto & wv = m_Wavelengths[ std::get< 1 >( item ) ];
+			const auto next = std::get< 2 >( item ) + 1;
+			if ( next < wv.size() ) {
+				heap.emplace( wv[ next ], std::get< 1 >( item ), next );
+			}
 		}
 
-		return combinedWavelengths;
+		return aCombined;
 	}
 
 }
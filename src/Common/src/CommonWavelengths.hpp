@@ -21,15 +21,22 @@ namespace FenestrationCommon {
 		// put additional wavelength
 		void addWavelength( std::vector< double > const& t_wv );
 
-		// getting combined wavelength
+		// Wavelengths that are closer than tolerance to previous wavelength in combined set are
+		// treated as duplicates and only the smallest one is kept. Default tolerance is zero
+		// (only identical wavelengths are removed).
+		void setTolerance( double t_Tolerance );
+
+		// Combined wavelengths are clipped to given range
+		void setRange( double t_MinWavelength, double t_MaxWavelength );
+
+		// getting combined wavelength. All sets are merged in single pass.
 		std::vector< double > getCombinedWavelengths( Combine const t_Combination );
 
 	private:
-		// Combine two wavelengths into one by applyting correct strategy
-		std::vector< double > combineWavelegths( std::vector< double > const& t_wv1,
-		                                         std::vector< double > const& t_wv2, Combine const t_Combination ) const;
-
 		std::vector< std::vector< double > > m_Wavelengths;
+		double m_Tolerance;
+		double m_MinWavelength;
+		double m_MaxWavelength;
 	};
 
 }
@@ -14,5 +14,7 @@ namespace ConstantsData {
 	static const double PLANKCONSTANT = 6.626196e-34;
 	static const double BOLTZMANNCONSTANT = 1.380622e-23;
 	static const double floatErrorTolerance = 1e-12;
+	// Wavelengths (in micrometers) closer than this are treated as same wavelength
+	static const double wavelengthTolerance = 1e-6;
 	static const double ELECTRON_CHARGE = 1.502e-19;
 }
@@ -0,0 +1,128 @@
+#ifndef FIXEDLINEARSOLVER_H
+#define FIXEDLINEARSOLVER_H
+
+#include <array>
+#include <cmath>
+#include <cassert>
+#include <cstddef>
+
+namespace FenestrationCommon
+{
+    // Solves system of linear equations with size known at compile time. Matrix is stored row by
+    // row in t_Matrix (N x N) and solution is stored into t_Vector. Elimination is identical to
+    // SquareMatrix::makeUpperTriangular and CLinearSolver (LU decomposition with scaled partial
+    // pivoting) so results are same as from generic solver. Since all loop bounds are constants,
+    // compiler is able to unroll them and pivoting workspace is kept on the stack.
+    template<std::size_t N>
+    void solveFixedSystem(double * t_Matrix, double * t_Vector)
+    {
+        const double TINY(1e-20);
+
+        std::array<double, N> vv;
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            double aamax = 0.0;
+            for(std::size_t j = 0; j < N; ++j)
+            {
+                const double absCellValue = std::abs(t_Matrix[i * N + j]);
+                if(absCellValue > aamax)
+                {
+                    aamax = absCellValue;
+                }
+            }
+            assert(aamax != 0);
+            vv[i] = 1 / aamax;
+        }
+
+        std::array<std::size_t, N> index;
+        for(std::size_t j = 0; j < N; ++j)
+        {
+            for(std::size_t i = 0; i < j; ++i)
+            {
+                double sum = t_Matrix[i * N + j];
+                for(std::size_t k = 0; k < i; ++k)
+                {
+                    sum -= t_Matrix[i * N + k] * t_Matrix[k * N + j];
+                }
+                t_Matrix[i * N + j] = sum;
+            }
+
+            double aamax = 0.0;
+            std::size_t imax = 0;
+            for(std::size_t i = j; i < N; ++i)
+            {
+                double sum = t_Matrix[i * N + j];
+                for(std::size_t k = 0; k < j; ++k)
+                {
+                    sum -= t_Matrix[i * N + k] * t_Matrix[k * N + j];
+                }
+                t_Matrix[i * N + j] = sum;
+                const double dum = vv[i] * std::abs(sum);
+                if(dum >= aamax)
+                {
+                    imax = i;
+                    aamax = dum;
+                }
+            }
+
+            if(j != imax)
+            {
+                for(std::size_t k = 0; k < N; ++k)
+                {
+                    const double dum = t_Matrix[imax * N + k];
+                    t_Matrix[imax * N + k] = t_Matrix[j * N + k];
+                    t_Matrix[j * N + k] = dum;
+                }
+                vv[imax] = vv[j];
+            }
+            index[j] = imax;
+            if(t_Matrix[j * N + j] == 0.0)
+            {
+                t_Matrix[j * N + j] = TINY;
+            }
+            const double dum = 1.0 / t_Matrix[j * N + j];
+            for(std::size_t i = j + 1; i < N; ++i)
+            {
+                t_Matrix[i * N + j] *= dum;
+            }
+        }
+
+        // Forward substitution. Leading zeros of right hand side are skipped same as in
+        // CLinearSolver.
+        bool nonZeroFound = false;
+        std::size_t ii = 0;
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            const std::size_t ll = index[i];
+            double sum = t_Vector[ll];
+            t_Vector[ll] = t_Vector[i];
+            if(nonZeroFound)
+            {
+                for(std::size_t j = ii; j < i; ++j)
+                {
+                    sum -= t_Matrix[i * N + j] * t_Vector[j];
+                }
+            }
+            else if(sum != 0.0)
+            {
+                nonZeroFound = true;
+                ii = i;
+            }
+            t_Vector[i] = sum;
+        }
+
+        for(std::size_t r = N; r > 0; --r)
+        {
+            const std::size_t i = r - 1;
+            double sum = t_Vector[i];
+            for(std::size_t j = i + 1; j < N; ++j)
+            {
+                sum -= t_Matrix[i * N + j] * t_Vector[j];
+            }
+            t_Vector[i] = sum / t_Matrix[i * N + i];
+        }
+    }
+
+}   // namespace FenestrationCommon
+
+#endif
@@ -0,0 +1,70 @@
+#include <limits>
+
+#include "FloatMatrix.hpp"
+
+namespace FenestrationCommon
+{
+    FloatMatrix::FloatMatrix(const SquareMatrix & tMatrix) :
+        m_Size(tMatrix.size()),
+        m_Diagonal(tMatrix.isDiagonal())
+    {
+        if(m_Diagonal)
+        {
+            m_Values.reserve(m_Size);
+            for(size_t i = 0; i < m_Size; ++i)
+            {
+                m_Values.push_back(static_cast<float>(tMatrix(i, i)));
+            }
+        }
+        else
+        {
+            m_Values.reserve(m_Size * m_Size);
+            for(size_t i = 0; i < m_Size; ++i)
+            {
+                for(size_t j = 0; j < m_Size; ++j)
+                {
+                    m_Values.push_back(static_cast<float>(tMatrix(i, j)));
+                }
+            }
+        }
+    }
+
+    std::size_t FloatMatrix::size() const
+    {
+        return m_Size;
+    }
+
+    bool FloatMatrix::isDiagonal() const
+    {
+        return m_Diagonal;
+    }
+
+    SquareMatrix FloatMatrix::matrix() const
+    {
+        SquareMatrix result(m_Size);
+        if(m_Diagonal)
+        {
+            for(size_t i = 0; i < m_Size; ++i)
+            {
+                result(i, i) = m_Values[i];
+            }
+        }
+        else
+        {
+            for(size_t i = 0; i < m_Size; ++i)
+            {
+                for(size_t j = 0; j < m_Size; ++j)
+                {
+                    result(i, j) = m_Values[i * m_Size + j];
+                }
+            }
+        }
+        return result;
+    }
+
+    double FloatMatrix::roundingError()
+    {
+        return std::numeric_limits<float>::epsilon() / 2;
+    }
+
+}   // namespace FenestrationCommon
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+
+#include "SquareMatrix.hpp"
+
+namespace FenestrationCommon
+{
+    // Square matrix stored in single precision. It is used to keep large results (BSDF matrices at
+    // every wavelength) in memory at half of the size. Only diagonal is stored for diagonal
+    // matrices. Matrix is converted back to double precision for any calculation and therefore the
+    // only error introduced is rounding of stored elements.
+    class FloatMatrix
+    {
+    public:
+        explicit FloatMatrix(const SquareMatrix & tMatrix);
+
+        std::size_t size() const;
+        bool isDiagonal() const;
+
+        SquareMatrix matrix() const;
+
+        // Maximum relative error of stored element (2^-24, about 6e-8)
+        static double roundingError();
+
+    private:
+        std::size_t m_Size;
+        bool m_Diagonal;
+        std::vector<float> m_Values;
+    };
+
+}   // namespace FenestrationCommon
@@ -0,0 +1,255 @@
+#include <mutex>
+#include <array>
+
+#include "Instrumentation.hpp"
+
+namespace FenestrationCommon
+{
+    namespace Instrumentation
+    {
+        namespace
+        {
+            // Values accumulated by single thread. Entries are identified by address of their
+            // name and are stored in place so that instrumentation never allocates memory in
+            // instrumented code.
+            template<typename Value>
+            class Entries
+            {
+            public:
+                Entries() : m_Size(0)
+                {}
+
+                // Returns nullptr when storage is full. Value is then dropped since it is called
+                // from destructors and must not throw.
+                Value * find(const char * t_Name) noexcept
+                {
+                    for(size_t i = 0; i < m_Size; ++i)
+                    {
+                        if(m_Entries[i].first == t_Name)
+                        {
+                            return &m_Entries[i].second;
+                        }
+                    }
+                    if(m_Size == MaxEntries)
+                    {
+                        return nullptr;
+                    }
+                    m_Entries[m_Size] = std::make_pair(t_Name, Value());
+                    return &m_Entries[m_Size++].second;
+                }
+
+                void mergeTo(std::map<std::string, Value> & t_Total) const;
+
+                void clear()
+                {
+                    m_Size = 0;
+                }
+
+            private:
+                static const size_t MaxEntries = 64;
+                std::array<std::pair<const char *, Value>, MaxEntries> m_Entries;
+                size_t m_Size;
+            };
+
+            void add(StageStatistics & t_Total, const StageStatistics & t_Stage)
+            {
+                t_Total.Calls += t_Stage.Calls;
+                t_Total.Time += t_Stage.Time;
+                t_Total.Matrices += t_Stage.Matrices;
+            }
+
+            void add(size_t & t_Total, const size_t t_Count)
+            {
+                t_Total += t_Count;
+            }
+
+            template<typename Value>
+            void Entries<Value>::mergeTo(std::map<std::string, Value> & t_Total) const
+            {
+                // Same name can be stored at different addresses in different translation units
+                for(size_t i = 0; i < m_Size; ++i)
+                {
+                    add(t_Total[m_Entries[i].first], m_Entries[i].second);
+                }
+            }
+
+            struct Statistics
+            {
+                std::map<std::string, StageStatistics> Stages;
+                std::map<std::string, size_t> Counters;
+            };
+
+            // Statistics of a single thread. Thread is the only writer and mutex is locked by
+            // other threads only while statistics are read or cleared. Threads are kept in linked
+            // list so that registration of a thread does not allocate memory either.
+            class ThreadStatistics
+            {
+            public:
+                ThreadStatistics();
+                ~ThreadStatistics();
+
+                std::mutex Mutex;
+                Entries<StageStatistics> Stages;
+                Entries<size_t> Counters;
+                // Running count of matrices constructed by the thread
+                size_t Matrices;
+
+                ThreadStatistics * Previous;
+                ThreadStatistics * Next;
+            };
+
+            struct Registry
+            {
+                Registry() : First(nullptr)
+                {}
+
+                std::mutex Mutex;
+                ThreadStatistics * First;
+                // Statistics of threads that are already finished
+                Statistics Finished;
+            };
+
+            Registry & registry()
+            {
+                static Registry aRegistry;
+                return aRegistry;
+            }
+
+            ThreadStatistics::ThreadStatistics() : Matrices(0), Previous(nullptr), Next(nullptr)
+            {
+                auto & aRegistry = registry();
+                std::lock_guard<std::mutex> lock(aRegistry.Mutex);
+                Next = aRegistry.First;
+                if(Next != nullptr)
+                {
+                    Next->Previous = this;
+                }
+                aRegistry.First = this;
+            }
+
+            ThreadStatistics::~ThreadStatistics()
+            {
+                auto & aRegistry = registry();
+                std::lock_guard<std::mutex> lock(aRegistry.Mutex);
+                Stages.mergeTo(aRegistry.Finished.Stages);
+                Counters.mergeTo(aRegistry.Finished.Counters);
+                if(Previous != nullptr)
+                {
+                    Previous->Next = Next;
+                }
+                else
+                {
+                    aRegistry.First = Next;
+                }
+                if(Next != nullptr)
+                {
+                    Next->Previous = Previous;
+                }
+            }
+
+            ThreadStatistics & threadStatistics()
+            {
+                thread_local ThreadStatistics aStatistics;
+                return aStatistics;
+            }
+
+            Statistics mergedStatistics()
+            {
+                auto & aRegistry = registry();
+                std::lock_guard<std::mutex> lock(aRegistry.Mutex);
+                auto aResult = aRegistry.Finished;
+                for(auto aThread = aRegistry.First; aThread != nullptr; aThread = aThread->Next)
+                {
+                    std::lock_guard<std::mutex> threadLock(aThread->Mutex);
+                    aThread->Stages.mergeTo(aResult.Stages);
+                    aThread->Counters.mergeTo(aResult.Counters);
+                }
+                return aResult;
+            }
+        }   // namespace
+
+        StageStatistics::StageStatistics() : Calls(0), Time(0), Matrices(0)
+        {}
+
+        bool isEnabled()
+        {
+#ifdef WCE_INSTRUMENTATION
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        std::map<std::string, StageStatistics> stages()
+        {
+            return mergedStatistics().Stages;
+        }
+
+        std::map<std::string, size_t> counters()
+        {
+            return mergedStatistics().Counters;
+        }
+
+        void reset()
+        {
+            auto & aRegistry = registry();
+            std::lock_guard<std::mutex> lock(aRegistry.Mutex);
+            aRegistry.Finished = Statistics();
+            for(auto aThread = aRegistry.First; aThread != nullptr; aThread = aThread->Next)
+            {
+                std::lock_guard<std::mutex> threadLock(aThread->Mutex);
+                aThread->Stages.clear();
+                aThread->Counters.clear();
+            }
+        }
+
+        void addStage(const char * t_Stage, const double t_Time, const size_t t_Matrices) noexcept
+        {
+            auto & aThread = threadStatistics();
+            std::lock_guard<std::mutex> lock(aThread.Mutex);
+            auto aStage = aThread.Stages.find(t_Stage);
+            if(aStage != nullptr)
+            {
+                ++aStage->Calls;
+                aStage->Time += t_Time;
+                aStage->Matrices += t_Matrices;
+            }
+        }
+
+        void addCount(const char * t_Counter, const size_t t_Value) noexcept
+        {
+            auto & aThread = threadStatistics();
+            std::lock_guard<std::mutex> lock(aThread.Mutex);
+            auto aCounter = aThread.Counters.find(t_Counter);
+            if(aCounter != nullptr)
+            {
+                *aCounter += t_Value;
+            }
+        }
+
+        void countMatrix() noexcept
+        {
+            // Only owning thread reads and writes running count
+            ++threadStatistics().Matrices;
+        }
+
+        size_t matrixCount() noexcept
+        {
+            return threadStatistics().Matrices;
+        }
+
+        ScopedTimer::ScopedTimer(const char * t_Stage) :
+            m_Stage(t_Stage),
+            m_Start(std::chrono::steady_clock::now()),
+            m_Matrices(matrixCount())
+        {}
+
+        ScopedTimer::~ScopedTimer()
+        {
+            const std::chrono::duration<double> aTime = std::chrono::steady_clock::now() - m_Start;
+            addStage(m_Stage, aTime.count(), matrixCount() - m_Matrices);
+        }
+
+    }   // namespace Instrumentation
+
+}   // namespace FenestrationCommon
@@ -0,0 +1,81 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <string>
+#include <map>
+#include <chrono>
+
+// Timers and counters at main calculation stages are compiled only when WCE_INSTRUMENTATION is
+// defined (CMake option WCE_INSTRUMENTATION). Otherwise macros below expand to nothing and
+// calculations carry no instrumentation cost. Query functions are always available and return
+// empty statistics in builds without instrumentation.
+#ifdef WCE_INSTRUMENTATION
+#    define WCE_SCOPED_TIMER(stage) \
+        FenestrationCommon::Instrumentation::ScopedTimer wceScopedTimer(stage)
+#    define WCE_COUNT(counter, value) FenestrationCommon::Instrumentation::addCount(counter, value)
+#    define WCE_COUNT_MATRIX() FenestrationCommon::Instrumentation::countMatrix()
+#else
+#    define WCE_SCOPED_TIMER(stage)
+#    define WCE_COUNT(counter, value)
+#    define WCE_COUNT_MATRIX()
+#endif
+
+namespace FenestrationCommon
+{
+    // Statistics are accumulated per thread, without any contention between calculation threads,
+    // and merged over all threads (including finished ones) when they are read.
+    namespace Instrumentation
+    {
+        struct StageStatistics
+        {
+            StageStatistics();
+
+            size_t Calls;
+            // Wall clock time in seconds. Time of nested stages is included.
+            double Time;
+            // Number of square matrices constructed by the stage (including nested stages). Only
+            // matrices created from size or data are counted; copies and other containers are not.
+            size_t Matrices;
+        };
+
+        // True if library is compiled with WCE_INSTRUMENTATION
+        bool isEnabled();
+
+        std::map<std::string, StageStatistics> stages();
+        std::map<std::string, size_t> counters();
+
+        // Clears statistics of all threads
+        void reset();
+
+        // Names must be string literals (or have static storage duration in general) since
+        // statistics of running threads are kept by address of the name. Statistics are stored
+        // in place and instrumented code does not allocate memory. Each thread keeps a fixed
+        // number of stages and counters; values for names beyond that limit are dropped.
+        void addStage(const char * t_Stage, double t_Time, size_t t_Matrices) noexcept;
+        void addCount(const char * t_Counter, size_t t_Value = 1) noexcept;
+
+        // Matrix constructions are counted per thread and assigned to all stages that are running
+        void countMatrix() noexcept;
+        size_t matrixCount() noexcept;
+
+        // Adds time and matrix constructions between construction and destruction to the stage
+        class ScopedTimer
+        {
+        public:
+            explicit ScopedTimer(const char * t_Stage);
+            ~ScopedTimer();
+
+            ScopedTimer(const ScopedTimer &) = delete;
+            ScopedTimer & operator=(const ScopedTimer &) = delete;
+
+        private:
+            const char * m_Stage;
+            std::chrono::steady_clock::time_point m_Start;
+            size_t m_Matrices;
+        };
+
+    }   // namespace Instrumentation
+
+}   // namespace FenestrationCommon
+
+#endif
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cmath>
+
 #include "Interpolation2D.hpp"
 #include "WCECommon.hpp"
 
@@ -15,46 +18,130 @@ namespace FenestrationCommon {
 
 	}
 
+	std::vector< double > IInterpolation2D::getValues( std::vector< double > const& t_Values ) const {
+		std::vector< double > result( t_Values.size() );
+		for ( size_t i = 0; i < t_Values.size(); ++i ) {
+			result[ i ] = getValue( t_Values[ i ] );
+		}
+		return result;
+	}
+
 	//////////////////////////////////////////////////////////////////////////////////////
 	// CSPChipInterpolation2D
 	//////////////////////////////////////////////////////////////////////////////////////
 
 	CSPChipInterpolation2D::CSPChipInterpolation2D( std::vector< std::pair< double, double > > const& t_Points ) :
-		IInterpolation2D( t_Points ) {
+		IInterpolation2D( t_Points ), m_Uniform( false ), m_Step( 0 ) {
 		m_Hs = calculateHs();
 		m_Deltas = calculateDeltas();
 		m_Derivatives = calculateDerivatives();
+		compile();
 	}
 
 	double CSPChipInterpolation2D::getValue( double const t_Value ) const {
-		if ( t_Value <= m_Points.begin()->first ) {
-			return m_Points.begin()->second;
-		}
+		const auto value = clamp( t_Value );
+		return evaluate( getSubinterval( value ), value );
+	}
 
-		if ( t_Value >= ( m_Points.end() - 1 )->first ) {
-			return ( m_Points.end() - 1 )->second;
+	std::vector< double > CSPChipInterpolation2D::getValues( std::vector< double > const& t_Values ) const {
+		const auto size = t_Values.size();
+		std::vector< double > values( size );
+		std::vector< size_t > subintervals( size );
+		for ( size_t i = 0; i < size; ++i ) {
+			values[ i ] = clamp( t_Values[ i ] );
 		}
 
-		auto subinterval = getSubinterval( t_Value );
-		auto s = t_Value - m_Points[ subinterval ].first;
-		auto h = m_Hs[ subinterval ];
+		if ( std::is_sorted( values.begin(), values.end() ) ) {
+			size_t interval = 0;
+			const size_t lastPoint = m_X.size() - 1;
+			for ( size_t i = 0; i < size; ++i ) {
+				while ( interval < lastPoint && m_X[ interval + 1 ] <= values[ i ] ) {
+					++interval;
+				}
+				subintervals[ i ] = interval;
+			}
+		}
+		else {
+			for ( size_t i = 0; i < size; ++i ) {
+				subintervals[ i ] = getSubinterval( values[ i ] );
+			}
+		}
 
-		auto y_k = m_Points[ subinterval ].second;
-		auto y_k_plus_1 = m_Points[ subinterval + 1 ].second;
-		auto d_k = m_Derivatives[ subinterval ];
-		auto d_k_plus_1 = m_Derivatives[ subinterval + 1 ];
-		return interpolate( h, s, y_k, y_k_plus_1, d_k, d_k_plus_1 );
+		std::vector< double > result( size );
+		const auto X = m_X.data();
+		const auto Y = m_Y.data();
+		const auto C1 = m_C1.data();
+		const auto C2 = m_C2.data();
+		const auto C3 = m_C3.data();
+		for ( size_t i = 0; i < size; ++i ) {
+			const auto k = subintervals[ i ];
+			const auto s = values[ i ] - X[ k ];
+			result[ i ] = Y[ k ] + s * ( C1[ k ] + s * ( C2[ k ] + s * C3[ k ] ) );
+		}
+		return result;
 	}
 
+	// Value must be within interpolation range. Range end belongs to zero polynomial of last point.
 	size_t CSPChipInterpolation2D::getSubinterval( double const t_Value ) const {
-		size_t interval = 1;
-		for ( auto i = 1u; i < m_Points.size(); ++i ) {
-			if ( m_Points[ i ].first > t_Value ) {
-				interval = i - 1;
+		const size_t lastPoint = m_X.size() - 1;
+		if ( t_Value >= m_X.back() ) {
+			return lastPoint;
+		}
+		if ( m_Uniform ) {
+			auto interval = std::min( size_t( ( t_Value - m_X.front() ) / m_Step ), lastPoint - 1 );
+			// Guard against rounding of division close to the points
+			if ( t_Value < m_X[ interval ] ) {
+				--interval;
+			}
+			else if ( t_Value >= m_X[ interval + 1 ] ) {
+				++interval;
+			}
+			return interval;
+		}
+		const auto it = std::upper_bound( m_X.begin(), m_X.end(), t_Value );
+		return size_t( std::distance( m_X.begin(), it ) ) - 1;
+	}
+
+	double CSPChipInterpolation2D::clamp( double const t_Value ) const {
+		return std::min( std::max( t_Value, m_X.front() ), m_X.back() );
+	}
+
+	double CSPChipInterpolation2D::evaluate( size_t const t_Subinterval, double const t_Value ) const {
+		const auto s = t_Value - m_X[ t_Subinterval ];
+		return m_Y[ t_Subinterval ] +
+			s * ( m_C1[ t_Subinterval ] + s * ( m_C2[ t_Subinterval ] + s * m_C3[ t_Subinterval ] ) );
+	}
+
+	// Converts Hermite form of every subinterval into polynomial coefficients
+	void CSPChipInterpolation2D::compile() {
+		const auto size = m_Points.size();
+		m_X.resize( size );
+		m_Y.resize( size );
+		for ( size_t i = 0; i < size; ++i ) {
+			m_X[ i ] = m_Points[ i ].first;
+			m_Y[ i ] = m_Points[ i ].second;
+		}
+
+		m_C1.assign( size, 0 );
+		m_C2.assign( size, 0 );
+		m_C3.assign( size, 0 );
+		for ( size_t k = 0; k < m_Hs.size(); ++k ) {
+			const auto h = m_Hs[ k ];
+			const auto d_k = m_Derivatives[ k ];
+			const auto d_k_plus_1 = m_Derivatives[ k + 1 ];
+			m_C1[ k ] = d_k;
+			m_C2[ k ] = ( 3 * m_Deltas[ k ] - 2 * d_k - d_k_plus_1 ) / h;
+			m_C3[ k ] = ( d_k + d_k_plus_1 - 2 * m_Deltas[ k ] ) / ( h * h );
+		}
+
+		m_Step = ( m_X.back() - m_X.front() ) / double( m_Hs.size() );
+		m_Uniform = true;
+		for ( auto h : m_Hs ) {
+			if ( std::abs( h - m_Step ) > 1e-12 * m_Step ) {
+				m_Uniform = false;
 				break;
 			}
 		}
-		return interval;
 	}
 
 	std::vector< double > CSPChipInterpolation2D::calculateHs() const {
@@ -129,12 +216,4 @@ namespace FenestrationCommon {
 		}
 		return res;
 	}
-
-	double CSPChipInterpolation2D::interpolate( double const h, double const s, double const y_k,
-	                                            double const y_k_plus_one, double const d_k, double const d_k_plus_one ) const {
-		return ( ( 3 * h * std::pow( s, 2 ) - 2 * std::pow( s, 3 ) ) / std::pow( h, 3 ) ) * y_k_plus_one +
-			( ( std::pow( h, 3 ) - 3 * h * std::pow( s, 2 ) + 2 * std::pow( s, 3 ) ) / std::pow( h, 3 ) ) * y_k +
-			( ( std::pow( s, 2 ) * ( s - h ) ) / std::pow( h, 2 ) ) * d_k_plus_one +
-			( ( s * std::pow( s - h, 2 ) ) / std::pow( h, 2 ) ) * d_k;
-	}
 }
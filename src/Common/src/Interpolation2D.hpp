@@ -16,6 +16,10 @@ namespace FenestrationCommon {
 
 		virtual double getValue( double const t_Value ) const = 0;
 
+		// Evaluates interpolation for every value in the vector. Default implementation calls
+		// getValue for every point.
+		virtual std::vector< double > getValues( std::vector< double > const& t_Values ) const;
+
 	protected:
 		std::vector< std::pair< double, double > > m_Points;
 	};
@@ -24,25 +28,46 @@ namespace FenestrationCommon {
 	// CSPChipInterpolation2D
 	//////////////////////////////////////////////////////////////////////////////////////
 
+	// Piecewise cubic Hermite interpolation. Cubic coefficients of every interval are precomputed in
+	// constructor so that evaluation is reduced to interval lookup and one polynomial evaluation.
 	class CSPChipInterpolation2D : public IInterpolation2D {
 	public:
 		explicit CSPChipInterpolation2D( std::vector< std::pair< double, double > > const& t_Points );
 
-		double getValue( double const t_Value ) const;
+		double getValue( double const t_Value ) const override;
+
+		// Sorted values are located in single pass over subintervals and unsorted values are
+		// located one by one. Polynomials are evaluated afterwards in a loop without branches.
+		std::vector< double > getValues( std::vector< double > const& t_Values ) const override;
 
 	private:
 		std::size_t getSubinterval( double const t_Value ) const;
+		double clamp( double const t_Value ) const;
+		double evaluate( std::size_t const t_Subinterval, double const t_Value ) const;
+		void compile();
 		std::vector< double > calculateHs() const;
 		std::vector< double > calculateDeltas() const;
 		std::vector< double > calculateDerivatives() const;
 		static double piecewiseCubicDerivative( double const delta_k, double const delta_k_minus_1, double const hk,
 		                                        double const hk_minus_1 );
-		double interpolate( double const h, double const s, double const y_k, double const y_k_plus_one,
-		                    double const d_k, double const d_k_plus_one ) const;
 
 		std::vector< double > m_Hs;
 		std::vector< double > m_Deltas;
 		std::vector< double > m_Derivatives;
+
+		// Abscissas of points and polynomial coefficients of every subinterval. Value inside of
+		// subinterval k is y_k + s * ( c1_k + s * ( c2_k + s * c3_k ) ) where s = x - x_k. Last
+		// point has zero coefficients so that values at or above range end are evaluated as
+		// y_n without branching.
+		std::vector< double > m_X;
+		std::vector< double > m_Y;
+		std::vector< double > m_C1;
+		std::vector< double > m_C2;
+		std::vector< double > m_C3;
+
+		// Uniformly spaced points are located by direct indexing instead of binary search
+		bool m_Uniform;
+		double m_Step;
 	};
 
 }
@@ -18,6 +18,28 @@ namespace FenestrationCommon
 
         std::vector<size_t> index = t_MatrixA.makeUpperTriangular();
 
+        backSubstitution(t_MatrixA, index, t_VectorB);
+
+        return t_VectorB;
+    }
+
+    void CLinearSolver::solveSystemInPlace(SquareMatrix & t_MatrixA,
+                                           std::vector<double> & t_VectorB)
+    {
+        if(t_MatrixA.size() != t_VectorB.size())
+        {
+            throw std::runtime_error("Matrix and vector for system of linear equations are not same size.");
+        }
+
+        t_MatrixA.makeUpperTriangular(m_Index, m_Scaling);
+
+        backSubstitution(t_MatrixA, m_Index, t_VectorB);
+    }
+
+    void CLinearSolver::backSubstitution(const SquareMatrix & t_MatrixA,
+                                         const std::vector<size_t> & index,
+                                         std::vector<double> & t_VectorB)
+    {
         const int size = int(t_MatrixA.size());
 
         int ii = -1;
@@ -49,8 +71,6 @@ namespace FenestrationCommon
             }   // j
             t_VectorB[i] = sum / t_MatrixA(i, i);
         }   // i
-
-        return t_VectorB;
     }
 
 }   // namespace FenestrationCommon
@@ -13,8 +13,17 @@ namespace FenestrationCommon
 
         static std::vector<double> solveSystem(SquareMatrix & t_MatrixA, std::vector<double> & t_VectorB);
 
+        // Solution is stored into t_VectorB. Pivoting workspace is kept in the solver so repeated
+        // solutions of the same size system do not allocate memory.
+        void solveSystemInPlace(SquareMatrix & t_MatrixA, std::vector<double> & t_VectorB);
+
     private:
-        
+        static void backSubstitution(const SquareMatrix & t_MatrixA,
+                                     const std::vector<size_t> & index,
+                                     std::vector<double> & t_VectorB);
+
+        std::vector<size_t> m_Index;
+        std::vector<double> m_Scaling;
     };
 }   // namespace FenestrationCommon
 
@@ -0,0 +1,73 @@
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include <vector>
+#include <thread>
+#include <exception>
+#include <algorithm>
+
+namespace FenestrationCommon
+{
+    // Calls t_Function for every index in [0, t_Size). Indexes are split into contiguous
+    // blocks which are processed by separate threads. Exception thrown in any of the threads
+    // is rethrown in the calling thread.
+    template<typename Function>
+    void parallelFor(const size_t t_Size, const size_t t_NumberOfThreads, Function t_Function)
+    {
+        const size_t numThreads = std::min(t_NumberOfThreads, t_Size);
+        if(numThreads < 2)
+        {
+            for(size_t i = 0; i < t_Size; ++i)
+            {
+                t_Function(i);
+            }
+            return;
+        }
+
+        std::vector<std::exception_ptr> errors(numThreads);
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads);
+        const size_t blockSize = (t_Size + numThreads - 1) / numThreads;
+        for(size_t k = 0; k < numThreads; ++k)
+        {
+            const size_t start = k * blockSize;
+            const size_t end = std::min(start + blockSize, t_Size);
+            threads.emplace_back([&t_Function, &errors, k, start, end]() {
+                try
+                {
+                    for(size_t i = start; i < end; ++i)
+                    {
+                        t_Function(i);
+                    }
+                }
+                catch(...)
+                {
+                    errors[k] = std::current_exception();
+                }
+            });
+        }
+
+        for(auto & aThread : threads)
+        {
+            aThread.join();
+        }
+
+        for(const auto & anError : errors)
+        {
+            if(anError != nullptr)
+            {
+                std::rethrow_exception(anError);
+            }
+        }
+    }
+
+    // Number of threads where zero stands for all hardware threads
+    inline size_t numberOfThreads(const size_t t_NumberOfThreads)
+    {
+        return t_NumberOfThreads == 0 ? std::max(std::thread::hardware_concurrency(), 1u)
+                                      : t_NumberOfThreads;
+    }
+
+}   // namespace FenestrationCommon
+
+#endif
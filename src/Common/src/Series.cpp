@@ -4,6 +4,7 @@
 
 #include "wceunique.hpp"
 #include "Series.hpp"
+#include "WavelengthGrid.hpp"
 #include "IntegratorStrategy.hpp"
 
 
@@ -80,7 +81,7 @@ namespace FenestrationCommon
         }
     }
 
-    CSeries::CSeries(CSeries const & t_Series)
+    CSeries::CSeries(CSeries const & t_Series) : m_Grid(t_Series.m_Grid)
     {
         m_Series.clear();
         for(const auto & val : t_Series.m_Series)
@@ -92,11 +93,13 @@ namespace FenestrationCommon
     void CSeries::addProperty(const double t_x, const double t_Value)
     {
         m_Series.push_back(wce::make_unique<CSeriesPoint>(t_x, t_Value));
+        m_Grid = nullptr;
     }
 
     void CSeries::insertToBeginning(double t_x, double t_Value)
     {
         m_Series.insert(m_Series.begin(), wce::make_unique<CSeriesPoint>(t_x, t_Value));
+        m_Grid = nullptr;
     }
 
     void CSeries::setConstantValues(const std::vector<double> & t_Wavelengths, double const t_Value)
@@ -106,6 +109,7 @@ namespace FenestrationCommon
         {
             addProperty((*it), t_Value);
         }
+        m_Grid = CWavelengthGrid::intern(t_Wavelengths);
     }
 
     std::unique_ptr<CSeries> CSeries::integrate(IntegrationType t_IntegrationType,
@@ -176,32 +180,58 @@ namespace FenestrationCommon
 
     CSeries CSeries::interpolate(const std::vector<double> & t_Wavelengths) const
     {
-        CSeries newProperties;
-
-        if(size() != 0)
+        // Wavelengths are not interned here since that locks global grid pool on every call
+        if(m_Grid != nullptr && m_Grid->values() == t_Wavelengths)
         {
-            ISeriesPoint * lower = nullptr;
-            ISeriesPoint * upper = nullptr;
-
-            for(double wavelength : t_Wavelengths)
-            {
-                lower = findLower(wavelength);
-                upper = findUpper(wavelength);
+            return *this;
+        }
+        if(size() == 0)
+        {
+            return CSeries();
+        }
+        return interpolateWithStencil(t_Wavelengths,
+                                      CWavelengthGrid::stencil(getXArray(), t_Wavelengths));
+    }
 
-                if(lower == nullptr)
-                {
-                    lower = upper;
-                }
+    CSeries CSeries::interpolate(const std::shared_ptr<const CWavelengthGrid> & t_Grid) const
+    {
+        if(t_Grid == nullptr)
+        {
+            throw std::runtime_error("Wavelength grid for interpolation is not defined.");
+        }
+        if(m_Grid == t_Grid)
+        {
+            return *this;
+        }
+        if(size() == 0)
+        {
+            return CSeries();
+        }
 
-                if(upper == nullptr)
-                {
-                    upper = lower;
-                }
+        // Stencils are cached between grids so search for surrounding points is done only
+        // once for every pair of wavelength sets.
+        CSeries newProperties =
+          m_Grid != nullptr
+            ? interpolateWithStencil(t_Grid->values(), *m_Grid->stencil(t_Grid))
+            : interpolateWithStencil(t_Grid->values(),
+                                     CWavelengthGrid::stencil(getXArray(), t_Grid->values()));
+        newProperties.m_Grid = t_Grid;
+        return newProperties;
+    }
 
-                newProperties.addProperty(wavelength, interpolate(lower, upper, wavelength));
-            }
+    CSeries CSeries::interpolateWithStencil(const std::vector<double> & t_Wavelengths,
+                                            const std::vector<GridStencilPoint> & t_Stencil) const
+    {
+        CSeries newProperties;
+        newProperties.m_Series.reserve(t_Wavelengths.size());
+        for(size_t i = 0; i < t_Wavelengths.size(); ++i)
+        {
+            const auto & point = t_Stencil[i];
+            const double wavelength = t_Wavelengths[i];
+            newProperties.m_Series.push_back(wce::make_unique<CSeriesPoint>(
+              wavelength,
+              interpolate(m_Series[point.Lower].get(), m_Series[point.Upper].get(), wavelength)));
         }
-
         return newProperties;
     }
 
@@ -212,6 +242,7 @@ namespace FenestrationCommon
         const double WAVELENGTHTOLERANCE = 1e-10;
 
         size_t minSize = std::min(m_Series.size(), other.m_Series.size());
+        const bool sameGrid = hasSameGrid(other);
 
         for(size_t i = 0; i < minSize; ++i)
         {
@@ -219,13 +250,14 @@ namespace FenestrationCommon
             double wv = m_Series[i]->x();
             double testWv = other.m_Series[i]->x();
 
-            if(std::abs(wv - testWv) > WAVELENGTHTOLERANCE)
+            if(!sameGrid && std::abs(wv - testWv) > WAVELENGTHTOLERANCE)
             {
                 throw std::runtime_error(
                         "Wavelengths of two vectors are not the same. Cannot preform multiplication.");
             }
             newProperty.addProperty(wv, value);
         }
+        newProperty.setGridFrom(*this);
 
         return newProperty;
     }
@@ -235,6 +267,7 @@ namespace FenestrationCommon
 
         CSeries newProperties;
         size_t minSize = std::min(m_Series.size(), t_Series.m_Series.size());
+        const bool sameGrid = hasSameGrid(t_Series);
 
         for(size_t i = 0; i < minSize; ++i)
         {
@@ -242,7 +275,7 @@ namespace FenestrationCommon
             double wv = m_Series[i]->x();
             double testWv = t_Series.m_Series[i]->x();
 
-            if(std::abs(wv - testWv) > WAVELENGTHTOLERANCE)
+            if(!sameGrid && std::abs(wv - testWv) > WAVELENGTHTOLERANCE)
             {
                 throw std::runtime_error(
                         "Wavelengths of two vectors are not the same. Cannot preform subtraction.");
@@ -250,6 +283,7 @@ namespace FenestrationCommon
 
             newProperties.addProperty(wv, value);
         }
+        newProperties.setGridFrom(*this);
 
         return newProperties;
     }
@@ -264,6 +298,7 @@ namespace FenestrationCommon
 
             newProperties.addProperty(wv, value);
         }
+        newProperties.setGridFrom(other);
 
         return newProperties;
     }
@@ -273,6 +308,7 @@ namespace FenestrationCommon
 
         CSeries newProperties;
         size_t minSize = std::min(m_Series.size(), other.m_Series.size());
+        const bool sameGrid = hasSameGrid(other);
 
         for(size_t i = 0; i < minSize; ++i)
         {
@@ -280,7 +316,7 @@ namespace FenestrationCommon
             double wv = m_Series[i]->x();
             double testWv = other.m_Series[i]->x();
 
-            if(std::abs(wv - testWv) > WAVELENGTHTOLERANCE)
+            if(!sameGrid && std::abs(wv - testWv) > WAVELENGTHTOLERANCE)
             {
                 throw std::runtime_error(
                         "Wavelengths of two vectors are not the same. Cannot preform addition.");
@@ -288,12 +324,88 @@ namespace FenestrationCommon
 
             newProperties.addProperty(wv, value);
         }
+        newProperties.setGridFrom(*this);
 
         return newProperties;
     }
 
+    void CSeries::checkSameWavelengths(const CSeries & t_Series) const
+    {
+        const double WAVELENGTHTOLERANCE = 1e-10;
+
+        if(hasSameGrid(t_Series))
+        {
+            return;
+        }
+
+        if(m_Series.size() != t_Series.m_Series.size())
+        {
+            throw std::runtime_error(
+                    "Series are not the same size. Cannot perform fused operation.");
+        }
+
+        for(size_t i = 0; i < m_Series.size(); ++i)
+        {
+            if(std::abs(m_Series[i]->x() - t_Series.m_Series[i]->x()) > WAVELENGTHTOLERANCE)
+            {
+                throw std::runtime_error(
+                        "Wavelengths of two vectors are not the same. Cannot perform fused operation.");
+            }
+        }
+    }
+
+    void CSeries::setXFrom(const CSeries & t_Series)
+    {
+        const double WAVELENGTHTOLERANCE = 1e-10;
+
+        if(hasSameGrid(t_Series))
+        {
+            return;
+        }
+
+        // Same tolerance as in wavelength check so that series which is also an argument of fused
+        // operation is never rebuilt
+        bool sameX = m_Series.size() == t_Series.m_Series.size();
+        for(size_t i = 0; sameX && i < m_Series.size(); ++i)
+        {
+            sameX = std::abs(m_Series[i]->x() - t_Series.m_Series[i]->x()) <= WAVELENGTHTOLERANCE;
+        }
+
+        if(!sameX)
+        {
+            m_Series.clear();
+            m_Series.reserve(t_Series.m_Series.size());
+            for(const auto & point : t_Series.m_Series)
+            {
+                m_Series.push_back(wce::make_unique<CSeriesPoint>(point->x(), 0));
+            }
+            m_Grid = t_Series.m_Grid;
+        }
+    }
+
+    bool CSeries::hasSameGrid(const CSeries & t_Series) const
+    {
+        return m_Grid != nullptr && m_Grid == t_Series.m_Grid;
+    }
+
+    void CSeries::setGridFrom(const CSeries & t_Series)
+    {
+        // Grid describes x values of the series only if all points are taken
+        m_Grid = m_Series.size() == t_Series.m_Series.size() ? t_Series.m_Grid : nullptr;
+    }
+
+    const std::shared_ptr<const CWavelengthGrid> & CSeries::wavelengthGrid() const
+    {
+        return m_Grid;
+    }
+
     std::vector<double> CSeries::getXArray() const
     {
+        if(m_Grid != nullptr)
+        {
+            return m_Grid->values();
+        }
+
         std::vector<double> aArray;
         for(auto & spectralProperty : m_Series)
         {
@@ -330,6 +442,7 @@ namespace FenestrationCommon
                   m_Series.end(),
                   [](std::unique_ptr<ISeriesPoint> const & l,
                      std::unique_ptr<ISeriesPoint> const & r) -> bool { return l->x() < r->x(); });
+        m_Grid = nullptr;
     }
 
     std::vector<std::unique_ptr<ISeriesPoint>>::const_iterator CSeries::begin() const
@@ -349,6 +462,11 @@ namespace FenestrationCommon
 
     CSeries & CSeries::operator=(CSeries const & t_Series)
     {
+        if(this == &t_Series)
+        {
+            return *this;
+        }
+        m_Grid = t_Series.m_Grid;
         m_Series.clear();
         for(std::unique_ptr<ISeriesPoint> const & val : t_Series.m_Series)
         {
@@ -369,6 +487,7 @@ namespace FenestrationCommon
     void CSeries::clear()
     {
         m_Series.clear();
+        m_Grid = nullptr;
     }
 
     void CSeries::cutExtraData(double minWavelength, double maxWavelength)
@@ -389,6 +508,7 @@ namespace FenestrationCommon
         {
             m_Series.push_back(val->clone());
         }
+        m_Grid = nullptr;
     }
 
 }   // namespace FenestrationCommon
@@ -39,6 +39,8 @@ namespace FenestrationCommon
     };
 
     enum class IntegrationType;
+    class CWavelengthGrid;
+    struct GridStencilPoint;
 
     // Spectral properties for certain range of data. It holds common behavior like integration and
     // interpolation over certain range of data. class CSeries : public
@@ -61,6 +63,9 @@ namespace FenestrationCommon
         std::unique_ptr<CSeries> integrate(IntegrationType t_IntegrationType,
                                            double normalizationCoefficient = 1) const;
         CSeries interpolate(const std::vector<double> & t_Wavelengths) const;
+        //! \brief Interpolation to interned grid. Stencil between grids is cached and result
+        //! references t_Grid.
+        CSeries interpolate(const std::shared_ptr<const CWavelengthGrid> & t_Grid) const;
 
         //! \brief Multiplication of values in spectral properties that have same wavelength.
         //!
@@ -83,6 +88,30 @@ namespace FenestrationCommon
         //! range, then interpolation function should be called.
         CSeries operator+(const CSeries & other) const;
 
+        //! \brief Fused arithmetic of spectral properties that have same wavelengths.
+        //!
+        //! Series is filled with t_Function evaluated for values of all arguments at each
+        //! wavelength, for example
+        //!     result.apply([](double t, double r) { return 1 - t - r; }, T, R);
+        //! Composite formulas are calculated in single pass without temporary series. Existing
+        //! points are reused when series already has wavelengths of the arguments so repeated
+        //! evaluation into the same series does not allocate. Series can be one of its own
+        //! arguments. All arguments must have identical wavelengths; otherwise runtime error will
+        //! be thrown.
+        template<typename Function, typename... Series>
+        void apply(Function t_Function, const CSeries & t_First, const Series &... t_Series)
+        {
+            const int checks[] = {0, (t_First.checkSameWavelengths(t_Series), 0)...};
+            (void)checks;
+            setXFrom(t_First);
+            const size_t size = m_Series.size();
+            for(size_t i = 0; i < size; ++i)
+            {
+                m_Series[i]->value(
+                  t_Function(t_First.m_Series[i]->value(), t_Series.m_Series[i]->value()...));
+            }
+        }
+
         // Return wavelength values for spectral properties.
         std::vector<double> getXArray() const;
 
@@ -103,12 +132,35 @@ namespace FenestrationCommon
 
         void cutExtraData(double minWavelength, double maxWavelength);
 
+        //! \brief Shared wavelength grid of the series.
+        //!
+        //! Series created from wavelength set (setConstantValues and interpolate) and results of
+        //! arithmetic on them reference interned grid. Series with the same grid have identical
+        //! wavelengths, which is checked by pointer compare. Null if grid is not known (for
+        //! example, series built point by point).
+        const std::shared_ptr<const CWavelengthGrid> & wavelengthGrid() const;
+
     private:
+        friend CSeries operator-(double val, const CSeries & other);
+
+        void checkSameWavelengths(const CSeries & t_Series) const;
+        bool hasSameGrid(const CSeries & t_Series) const;
+
+        // Result of operation takes grid of t_Series
+        void setGridFrom(const CSeries & t_Series);
+
+        // Makes x values of series same as in t_Series. Points are kept if x values are already
+        // the same (within wavelength tolerance).
+        void setXFrom(const CSeries & t_Series);
+
         ISeriesPoint * findLower(double t_x) const;
         ISeriesPoint * findUpper(double t_x) const;
         static double interpolate(ISeriesPoint * t_Lower, ISeriesPoint * t_Upper, double t_x);
+        CSeries interpolateWithStencil(const std::vector<double> & t_Wavelengths,
+                                       const std::vector<GridStencilPoint> & t_Stencil) const;
 
         std::vector<std::unique_ptr<ISeriesPoint>> m_Series;
+        std::shared_ptr<const CWavelengthGrid> m_Grid;
     };
 
     CSeries operator-(const double val, const CSeries & other);
@@ -0,0 +1,133 @@
+#include <stdexcept>
+
+#include "SpectralWeights.hpp"
+#include "Series.hpp"
+
+namespace FenestrationCommon
+{
+    std::vector<double> integrationCoefficients(const std::vector<double> & t_Wavelengths,
+                                                const IntegrationType t_IntegrationType,
+                                                const double normalizationCoefficient,
+                                                const double minLambda,
+                                                const double maxLambda)
+    {
+        // Integrators are linear and every integrated value depends on at most two neighbouring
+        // points. Integrating series that are one at even (odd) points and zero otherwise gives
+        // contribution of even (odd) point to each integrated value.
+        const auto size = t_Wavelengths.size();
+        CSeries even;
+        CSeries odd;
+        for(size_t i = 0; i < size; ++i)
+        {
+            even.addProperty(t_Wavelengths[i], i % 2 == 0 ? 1 : 0);
+            odd.addProperty(t_Wavelengths[i], i % 2 == 0 ? 0 : 1);
+        }
+        const auto evenIntegral = even.integrate(t_IntegrationType, normalizationCoefficient);
+        const auto oddIntegral = odd.integrate(t_IntegrationType, normalizationCoefficient);
+
+        std::vector<double> result(size, 0);
+        // Integrated value is either defined over range between two points or for each point
+        const auto numOfRanges = evenIntegral->size();
+        const auto offset = numOfRanges == size ? 0u : 1u;
+        for(size_t i = 0; i < numOfRanges; ++i)
+        {
+            // Same range check as in CSeries::sum
+            const double TOLERANCE = 1e-6;
+            const auto wavelength = (*evenIntegral)[i].x();
+            if(!((wavelength >= (minLambda - TOLERANCE) && wavelength < (maxLambda - TOLERANCE))
+                 || (minLambda == 0 && maxLambda == 0)))
+            {
+                continue;
+            }
+            const auto evenIndex = (i + offset) % 2 == 0 ? i + offset : i;
+            const auto oddIndex = (i + offset) % 2 == 0 ? i : i + offset;
+            result[evenIndex] += (*evenIntegral)[i].value();
+            result[oddIndex] += (*oddIntegral)[i].value();
+        }
+
+        return result;
+    }
+
+    CSpectralWeights::CSpectralWeights(const std::vector<CSeries> & t_Weights,
+                                       const IntegrationType t_IntegrationType,
+                                       const double normalizationCoefficient,
+                                       const double minLambda,
+                                       const double maxLambda) :
+        m_Wavelengths(t_Weights.empty() ? std::vector<double>() : t_Weights[0].getXArray()),
+        m_Totals(t_Weights.size(), 0)
+    {
+        const auto size = m_Wavelengths.size();
+        const auto coefficients = integrationCoefficients(
+          m_Wavelengths, t_IntegrationType, normalizationCoefficient, minLambda, maxLambda);
+
+        m_Weights.resize(t_Weights.size() * size);
+        for(size_t k = 0; k < t_Weights.size(); ++k)
+        {
+            if(t_Weights[k].size() != size)
+            {
+                throw std::runtime_error(
+                  "Weighting functions must be defined over the same wavelengths.");
+            }
+            auto row = m_Weights.data() + k * size;
+            for(size_t i = 0; i < size; ++i)
+            {
+                row[i] = coefficients[i] * t_Weights[k][i].value();
+                m_Totals[k] += row[i];
+            }
+            // Zero property is assumed when there is no incoming energy
+            const auto factor = m_Totals[k] != 0 ? 1 / m_Totals[k] : 0;
+            for(size_t i = 0; i < size; ++i)
+            {
+                row[i] *= factor;
+            }
+        }
+    }
+
+    size_t CSpectralWeights::numberOfWeights() const
+    {
+        return m_Totals.size();
+    }
+
+    const std::vector<double> & CSpectralWeights::getWavelengths() const
+    {
+        return m_Wavelengths;
+    }
+
+    const std::vector<double> & CSpectralWeights::getTotals() const
+    {
+        return m_Totals;
+    }
+
+    std::vector<double> CSpectralWeights::average(const std::vector<double> & t_Property) const
+    {
+        const auto size = m_Wavelengths.size();
+        if(t_Property.size() != size)
+        {
+            throw std::runtime_error(
+              "Property must be defined over the same wavelengths as weighting functions.");
+        }
+        std::vector<double> result(m_Totals.size(), 0);
+        for(size_t k = 0; k < result.size(); ++k)
+        {
+            const auto row = m_Weights.data() + k * size;
+            double sum = 0;
+            for(size_t i = 0; i < size; ++i)
+            {
+                sum += row[i] * t_Property[i];
+            }
+            result[k] = sum;
+        }
+        return result;
+    }
+
+    std::vector<double> CSpectralWeights::average(const CSeries & t_Property) const
+    {
+        std::vector<double> values(t_Property.size());
+        for(size_t i = 0; i < values.size(); ++i)
+        {
+            values[i] = t_Property[i].value();
+        }
+        return average(values);
+    }
+
+}   // namespace FenestrationCommon
@@ -0,0 +1,56 @@
+#ifndef SPECTRALWEIGHTS_H
+#define SPECTRALWEIGHTS_H
+
+#include <vector>
+
+#include "IntegratorStrategy.hpp"
+
+namespace FenestrationCommon
+{
+    class CSeries;
+
+    // Coefficients of each wavelength in sum of integrated series over [minLambda, maxLambda)
+    // range. Sum of t_IntegrationType integral of any series y defined over t_Wavelengths is equal
+    // to sum of coefficient[i] * y[i].
+    std::vector<double> integrationCoefficients(const std::vector<double> & t_Wavelengths,
+                                                IntegrationType t_IntegrationType,
+                                                double normalizationCoefficient,
+                                                double minLambda,
+                                                double maxLambda);
+
+    // Weight matrix (number of weighting functions x number of wavelengths) for integration of
+    // spectral properties with many sources (or source and detector products) at once. Each row
+    // is normalized with integrated weighting function so that product of matrix with property
+    // over wavelengths gives property averaged with every weighting function.
+    class CSpectralWeights
+    {
+    public:
+        // All weighting functions must be defined over the same wavelengths.
+        CSpectralWeights(const std::vector<CSeries> & t_Weights,
+                         IntegrationType t_IntegrationType,
+                         double normalizationCoefficient,
+                         double minLambda,
+                         double maxLambda);
+
+        size_t numberOfWeights() const;
+        const std::vector<double> & getWavelengths() const;
+
+        // Integrated weighting functions (incoming energy for each source)
+        const std::vector<double> & getTotals() const;
+
+        // Property averaged with every weighting function. Property must be defined over the same
+        // wavelengths as weighting functions.
+        std::vector<double> average(const std::vector<double> & t_Property) const;
+        std::vector<double> average(const CSeries & t_Property) const;
+
+    private:
+        std::vector<double> m_Wavelengths;
+        std::vector<double> m_Totals;
+
+        // Row major matrix of normalized weights
+        std::vector<double> m_Weights;
+    };
+
+}   // namespace FenestrationCommon
+
+#endif
@@ -3,18 +3,22 @@
 #include <cmath>
 
 #include "SquareMatrix.hpp"
+#include "Instrumentation.hpp"
 
 namespace FenestrationCommon
 {
     SquareMatrix::SquareMatrix(const std::size_t tSize) :
         m_size(tSize),
         m_Matrix(tSize, std::vector<double>(tSize, 0))
-    {}
+    {
+        WCE_COUNT_MATRIX();
+    }
 
     SquareMatrix::SquareMatrix(const std::initializer_list<std::vector<double>> & tInput) :
         m_size(tInput.size()),
         m_Matrix(m_size, std::vector<double>(m_size, 0))
     {
+        WCE_COUNT_MATRIX();
         auto i = 0u;
         for(const auto & vec : tInput)
         {
@@ -29,12 +33,16 @@ namespace FenestrationCommon
     SquareMatrix::SquareMatrix(const std::vector<std::vector<double>> & tInput) :
         m_size(tInput.size()),
         m_Matrix(tInput)
-    {}
+    {
+        WCE_COUNT_MATRIX();
+    }
 
     SquareMatrix::SquareMatrix(const std::vector<std::vector<double>> && tInput) :
         m_size(tInput.size()),
         m_Matrix(tInput)
-    {}
+    {
+        WCE_COUNT_MATRIX();
+    }
 
     std::size_t SquareMatrix::size() const
     {
@@ -43,7 +51,11 @@ namespace FenestrationCommon
 
     void SquareMatrix::setZeros()
     {
-        m_Matrix.assign(m_size, std::vector<double>(m_size, 0));
+        // Rows are reused so that repeated calls do not allocate memory
+        for(auto & row : m_Matrix)
+        {
+            row.assign(m_size, 0);
+        }
     }
 
     void SquareMatrix::setIdentity()
@@ -69,6 +81,31 @@ namespace FenestrationCommon
         }
     }
 
+    bool SquareMatrix::isDiagonal() const
+    {
+        for(auto i = 0u; i < m_size; ++i)
+        {
+            for(auto j = 0u; j < m_size; ++j)
+            {
+                if(i != j && m_Matrix[i][j] != 0)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    std::vector<double> SquareMatrix::getDiagonal() const
+    {
+        std::vector<double> result(m_size);
+        for(auto i = 0u; i < m_size; ++i)
+        {
+            result[i] = m_Matrix[i][i];
+        }
+        return result;
+    }
+
     // SquareMatrix::SquareMatrix(SquareMatrix && tMatrix) :
     //    m_size(tMatrix.size()),
     //    m_Matrix(std::move(tMatrix.m_Matrix))
@@ -127,7 +164,7 @@ namespace FenestrationCommon
     SquareMatrix SquareMatrix::LU() const {
         SquareMatrix D(this->m_Matrix);
 
-        for(auto k = 0u; k <= m_size - 2; ++k)
+        for(auto k = 0u; k + 1 < m_size; ++k)
         {
             for(auto j = k + 1; j <= m_size - 1; ++j)
             {
@@ -146,6 +183,13 @@ namespace FenestrationCommon
     std::vector<double> SquareMatrix::checkSingularity() const
     {
         std::vector<double> vv;
+        checkSingularity(vv);
+        return vv;
+    }
+
+    void SquareMatrix::checkSingularity(std::vector<double> & vv) const
+    {
+        vv.clear();
 
         for (auto i = 0u; i < m_size; ++i)
         {
@@ -164,17 +208,23 @@ namespace FenestrationCommon
             }
             vv.push_back(1 / aamax);
         }
-
-        return vv;
     }
 
     std::vector<size_t> SquareMatrix::makeUpperTriangular()
+    {
+        std::vector<size_t> index;
+        std::vector<double> vv;
+        makeUpperTriangular(index, vv);
+        return index;
+    }
+
+    void SquareMatrix::makeUpperTriangular(std::vector<size_t> & index, std::vector<double> & vv)
     {
         const auto TINY( 1e-20 );
 
-        std::vector<size_t> index(m_size);
+        index.resize(m_size);
 
-        std::vector<double> vv = checkSingularity();
+        checkSingularity(vv);
 
         auto d = 1;
 
@@ -234,8 +284,6 @@ namespace FenestrationCommon
                 }   // i
             }
         }
-
-        return index;
     }
 
     SquareMatrix operator*(const SquareMatrix & first, const SquareMatrix & second)
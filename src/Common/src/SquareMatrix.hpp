@@ -18,7 +18,14 @@ namespace FenestrationCommon
         void setIdentity();
         void setDiagonal(const std::vector<double> & tInput);
 
+        // True if all off-diagonal elements are zero
+        bool isDiagonal() const;
+        std::vector<double> getDiagonal() const;
+
         std::vector<size_t> makeUpperTriangular();
+        // Same as above with row permutation and scaling stored into provided workspace vectors.
+        // Vectors are not reallocated if they already have enough capacity.
+        void makeUpperTriangular(std::vector<size_t> & index, std::vector<double> & vv);
 
         SquareMatrix inverse() const;
 
@@ -31,6 +38,7 @@ namespace FenestrationCommon
         // explicit SquareMatrix(SquareMatrix && tMatrix);
         SquareMatrix LU() const;
         std::vector<double> checkSingularity() const;
+        void checkSingularity(std::vector<double> & vv) const;
         std::size_t m_size;
         std::vector<std::vector<double>> m_Matrix;
     };
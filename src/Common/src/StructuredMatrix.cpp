@@ -0,0 +1,598 @@
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+
+#include "StructuredMatrix.hpp"
+
+namespace FenestrationCommon
+{
+    namespace
+    {
+        typedef std::vector<std::vector<double>> Factors;
+
+        // Factors are kept as long as rank is small compared to matrix size. Products and
+        // inverse of factors are O(n * k^2) while expanded matrix is O(n^2 * k).
+        std::size_t maxRank(const std::size_t size)
+        {
+            return size / 4;
+        }
+
+        SquareMatrix expand(const std::vector<double> & tDiagonal,
+                            const Factors & tU,
+                            const Factors & tV)
+        {
+            const auto size = tDiagonal.size();
+            SquareMatrix aMatrix{size};
+            aMatrix.setDiagonal(tDiagonal);
+            for(size_t k = 0; k < tU.size(); ++k)
+            {
+                for(size_t i = 0; i < size; ++i)
+                {
+                    const auto u = tU[k][i];
+                    if(u == 0)
+                    {
+                        continue;
+                    }
+                    for(size_t j = 0; j < size; ++j)
+                    {
+                        aMatrix(i, j) += u * tV[k][j];
+                    }
+                }
+            }
+            return aMatrix;
+        }
+
+        std::vector<double> scaled(const std::vector<double> & tScale,
+                                   const std::vector<double> & tVector)
+        {
+            std::vector<double> result(tVector.size());
+            for(size_t i = 0; i < tVector.size(); ++i)
+            {
+                result[i] = tScale[i] * tVector[i];
+            }
+            return result;
+        }
+
+        Factors scaled(const std::vector<double> & tScale, const Factors & tFactors)
+        {
+            Factors result;
+            result.reserve(tFactors.size());
+            for(const auto & aFactor : tFactors)
+            {
+                result.push_back(scaled(tScale, aFactor));
+            }
+            return result;
+        }
+
+        double dot(const std::vector<double> & first, const std::vector<double> & second)
+        {
+            double sum = 0;
+            for(size_t i = 0; i < first.size(); ++i)
+            {
+                sum += first[i] * second[i];
+            }
+            return sum;
+        }
+
+        StructuredMatrix addLowRank(const StructuredMatrix & first,
+                                    const StructuredMatrix & second,
+                                    const double sign)
+        {
+            auto aDiagonal = first.diagonal();
+            const auto secondDiagonal = second.diagonal();
+            for(size_t i = 0; i < aDiagonal.size(); ++i)
+            {
+                aDiagonal[i] += sign * secondDiagonal[i];
+            }
+            auto aU = first.leftFactors();
+            auto aV = first.rightFactors();
+            for(size_t k = 0; k < second.rank(); ++k)
+            {
+                auto u = second.leftFactors()[k];
+                for(auto & value : u)
+                {
+                    value *= sign;
+                }
+                aU.push_back(u);
+                aV.push_back(second.rightFactors()[k]);
+            }
+            return StructuredMatrix(aDiagonal, aU, aV);
+        }
+    }   // namespace
+
+    StructuredMatrix::StructuredMatrix(const SquareMatrix & tMatrix) :
+        m_Matrix(tMatrix),
+        m_Structure(MatrixStructure::Dense),
+        m_Expanded(true)
+    {
+        if(tMatrix.isDiagonal())
+        {
+            m_Structure = MatrixStructure::Diagonal;
+        }
+        else if(hasConstantColumns(tMatrix))
+        {
+            const auto aFactors = fromConstantColumns(tMatrix);
+            m_Structure = MatrixStructure::LowRank;
+            m_Diagonal = aFactors.m_Diagonal;
+            m_U = aFactors.m_U;
+            m_V = aFactors.m_V;
+        }
+    }
+
+    StructuredMatrix::StructuredMatrix(const SquareMatrix & tMatrix,
+                                       const MatrixStructure tStructure) :
+        m_Matrix(tMatrix),
+        m_Structure(tStructure),
+        m_Expanded(true)
+    {
+        if(tStructure == MatrixStructure::LowRank)
+        {
+            throw std::runtime_error("Low rank matrix must be created from its factors.");
+        }
+    }
+
+    StructuredMatrix::StructuredMatrix(const std::vector<double> & tDiagonal) :
+        m_Matrix(tDiagonal.size()),
+        m_Structure(MatrixStructure::Diagonal),
+        m_Expanded(true)
+    {
+        m_Matrix.setDiagonal(tDiagonal);
+    }
+
+    StructuredMatrix::StructuredMatrix(const std::vector<double> & tDiagonal,
+                                       const std::vector<std::vector<double>> & tU,
+                                       const std::vector<std::vector<double>> & tV) :
+        m_Structure(MatrixStructure::LowRank),
+        m_Diagonal(tDiagonal),
+        m_U(tU),
+        m_V(tV),
+        m_Expanded(false)
+    {
+        const auto size = tDiagonal.size();
+        if(tU.size() != tV.size())
+        {
+            throw std::runtime_error("Low rank factors must have same number of columns.");
+        }
+        for(size_t k = 0; k < tU.size(); ++k)
+        {
+            if(tU[k].size() != size || tV[k].size() != size)
+            {
+                throw std::runtime_error("Low rank factors do not match size of diagonal.");
+            }
+        }
+
+        if(tU.empty())
+        {
+            m_Matrix = SquareMatrix(size);
+            m_Matrix.setDiagonal(tDiagonal);
+            m_Structure = MatrixStructure::Diagonal;
+            m_Expanded = true;
+        }
+        else if(tU.size() > maxRank(size))
+        {
+            m_Matrix = expand(tDiagonal, tU, tV);
+            m_Structure = MatrixStructure::Dense;
+            m_Expanded = true;
+        }
+
+        if(m_Structure != MatrixStructure::LowRank)
+        {
+            m_Diagonal.clear();
+            m_U.clear();
+            m_V.clear();
+        }
+    }
+
+    bool StructuredMatrix::hasConstantColumns(const SquareMatrix & tMatrix)
+    {
+        const auto size = tMatrix.size();
+        if(maxRank(size) == 0)
+        {
+            return false;
+        }
+        for(size_t j = 0; j < size; ++j)
+        {
+            const auto value = tMatrix(j == 0 ? 1 : 0, j);
+            for(size_t i = 0; i < size; ++i)
+            {
+                if(i != j && tMatrix(i, j) != value)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    StructuredMatrix StructuredMatrix::fromConstantColumns(const SquareMatrix & tMatrix)
+    {
+        if(!hasConstantColumns(tMatrix))
+        {
+            throw std::runtime_error("Matrix does not have constant columns.");
+        }
+        const auto size = tMatrix.size();
+        std::vector<double> aDiagonal(size);
+        std::vector<double> aColumns(size);
+        for(size_t j = 0; j < size; ++j)
+        {
+            aColumns[j] = tMatrix(j == 0 ? 1 : 0, j);
+            aDiagonal[j] = tMatrix(j, j) - aColumns[j];
+        }
+        return StructuredMatrix(aDiagonal, {std::vector<double>(size, 1)}, {aColumns});
+    }
+
+    std::size_t StructuredMatrix::size() const
+    {
+        return isLowRank() ? m_Diagonal.size() : m_Matrix.size();
+    }
+
+    MatrixStructure StructuredMatrix::structure() const
+    {
+        return m_Structure;
+    }
+
+    bool StructuredMatrix::isDiagonal() const
+    {
+        return m_Structure == MatrixStructure::Diagonal;
+    }
+
+    bool StructuredMatrix::isLowRank() const
+    {
+        return m_Structure == MatrixStructure::LowRank;
+    }
+
+    std::size_t StructuredMatrix::rank() const
+    {
+        return m_U.size();
+    }
+
+    std::vector<double> StructuredMatrix::diagonal() const
+    {
+        return isLowRank() ? m_Diagonal : m_Matrix.getDiagonal();
+    }
+
+    const std::vector<std::vector<double>> & StructuredMatrix::leftFactors() const
+    {
+        return m_U;
+    }
+
+    const std::vector<std::vector<double>> & StructuredMatrix::rightFactors() const
+    {
+        return m_V;
+    }
+
+    const SquareMatrix & StructuredMatrix::matrix() const
+    {
+        if(!m_Expanded)
+        {
+            m_Matrix = expand(m_Diagonal, m_U, m_V);
+            m_Expanded = true;
+        }
+        return m_Matrix;
+    }
+
+    double StructuredMatrix::operator()(const std::size_t i, const std::size_t j) const
+    {
+        if(m_Expanded)
+        {
+            return m_Matrix(i, j);
+        }
+        auto value = i == j ? m_Diagonal[i] : 0.0;
+        for(size_t k = 0; k < m_U.size(); ++k)
+        {
+            value += m_U[k][i] * m_V[k][j];
+        }
+        return value;
+    }
+
+    StructuredMatrix StructuredMatrix::inverse() const
+    {
+        if(isDiagonal())
+        {
+            std::vector<double> diagonal(m_Matrix.getDiagonal());
+            for(auto & value : diagonal)
+            {
+                value = 1 / value;
+            }
+            return StructuredMatrix(diagonal);
+        }
+
+        if(isLowRank())
+        {
+            bool invertible = true;
+            std::vector<double> aInvDiagonal(m_Diagonal);
+            for(auto & value : aInvDiagonal)
+            {
+                invertible = invertible && value != 0;
+                value = 1 / value;
+            }
+            if(invertible)
+            {
+                // (D + U V^T)^-1 = D^-1 - D^-1 U (I + V^T D^-1 U)^-1 V^T D^-1
+                const auto k = rank();
+                const auto aInvDU = scaled(aInvDiagonal, m_U);
+                SquareMatrix aCapacitance{k};
+                for(size_t l = 0; l < k; ++l)
+                {
+                    for(size_t m = 0; m < k; ++m)
+                    {
+                        aCapacitance(l, m) = (l == m ? 1.0 : 0.0) + dot(m_V[l], aInvDU[m]);
+                    }
+                }
+                const auto aInvCapacitance = aCapacitance.inverse();
+
+                Factors aU(k, std::vector<double>(size(), 0));
+                for(size_t m = 0; m < k; ++m)
+                {
+                    for(size_t l = 0; l < k; ++l)
+                    {
+                        const auto c = aInvCapacitance(l, m);
+                        for(size_t i = 0; i < size(); ++i)
+                        {
+                            aU[m][i] -= aInvDU[l][i] * c;
+                        }
+                    }
+                }
+                return StructuredMatrix(aInvDiagonal, aU, scaled(aInvDiagonal, m_V));
+            }
+        }
+
+        return StructuredMatrix(matrix().inverse(), MatrixStructure::Dense);
+    }
+
+    double StructuredMatrix::norm1() const
+    {
+        const auto n = size();
+        double result = 0;
+        if(isDiagonal())
+        {
+            for(size_t i = 0; i < n; ++i)
+            {
+                result = std::max(result, std::abs(m_Matrix(i, i)));
+            }
+        }
+        else if(isLowRank())
+        {
+            std::vector<double> aColumnSums(n);
+            for(size_t j = 0; j < n; ++j)
+            {
+                aColumnSums[j] = std::abs(m_Diagonal[j]);
+            }
+            for(size_t k = 0; k < m_U.size(); ++k)
+            {
+                double uSum = 0;
+                for(const auto value : m_U[k])
+                {
+                    uSum += std::abs(value);
+                }
+                for(size_t j = 0; j < n; ++j)
+                {
+                    aColumnSums[j] += uSum * std::abs(m_V[k][j]);
+                }
+            }
+            for(const auto value : aColumnSums)
+            {
+                result = std::max(result, value);
+            }
+        }
+        else
+        {
+            for(size_t j = 0; j < n; ++j)
+            {
+                double sum = 0;
+                for(size_t i = 0; i < n; ++i)
+                {
+                    sum += std::abs(m_Matrix(i, j));
+                }
+                result = std::max(result, sum);
+            }
+        }
+        return result;
+    }
+
+    StructuredMatrix operator*(const StructuredMatrix & first, const StructuredMatrix & second)
+    {
+        if(first.size() != second.size())
+        {
+            throw std::runtime_error("Matrices must be identical in size.");
+        }
+
+        const auto size = first.size();
+
+        if(first.isDiagonal() && second.isDiagonal())
+        {
+            std::vector<double> diagonal(size);
+            for(size_t i = 0; i < size; ++i)
+            {
+                diagonal[i] = first(i, i) * second(i, i);
+            }
+            return StructuredMatrix(diagonal);
+        }
+
+        if(first.isLowRank() || second.isLowRank())
+        {
+            if(first.isDiagonal())
+            {
+                // diag(a) (D + U V^T) = diag(a) D + (diag(a) U) V^T
+                const auto a = first.diagonal();
+                return StructuredMatrix(scaled(a, second.diagonal()),
+                                        scaled(a, second.leftFactors()),
+                                        second.rightFactors());
+            }
+            if(second.isDiagonal())
+            {
+                // (D + U V^T) diag(b) = D diag(b) + U (diag(b) V)^T
+                const auto b = second.diagonal();
+                return StructuredMatrix(scaled(first.diagonal(), b),
+                                        first.leftFactors(),
+                                        scaled(b, first.rightFactors()));
+            }
+            if(first.isLowRank() && second.isLowRank())
+            {
+                // (D1 + U1 V1^T)(D2 + U2 V2^T) = D1 D2 + (D1 U2) V2^T + U1 (D2 V1 + V2 U2^T V1)^T
+                const auto d1 = first.diagonal();
+                const auto d2 = second.diagonal();
+                const auto & U1 = first.leftFactors();
+                const auto & V1 = first.rightFactors();
+                const auto & U2 = second.leftFactors();
+                const auto & V2 = second.rightFactors();
+
+                auto aU = scaled(d1, U2);
+                auto aV = V2;
+                for(size_t l = 0; l < U1.size(); ++l)
+                {
+                    auto v = scaled(d2, V1[l]);
+                    for(size_t m = 0; m < U2.size(); ++m)
+                    {
+                        const auto c = dot(U2[m], V1[l]);
+                        for(size_t i = 0; i < size; ++i)
+                        {
+                            v[i] += V2[m][i] * c;
+                        }
+                    }
+                    aU.push_back(U1[l]);
+                    aV.push_back(v);
+                }
+                return StructuredMatrix(scaled(d1, d2), aU, aV);
+            }
+            if(first.isLowRank())
+            {
+                // (D + U V^T) M = D M + U (V^T M)
+                const auto d = first.diagonal();
+                const auto & M = second.matrix();
+                SquareMatrix aMatrix{size};
+                for(size_t i = 0; i < size; ++i)
+                {
+                    for(size_t j = 0; j < size; ++j)
+                    {
+                        aMatrix(i, j) = d[i] * M(i, j);
+                    }
+                }
+                for(size_t k = 0; k < first.rank(); ++k)
+                {
+                    const auto & u = first.leftFactors()[k];
+                    const auto w = first.rightFactors()[k] * M;
+                    for(size_t i = 0; i < size; ++i)
+                    {
+                        for(size_t j = 0; j < size; ++j)
+                        {
+                            aMatrix(i, j) += u[i] * w[j];
+                        }
+                    }
+                }
+                return StructuredMatrix(aMatrix, MatrixStructure::Dense);
+            }
+            // M (D + U V^T) = M D + (M U) V^T
+            const auto d = second.diagonal();
+            const auto & M = first.matrix();
+            SquareMatrix aMatrix{size};
+            for(size_t i = 0; i < size; ++i)
+            {
+                for(size_t j = 0; j < size; ++j)
+                {
+                    aMatrix(i, j) = M(i, j) * d[j];
+                }
+            }
+            for(size_t k = 0; k < second.rank(); ++k)
+            {
+                const auto w = M * second.leftFactors()[k];
+                const auto & v = second.rightFactors()[k];
+                for(size_t i = 0; i < size; ++i)
+                {
+                    for(size_t j = 0; j < size; ++j)
+                    {
+                        aMatrix(i, j) += w[i] * v[j];
+                    }
+                }
+            }
+            return StructuredMatrix(aMatrix, MatrixStructure::Dense);
+        }
+
+        if(first.isDiagonal())
+        {
+            // Scaling rows of the second matrix
+            SquareMatrix aMatrix{size};
+            for(size_t i = 0; i < size; ++i)
+            {
+                const auto value = first(i, i);
+                for(size_t j = 0; j < size; ++j)
+                {
+                    aMatrix(i, j) = value * second(i, j);
+                }
+            }
+            return StructuredMatrix(aMatrix, MatrixStructure::Dense);
+        }
+
+        if(second.isDiagonal())
+        {
+            // Scaling columns of the first matrix
+            SquareMatrix aMatrix{size};
+            for(size_t i = 0; i < size; ++i)
+            {
+                for(size_t j = 0; j < size; ++j)
+                {
+                    aMatrix(i, j) = first(i, j) * second(j, j);
+                }
+            }
+            return StructuredMatrix(aMatrix, MatrixStructure::Dense);
+        }
+
+        return StructuredMatrix(first.matrix() * second.matrix(), MatrixStructure::Dense);
+    }
+
+    StructuredMatrix operator+(const StructuredMatrix & first, const StructuredMatrix & second)
+    {
+        if((first.isLowRank() || second.isLowRank())
+           && first.structure() != MatrixStructure::Dense
+           && second.structure() != MatrixStructure::Dense)
+        {
+            return addLowRank(first, second, 1);
+        }
+        const auto aStructure = (first.isDiagonal() && second.isDiagonal())
+                                  ? MatrixStructure::Diagonal
+                                  : MatrixStructure::Dense;
+        return StructuredMatrix(first.matrix() + second.matrix(), aStructure);
+    }
+
+    StructuredMatrix operator-(const StructuredMatrix & first, const StructuredMatrix & second)
+    {
+        if((first.isLowRank() || second.isLowRank())
+           && first.structure() != MatrixStructure::Dense
+           && second.structure() != MatrixStructure::Dense)
+        {
+            return addLowRank(first, second, -1);
+        }
+        const auto aStructure = (first.isDiagonal() && second.isDiagonal())
+                                  ? MatrixStructure::Diagonal
+                                  : MatrixStructure::Dense;
+        return StructuredMatrix(first.matrix() - second.matrix(), aStructure);
+    }
+
+    std::vector<double> operator*(const std::vector<double> & first,
+                                  const StructuredMatrix & second)
+    {
+        if(second.structure() == MatrixStructure::Dense)
+        {
+            return first * second.matrix();
+        }
+
+        if(first.size() != second.size())
+        {
+            throw std::runtime_error("Vector and matrix do not have same size.");
+        }
+
+        std::vector<double> res(scaled(first, second.diagonal()));
+        for(size_t k = 0; k < second.rank(); ++k)
+        {
+            const auto c = dot(first, second.leftFactors()[k]);
+            const auto & v = second.rightFactors()[k];
+            for(size_t i = 0; i < res.size(); ++i)
+            {
+                res[i] += c * v[i];
+            }
+        }
+
+        return res;
+    }
+
+}   // namespace FenestrationCommon
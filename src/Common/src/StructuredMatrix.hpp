@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+
+#include "SquareMatrix.hpp"
+
+namespace FenestrationCommon
+{
+    enum class MatrixStructure
+    {
+        Diagonal,
+        // Diagonal plus low rank: D + U * V^T
+        LowRank,
+        Dense
+    };
+
+    // Square matrix that keeps track of its structure. Diagonal matrices (lambda matrix and
+    // specular BSDF layers) are multiplied, added and inverted without touching off-diagonal
+    // elements, which avoids O(n^3) work whenever one of the operands is diagonal.
+    //
+    // Uniform diffuse BSDF layers have constant columns outside of the diagonal (diffuse part
+    // does not depend on outgoing direction) and they are kept as diagonal plus low rank matrix.
+    // Products of such matrices are calculated from their factors and inverse is calculated with
+    // Sherman-Morrison-Woodbury formula. Matrix is expanded into dense form once its rank becomes
+    // too large for factors to pay off.
+    class StructuredMatrix
+    {
+    public:
+        // Structure is detected from the matrix content
+        explicit StructuredMatrix(const SquareMatrix & tMatrix);
+        // Structure must be Diagonal or Dense
+        StructuredMatrix(const SquareMatrix & tMatrix, MatrixStructure tStructure);
+        explicit StructuredMatrix(const std::vector<double> & tDiagonal);
+        // Diagonal plus low rank matrix. Every column of U and V is given as separate vector.
+        StructuredMatrix(const std::vector<double> & tDiagonal,
+                         const std::vector<std::vector<double>> & tU,
+                         const std::vector<std::vector<double>> & tV);
+
+        // True if all elements of every column, except the diagonal one, are equal
+        static bool hasConstantColumns(const SquareMatrix & tMatrix);
+        // Rank one factors of the matrix with constant columns. Dense form is not kept.
+        static StructuredMatrix fromConstantColumns(const SquareMatrix & tMatrix);
+
+        std::size_t size() const;
+        MatrixStructure structure() const;
+        bool isDiagonal() const;
+        bool isLowRank() const;
+
+        // Factors of low rank matrix
+        std::size_t rank() const;
+        std::vector<double> diagonal() const;
+        const std::vector<std::vector<double>> & leftFactors() const;
+        const std::vector<std::vector<double>> & rightFactors() const;
+
+        // Low rank matrices are expanded on the first request
+        const SquareMatrix & matrix() const;
+        double operator()(std::size_t i, std::size_t j) const;
+
+        StructuredMatrix inverse() const;
+
+        // Maximum absolute column sum. It is exact for diagonal and dense matrices and upper
+        // bound (calculated from factors) for low rank matrices.
+        double norm1() const;
+
+    private:
+        mutable SquareMatrix m_Matrix;
+        MatrixStructure m_Structure;
+
+        std::vector<double> m_Diagonal;
+        std::vector<std::vector<double>> m_U;
+        std::vector<std::vector<double>> m_V;
+        mutable bool m_Expanded;
+    };
+
+    StructuredMatrix operator*(const StructuredMatrix & first, const StructuredMatrix & second);
+    StructuredMatrix operator+(const StructuredMatrix & first, const StructuredMatrix & second);
+    StructuredMatrix operator-(const StructuredMatrix & first, const StructuredMatrix & second);
+
+    std::vector<double> operator*(const std::vector<double> & first,
+                                  const StructuredMatrix & second);
+
+}   // namespace FenestrationCommon
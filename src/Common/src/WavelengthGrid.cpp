@@ -0,0 +1,146 @@
+#include <algorithm>
+
+#include "WavelengthGrid.hpp"
+
+namespace FenestrationCommon
+{
+    namespace
+    {
+        // Grids are kept in the pool only while some series is using them
+        class CGridPool
+        {
+        public:
+            std::shared_ptr<const CWavelengthGrid>
+              find(const std::vector<double> & t_Values) const
+            {
+                const auto it = m_Grids.find(t_Values);
+                return it != m_Grids.end() ? it->second.lock() : nullptr;
+            }
+
+            void insert(const std::vector<double> & t_Values,
+                        const std::shared_ptr<const CWavelengthGrid> & t_Grid)
+            {
+                m_Grids[t_Values] = t_Grid;
+                if(m_Grids.size() > 2 * m_SizeAfterCleanup)
+                {
+                    for(auto it = m_Grids.begin(); it != m_Grids.end();)
+                    {
+                        it = it->second.expired() ? m_Grids.erase(it) : std::next(it);
+                    }
+                    m_SizeAfterCleanup = std::max(m_Grids.size(), size_t(16));
+                }
+            }
+
+            std::mutex & mutex()
+            {
+                return m_Mutex;
+            }
+
+        private:
+            std::map<std::vector<double>, std::weak_ptr<const CWavelengthGrid>> m_Grids;
+            size_t m_SizeAfterCleanup = 16;
+            std::mutex m_Mutex;
+        };
+
+        CGridPool & gridPool()
+        {
+            static CGridPool pool;
+            return pool;
+        }
+    }   // namespace
+
+    std::shared_ptr<const CWavelengthGrid>
+      CWavelengthGrid::intern(const std::vector<double> & t_Values)
+    {
+        auto & pool = gridPool();
+        std::lock_guard<std::mutex> lock(pool.mutex());
+        auto aGrid = pool.find(t_Values);
+        if(aGrid == nullptr)
+        {
+            aGrid = std::shared_ptr<const CWavelengthGrid>(new CWavelengthGrid(t_Values));
+            pool.insert(t_Values, aGrid);
+        }
+        return aGrid;
+    }
+
+    CWavelengthGrid::CWavelengthGrid(const std::vector<double> & t_Values) :
+        m_Values(t_Values),
+        m_Sorted(std::is_sorted(t_Values.begin(), t_Values.end()))
+    {}
+
+    const std::vector<double> & CWavelengthGrid::values() const
+    {
+        return m_Values;
+    }
+
+    size_t CWavelengthGrid::size() const
+    {
+        return m_Values.size();
+    }
+
+    std::shared_ptr<const std::vector<GridStencilPoint>>
+      CWavelengthGrid::stencil(const std::shared_ptr<const CWavelengthGrid> & t_Target) const
+    {
+        std::lock_guard<std::mutex> lock(m_StencilMutex);
+        const auto it = m_Stencils.find(t_Target.get());
+        // Address of expired grid can be reused by new grid
+        if(it != m_Stencils.end() && it->second.first.lock() == t_Target)
+        {
+            return it->second.second;
+        }
+
+        for(auto expired = m_Stencils.begin(); expired != m_Stencils.end();)
+        {
+            expired = expired->second.first.expired() ? m_Stencils.erase(expired)
+                                                      : std::next(expired);
+        }
+
+        auto aStencil = std::make_shared<std::vector<GridStencilPoint>>(
+          calculateStencil(m_Values, m_Sorted, t_Target->values()));
+        m_Stencils[t_Target.get()] = StencilEntry(t_Target, aStencil);
+        return aStencil;
+    }
+
+    std::vector<GridStencilPoint> CWavelengthGrid::stencil(const std::vector<double> & t_Source,
+                                                           const std::vector<double> & t_Target)
+    {
+        return calculateStencil(
+          t_Source, std::is_sorted(t_Source.begin(), t_Source.end()), t_Target);
+    }
+
+    std::vector<GridStencilPoint>
+      CWavelengthGrid::calculateStencil(const std::vector<double> & t_Source,
+                                        const bool t_Sorted,
+                                        const std::vector<double> & t_Target)
+    {
+        // Upper point is the first point with x greater than target value and lower point is
+        // the one before it. Points out of range use the closest point.
+        std::vector<GridStencilPoint> result;
+        const auto size = t_Source.size();
+        if(size == 0)
+        {
+            return result;
+        }
+        result.reserve(t_Target.size());
+        for(const auto value : t_Target)
+        {
+            size_t upper = 0;
+            if(t_Sorted)
+            {
+                upper = size_t(std::distance(
+                  t_Source.begin(), std::upper_bound(t_Source.begin(), t_Source.end(), value)));
+            }
+            else
+            {
+                while(upper < size && t_Source[upper] <= value)
+                {
+                    ++upper;
+                }
+            }
+            const size_t lower = upper == 0 ? 0 : upper - 1;
+            result.push_back({lower, upper == size ? lower : upper});
+        }
+        return result;
+    }
+
+}   // namespace FenestrationCommon
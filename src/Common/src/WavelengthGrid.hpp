@@ -0,0 +1,59 @@
+#ifndef WAVELENGTHGRID_H
+#define WAVELENGTHGRID_H
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <map>
+
+namespace FenestrationCommon
+{
+    // Indexes of points of source grid that are used to interpolate value at single x of target
+    // grid. Lower and Upper are the same point when x is out of source grid range.
+    struct GridStencilPoint
+    {
+        size_t Lower;
+        size_t Upper;
+    };
+
+    // Immutable set of x values shared between series. Grids are interned, which means that all
+    // grids created from identical values are the same object. Series with the same grid can be
+    // compared by pointer instead of point by point. Interning locks global pool, so objects that
+    // interpolate to the same wavelengths many times should intern them once and keep the handle.
+    class CWavelengthGrid
+    {
+    public:
+        static std::shared_ptr<const CWavelengthGrid> intern(const std::vector<double> & t_Values);
+
+        const std::vector<double> & values() const;
+        size_t size() const;
+
+        // Stencil for linear interpolation of series defined on this grid to t_Target grid. It is
+        // calculated only once for every pair of grids.
+        std::shared_ptr<const std::vector<GridStencilPoint>>
+          stencil(const std::shared_ptr<const CWavelengthGrid> & t_Target) const;
+
+        // Stencil between wavelengths that are not interned. It is calculated on every call.
+        static std::vector<GridStencilPoint> stencil(const std::vector<double> & t_Source,
+                                                     const std::vector<double> & t_Target);
+
+    private:
+        explicit CWavelengthGrid(const std::vector<double> & t_Values);
+
+        static std::vector<GridStencilPoint> calculateStencil(const std::vector<double> & t_Source,
+                                                              bool t_Sorted,
+                                                              const std::vector<double> & t_Target);
+
+        std::vector<double> m_Values;
+        bool m_Sorted;
+
+        using StencilEntry = std::pair<std::weak_ptr<const CWavelengthGrid>,
+                                       std::shared_ptr<const std::vector<GridStencilPoint>>>;
+
+        mutable std::mutex m_StencilMutex;
+        mutable std::map<const CWavelengthGrid *, StencilEntry> m_Stencils;
+    };
+
+}   // namespace FenestrationCommon
+
+#endif
@@ -0,0 +1,58 @@
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "WCECommon.hpp"
+
+using namespace FenestrationCommon;
+
+class TestCommonWavelengths : public testing::Test
+{
+protected:
+    static CCommonWavelengths createWavelengths()
+    {
+        CCommonWavelengths aWavelengths;
+        aWavelengths.addWavelength({0.30, 0.40, 0.50, 0.60, 0.70});
+        aWavelengths.addWavelength({0.35, 0.45, 0.50000001, 0.55, 0.80});
+        aWavelengths.addWavelength({0.25, 0.40, 0.50, 0.65});
+        return aWavelengths;
+    }
+};
+
+TEST_F(TestCommonWavelengths, TestInterpolate)
+{
+    SCOPED_TRACE("Begin Test: Common wavelengths - interpolate.");
+
+    auto aWavelengths = createWavelengths();
+
+    const std::vector<double> correct{0.35, 0.40, 0.45, 0.50, 0.50000001, 0.55, 0.60, 0.65};
+    const auto aCombined = aWavelengths.getCombinedWavelengths(Combine::Interpolate);
+
+    EXPECT_EQ(correct, aCombined);
+}
+
+TEST_F(TestCommonWavelengths, TestExtrapolate)
+{
+    SCOPED_TRACE("Begin Test: Common wavelengths - extrapolate.");
+
+    auto aWavelengths = createWavelengths();
+
+    const std::vector<double> correct{
+      0.25, 0.30, 0.35, 0.40, 0.45, 0.50, 0.50000001, 0.55, 0.60, 0.65, 0.70, 0.80};
+    const auto aCombined = aWavelengths.getCombinedWavelengths(Combine::Extrapolate);
+
+    EXPECT_EQ(correct, aCombined);
+}
+
+TEST_F(TestCommonWavelengths, TestToleranceAndRange)
+{
+    SCOPED_TRACE("Begin Test: Common wavelengths - tolerance and range.");
+
+    auto aWavelengths = createWavelengths();
+    aWavelengths.setTolerance(1e-6);
+    aWavelengths.setRange(0.30, 0.60);
+
+    const std::vector<double> correct{0.30, 0.35, 0.40, 0.45, 0.50, 0.55, 0.60};
+    const auto aCombined = aWavelengths.getCombinedWavelengths(Combine::Extrapolate);
+
+    EXPECT_EQ(correct, aCombined);
+}
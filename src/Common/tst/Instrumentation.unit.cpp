@@ -0,0 +1,103 @@
+#include <memory>
+#include <cstdio>
+#include <gtest/gtest.h>
+
+#include "WCECommon.hpp"
+
+using namespace FenestrationCommon;
+
+class TestInstrumentation : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Instrumentation::reset();
+    }
+};
+
+TEST_F(TestInstrumentation, StagesAndCounters)
+{
+    SCOPED_TRACE("Begin Test: Stage and counter statistics.");
+
+    for(size_t i = 0; i < 3; ++i)
+    {
+        Instrumentation::ScopedTimer aTimer("Stage");
+        Instrumentation::countMatrix();
+        Instrumentation::countMatrix();
+        Instrumentation::addCount("Counter", 5);
+    }
+
+    const auto aStages = Instrumentation::stages();
+    ASSERT_EQ(1u, aStages.count("Stage"));
+    EXPECT_EQ(3u, aStages.at("Stage").Calls);
+    EXPECT_EQ(6u, aStages.at("Stage").Matrices);
+    EXPECT_GE(aStages.at("Stage").Time, 0.0);
+
+    const auto aCounters = Instrumentation::counters();
+    ASSERT_EQ(1u, aCounters.count("Counter"));
+    EXPECT_EQ(15u, aCounters.at("Counter"));
+
+    Instrumentation::reset();
+    EXPECT_TRUE(Instrumentation::stages().empty());
+    EXPECT_TRUE(Instrumentation::counters().empty());
+}
+
+TEST_F(TestInstrumentation, MergeThreads)
+{
+    SCOPED_TRACE("Begin Test: Statistics of finished threads are merged.");
+
+    parallelFor(8, 4, [](const size_t) {
+        Instrumentation::ScopedTimer aTimer("Parallel");
+        Instrumentation::addCount("Items", 1);
+    });
+
+    const auto aStages = Instrumentation::stages();
+    ASSERT_EQ(1u, aStages.count("Parallel"));
+    EXPECT_EQ(8u, aStages.at("Parallel").Calls);
+    EXPECT_EQ(8u, Instrumentation::counters().at("Items"));
+}
+
+TEST_F(TestInstrumentation, MatrixConstructions)
+{
+    SCOPED_TRACE("Begin Test: Matrix constructions are counted in instrumented build.");
+
+    {
+        WCE_SCOPED_TIMER("Matrices");
+        const SquareMatrix aMatrix(3);
+        const auto aProduct = aMatrix * aMatrix;
+        EXPECT_EQ(3u, aProduct.size());
+    }
+
+    const auto aStages = Instrumentation::stages();
+    if(Instrumentation::isEnabled())
+    {
+        ASSERT_EQ(1u, aStages.count("Matrices"));
+        EXPECT_EQ(1u, aStages.at("Matrices").Calls);
+        EXPECT_GE(aStages.at("Matrices").Matrices, 2u);
+    }
+    else
+    {
+        EXPECT_TRUE(aStages.empty());
+    }
+}
+
+TEST_F(TestInstrumentation, TooManyStages)
+{
+    SCOPED_TRACE("Begin Test: Stages beyond storage limit are dropped without exception.");
+
+    // Names must have static storage duration
+    static char aNames[100][8];
+    for(size_t i = 0; i < 100; ++i)
+    {
+        std::snprintf(aNames[i], sizeof(aNames[i]), "S%zu", i);
+        EXPECT_NO_THROW(Instrumentation::ScopedTimer aTimer(aNames[i]));
+        EXPECT_NO_THROW(Instrumentation::addCount(aNames[i]));
+    }
+
+    const auto aStages = Instrumentation::stages();
+    EXPECT_GT(aStages.size(), 0u);
+    EXPECT_LT(aStages.size(), 100u);
+    ASSERT_EQ(1u, aStages.count("S0"));
+    EXPECT_EQ(1u, aStages.at("S0").Calls);
+    EXPECT_EQ(0u, aStages.count("S99"));
+}
@@ -0,0 +1,64 @@
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "WCECommon.hpp"
+
+using namespace FenestrationCommon;
+
+class TestLinearSolverFixed : public testing::Test
+{
+protected:
+    void SetUp() override
+    {}
+};
+
+TEST_F(TestLinearSolverFixed, Test1)
+{
+    SCOPED_TRACE("Begin Test: Test Fixed Linear Solver - Heat balance of single layer.");
+
+    std::array<double, 16> aMatrix{{32817.2867004354, 1, 0, -32808.3972386696,
+                                    1.28054053432588, -1, 0, 0,
+                                    0, 0, -1, 1.26433319889839,
+                                    32808.3972386696, 0, -1, -32810.4664383299}};
+
+    std::array<double, 4> aVector{{3163.241853, -73.479324, -67.913411, -1070.271453}};
+
+    solveFixedSystem<4>(aMatrix.data(), aVector.data());
+
+    EXPECT_NEAR(303.040746, aVector[0], 1e-6);
+    EXPECT_NEAR(461.535283, aVector[1], 1e-6);
+    EXPECT_NEAR(451.057585, aVector[2], 1e-6);
+    EXPECT_NEAR(303.040507, aVector[3], 1e-6);
+}
+
+TEST_F(TestLinearSolverFixed, TestSameAsGeneric)
+{
+    SCOPED_TRACE("Begin Test: Test Fixed Linear Solver - Comparison with generic solver.");
+
+    const size_t size = 8;
+
+    // Diagonal is not dominant so that pivoting is needed
+    SquareMatrix aSquareMatrix(size);
+    std::array<double, size * size> aMatrix;
+    std::vector<double> aVector(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        for(size_t j = 0; j < size; ++j)
+        {
+            const double value = double((3 * i + 5 * j) % 7) - 2.5 + (i == j ? 0.1 : 0.0);
+            aSquareMatrix(i, j) = value;
+            aMatrix[i * size + j] = value;
+        }
+        aVector[i] = double(i % 3) - 1.0;
+    }
+
+    auto aFixedVector = aVector;
+    solveFixedSystem<size>(aMatrix.data(), aFixedVector.data());
+
+    const auto aSolution = CLinearSolver::solveSystem(aSquareMatrix, aVector);
+
+    for(size_t i = 0; i < size; ++i)
+    {
+        EXPECT_DOUBLE_EQ(aSolution[i], aFixedVector[i]);
+    }
+}
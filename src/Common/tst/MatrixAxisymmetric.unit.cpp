@@ -0,0 +1,88 @@
+#include <memory>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "WCECommon.hpp"
+
+using namespace FenestrationCommon;
+
+class TestMatrixAxisymmetric : public testing::Test
+{
+protected:
+    void SetUp() override
+    {}
+
+    static std::vector<size_t> rings()
+    {
+        return {1, 2, 3};
+    }
+
+    static AxisymmetricMatrix matrixA()
+    {
+        const SquareMatrix beta{{0.1, 0.2, 0.05}, {0.3, 0.02, 0.1}, {0.04, 0.06, 0.01}};
+        return AxisymmetricMatrix(rings(), {0.5, 0.7, 0.6}, beta);
+    }
+
+    static AxisymmetricMatrix matrixB()
+    {
+        const SquareMatrix beta{{0.03, 0.01, 0.02}, {0.02, 0.05, 0.04}, {0.01, 0.02, 0.03}};
+        return AxisymmetricMatrix(rings(), {0.2, 0.1, 0.3}, beta);
+    }
+};
+
+TEST_F(TestMatrixAxisymmetric, ReduceAndExpand)
+{
+    SCOPED_TRACE("Begin Test: Reduction of full matrix to per-ring data.");
+
+    const auto full = matrixA().expand();
+    EXPECT_EQ(6u, full.size());
+    EXPECT_TRUE(AxisymmetricMatrix::isAxisymmetric(full, rings()));
+
+    const AxisymmetricMatrix reduced(full, rings());
+    const auto expanded = reduced.expand();
+    for(size_t i = 0; i < full.size(); ++i)
+    {
+        for(size_t j = 0; j < full.size(); ++j)
+        {
+            EXPECT_NEAR(full(i, j), expanded(i, j), 1e-14);
+        }
+    }
+
+    auto nonSymmetric = full;
+    nonSymmetric(4, 5) += 0.1;
+    EXPECT_FALSE(AxisymmetricMatrix::isAxisymmetric(nonSymmetric, rings()));
+}
+
+TEST_F(TestMatrixAxisymmetric, Operations)
+{
+    SCOPED_TRACE("Begin Test: Per-ring operations against full matrix operations.");
+
+    const auto a = matrixA();
+    const auto b = matrixB();
+
+    const auto mult = (a * b).expand();
+    const auto multCorrect = a.expand() * b.expand();
+
+    const AxisymmetricMatrix I(rings(), {1, 1, 1});
+    const auto inv = (I - a * b).inverse().expand();
+    SquareMatrix fullI(6);
+    fullI.setIdentity();
+    const auto invCorrect = (fullI - multCorrect).inverse();
+
+    for(size_t i = 0; i < 6; ++i)
+    {
+        for(size_t j = 0; j < 6; ++j)
+        {
+            EXPECT_NEAR(multCorrect(i, j), mult(i, j), 1e-12);
+            EXPECT_NEAR(invCorrect(i, j), inv(i, j), 1e-12);
+        }
+    }
+
+    const std::vector<double> aVector{1, 2, 3, 4, 5, 6};
+    const auto vectMult = aVector * a;
+    const auto vectCorrect = aVector * a.expand();
+    for(size_t i = 0; i < 6; ++i)
+    {
+        EXPECT_NEAR(vectCorrect[i], vectMult[i], 1e-12);
+    }
+}
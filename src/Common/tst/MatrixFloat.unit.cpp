@@ -0,0 +1,54 @@
+#include <memory>
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "WCECommon.hpp"
+
+using namespace FenestrationCommon;
+
+class TestMatrixFloat : public testing::Test
+{
+protected:
+    void SetUp() override
+    {}
+};
+
+TEST_F(TestMatrixFloat, DenseMatrix)
+{
+    SCOPED_TRACE("Begin Test: Dense matrix stored in single precision.");
+
+    const SquareMatrix aMatrix{{0.1, 2.5, 1e-3}, {1.0 / 3, 7.1, 0.2}, {0, 4e-5, 123.456}};
+    const FloatMatrix aFloat(aMatrix);
+
+    EXPECT_EQ(3u, aFloat.size());
+    EXPECT_FALSE(aFloat.isDiagonal());
+
+    const auto aResult = aFloat.matrix();
+    for(size_t i = 0; i < aMatrix.size(); ++i)
+    {
+        for(size_t j = 0; j < aMatrix.size(); ++j)
+        {
+            EXPECT_NEAR(aMatrix(i, j),
+                        aResult(i, j),
+                        FloatMatrix::roundingError() * std::abs(aMatrix(i, j)));
+        }
+    }
+}
+
+TEST_F(TestMatrixFloat, DiagonalMatrix)
+{
+    SCOPED_TRACE("Begin Test: Diagonal matrix stored in single precision.");
+
+    SquareMatrix aMatrix(3);
+    aMatrix.setDiagonal({0.7, 1.0 / 3, 25.0});
+    const FloatMatrix aFloat(aMatrix);
+
+    EXPECT_TRUE(aFloat.isDiagonal());
+
+    const auto aResult = aFloat.matrix();
+    EXPECT_TRUE(aResult.isDiagonal());
+    for(size_t i = 0; i < aMatrix.size(); ++i)
+    {
+        EXPECT_NEAR(aMatrix(i, i), aResult(i, i), FloatMatrix::roundingError() * aMatrix(i, i));
+    }
+}
@@ -0,0 +1,207 @@
+#include <memory>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "WCECommon.hpp"
+
+using namespace FenestrationCommon;
+
+class TestMatrixStructured : public testing::Test
+{
+protected:
+    void SetUp() override
+    {}
+};
+
+TEST_F(TestMatrixStructured, DiagonalDetection)
+{
+    SCOPED_TRACE("Begin Test: Structure detection of square matrix.");
+
+    const SquareMatrix a{{4, 0, 0}, {0, 8, 0}, {0, 0, 7}};
+    const SquareMatrix b{{4, 0, 0}, {0, 8, 1}, {0, 0, 7}};
+
+    EXPECT_EQ(MatrixStructure::Diagonal, StructuredMatrix(a).structure());
+    EXPECT_EQ(MatrixStructure::Dense, StructuredMatrix(b).structure());
+}
+
+TEST_F(TestMatrixStructured, DiagonalDenseMultiplication)
+{
+    SCOPED_TRACE("Begin Test: Diagonal and dense matrix multiplication (3 x 3).");
+
+    const auto n = 3u;
+
+    const StructuredMatrix d(std::vector<double>{2, 3, 4});
+    const StructuredMatrix a(SquareMatrix{{4, 3, 9}, {8, 8, 4}, {4, 3, 7}});
+
+    const auto left = d * a;
+    const auto right = a * d;
+    const auto leftCorrect = d.matrix() * a.matrix();
+    const auto rightCorrect = a.matrix() * d.matrix();
+
+    EXPECT_EQ(MatrixStructure::Dense, left.structure());
+    EXPECT_EQ(MatrixStructure::Dense, right.structure());
+
+    for(size_t i = 0; i < n; ++i)
+    {
+        for(size_t j = 0; j < n; ++j)
+        {
+            EXPECT_NEAR(leftCorrect(i, j), left(i, j), 1e-12);
+            EXPECT_NEAR(rightCorrect(i, j), right(i, j), 1e-12);
+        }
+    }
+}
+
+TEST_F(TestMatrixStructured, DiagonalDiagonalOperations)
+{
+    SCOPED_TRACE("Begin Test: Diagonal matrices multiplication, subtraction and inverse.");
+
+    const auto n = 3u;
+
+    const StructuredMatrix d1(std::vector<double>{2, 3, 4});
+    const StructuredMatrix d2(std::vector<double>{0.5, 0.25, 0.1});
+
+    const auto mult = d1 * d2;
+    const auto diff = d1 - d2;
+    const auto inv = diff.inverse();
+
+    EXPECT_EQ(MatrixStructure::Diagonal, mult.structure());
+    EXPECT_EQ(MatrixStructure::Diagonal, diff.structure());
+    EXPECT_EQ(MatrixStructure::Diagonal, inv.structure());
+
+    const std::vector<double> multCorrect{1, 0.75, 0.4};
+    const std::vector<double> invCorrect{1 / 1.5, 1 / 2.75, 1 / 3.9};
+
+    for(size_t i = 0; i < n; ++i)
+    {
+        for(size_t j = 0; j < n; ++j)
+        {
+            EXPECT_NEAR(i == j ? multCorrect[i] : 0, mult(i, j), 1e-12);
+            EXPECT_NEAR(i == j ? invCorrect[i] : 0, inv(i, j), 1e-12);
+        }
+    }
+
+    const std::vector<double> aVector{1, 2, 3};
+    const auto vectMult = aVector * d1;
+    const std::vector<double> vectCorrect{2, 6, 12};
+    for(size_t i = 0; i < n; ++i)
+    {
+        EXPECT_NEAR(vectCorrect[i], vectMult[i], 1e-12);
+    }
+}
+
+namespace
+{
+    // Diagonal plus constant columns (same as uniform diffuse BSDF matrices)
+    SquareMatrix constantColumns(const std::vector<double> & t_Diagonal,
+                                 const std::vector<double> & t_Columns)
+    {
+        const auto n = t_Diagonal.size();
+        SquareMatrix aMatrix{n};
+        for(size_t i = 0; i < n; ++i)
+        {
+            for(size_t j = 0; j < n; ++j)
+            {
+                aMatrix(i, j) = t_Columns[j] + (i == j ? t_Diagonal[i] : 0);
+            }
+        }
+        return aMatrix;
+    }
+
+    void compareMatrices(const SquareMatrix & t_Correct, const StructuredMatrix & t_Matrix)
+    {
+        const auto n = t_Correct.size();
+        ASSERT_EQ(n, t_Matrix.size());
+        for(size_t i = 0; i < n; ++i)
+        {
+            for(size_t j = 0; j < n; ++j)
+            {
+                EXPECT_NEAR(t_Correct(i, j), t_Matrix(i, j), 1e-12);
+            }
+        }
+    }
+}   // namespace
+
+TEST_F(TestMatrixStructured, LowRankDetection)
+{
+    SCOPED_TRACE("Begin Test: Detection of diagonal plus constant columns matrix.");
+
+    const auto a = constantColumns({1, 2, 3, 4, 5, 6, 7, 8}, {1, 0.5, 0.1, 0, 2, 3, 1, 4});
+    auto b = a;
+    b(3, 5) += 0.1;
+
+    const StructuredMatrix aStructured(a);
+    EXPECT_EQ(MatrixStructure::LowRank, aStructured.structure());
+    EXPECT_EQ(1u, aStructured.rank());
+    EXPECT_EQ(MatrixStructure::Dense, StructuredMatrix(b).structure());
+
+    const auto aFactors = StructuredMatrix::fromConstantColumns(a);
+    compareMatrices(a, aFactors);
+    compareMatrices(a, StructuredMatrix(aFactors.matrix()));
+
+    // Small matrices are not worth to be kept in factors
+    EXPECT_EQ(MatrixStructure::Dense,
+              StructuredMatrix(constantColumns({1, 2, 3}, {1, 2, 3})).structure());
+}
+
+TEST_F(TestMatrixStructured, LowRankOperations)
+{
+    SCOPED_TRACE("Begin Test: Diagonal plus low rank matrix products, sums and inverse.");
+
+    const auto a = constantColumns({0.9, 0.8, 0.7, 0.6, 0.5, 0.4, 0.3, 0.2},
+                                   {0.01, 0.02, 0.03, 0.04, 0.05, 0.06, 0.07, 0.08});
+    const auto b = constantColumns({0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8},
+                                   {0.05, 0.01, 0.02, 0.03, 0.02, 0.01, 0.04, 0.03});
+    SquareMatrix c{8};
+    for(size_t i = 0; i < 8; ++i)
+    {
+        for(size_t j = 0; j < 8; ++j)
+        {
+            c(i, j) = 0.01 * double(i + 1) + 0.02 * double(j * j) + (i == j ? 1 : 0);
+        }
+    }
+    const StructuredMatrix d(std::vector<double>{2, 3, 4, 5, 6, 7, 8, 9});
+
+    const StructuredMatrix la(a);
+    const StructuredMatrix lb(b);
+    const StructuredMatrix dense(c);
+    ASSERT_EQ(MatrixStructure::Dense, dense.structure());
+
+    const auto product = la * lb;
+    EXPECT_EQ(MatrixStructure::LowRank, product.structure());
+    EXPECT_EQ(2u, product.rank());
+    compareMatrices(a * b, product);
+
+    EXPECT_EQ(MatrixStructure::LowRank, (d * la).structure());
+    compareMatrices(d.matrix() * a, d * la);
+    EXPECT_EQ(MatrixStructure::LowRank, (la * d).structure());
+    compareMatrices(a * d.matrix(), la * d);
+
+    compareMatrices(a * c, la * dense);
+    compareMatrices(c * a, dense * la);
+
+    EXPECT_EQ(MatrixStructure::LowRank, (d - la).structure());
+    compareMatrices(d.matrix() - a, d - la);
+    compareMatrices(a + b, la + lb);
+    compareMatrices(a + c, la + dense);
+
+    // Rank grows with products until factors are expanded to dense matrix
+    const auto product3 = product * la * lb;
+    EXPECT_EQ(MatrixStructure::Dense, product3.structure());
+    compareMatrices(a * b * a * b, product3);
+
+    const auto inv = la.inverse();
+    EXPECT_EQ(MatrixStructure::LowRank, inv.structure());
+    compareMatrices(a.inverse(), inv);
+
+    const auto inv2 = product.inverse();
+    EXPECT_EQ(MatrixStructure::LowRank, inv2.structure());
+    compareMatrices((a * b).inverse(), inv2);
+
+    const std::vector<double> aVector{1, 2, 3, 4, 5, 6, 7, 8};
+    const auto vectCorrect = aVector * a;
+    const auto vectMult = aVector * la;
+    for(size_t i = 0; i < aVector.size(); ++i)
+    {
+        EXPECT_NEAR(vectCorrect[i], vectMult[i], 1e-12);
+    }
+}
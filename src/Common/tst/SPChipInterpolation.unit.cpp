@@ -54,3 +54,56 @@ TEST_F( TestSPChipInterpolation, TestInterpolations ) {
 	EXPECT_NEAR( value, 0.330733, 1e-5 );
 
 }
+
+TEST_F( TestSPChipInterpolation, TestUniformGridValues ) {
+	SCOPED_TRACE( "Begin Test: Batch interpolation on uniformly spaced points." );
+
+	std::vector< std::pair< double, double > > aPoints = {
+		std::make_pair( 300, 0.84 ),
+		std::make_pair( 310, 0.83 ),
+		std::make_pair( 320, 0.6 ),
+		std::make_pair( 330, 0.3 ),
+		std::make_pair( 340, 0.25 ),
+		std::make_pair( 350, 0.25 )
+	};
+
+	CSPChipInterpolation2D aInterpolation( aPoints );
+
+	std::vector< double > aTemperatures = { 295, 300, 305, 312.5, 320, 327.3, 334, 349.9, 360 };
+	std::vector< double > correctValues = { 0.84, 0.84, 0.8373958333, 0.8035723762, 0.6, 0.3522765267,
+	                                        0.2700571429, 0.25, 0.25 };
+
+	auto values = aInterpolation.getValues( aTemperatures );
+	ASSERT_EQ( correctValues.size(), values.size() );
+
+	for ( size_t i = 0; i < values.size(); ++i ) {
+		EXPECT_NEAR( correctValues[ i ], values[ i ], 1e-9 );
+		EXPECT_EQ( aInterpolation.getValue( aTemperatures[ i ] ), values[ i ] );
+	}
+}
+
+TEST_F( TestSPChipInterpolation, TestSortedAndUnsortedValues ) {
+	SCOPED_TRACE( "Begin Test: Batch interpolation of sorted and unsorted values." );
+
+	std::shared_ptr< IInterpolation2D > aInterpolation = getInterpolation();
+
+	std::vector< double > sortedValues;
+	for ( auto value = 20.0; value <= 80.0; value += 0.25 ) {
+		sortedValues.push_back( value );
+	}
+	std::vector< double > unsortedValues( sortedValues.rbegin(), sortedValues.rend() );
+
+	auto sortedResults = aInterpolation->getValues( sortedValues );
+	auto unsortedResults = aInterpolation->getValues( unsortedValues );
+	ASSERT_EQ( sortedValues.size(), sortedResults.size() );
+	ASSERT_EQ( unsortedValues.size(), unsortedResults.size() );
+
+	const auto size = sortedValues.size();
+	for ( size_t i = 0; i < size; ++i ) {
+		EXPECT_EQ( aInterpolation->getValue( sortedValues[ i ] ), sortedResults[ i ] );
+		EXPECT_EQ( sortedResults[ i ], unsortedResults[ size - 1 - i ] );
+	}
+
+	EXPECT_NEAR( 0.664845, aInterpolation->getValues( { 28 } )[ 0 ], 1e-5 );
+	EXPECT_NEAR( 0.330733, aInterpolation->getValues( { 75 } )[ 0 ], 1e-12 );
+}
@@ -0,0 +1,63 @@
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "WCECommon.hpp"
+
+using namespace FenestrationCommon;
+
+class TestSeriesFusedOperations : public testing::Test
+{
+protected:
+    void SetUp() override
+    {}
+};
+
+TEST_F(TestSeriesFusedOperations, TestAbsorptance)
+{
+    SCOPED_TRACE("Begin Test: Series fused operation - absorptance in single pass.");
+
+    CSeries aT{{0.30, 0.51}, {0.32, 0.52}, {0.34, 0.53}, {0.36, 0.54}};
+    CSeries aR{{0.30, 0.11}, {0.32, 0.12}, {0.34, 0.13}, {0.36, 0.14}};
+    CSeries aI{{0.30, 0.9}, {0.32, 0.8}, {0.34, 0.7}, {0.36, 0.6}};
+
+    CSeries aAbs;
+    aAbs.apply([](double i, double t, double r) { return i * (1 - t - r); }, aI, aT, aR);
+
+    const auto aCorrect = aI * (1 - aT - aR);
+
+    ASSERT_EQ(aCorrect.size(), aAbs.size());
+    for(size_t i = 0; i < aCorrect.size(); ++i)
+    {
+        EXPECT_NEAR(aCorrect[i].x(), aAbs[i].x(), 1e-12);
+        EXPECT_NEAR(aCorrect[i].value(), aAbs[i].value(), 1e-12);
+    }
+}
+
+TEST_F(TestSeriesFusedOperations, TestInPlace)
+{
+    SCOPED_TRACE("Begin Test: Series fused operation - result is one of the arguments.");
+
+    CSeries aT{{0.30, 0.5}, {0.32, 0.6}, {0.34, 0.7}};
+    CSeries aR{{0.30, 0.1}, {0.32, 0.2}, {0.34, 0.3}};
+
+    aT.apply([](double r, double t) { return r + t; }, aR, aT);
+
+    const std::vector<double> correct{0.6, 0.8, 1.0};
+    ASSERT_EQ(correct.size(), aT.size());
+    for(size_t i = 0; i < correct.size(); ++i)
+    {
+        EXPECT_NEAR(correct[i], aT[i].value(), 1e-12);
+    }
+}
+
+TEST_F(TestSeriesFusedOperations, TestDifferentWavelengths)
+{
+    SCOPED_TRACE("Begin Test: Series fused operation - different wavelengths.");
+
+    CSeries aT{{0.30, 0.5}, {0.32, 0.6}, {0.34, 0.7}};
+    CSeries aR{{0.30, 0.1}, {0.33, 0.2}, {0.34, 0.3}};
+
+    CSeries aResult;
+    EXPECT_THROW(aResult.apply([](double t, double r) { return t + r; }, aT, aR),
+                 std::runtime_error);
+}
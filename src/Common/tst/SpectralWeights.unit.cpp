@@ -0,0 +1,77 @@
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "WCECommon.hpp"
+
+using namespace FenestrationCommon;
+
+class TestSpectralWeights : public testing::Test
+{
+protected:
+    void SetUp() override
+    {}
+};
+
+TEST_F(TestSpectralWeights, TestIntegrationCoefficients)
+{
+    SCOPED_TRACE("Begin Test: Integration coefficients - same as integrated series sum.");
+
+    const std::vector<double> wavelengths{0.30, 0.32, 0.35, 0.40, 0.42, 0.50, 0.55};
+    CSeries aSeries({{0.30, 0.2},
+                     {0.32, 0.7},
+                     {0.35, 1.3},
+                     {0.40, 0.4},
+                     {0.42, 0.9},
+                     {0.50, 1.7},
+                     {0.55, 0.1}});
+
+    const double minLambda = 0.32;
+    const double maxLambda = 0.50;
+
+    for(const auto type : {IntegrationType::Rectangular,
+                           IntegrationType::RectangularCentroid,
+                           IntegrationType::Trapezoidal,
+                           IntegrationType::TrapezoidalA,
+                           IntegrationType::TrapezoidalB,
+                           IntegrationType::PreWeighted})
+    {
+        const auto correct = aSeries.integrate(type, 2)->sum(minLambda, maxLambda);
+
+        const auto coefficients = integrationCoefficients(wavelengths, type, 2, minLambda, maxLambda);
+        double result = 0;
+        for(size_t i = 0; i < wavelengths.size(); ++i)
+        {
+            result += coefficients[i] * aSeries[i].value();
+        }
+
+        EXPECT_NEAR(correct, result, 1e-12);
+    }
+}
+
+TEST_F(TestSpectralWeights, TestManySources)
+{
+    SCOPED_TRACE("Begin Test: Spectral weights - property averaged with many sources.");
+
+    CSeries aProperty({{0.30, 0.2}, {0.32, 0.7}, {0.35, 1.3}, {0.40, 0.4}, {0.42, 0.9}});
+    const std::vector<CSeries> aSources{
+      CSeries({{0.30, 1.0}, {0.32, 2.0}, {0.35, 3.0}, {0.40, 4.0}, {0.42, 5.0}}),
+      CSeries({{0.30, 5.0}, {0.32, 1.0}, {0.35, 0.5}, {0.40, 2.0}, {0.42, 1.0}}),
+      CSeries({{0.30, 0.0}, {0.32, 0.0}, {0.35, 0.0}, {0.40, 0.0}, {0.42, 0.0}})};
+
+    const CSpectralWeights aWeights(aSources, IntegrationType::Trapezoidal, 1, 0.3, 0.42);
+    EXPECT_EQ(3u, aWeights.numberOfWeights());
+
+    const auto results = aWeights.average(aProperty);
+    ASSERT_EQ(3u, results.size());
+    for(size_t k = 0; k < 2; ++k)
+    {
+        const auto total = aSources[k].integrate(IntegrationType::Trapezoidal)->sum(0.3, 0.42);
+        const auto energy =
+          (aProperty * aSources[k]).integrate(IntegrationType::Trapezoidal)->sum(0.3, 0.42);
+        EXPECT_NEAR(total, aWeights.getTotals()[k], 1e-12);
+        EXPECT_NEAR(energy / total, results[k], 1e-12);
+    }
+
+    // Source without energy gives zero property
+    EXPECT_EQ(0.0, results[2]);
+}
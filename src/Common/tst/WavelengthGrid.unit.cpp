@@ -0,0 +1,81 @@
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "WCECommon.hpp"
+
+using namespace FenestrationCommon;
+
+class TestWavelengthGrid : public testing::Test
+{
+protected:
+    void SetUp() override
+    {}
+};
+
+TEST_F(TestWavelengthGrid, TestInterning)
+{
+    SCOPED_TRACE("Begin Test: Wavelength grid - same values share grid.");
+
+    const std::vector<double> wavelengths{0.30, 0.32, 0.34, 0.36};
+
+    const auto aGrid1 = CWavelengthGrid::intern(wavelengths);
+    const auto aGrid2 = CWavelengthGrid::intern(wavelengths);
+    const auto aGrid3 = CWavelengthGrid::intern({0.30, 0.32, 0.34});
+
+    EXPECT_EQ(aGrid1, aGrid2);
+    EXPECT_NE(aGrid1, aGrid3);
+    EXPECT_EQ(wavelengths, aGrid1->values());
+
+    CSeries aSeries1;
+    aSeries1.setConstantValues(wavelengths, 0.5);
+    CSeries aSeries2;
+    aSeries2.setConstantValues(wavelengths, 0.25);
+
+    EXPECT_EQ(aGrid1, aSeries1.wavelengthGrid());
+
+    // Results of arithmetic keep grid of the operands
+    const auto aSum = aSeries1 + aSeries2;
+    EXPECT_EQ(aGrid1, aSum.wavelengthGrid());
+
+    // Adding points invalidates grid
+    aSeries1.addProperty(0.38, 0.5);
+    EXPECT_EQ(nullptr, aSeries1.wavelengthGrid());
+}
+
+TEST_F(TestWavelengthGrid, TestInterpolation)
+{
+    SCOPED_TRACE("Begin Test: Wavelength grid - interpolation with cached stencil.");
+
+    CSeries aSeries{{0.30, 1.0}, {0.34, 2.0}, {0.40, 5.0}};
+    const std::vector<double> wavelengths{0.28, 0.30, 0.32, 0.37, 0.40, 0.45};
+    const std::vector<double> correct{1.0, 1.0, 1.5, 3.5, 5.0, 5.0};
+
+    // Interpolation to plain wavelengths does not intern them
+    const auto aPlain = aSeries.interpolate(wavelengths);
+    EXPECT_EQ(nullptr, aPlain.wavelengthGrid());
+    ASSERT_EQ(correct.size(), aPlain.size());
+    for(size_t i = 0; i < correct.size(); ++i)
+    {
+        EXPECT_NEAR(wavelengths[i], aPlain[i].x(), 1e-12);
+        EXPECT_NEAR(correct[i], aPlain[i].value(), 1e-12);
+    }
+
+    // Second interpolation to the grid reuses stencil of the first one
+    const auto aGrid = CWavelengthGrid::intern(wavelengths);
+    auto aSource = aSeries.interpolate(CWavelengthGrid::intern({0.30, 0.34, 0.40}));
+    for(size_t k = 0; k < 2; ++k)
+    {
+        const auto aInterpolated = aSource.interpolate(aGrid);
+        EXPECT_EQ(aGrid, aInterpolated.wavelengthGrid());
+        ASSERT_EQ(correct.size(), aInterpolated.size());
+        for(size_t i = 0; i < correct.size(); ++i)
+        {
+            EXPECT_NEAR(wavelengths[i], aInterpolated[i].x(), 1e-12);
+            EXPECT_NEAR(correct[i], aInterpolated[i].value(), 1e-12);
+        }
+
+        // Series that is already on the grid is recognized by handle
+        EXPECT_EQ(aGrid, aInterpolated.interpolate(aGrid).wavelengthGrid());
+        EXPECT_EQ(aGrid, aInterpolated.interpolate(wavelengths).wavelengthGrid());
+    }
+}
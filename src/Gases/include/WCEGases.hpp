@@ -6,6 +6,7 @@
 #include "../src/GasItem.hpp"
 #include "../src/GasProperties.hpp"
 #include "../src/GasSetting.hpp"
+#include "../src/GasPropertiesTable.hpp"
 #include "../src/GasCreator.hpp"
 
 #endif
\ No newline at end of file
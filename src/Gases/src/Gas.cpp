@@ -4,11 +4,13 @@
 #include "GasData.hpp"
 #include "GasItem.hpp"
 #include "GasSetting.hpp"
+#include "GasPropertiesTable.hpp"
+#include "WCECommon.hpp"
 
 
 namespace Gases
 {
-    CGas::CGas() : m_Pressure(DefaultPressure)
+    CGas::CGas() : m_Temperature(DefaultTemperature), m_Pressure(DefaultPressure)
     {
         // create default gas to be Air
         auto Air = CGasItem();
@@ -17,12 +19,14 @@ namespace Gases
     }
 
     CGas::CGas(const std::vector<std::pair<double, CGasData>> & gases) :
+        m_Temperature(DefaultTemperature),
         m_Pressure(DefaultPressure)
     {
         addGasItems(gases);
     }
 
     CGas::CGas(const std::vector<std::pair<double, Gases::GasDef>> & gases) :
+        m_Temperature(DefaultTemperature),
         m_Pressure(DefaultPressure)
     {
         addGasItems(gases);
@@ -33,7 +37,9 @@ namespace Gases
         m_SimpleProperties(t_Gas.m_SimpleProperties),
         m_Properties(t_Gas.m_Properties),
         m_DefaultGas(t_Gas.m_DefaultGas),
-        m_Pressure(t_Gas.m_Pressure)
+        m_Temperature(t_Gas.m_Temperature),
+        m_Pressure(t_Gas.m_Pressure),
+        m_Table(t_Gas.m_Table)
     {
         m_GasItem.clear();
         for(auto item : t_Gas.m_GasItem)
@@ -45,6 +51,7 @@ namespace Gases
     void CGas::addGasItem(const double percent, const CGasData & t_GasData)
     {
         CGasItem item(percent, t_GasData);
+        m_Table = nullptr;
         // Need to remove default since user wants to create their own Gases
         if(m_DefaultGas)
         {
@@ -56,6 +63,7 @@ namespace Gases
 
     void CGas::addGasItems(const std::vector<std::pair<double, CGasData>> & gases)
     {
+        m_Table = nullptr;
         if(m_DefaultGas)
         {
             m_GasItem.clear();
@@ -69,6 +77,7 @@ namespace Gases
 
     void CGas::addGasItems(const std::vector<std::pair<double, Gases::GasDef>> & gases)
     {
+        m_Table = nullptr;
         if(m_DefaultGas)
         {
             m_GasItem.clear();
@@ -99,6 +108,7 @@ namespace Gases
 
     void CGas::setTemperatureAndPressure(double const t_Temperature, double const t_Pressure)
     {
+        m_Temperature = t_Temperature;
         m_Pressure = t_Pressure;
         for(auto & item : m_GasItem)
         {
@@ -120,47 +130,82 @@ namespace Gases
 
     const GasProperties & CGas::getGasProperties()
     {
-        auto aSettings = CGasSettings::instance();
+        const auto & aSettings = CGasSettings::instance();
         return aSettings.getVacuumPressure() < m_Pressure ? getStandardPressureGasProperties()
                                                           : getVacuumPressureGasProperties();
     }
 
+    void CGas::enableLookupTable(double const t_MinTemperature,
+                                 double const t_MaxTemperature,
+                                 double const t_Tolerance)
+    {
+        m_Table = std::make_shared<CGasPropertiesTable>(
+          [this](double const t_Temperature) {
+              return standardPressureGasProperties(t_Temperature);
+          },
+          t_MinTemperature,
+          t_MaxTemperature,
+          t_Tolerance);
+    }
+
+    void CGas::disableLookupTable()
+    {
+        m_Table = nullptr;
+    }
+
+    bool CGas::isLookupTableEnabled() const
+    {
+        return m_Table != nullptr;
+    }
+
+    GasProperties CGas::standardPressureGasProperties(double const t_Temperature) const
+    {
+        // Conductivity, viscosity and specific heat do not depend on pressure. Pressure is set
+        // to default so that table is correct even when gas is currently at vacuum pressure.
+        CGas aGas(*this);
+        aGas.setTemperatureAndPressure(t_Temperature, DefaultPressure);
+        return aGas.calculateStandardPressureGasProperties();
+    }
+
     const GasProperties & CGas::getStandardPressureGasProperties()
     {
-        auto simpleProperties = getSimpleGasProperties();
+        if(m_Table != nullptr && m_Table->isInRange(m_Temperature))
+        {
+            using ConstantsData::UNIVERSALGASCONSTANT;
+            m_Table->interpolate(m_Temperature, m_Properties);
+            m_Properties.m_Density = m_Pressure * m_Properties.m_MolecularWeight
+                                     / (UNIVERSALGASCONSTANT * m_Temperature);
+            m_Properties.calculateAlphaAndPrandl();
+            return m_Properties;
+        }
 
-        // coefficients for intermediate calculations
-        std::vector<std::vector<double>> miItem;
-        std::vector<std::vector<double>> lambdaPrimItem;
-        std::vector<std::vector<double>> lambdaSecondItem;
+        return calculateStandardPressureGasProperties();
+    }
 
-        auto gasSize = m_GasItem.size();
-        auto counter = 0;
+    const GasProperties & CGas::calculateStandardPressureGasProperties()
+    {
+        const auto & simpleProperties = getSimpleGasProperties();
 
-        miItem.resize(gasSize);
-        lambdaPrimItem.resize(gasSize);
-        lambdaSecondItem.resize(gasSize);
+        // coefficients for intermediate calculations. Workspace is kept between calls so that
+        // repeated evaluations do not allocate memory.
+        const auto gasSize = m_GasItem.size();
+        m_MiItem.assign(gasSize * gasSize, 0);
+        m_LambdaPrimItem.assign(gasSize * gasSize, 0);
+        m_LambdaSecondItem.assign(gasSize * gasSize, 0);
 
-        for(auto & primaryIt : m_GasItem)
+        for(size_t i = 0; i < gasSize; ++i)
         {
-            for(auto & secondaryIt : m_GasItem)
+            for(size_t j = 0; j < gasSize; ++j)
             {
-                if(primaryIt != secondaryIt)
-                {
-                    miItem[counter].push_back(viscDenomTwoGases(primaryIt, secondaryIt));
-                    lambdaPrimItem[counter].push_back(
-                      lambdaPrimDenomTwoGases(primaryIt, secondaryIt));
-                    lambdaSecondItem[counter].push_back(
-                      lambdaSecondDenomTwoGases(primaryIt, secondaryIt));
-                }
-                else
+                if(m_GasItem[i] != m_GasItem[j])
                 {
-                    miItem[counter].push_back(0);
-                    lambdaPrimItem[counter].push_back(0);
-                    lambdaSecondItem[counter].push_back(0);
+                    m_MiItem[i * gasSize + j] = viscDenomTwoGases(m_GasItem[i], m_GasItem[j]);
+                    m_LambdaPrimItem[i * gasSize + j] =
+                      lambdaPrimDenomTwoGases(m_GasItem[i], m_GasItem[j]);
+                    m_LambdaSecondItem[i * gasSize + j] =
+                      lambdaSecondDenomTwoGases(m_GasItem[i], m_GasItem[j]);
                 }
             }
-            counter++;
         }
 
         double miMix(0);
@@ -168,17 +213,17 @@ namespace Gases
         double lambdaSecondMix(0);
         double cpMix(0);
 
-        counter = 0;
-        for(auto & it : m_GasItem)
+        for(size_t counter = 0; counter < gasSize; ++counter)
         {
-            auto itGasProperties = it.getGasProperties();
+            const auto & it = m_GasItem[counter];
+            const auto & itGasProperties = it.getGasProperties();
             auto lambdaPrim(itGasProperties->getLambdaPrim());
             auto lambdaSecond(itGasProperties->getLambdaSecond());
 
             auto sumMix = 1.0;
             for(size_t i = 0; i < gasSize; ++i)
             {
-                sumMix += miItem[counter][i];
+                sumMix += m_MiItem[counter * gasSize + i];
             }
 
             miMix += itGasProperties->m_Viscosity / sumMix;
@@ -186,7 +231,7 @@ namespace Gases
             sumMix = 1.0;
             for(size_t i = 0; i < gasSize; ++i)
             {
-                sumMix += lambdaPrimItem[counter][i];
+                sumMix += m_LambdaPrimItem[counter * gasSize + i];
             }
 
             lambdaPrimMix += lambdaPrim / sumMix;
@@ -194,14 +239,13 @@ namespace Gases
             sumMix = 1.0;
             for(size_t i = 0; i < gasSize; ++i)
             {
-                sumMix += lambdaSecondItem[counter][i];
+                sumMix += m_LambdaSecondItem[counter * gasSize + i];
             }
 
             lambdaSecondMix += lambdaSecond / sumMix;
 
             cpMix += itGasProperties->m_SpecificHeat * it.getFraction()
                      * itGasProperties->m_MolecularWeight;
-            ++counter;
         }
 
         m_Properties.m_ThermalConductivity = lambdaPrimMix + lambdaSecondMix;
@@ -355,7 +399,9 @@ namespace Gases
         m_SimpleProperties = t_Gas.m_SimpleProperties;
         m_Properties = t_Gas.m_Properties;
         m_DefaultGas = t_Gas.m_DefaultGas;
+        m_Temperature = t_Gas.m_Temperature;
         m_Pressure = t_Gas.m_Pressure;
+        m_Table = t_Gas.m_Table;
 
         return *this;
     }
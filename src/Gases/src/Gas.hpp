@@ -10,6 +10,7 @@ namespace Gases {
 
 	class CGasItem;
 	class CGasData;
+	class CGasPropertiesTable;
 
 	class CGas {
 	public:
@@ -26,6 +27,15 @@ namespace Gases {
 		const GasProperties & getGasProperties();
 		void setTemperatureAndPressure( double t_Temperature, double t_Pressure );
 
+		// Opt-in tabulated mode. Mixture properties are precomputed over temperature range and
+		// interpolated afterwards with relative error below t_Tolerance. Temperatures outside of
+		// the range and vacuum pressures are still calculated directly.
+		void enableLookupTable( double t_MinTemperature,
+		                        double t_MaxTemperature,
+		                        double t_Tolerance = 1e-6 );
+		void disableLookupTable();
+		bool isLookupTableEnabled() const;
+
 		CGas& operator=( CGas const& t_Gas );
 		bool operator==( CGas const& t_Gas ) const;
 		bool operator!=( CGas const& t_Gas ) const;
@@ -33,6 +43,11 @@ namespace Gases {
 	private:
 
 		const GasProperties & getStandardPressureGasProperties();
+		const GasProperties & calculateStandardPressureGasProperties();
+
+		// Exact mixture properties at standard pressure for given temperature. Used to create
+		// lookup table. Calculation is done on a copy and state of this mixture is not changed.
+		GasProperties standardPressureGasProperties( double t_Temperature ) const;
 		const GasProperties & getVacuumPressureGasProperties();
 
 		double viscTwoGases( GasProperties const& t_Gas1Properties, GasProperties const& t_Gas2Properties ) const;
@@ -45,11 +60,20 @@ namespace Gases {
 		double lambdaSecondDenomTwoGases( CGasItem& t_GasItem1, CGasItem& t_GasItem2 ) const;
 
 		std::vector< CGasItem > m_GasItem;
+
+		// Workspace for mixture coefficients (gas count x gas count, row major)
+		std::vector< double > m_MiItem;
+		std::vector< double > m_LambdaPrimItem;
+		std::vector< double > m_LambdaSecondItem;
 		GasProperties m_SimpleProperties;
 		GasProperties m_Properties;
 
 		bool m_DefaultGas;
+		double m_Temperature;
 		double m_Pressure;
+
+		// Table is immutable and shared between copies of the same mixture
+		std::shared_ptr< const CGasPropertiesTable > m_Table;
 	};
 
 }
@@ -0,0 +1,141 @@
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+
+#include "GasPropertiesTable.hpp"
+
+namespace Gases
+{
+    namespace
+    {
+        const size_t InitialIntervals = 16;
+        const size_t MaximumIntervals = 65536;
+        // Error is not checked at the middle of interval only since properties that are not
+        // convex over the interval can have largest error anywhere inside of it
+        const size_t SamplesPerInterval = 8;
+
+        double relativeError(double const t_Exact, double const t_Interpolated)
+        {
+            return t_Exact != 0 ? std::abs((t_Interpolated - t_Exact) / t_Exact)
+                                : std::abs(t_Interpolated);
+        }
+    }   // namespace
+
+    CGasPropertiesTable::CGasPropertiesTable(
+      const std::function<GasProperties(double)> & t_Properties,
+      double const t_MinTemperature,
+      double const t_MaxTemperature,
+      double const t_Tolerance) :
+        m_MinTemperature(t_MinTemperature),
+        m_MaxTemperature(t_MaxTemperature),
+        m_Tolerance(t_Tolerance),
+        m_Step(0),
+        m_MolecularWeight(0)
+    {
+        if(t_MinTemperature <= 0 || t_MaxTemperature <= t_MinTemperature)
+        {
+            throw std::runtime_error("Invalid temperature range for gas properties table.");
+        }
+        if(t_Tolerance <= 0)
+        {
+            throw std::runtime_error("Tolerance of gas properties table must be positive.");
+        }
+
+        auto intervals = InitialIntervals;
+        fill(t_Properties, intervals);
+        while(maxInterpolationError(t_Properties) > m_Tolerance)
+        {
+            intervals *= 2;
+            if(intervals > MaximumIntervals)
+            {
+                throw std::runtime_error(
+                  "Gas properties table cannot reach requested tolerance.");
+            }
+            fill(t_Properties, intervals);
+        }
+    }
+
+    bool CGasPropertiesTable::isInRange(double const t_Temperature) const
+    {
+        return t_Temperature >= m_MinTemperature && t_Temperature <= m_MaxTemperature;
+    }
+
+    void CGasPropertiesTable::interpolate(double const t_Temperature,
+                                          GasProperties & t_Properties) const
+    {
+        const auto position = (t_Temperature - m_MinTemperature) / m_Step;
+        const auto index = std::min(size_t(position), m_ThermalConductivity.size() - 2);
+        const auto w = position - double(index);
+
+        t_Properties.m_ThermalConductivity =
+          m_ThermalConductivity[index]
+          + w * (m_ThermalConductivity[index + 1] - m_ThermalConductivity[index]);
+        t_Properties.m_Viscosity =
+          m_Viscosity[index] + w * (m_Viscosity[index + 1] - m_Viscosity[index]);
+        t_Properties.m_SpecificHeat =
+          m_SpecificHeat[index] + w * (m_SpecificHeat[index + 1] - m_SpecificHeat[index]);
+        t_Properties.m_MolecularWeight = m_MolecularWeight;
+    }
+
+    double CGasPropertiesTable::minTemperature() const
+    {
+        return m_MinTemperature;
+    }
+
+    double CGasPropertiesTable::maxTemperature() const
+    {
+        return m_MaxTemperature;
+    }
+
+    double CGasPropertiesTable::tolerance() const
+    {
+        return m_Tolerance;
+    }
+
+    size_t CGasPropertiesTable::numberOfIntervals() const
+    {
+        return m_ThermalConductivity.size() - 1;
+    }
+
+    void CGasPropertiesTable::fill(const std::function<GasProperties(double)> & t_Properties,
+                                   size_t const t_Intervals)
+    {
+        m_Step = (m_MaxTemperature - m_MinTemperature) / double(t_Intervals);
+        m_ThermalConductivity.resize(t_Intervals + 1);
+        m_Viscosity.resize(t_Intervals + 1);
+        m_SpecificHeat.resize(t_Intervals + 1);
+        for(size_t i = 0; i <= t_Intervals; ++i)
+        {
+            const auto aProperties = t_Properties(m_MinTemperature + double(i) * m_Step);
+            m_ThermalConductivity[i] = aProperties.m_ThermalConductivity;
+            m_Viscosity[i] = aProperties.m_Viscosity;
+            m_SpecificHeat[i] = aProperties.m_SpecificHeat;
+            m_MolecularWeight = aProperties.m_MolecularWeight;
+        }
+    }
+
+    double CGasPropertiesTable::maxInterpolationError(
+      const std::function<GasProperties(double)> & t_Properties) const
+    {
+        double result(0);
+        GasProperties interpolated;
+        for(size_t i = 0; i < numberOfIntervals(); ++i)
+        {
+            for(size_t j = 1; j < SamplesPerInterval; ++j)
+            {
+                const auto temperature =
+                  m_MinTemperature
+                  + (double(i) + double(j) / double(SamplesPerInterval)) * m_Step;
+                const auto exact = t_Properties(temperature);
+                interpolate(temperature, interpolated);
+                result = std::max(
+                  {result,
+                   relativeError(exact.m_ThermalConductivity, interpolated.m_ThermalConductivity),
+                   relativeError(exact.m_Viscosity, interpolated.m_Viscosity),
+                   relativeError(exact.m_SpecificHeat, interpolated.m_SpecificHeat)});
+            }
+        }
+        return result;
+    }
+
+}   // namespace Gases
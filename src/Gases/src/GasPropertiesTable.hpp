@@ -0,0 +1,52 @@
+#ifndef GASPROPERTIESTABLE_H
+#define GASPROPERTIESTABLE_H
+
+#include <functional>
+#include <vector>
+
+#include "GasProperties.hpp"
+
+namespace Gases
+{
+    // Temperature dependent properties of gas mixture (conductivity, viscosity and specific heat)
+    // tabulated on uniform temperature grid. Grid is refined until relative error of linear
+    // interpolation, sampled at several points inside of every interval, is below requested
+    // tolerance.
+    // Properties that depend on pressure (density) are not part of the table and molecular weight
+    // is constant for given mixture.
+    class CGasPropertiesTable
+    {
+    public:
+        CGasPropertiesTable(const std::function<GasProperties(double)> & t_Properties,
+                            double t_MinTemperature,
+                            double t_MaxTemperature,
+                            double t_Tolerance);
+
+        bool isInRange(double t_Temperature) const;
+
+        // Sets conductivity, viscosity, specific heat and molecular weight of given properties
+        void interpolate(double t_Temperature, GasProperties & t_Properties) const;
+
+        double minTemperature() const;
+        double maxTemperature() const;
+        double tolerance() const;
+        size_t numberOfIntervals() const;
+
+    private:
+        void fill(const std::function<GasProperties(double)> & t_Properties, size_t t_Intervals);
+        double maxInterpolationError(const std::function<GasProperties(double)> & t_Properties) const;
+
+        double m_MinTemperature;
+        double m_MaxTemperature;
+        double m_Tolerance;
+        double m_Step;
+        double m_MolecularWeight;
+
+        std::vector<double> m_ThermalConductivity;
+        std::vector<double> m_Viscosity;
+        std::vector<double> m_SpecificHeat;
+    };
+
+}   // namespace Gases
+
+#endif
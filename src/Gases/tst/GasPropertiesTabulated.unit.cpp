@@ -0,0 +1,128 @@
+#include <memory>
+#include <string>
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "WCEGases.hpp"
+#include "WCECommon.hpp"
+
+using namespace Gases;
+
+// Mixture properties interpolated from lookup table
+
+class TestGasPropertiesTabulated : public testing::Test
+{
+protected:
+    CGas m_Gas;
+
+    virtual void SetUp()
+    {
+        m_Gas.addGasItem(0.1, GasDef::Air);
+        m_Gas.addGasItem(0.3, GasDef::Argon);
+        m_Gas.addGasItem(0.3, GasDef::Krypton);
+        m_Gas.addGasItem(0.3, GasDef::Xenon);
+    }
+};
+
+TEST_F(TestGasPropertiesTabulated, TestRealProperties)
+{
+    SCOPED_TRACE("Begin Test: Gas Properties (quadruple gas) tabulated mix - Temperature = 300 "
+                 "[K], Pressure = 101325 [Pa]");
+
+    m_Gas.enableLookupTable(250, 350, 1e-6);
+    EXPECT_TRUE(m_Gas.isLookupTableEnabled());
+
+    m_Gas.setTemperatureAndPressure(300, 101325);
+    auto aProperties = m_Gas.getGasProperties();
+
+    EXPECT_NEAR(79.4114, aProperties.m_MolecularWeight, 0.0001);
+    EXPECT_NEAR(1.108977555E-02, aProperties.m_ThermalConductivity, 1e-6);
+    EXPECT_NEAR(2.412413749E-05, aProperties.m_Viscosity, 1e-6);
+    EXPECT_NEAR(272.5637141, aProperties.m_SpecificHeat, 0.001);
+    EXPECT_NEAR(3.225849103, aProperties.m_Density, 0.0001);
+    EXPECT_NEAR(1.26127756E-05, aProperties.m_Alpha, 1e-6);
+    EXPECT_NEAR(0.592921334, aProperties.m_PrandlNumber, 0.0001);
+}
+
+TEST_F(TestGasPropertiesTabulated, TestAgainstExactProperties)
+{
+    SCOPED_TRACE("Begin Test: Gas Properties (quadruple gas) tabulated mix against exact "
+                 "calculation over temperature range.");
+
+    const auto tolerance = 1e-6;
+
+    CGas aExactGas(m_Gas);
+    m_Gas.enableLookupTable(250, 350, tolerance);
+
+    for(auto temperature = 245.0; temperature <= 355.0; temperature += 0.7)
+    {
+        for(auto pressure : {101325.0, 90000.0})
+        {
+            m_Gas.setTemperatureAndPressure(temperature, pressure);
+            aExactGas.setTemperatureAndPressure(temperature, pressure);
+            const auto aTabulated = m_Gas.getGasProperties();
+            const auto aExact = aExactGas.getGasProperties();
+
+            EXPECT_NEAR(aExact.m_ThermalConductivity,
+                        aTabulated.m_ThermalConductivity,
+                        tolerance * aExact.m_ThermalConductivity);
+            EXPECT_NEAR(aExact.m_Viscosity, aTabulated.m_Viscosity, tolerance * aExact.m_Viscosity);
+            EXPECT_NEAR(
+              aExact.m_SpecificHeat, aTabulated.m_SpecificHeat, tolerance * aExact.m_SpecificHeat);
+            EXPECT_NEAR(aExact.m_Density, aTabulated.m_Density, 1e-12 * aExact.m_Density);
+            EXPECT_NEAR(aExact.m_PrandlNumber,
+                        aTabulated.m_PrandlNumber,
+                        3 * tolerance * aExact.m_PrandlNumber);
+        }
+    }
+}
+
+TEST_F(TestGasPropertiesTabulated, TestLookupTableKeepsGasState)
+{
+    SCOPED_TRACE("Begin Test: Gas Properties (quadruple gas) - creating lookup table does not "
+                 "change state of the gas.");
+
+    // Vacuum pressure properties are held by the gas and must not be overwritten by table
+    // calculations at standard pressure
+    m_Gas.setTemperatureAndPressure(320, 0.05);
+    const auto & aProperties = m_Gas.getGasProperties();
+    const auto aConductivity = aProperties.m_ThermalConductivity;
+
+    m_Gas.enableLookupTable(250, 350, 1e-6);
+
+    EXPECT_EQ(aConductivity, aProperties.m_ThermalConductivity);
+    EXPECT_EQ(aConductivity, m_Gas.getGasProperties().m_ThermalConductivity);
+}
+
+TEST(TestGasPropertiesTable, TestErrorAwayFromMidpoints)
+{
+    SCOPED_TRACE("Begin Test: Gas properties table - interpolation error is checked inside of "
+                 "whole interval.");
+
+    // Function is exact at nodes and midpoints of initial grid (16 intervals) and has largest
+    // error at eighths of interval
+    const auto minTemperature = 250.0;
+    const auto maxTemperature = 350.0;
+    const auto initialStep = (maxTemperature - minTemperature) / 16;
+    const auto properties = [=](double const t_Temperature) {
+        GasProperties result;
+        result.m_ThermalConductivity =
+          1 + 0.1 * std::sin(4 * ConstantsData::WCE_PI * (t_Temperature - minTemperature) / initialStep);
+        result.m_Viscosity = 1;
+        result.m_SpecificHeat = 1;
+        result.m_MolecularWeight = 1;
+        return result;
+    };
+
+    const auto tolerance = 1e-3;
+    CGasPropertiesTable aTable(properties, minTemperature, maxTemperature, tolerance);
+    EXPECT_GT(aTable.numberOfIntervals(), 16u);
+
+    GasProperties aInterpolated;
+    for(auto temperature = minTemperature; temperature <= maxTemperature; temperature += 0.01)
+    {
+        aTable.interpolate(temperature, aInterpolated);
+        const auto exact = properties(temperature).m_ThermalConductivity;
+        EXPECT_NEAR(exact, aInterpolated.m_ThermalConductivity, tolerance * exact);
+    }
+}
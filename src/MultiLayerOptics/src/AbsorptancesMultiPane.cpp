@@ -50,97 +50,91 @@ namespace MultiLayerOptics
         {
             size_t size = m_T.size();
 
-            // Calculate r and t coefficients
-            CSeries r;
-            CSeries t;
+            // Calculate r and t coefficients. Coefficients of layer are calculated from
+            // r coefficient of the next layer (zero behind the last layer).
+            CSeries zero;
             std::vector<double> wv = m_T[size - 1].getXArray();
-            r.setConstantValues(wv, 0);
-            t.setConstantValues(wv, 0);
-            m_rCoeffs.clear();
-            m_tCoeffs.clear();
+            zero.setConstantValues(wv, 0);
+            m_rCoeffs.resize(size);
+            m_tCoeffs.resize(size);
 
             // layers loop
             for(int i = int(size) - 1; i >= 0; --i)
             {
-                t = tCoeffs(m_T[i], m_Rb[i], r);
-                r = rCoeffs(m_T[i], m_Rf[i], m_Rb[i], r);
-
-                m_rCoeffs.insert(m_rCoeffs.begin(), r);
-                m_tCoeffs.insert(m_tCoeffs.begin(), t);
+                const auto & r = (size_t(i) + 1 < size) ? m_rCoeffs[i + 1] : zero;
+                tCoeffs(m_T[i], m_Rb[i], r, m_tCoeffs[i]);
+                rCoeffs(m_T[i], m_Rf[i], m_Rb[i], r, m_rCoeffs[i]);
             }
 
             // Calculate normalized radiances
-            size = m_rCoeffs.size();
-            std::vector<CSeries> Iplus;
-            std::vector<CSeries> Iminus;
-
-            CSeries Im;
-            CSeries Ip;
-            Im.setConstantValues(wv, 1);
-            Iminus.push_back(Im);
+            std::vector<CSeries> Iplus(size + 1);
+            std::vector<CSeries> Iminus(size + 1);
 
+            Iminus[0].setConstantValues(wv, 1);
             for(size_t i = 0; i < size; ++i)
             {
-                Ip = m_rCoeffs[i] * Im;
-                Im = m_tCoeffs[i] * Im;
-                Iplus.push_back(Ip);
-                Iminus.push_back(Im);
+                Iplus[i].apply([](double r, double im) { return r * im; }, m_rCoeffs[i], Iminus[i]);
+                Iminus[i + 1].apply(
+                  [](double t, double im) { return t * im; }, m_tCoeffs[i], Iminus[i]);
             }
-            Ip.setConstantValues(wv, 0);
-            Iplus.push_back(Ip);
+            Iplus[size].setConstantValues(wv, 0);
 
             // Calculate absorptances
-            m_Abs.clear();
-            m_AbsBySide[FenestrationCommon::Side::Front] = std::vector<CSeries>();
-            m_AbsBySide[FenestrationCommon::Side::Back] = std::vector<CSeries>();
-            size = Iminus.size();
-            for(size_t i = 0; i < size - 1; ++i)
+            m_Abs.resize(size);
+            auto & absFront = m_AbsBySide[FenestrationCommon::Side::Front];
+            auto & absBack = m_AbsBySide[FenestrationCommon::Side::Back];
+            absFront.resize(size);
+            absBack.resize(size);
+            for(size_t i = 0; i < size; ++i)
             {
-                const auto Iincoming = Iminus[i] - Iplus[i];
-                const auto Ioutgoing = Iminus[i + 1] - Iplus[i + 1];
-                CSeries layerAbs = Iincoming - Ioutgoing;
-                m_Abs.push_back(layerAbs);
-                m_AbsBySide[Side::Front].emplace_back(Iminus[i] * (1 - m_T[i] - m_Rf[i]));
-                m_AbsBySide[Side::Back].emplace_back(Iplus[i + 1] * (1 - m_T[i] - m_Rb[i]));
+                m_Abs[i].apply(
+                  [](double imIn, double ipIn, double imOut, double ipOut) {
+                      return (imIn - ipIn) - (imOut - ipOut);
+                  },
+                  Iminus[i],
+                  Iplus[i],
+                  Iminus[i + 1],
+                  Iplus[i + 1]);
+                absFront[i].apply([](double im, double t, double r) { return im * (1 - t - r); },
+                                  Iminus[i],
+                                  m_T[i],
+                                  m_Rf[i]);
+                absBack[i].apply([](double ip, double t, double r) { return ip * (1 - t - r); },
+                                 Iplus[i + 1],
+                                 m_T[i],
+                                 m_Rb[i]);
             }
+
+            m_StateCalculated = true;
         }
     }
 
-    CSeries CAbsorptancesMultiPane::rCoeffs(const CSeries & t_T,
-                                            const CSeries & t_Rf,
-                                            const CSeries & t_Rb,
-                                            const CSeries & t_RCoeffs)
+    void CAbsorptancesMultiPane::rCoeffs(const CSeries & t_T,
+                                         const CSeries & t_Rf,
+                                         const CSeries & t_Rb,
+                                         const CSeries & t_RCoeffs,
+                                         CSeries & t_Result)
     {
-        CSeries rCoeffs;
-        size_t size = t_T.size();
-
-        for(size_t i = 0; i < size; ++i)
-        {
-            double wl = t_T[i].x();
-            double rValue = t_Rf[i].value()
-                            + t_T[i].value() * t_T[i].value() * t_RCoeffs[i].value()
-                                / (1 - t_Rb[i].value() * t_RCoeffs[i].value());
-            rCoeffs.addProperty(wl, rValue);
-        }
-
-        return rCoeffs;
+        t_Result.apply(
+          [](double t, double rf, double rb, double rCoeff) {
+              return rf + t * t * rCoeff / (1 - rb * rCoeff);
+          },
+          t_T,
+          t_Rf,
+          t_Rb,
+          t_RCoeffs);
     }
 
-    CSeries CAbsorptancesMultiPane::tCoeffs(const CSeries & t_T,
-                                            const CSeries & t_Rb,
-                                            const CSeries & t_RCoeffs)
+    void CAbsorptancesMultiPane::tCoeffs(const CSeries & t_T,
+                                         const CSeries & t_Rb,
+                                         const CSeries & t_RCoeffs,
+                                         CSeries & t_Result)
     {
-        CSeries tCoeffs;
-        size_t size = t_T.size();
-
-        for(size_t i = 0; i < size; ++i)
-        {
-            double wl = t_T[i].x();
-            double tValue = t_T[i].value() / (1 - t_Rb[i].value() * t_RCoeffs[i].value());
-            tCoeffs.addProperty(wl, tValue);
-        }
-
-        return tCoeffs;
+        t_Result.apply(
+          [](double t, double rb, double rCoeff) { return t / (1 - rb * rCoeff); },
+          t_T,
+          t_Rb,
+          t_RCoeffs);
     }
 
 }   // namespace MultiLayerOptics
@@ -25,16 +25,19 @@ namespace MultiLayerOptics {
 	private:
 		void calculateState();
 
-		FenestrationCommon::CSeries rCoeffs(
+		// Results are calculated in single pass into t_Result
+		static void rCoeffs(
 			const FenestrationCommon::CSeries& t_T,
 			const FenestrationCommon::CSeries& t_Rf,
 			const FenestrationCommon::CSeries& t_Rb,
-			const FenestrationCommon::CSeries& t_RCoeffs );
+			const FenestrationCommon::CSeries& t_RCoeffs,
+			FenestrationCommon::CSeries& t_Result );
 
-        FenestrationCommon::CSeries tCoeffs(
+		static void tCoeffs(
 			const FenestrationCommon::CSeries& t_T,
 			const FenestrationCommon::CSeries& t_Rb,
-			const FenestrationCommon::CSeries& t_RCoeffs );
+			const FenestrationCommon::CSeries& t_RCoeffs,
+			FenestrationCommon::CSeries& t_Result );
 
 		std::vector< FenestrationCommon::CSeries > m_T;
 		std::vector< FenestrationCommon::CSeries > m_Rf;
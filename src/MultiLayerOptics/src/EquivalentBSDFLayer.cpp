@@ -2,6 +2,7 @@
 #include <cmath>
 #include <cassert>
 #include <stdexcept>
+#include <algorithm>
 
 #include "EquivalentBSDFLayer.hpp"
 #include "EquivalentBSDFLayerSingleBand.hpp"
@@ -13,11 +14,40 @@ using namespace SingleLayerOptics;
 
 namespace MultiLayerOptics
 {
+    namespace
+    {
+        // Transmittances and reflectances of layer for single beam or hemispherical flux
+        struct ScalarLayer
+        {
+            double Tf;
+            double Tb;
+            double Rf;
+            double Rb;
+        };
+
+        // Net radiation equations for layer t_Back placed behind t_Front
+        ScalarLayer combine(const ScalarLayer & t_Front, const ScalarLayer & t_Back)
+        {
+            const auto denominator = 1 - t_Front.Rb * t_Back.Rf;
+            return {t_Front.Tf * t_Back.Tf / denominator,
+                    t_Back.Tb * t_Front.Tb / denominator,
+                    t_Front.Rf + t_Front.Tf * t_Front.Tb * t_Back.Rf / denominator,
+                    t_Back.Rb + t_Back.Tb * t_Back.Tf * t_Front.Rb / denominator};
+        }
+    }   // namespace
+
     CEquivalentBSDFLayer::CEquivalentBSDFLayer(const std::vector<double> & t_CommonWavelengths,
                                                const std::shared_ptr<CBSDFLayer> & t_Layer) :
-        m_Lambda(t_Layer->getResults()->lambdaMatrix()),
+        m_Lambda(t_Layer->getDirections(BSDFDirection::Incoming).lambdaMatrix()),
         m_CombinedLayerWavelengths(t_CommonWavelengths),
-        m_Calculated(false)
+        m_Calculated(false),
+        m_MinLambdaCalculated(0),
+        m_MaxLambdaCalculated(0),
+        m_SpectralTolerance(0),
+        m_InterReflectanceTolerance(0),
+        m_FloatStorage(false),
+        m_NumberOfBands(0),
+        m_BandError(0)
     {
         if(t_Layer == nullptr)
         {
@@ -29,8 +59,9 @@ namespace MultiLayerOptics
 
     void CEquivalentBSDFLayer::addLayer(const std::shared_ptr<CBSDFLayer> & t_Layer)
     {
-        updateWavelengthLayers(*t_Layer);
         m_Layer.push_back(t_Layer);
+        m_LayersWL.clear();
+        m_Calculated = false;
     }
 
     const CBSDFDirections & CEquivalentBSDFLayer::getDirections(const BSDFDirection t_Side) const
@@ -43,22 +74,39 @@ namespace MultiLayerOptics
         return m_CombinedLayerWavelengths;
     }
 
+    std::vector<double> CEquivalentBSDFLayer::getCommonWavelengths(const double minLambda,
+                                                                    const double maxLambda) const
+    {
+        const auto range = rangeIndexes(minLambda, maxLambda);
+        return std::vector<double>(m_CombinedLayerWavelengths.begin() + range.first,
+                                   m_CombinedLayerWavelengths.begin() + range.second);
+    }
+
     std::shared_ptr<CMatrixSeries> CEquivalentBSDFLayer::getTotalA(const Side t_Side)
     {
-        if(!m_Calculated)
-        {
-            calculate();
-        }
-        return m_TotA.at(t_Side);
+        return getTotalA(0, 0, t_Side);
     }
 
     std::shared_ptr<CMatrixSeries> CEquivalentBSDFLayer::getTotal(const Side t_Side,
                                                                   const PropertySimple t_Property)
     {
-        if(!m_Calculated)
-        {
-            calculate();
-        }
+        return getTotal(0, 0, t_Side, t_Property);
+    }
+
+    std::shared_ptr<CMatrixSeries> CEquivalentBSDFLayer::getTotalA(const double minLambda,
+                                                                   const double maxLambda,
+                                                                   const Side t_Side)
+    {
+        calculate(minLambda, maxLambda);
+        return m_TotA.at(t_Side);
+    }
+
+    std::shared_ptr<CMatrixSeries> CEquivalentBSDFLayer::getTotal(const double minLambda,
+                                                                  const double maxLambda,
+                                                                  const Side t_Side,
+                                                                  const PropertySimple t_Property)
+    {
+        calculate(minLambda, maxLambda);
         return m_Tot.at(std::make_pair(t_Side, t_Property));
     }
 
@@ -69,15 +117,71 @@ namespace MultiLayerOptics
         for(auto & aLayer : m_Layer)
         {
             aLayer->setSourceData(t_SolarRadiation);
-            updateWavelengthLayers(*aLayer);
+        }
+        const auto aSource = t_SolarRadiation.interpolate(m_CombinedLayerWavelengths);
+        m_Source.resize(aSource.size());
+        for(size_t i = 0; i < aSource.size(); ++i)
+        {
+            m_Source[i] = aSource[i].value();
+        }
+        m_Calculated = false;
+    }
+
+    void CEquivalentBSDFLayer::setSpectralTolerance(const double t_Tolerance)
+    {
+        m_SpectralTolerance = t_Tolerance;
+        m_Calculated = false;
+    }
+
+    void CEquivalentBSDFLayer::setInterReflectanceTolerance(const double t_Tolerance)
+    {
+        m_InterReflectanceTolerance = t_Tolerance;
+        for(auto & aLayer : m_LayersWL)
+        {
+            aLayer.second.setInterReflectanceTolerance(t_Tolerance);
+        }
+        m_Calculated = false;
+    }
+
+    void CEquivalentBSDFLayer::setFloatStorage(const bool t_FloatStorage)
+    {
+        m_FloatStorage = t_FloatStorage;
+        for(auto & aLayer : m_LayersWL)
+        {
+            aLayer.second.setFloatStorage(t_FloatStorage);
         }
         m_Calculated = false;
     }
 
-    void CEquivalentBSDFLayer::calculate()
+    size_t CEquivalentBSDFLayer::getNumberOfBands()
+    {
+        if(!m_Calculated)
+        {
+            calculate(m_MinLambdaCalculated, m_MaxLambdaCalculated);
+        }
+        return m_NumberOfBands;
+    }
+
+    double CEquivalentBSDFLayer::getBandError()
+    {
+        if(!m_Calculated)
+        {
+            calculate(m_MinLambdaCalculated, m_MaxLambdaCalculated);
+        }
+        return m_BandError;
+    }
+
+    void CEquivalentBSDFLayer::calculate(const double minLambda, const double maxLambda)
     {
+        if(m_Calculated && minLambda == m_MinLambdaCalculated
+           && maxLambda == m_MaxLambdaCalculated)
+        {
+            return;
+        }
+        WCE_SCOPED_TIMER("CEquivalentBSDFLayer::calculate");
+
         size_t matrixSize = m_Lambda.size();
-        size_t numberOfLayers = m_LayersWL[0].getNumberOfLayers();
+        size_t numberOfLayers = m_Layer.size();
 
         for(Side aSide : EnumSide())
         {
@@ -90,7 +194,7 @@ namespace MultiLayerOptics
         }
 
         // Calculate total transmitted solar per matrix and perform integration over each wavelength
-        size_t WLsize = m_CombinedLayerWavelengths.size();
+        const auto range = rangeIndexes(minLambda, maxLambda);
 
         // // This is for multithread calculations.
         // size_t numOfThreads = size_t( thread::hardware_concurrency() - 2 );
@@ -121,11 +225,39 @@ namespace MultiLayerOptics
         // // End of multithreaded calculations.
 
 
-        calculateWavelengthProperties(numberOfLayers, 0, WLsize);
+        calculateBands(range.first, range.second);
+        calculateWavelengthProperties(numberOfLayers, range.first, range.second);
 
+        m_MinLambdaCalculated = minLambda;
+        m_MaxLambdaCalculated = maxLambda;
         m_Calculated = true;
     }
 
+    std::pair<size_t, size_t> CEquivalentBSDFLayer::rangeIndexes(const double minLambda,
+                                                                 const double maxLambda) const
+    {
+        const auto size = m_CombinedLayerWavelengths.size();
+        if(minLambda == 0 && maxLambda == 0)
+        {
+            return std::make_pair(size_t(0), size);
+        }
+
+        // Same tolerance as in CSeries::sum. Wavelength at the end of the range is needed as
+        // upper limit of the last integrated interval.
+        const double TOLERANCE = 1e-6;
+        size_t first = 0;
+        while(first < size && m_CombinedLayerWavelengths[first] < minLambda - TOLERANCE)
+        {
+            ++first;
+        }
+        size_t last = first;
+        while(last < size && m_CombinedLayerWavelengths[last] < maxLambda - TOLERANCE)
+        {
+            ++last;
+        }
+        return std::make_pair(first, std::min(last + 1, size));
+    }
+
     void CEquivalentBSDFLayer::calculateWavelengthProperties(size_t const t_NumOfLayers,
                                                              size_t const t_Start,
                                                              size_t const t_End)
@@ -133,17 +265,18 @@ namespace MultiLayerOptics
         for(auto i = t_Start; i < t_End; ++i)
         {
             const auto curWL = m_CombinedLayerWavelengths[i];
+            auto & aBand = wavelengthLayer(m_BandWavelength[i]);
 
             for(auto aSide : EnumSide())
             {
                 for(size_t k = 0; k < t_NumOfLayers; ++k)
                 {
                     m_TotA.at(aSide)->addProperties(
-                      k, curWL, m_LayersWL[i].getLayerAbsorptances(k + 1, aSide));
+                      k, curWL, aBand.getLayerAbsorptances(k + 1, aSide));
                 }
                 for(auto aProperty : EnumPropertySimple())
                 {
-                    auto curPropertyMatrix = m_LayersWL[i].getProperty(aSide, aProperty);
+                    auto curPropertyMatrix = aBand.getProperty(aSide, aProperty);
                     m_Tot.at(std::make_pair(aSide, aProperty))
                       ->addProperties(curWL, curPropertyMatrix);
                 }
@@ -151,29 +284,184 @@ namespace MultiLayerOptics
         }
     }
 
-    void CEquivalentBSDFLayer::updateWavelengthLayers(CBSDFLayer & t_Layer)
+    void CEquivalentBSDFLayer::calculateBands(size_t const t_Start, size_t const t_End)
     {
-        const auto aResults = t_Layer.getWavelengthResults();
-        const auto size = m_CombinedLayerWavelengths.size();
-        for(size_t i = 0; i < size; ++i)
+        m_BandWavelength.resize(m_CombinedLayerWavelengths.size());
+        m_BandError = 0;
+        if(m_SpectralTolerance <= 0)
         {
-            const auto curWL = m_CombinedLayerWavelengths[i];
-            const auto index = t_Layer.getBandIndex(curWL);
-            assert(index > -1);
+            for(size_t i = t_Start; i < t_End; ++i)
+            {
+                m_BandWavelength[i] = i;
+            }
+            m_NumberOfBands = t_End - t_Start;
+            return;
+        }
+
+        // Multilayer quantities are needed only for wavelengths in the calculated range
+        std::vector<std::vector<double>> quantities;
+        quantities.reserve(t_End - t_Start);
+        for(size_t i = t_Start; i < t_End; ++i)
+        {
+            quantities.push_back(multilayerQuantities(i));
+        }
+        const auto quantity = [&quantities, t_Start](const size_t i) -> const std::vector<double> & {
+            return quantities[i - t_Start];
+        };
+
+        // Wavelength weights are source (solar radiation multiplied with detector) multiplied with
+        // trapezoidal integration width over the range
+        std::vector<double> weights(t_End - t_Start, 1.0);
+        for(size_t i = t_Start; i < t_End; ++i)
+        {
+            const auto lower = m_CombinedLayerWavelengths[i > t_Start ? i - 1 : i];
+            const auto upper = m_CombinedLayerWavelengths[i + 1 < t_End ? i + 1 : i];
+            const auto source = i < m_Source.size() ? m_Source[i] : 1.0;
+            weights[i - t_Start] = source * (upper - lower) / 2;
+        }
+
+        const auto deviation = [&quantity](const size_t i, const std::vector<double> & value) {
+            double result = 0;
+            for(size_t k = 0; k < value.size(); ++k)
+            {
+                result = std::max(result, std::abs(quantity(i)[k] - value[k]));
+            }
+            return result;
+        };
+
+        const auto numOfQuantities = quantities.empty() ? 0u : quantities[0].size();
+        std::vector<double> errorSum(numOfQuantities, 0);
+        double weightSum = 0;
+        m_NumberOfBands = 0;
+        size_t start = t_Start;
+        while(start < t_End)
+        {
+            // Band is extended while every multilayer quantity stays within tolerance
+            auto minValue = quantity(start);
+            auto maxValue = quantity(start);
+            size_t end = start + 1;
+            for(; end < t_End; ++end)
+            {
+                bool inBand = true;
+                for(size_t k = 0; k < numOfQuantities && inBand; ++k)
+                {
+                    inBand = std::max(maxValue[k], quantity(end)[k])
+                               - std::min(minValue[k], quantity(end)[k])
+                             <= m_SpectralTolerance;
+                }
+                if(!inBand)
+                {
+                    break;
+                }
+                for(size_t k = 0; k < numOfQuantities; ++k)
+                {
+                    minValue[k] = std::min(minValue[k], quantity(end)[k]);
+                    maxValue[k] = std::max(maxValue[k], quantity(end)[k]);
+                }
+            }
+
+            std::vector<double> average(numOfQuantities, 0);
+            double bandWeight = 0;
+            for(size_t i = start; i < end; ++i)
+            {
+                for(size_t k = 0; k < numOfQuantities; ++k)
+                {
+                    average[k] += weights[i - t_Start] * quantity(i)[k];
+                }
+                bandWeight += weights[i - t_Start];
+            }
+            for(size_t k = 0; k < numOfQuantities; ++k)
+            {
+                average[k] = bandWeight > 0 ? average[k] / bandWeight
+                                            : (minValue[k] + maxValue[k]) / 2;
+            }
 
-            const std::shared_ptr<CBSDFIntegrator> currentLayer = (*aResults)[size_t(index)];
+            auto representative = start;
+            for(size_t i = start + 1; i < end; ++i)
+            {
+                if(deviation(i, average) < deviation(representative, average))
+                {
+                    representative = i;
+                }
+            }
 
-            if(m_LayersWL.size() <= i)
+            for(size_t i = start; i < end; ++i)
             {
-                const CEquivalentBSDFLayerSingleBand aEquivalentLayer(currentLayer);
+                m_BandWavelength[i] = representative;
+                for(size_t k = 0; k < numOfQuantities; ++k)
+                {
+                    errorSum[k] += weights[i - t_Start]
+                                   * std::abs(quantity(i)[k] - quantity(representative)[k]);
+                }
+                weightSum += weights[i - t_Start];
+            }
+            ++m_NumberOfBands;
+            start = end;
+        }
+
+        for(const auto error : errorSum)
+        {
+            m_BandError = std::max(m_BandError, weightSum > 0 ? error / weightSum : 0);
+        }
+    }
+
+    std::vector<double> CEquivalentBSDFLayer::multilayerQuantities(size_t const t_Index)
+    {
+        const auto numOfDirections = m_Lambda.size();
+        ScalarLayer diffuse;
+        std::vector<ScalarLayer> direct(numOfDirections);
+        for(size_t k = 0; k < m_Layer.size(); ++k)
+        {
+            auto & aResult = *layerResults(k, t_Index);
 
-                m_LayersWL.push_back(aEquivalentLayer);
+            const ScalarLayer aDiffuse{aResult.DiffDiff(Side::Front, PropertySimple::T),
+                                       aResult.DiffDiff(Side::Back, PropertySimple::T),
+                                       aResult.DiffDiff(Side::Front, PropertySimple::R),
+                                       aResult.DiffDiff(Side::Back, PropertySimple::R)};
+            diffuse = k == 0 ? aDiffuse : combine(diffuse, aDiffuse);
+            for(size_t j = 0; j < numOfDirections; ++j)
+            {
+                const ScalarLayer aDirect{aResult.DirDir(Side::Front, PropertySimple::T, j),
+                                          aResult.DirDir(Side::Back, PropertySimple::T, j),
+                                          aResult.DirDir(Side::Front, PropertySimple::R, j),
+                                          aResult.DirDir(Side::Back, PropertySimple::R, j)};
+                direct[j] = k == 0 ? aDirect : combine(direct[j], aDirect);
             }
-            else
+        }
+
+        std::vector<double> result{diffuse.Tf, diffuse.Tb, diffuse.Rf, diffuse.Rb};
+        result.reserve(4 * (numOfDirections + 1));
+        for(const auto & aDirect : direct)
+        {
+            result.insert(result.end(), {aDirect.Tf, aDirect.Tb, aDirect.Rf, aDirect.Rb});
+        }
+        return result;
+    }
+
+    std::shared_ptr<CBSDFIntegrator> CEquivalentBSDFLayer::layerResults(size_t const t_LayerIndex,
+                                                                        size_t const t_Index)
+    {
+        auto & aLayer = *m_Layer[t_LayerIndex];
+        const auto index = aLayer.getBandIndex(m_CombinedLayerWavelengths[t_Index]);
+        assert(index > -1);
+        return aLayer.getBandResults(size_t(index));
+    }
+
+    CEquivalentBSDFLayerSingleBand & CEquivalentBSDFLayer::wavelengthLayer(size_t const t_Index)
+    {
+        auto it = m_LayersWL.find(t_Index);
+        if(it == m_LayersWL.end())
+        {
+            CEquivalentBSDFLayerSingleBand aEquivalentLayer(layerResults(0, t_Index));
+            aEquivalentLayer.setInterReflectanceTolerance(m_InterReflectanceTolerance);
+            aEquivalentLayer.setFloatStorage(m_FloatStorage);
+            for(size_t k = 1; k < m_Layer.size(); ++k)
             {
-                m_LayersWL[i].addLayer(currentLayer);
+                aEquivalentLayer.addLayer(layerResults(k, t_Index));
             }
+            it = m_LayersWL.emplace(t_Index, aEquivalentLayer).first;
         }
+        return it->second;
     }
 
 }   // namespace MultiLayerOptics
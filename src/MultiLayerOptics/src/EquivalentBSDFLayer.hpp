@@ -42,6 +42,11 @@ namespace MultiLayerOptics
           getDirections(SingleLayerOptics::BSDFDirection t_Side) const;
         std::vector<double> getCommonWavelengths() const;
 
+        // Common wavelengths that are needed to integrate results over [minLambda, maxLambda)
+        // range. Range is defined in the same way as for CSeries::sum (zero range stands for all
+        // wavelengths).
+        std::vector<double> getCommonWavelengths(double minLambda, double maxLambda) const;
+
         // Absorptance wavelength by wavelength matrices
         std::shared_ptr<FenestrationCommon::CMatrixSeries>
           getTotalA(FenestrationCommon::Side t_Side);
@@ -50,19 +55,89 @@ namespace MultiLayerOptics
         std::shared_ptr<FenestrationCommon::CMatrixSeries>
           getTotal(FenestrationCommon::Side t_Side, FenestrationCommon::PropertySimple t_Property);
 
+        // Same as above, but equivalent layer is composed only at common wavelengths in given
+        // range. Composed wavelengths are kept so that they are not calculated again for other
+        // ranges.
+        std::shared_ptr<FenestrationCommon::CMatrixSeries>
+          getTotalA(double minLambda, double maxLambda, FenestrationCommon::Side t_Side);
+
+        std::shared_ptr<FenestrationCommon::CMatrixSeries>
+          getTotal(double minLambda,
+                   double maxLambda,
+                   FenestrationCommon::Side t_Side,
+                   FenestrationCommon::PropertySimple t_Property);
+
+        // Source is passed to the layers and used as wavelength weight for band merging. Source
+        // must already be multiplied with detector when there is one (CMultiPaneBSDF passes
+        // solar radiation multiplied with its detector data).
         void
           setSolarRadiation(FenestrationCommon::CSeries &t_SolarRadiation);
 
+        // Adjacent wavelengths are merged into bands in which multilayer quantities (see
+        // getBandError) do not change more than given tolerance. Equivalent layer is calculated
+        // once per band, at the wavelength closest to source weighted band average, and used for
+        // all wavelengths in the band. Only wavelengths in the calculated range are merged. Zero
+        // tolerance (default) calculates every wavelength.
+        void setSpectralTolerance(double t_Tolerance);
+
+        size_t getNumberOfBands();
+
+        // Layer absorptances of dense layers are calculated with truncated interreflectance series
+        // instead of with matrix inverse. Series is stopped once its remainder is bound to be
+        // smaller than given relative tolerance. Zero tolerance (default) uses inverse. Equivalent
+        // transmittances and reflectances are always calculated with inverse. Series saves one
+        // dense inverse per layer and side, which is about a quarter of composition time for two
+        // or three dense layers with moderate reflectance. It does not help layers with diagonal
+        // or uniform diffuse reflectances, which have cheap inverses.
+        void setInterReflectanceTolerance(double t_Tolerance);
+
+        // Per-wavelength matrices created by composition (intermediate layers used for
+        // absorptances and equivalent layer) are stored in single precision once the wavelength
+        // is composed. That halves memory needed for dense matrices of these layers only.
+        // Wavelength results of added layers belong to their CBSDFLayer objects and stay in double
+        // precision, as do wavelength by wavelength totals (getTotal, getTotalA). Compositions and
+        // integrations are still done in double precision and the only error is rounding of
+        // stored matrix elements, which is at most FloatMatrix::roundingError (6e-8) relative.
+        // Since all BSDF elements are non-negative, integrated results keep relative error of the
+        // same order.
+        void setFloatStorage(bool t_FloatStorage);
+
+        // Bound of error of source weighted integrals over calculated range caused by merging of
+        // wavelengths into bands. It is calculated for multilayer quantities that are cheap to get
+        // at every wavelength: diffuse-diffuse transmittances and reflectances of layers combined
+        // with net radiation equations and the same for direct-direct properties of every
+        // incoming direction. Direct-direct quantities are exact multilayer results while
+        // diffuse-diffuse ones are approximation of results of BSDF composition. Result is the
+        // largest, over all quantities, source weighted average of absolute difference from the
+        // quantity at the wavelength that represents the band and cannot be greater than spectral
+        // tolerance.
+        double getBandError();
+
     private:
-        void calculate();
+        void calculate(double minLambda, double maxLambda);
+
+        // First and one past last index of common wavelengths needed for given range
+        std::pair<size_t, size_t> rangeIndexes(double minLambda, double maxLambda) const;
+
+        // Assigns every wavelength in [t_Start, t_End) to the wavelength which represents its band
+        void calculateBands(size_t t_Start, size_t t_End);
+
+        // Multilayer quantities used to merge wavelengths into bands (see getBandError)
+        std::vector<double> multilayerQuantities(size_t t_Index);
 
         // Wavelength layer per layer calculations
         void calculateWavelengthProperties(size_t t_NumOfLayers, size_t t_Start, size_t t_End);
 
-        void updateWavelengthLayers(SingleLayerOptics::CBSDFLayer & t_Layer);
+        // Results of layer at given common wavelength. Layer calculates results only for bands
+        // that are requested.
+        std::shared_ptr<SingleLayerOptics::CBSDFIntegrator> layerResults(size_t t_LayerIndex,
+                                                                          size_t t_Index);
+
+        // Equivalent layer at given common wavelength. It is composed on first request.
+        CEquivalentBSDFLayerSingleBand & wavelengthLayer(size_t t_Index);
 
-        // std::vector of layer results over each wavelength
-        std::vector<CEquivalentBSDFLayerSingleBand> m_LayersWL;
+        // Equivalent layers composed so far, keyed by index of common wavelength
+        std::map<size_t, CEquivalentBSDFLayerSingleBand> m_LayersWL;
 
         // Layers that are added to the equivalent layer
         std::vector<std::shared_ptr<SingleLayerOptics::CBSDFLayer>> m_Layer;
@@ -81,6 +156,19 @@ namespace MultiLayerOptics
 
         std::vector<double> m_CombinedLayerWavelengths;
         bool m_Calculated;
+        double m_MinLambdaCalculated;
+        double m_MaxLambdaCalculated;
+
+        // Source given with setSolarRadiation (solar radiation multiplied with detector) at common
+        // wavelengths
+        std::vector<double> m_Source;
+
+        double m_SpectralTolerance;
+        double m_InterReflectanceTolerance;
+        bool m_FloatStorage;
+        std::vector<size_t> m_BandWavelength;
+        size_t m_NumberOfBands;
+        double m_BandError;
     };
 
 }   // namespace MultiLayerOptics
@@ -1,3 +1,6 @@
+#include <cmath>
+#include <algorithm>
+
 #include "EquivalentBSDFLayerSingleBand.hpp"
 #include "WCESingleLayerOptics.hpp"
 #include "WCECommon.hpp"
@@ -11,56 +14,190 @@ namespace MultiLayerOptics
     //  CInterReflectance
     //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    CInterReflectance::CInterReflectance(const SquareMatrix & t_Lambda, const SquareMatrix & t_Rb, const SquareMatrix & t_Rf)
+    namespace
+    {
+        // Series that does not converge within this number of terms is replaced with inverse
+        const size_t MaxSeriesTerms = 100;
+
+        // Row vector norm which is consistent with column sum norm of the matrix
+        double seriesNorm(const std::vector<double> & t_Vector)
+        {
+            double result = 0;
+            for(const auto value : t_Vector)
+            {
+                result = std::max(result, std::abs(value));
+            }
+            return result;
+        }
+
+        void addTerm(std::vector<double> & t_Sum, const std::vector<double> & t_Term)
+        {
+            for(size_t i = 0; i < t_Sum.size(); ++i)
+            {
+                t_Sum[i] += t_Term[i];
+            }
+        }
+    }   // namespace
+
+    CInterReflectance::CInterReflectance(const SquareMatrix & t_Lambda, const SquareMatrix & t_Rb, const SquareMatrix & t_Rf) :
+        CInterReflectance(StructuredMatrix(t_Lambda), StructuredMatrix(t_Rb), StructuredMatrix(t_Rf))
+    {}
+
+    CInterReflectance::CInterReflectance(const StructuredMatrix & t_Lambda,
+                                         const StructuredMatrix & t_Rb,
+                                         const StructuredMatrix & t_Rf,
+                                         const double t_Tolerance) :
+        m_LambdaRb(t_Lambda * t_Rb),
+        m_LambdaRf(t_Lambda * t_Rf),
+        m_Tolerance(t_Tolerance),
+        m_Norm(m_LambdaRb.norm1() * m_LambdaRf.norm1()),
+        m_Series(t_Tolerance > 0 && m_Norm < 1
+                 && (m_LambdaRb.structure() == MatrixStructure::Dense
+                     || m_LambdaRf.structure() == MatrixStructure::Dense)),
+        m_InverseCalculated(false),
+        m_InterRefl(SquareMatrix(t_Lambda.size()))
     {
-        const auto size = t_Lambda.size();
-        const auto lRb = t_Lambda * t_Rb;
-        const auto lRf = t_Lambda * t_Rf;
-        m_InterRefl = lRb * lRf;
-        SquareMatrix I(size);
-        I.setIdentity();
-        m_InterRefl = I - m_InterRefl;
-        m_InterRefl = m_InterRefl.inverse();
+        if(!m_Series)
+        {
+            structuredValue();
+        }
     }
 
     SquareMatrix CInterReflectance::value() const
     {
+        return structuredValue().matrix();
+    }
+
+    const StructuredMatrix & CInterReflectance::structuredValue() const
+    {
+        if(!m_InverseCalculated)
+        {
+            SquareMatrix I(m_LambdaRb.size());
+            I.setIdentity();
+            m_InterRefl = StructuredMatrix(I, MatrixStructure::Diagonal) - m_LambdaRb * m_LambdaRf;
+            m_InterRefl = m_InterRefl.inverse();
+            m_InverseCalculated = true;
+        }
         return m_InterRefl;
     }
 
+    StructuredMatrix CInterReflectance::leftMultiply(const StructuredMatrix & t_Matrix) const
+    {
+        return t_Matrix * structuredValue();
+    }
+
+    std::vector<double> CInterReflectance::leftMultiply(const std::vector<double> & t_Vector) const
+    {
+        // Product with already calculated inverse is cheaper than any term of the series
+        if(m_Series && !m_InverseCalculated)
+        {
+            auto aSum = t_Vector;
+            if(sumSeries(aSum) > 0)
+            {
+                return aSum;
+            }
+        }
+        return t_Vector * structuredValue();
+    }
+
+    bool CInterReflectance::isSeries() const
+    {
+        return m_Series;
+    }
+
+    size_t CInterReflectance::sumSeries(std::vector<double> & t_Sum) const
+    {
+        // Remainder after term m is term_m * (A + A^2 + ...) and its norm is therefore not
+        // greater than norm(term_m) * q / (1 - q)
+        const auto remainderFactor = m_Norm / (1 - m_Norm);
+        auto aTerm = t_Sum;
+        for(size_t m = 1; m <= MaxSeriesTerms; ++m)
+        {
+            aTerm = aTerm * m_LambdaRb;
+            aTerm = aTerm * m_LambdaRf;
+            addTerm(t_Sum, aTerm);
+            if(seriesNorm(aTerm) * remainderFactor <= m_Tolerance * seriesNorm(t_Sum))
+            {
+                return m;
+            }
+        }
+        return 0;
+    }
+
     //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //  CBSDFDoubleLayer
     //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    CBSDFDoubleLayer::CBSDFDoubleLayer(const CBSDFIntegrator & t_FrontLayer, const CBSDFIntegrator & t_BackLayer)
-    {
-        const SquareMatrix aLambda = t_FrontLayer.lambdaMatrix();
-        CInterReflectance InterRefl1 =
-          CInterReflectance(aLambda, t_FrontLayer.at(Side::Back, PropertySimple::R), t_BackLayer.at(Side::Front, PropertySimple::R));
-
-        CInterReflectance InterRefl2 =
-          CInterReflectance(aLambda, t_BackLayer.at(Side::Front, PropertySimple::R), t_FrontLayer.at(Side::Back, PropertySimple::R));
-
-        m_Tf =
-          equivalentT(t_BackLayer.at(Side::Front, PropertySimple::T), InterRefl1.value(), aLambda, t_FrontLayer.at(Side::Front, PropertySimple::T));
-        m_Tb =
-          equivalentT(t_FrontLayer.at(Side::Back, PropertySimple::T), InterRefl2.value(), aLambda, t_BackLayer.at(Side::Back, PropertySimple::T));
-        m_Rf = equivalentR(t_FrontLayer.at(Side::Front, PropertySimple::R),
-                           t_FrontLayer.at(Side::Front, PropertySimple::T),
-                           t_FrontLayer.at(Side::Back, PropertySimple::T),
-                           t_BackLayer.at(Side::Front, PropertySimple::R),
-                           InterRefl2.value(),
-                           aLambda);
-        m_Rb = equivalentR(t_BackLayer.at(Side::Back, PropertySimple::R),
-                           t_BackLayer.at(Side::Back, PropertySimple::T),
-                           t_BackLayer.at(Side::Front, PropertySimple::T),
-                           t_FrontLayer.at(Side::Back, PropertySimple::R),
-                           InterRefl1.value(),
-                           aLambda);
-
+    CBSDFDoubleLayer::CBSDFDoubleLayer(const CBSDFIntegrator & t_FrontLayer,
+                                       const CBSDFIntegrator & t_BackLayer)
+    {
         m_Results = std::make_shared<CBSDFIntegrator>(t_FrontLayer);
-        m_Results->setResultMatrices(m_Tf, m_Rf, Side::Front);
-        m_Results->setResultMatrices(m_Tb, m_Rb, Side::Back);
+        if(t_FrontLayer.isAxisymmetric() && t_BackLayer.isAxisymmetric())
+        {
+            composeAxisymmetric(t_FrontLayer, t_BackLayer);
+        }
+        else
+        {
+            composeStructured(t_FrontLayer, t_BackLayer);
+        }
+    }
+
+    void CBSDFDoubleLayer::composeAxisymmetric(const CBSDFIntegrator & t_FrontLayer, const CBSDFIntegrator & t_BackLayer)
+    {
+        const auto aLambda = t_FrontLayer.axisymmetricLambdaMatrix();
+        const auto & aRings = aLambda.ringSizes();
+
+        const auto & Tf1 = t_FrontLayer.axisymmetricAt(Side::Front, PropertySimple::T);
+        const auto & Tb1 = t_FrontLayer.axisymmetricAt(Side::Back, PropertySimple::T);
+        const auto & Rf1 = t_FrontLayer.axisymmetricAt(Side::Front, PropertySimple::R);
+        const auto & Rb1 = t_FrontLayer.axisymmetricAt(Side::Back, PropertySimple::R);
+        const auto & Tf2 = t_BackLayer.axisymmetricAt(Side::Front, PropertySimple::T);
+        const auto & Tb2 = t_BackLayer.axisymmetricAt(Side::Back, PropertySimple::T);
+        const auto & Rf2 = t_BackLayer.axisymmetricAt(Side::Front, PropertySimple::R);
+        const auto & Rb2 = t_BackLayer.axisymmetricAt(Side::Back, PropertySimple::R);
+
+        const AxisymmetricMatrix I(aRings, std::vector<double>(aRings.size(), 1));
+        const auto InterRefl1 = (I - aLambda * Rb1 * aLambda * Rf2).inverse();
+        const auto InterRefl2 = (I - aLambda * Rf2 * aLambda * Rb1).inverse();
+
+        const auto Tf2InterRefl = Tf2 * InterRefl1;
+        const auto Tb1InterRefl = Tb1 * InterRefl2;
+
+        m_Results->setResultMatrices(equivalentT(Tf2InterRefl, aLambda, Tf1),
+                                     equivalentR(Rf1, Tf1, Tb1InterRefl, Rf2, aLambda),
+                                     Side::Front);
+        m_Results->setResultMatrices(equivalentT(Tb1InterRefl, aLambda, Tb2),
+                                     equivalentR(Rb2, Tb2, Tf2InterRefl, Rb1, aLambda),
+                                     Side::Back);
+    }
+
+    void CBSDFDoubleLayer::composeStructured(const CBSDFIntegrator & t_FrontLayer,
+                                             const CBSDFIntegrator & t_BackLayer)
+    {
+        const auto aLambda = t_FrontLayer.structuredLambdaMatrix();
+
+        const auto Tf1 = t_FrontLayer.structuredAt(Side::Front, PropertySimple::T);
+        const auto Tb1 = t_FrontLayer.structuredAt(Side::Back, PropertySimple::T);
+        const auto Rf1 = t_FrontLayer.structuredAt(Side::Front, PropertySimple::R);
+        const auto Rb1 = t_FrontLayer.structuredAt(Side::Back, PropertySimple::R);
+        const auto Tf2 = t_BackLayer.structuredAt(Side::Front, PropertySimple::T);
+        const auto Tb2 = t_BackLayer.structuredAt(Side::Back, PropertySimple::T);
+        const auto Rf2 = t_BackLayer.structuredAt(Side::Front, PropertySimple::R);
+        const auto Rb2 = t_BackLayer.structuredAt(Side::Back, PropertySimple::R);
+
+        const CInterReflectance InterRefl1(aLambda, Rb1, Rf2);
+        const CInterReflectance InterRefl2(aLambda, Rf2, Rb1);
+
+        const auto Tf2InterRefl = InterRefl1.leftMultiply(Tf2);
+        const auto Tb1InterRefl = InterRefl2.leftMultiply(Tb1);
+
+        const auto aTf = equivalentT(Tf2InterRefl, aLambda, Tf1);
+        const auto aTb = equivalentT(Tb1InterRefl, aLambda, Tb2);
+        const auto aRf = equivalentR(Rf1, Tf1, Tb1InterRefl, Rf2, aLambda);
+        const auto aRb = equivalentR(Rb2, Tb2, Tf2InterRefl, Rb1, aLambda);
+
+        m_Results->setResultMatrices(aTf, aRf, Side::Front);
+        m_Results->setResultMatrices(aTb, aRb, Side::Back);
     }
 
     std::shared_ptr<CBSDFIntegrator> CBSDFDoubleLayer::value() const
@@ -68,27 +205,25 @@ namespace MultiLayerOptics
         return m_Results;
     }
 
-    SquareMatrix CBSDFDoubleLayer::equivalentT(const SquareMatrix & t_Tf2,
-                                               const SquareMatrix & t_InterRefl,
-                                               const SquareMatrix & t_Lambda,
-                                               const SquareMatrix & t_Tf1)
+    template<typename MatrixType>
+    MatrixType CBSDFDoubleLayer::equivalentT(const MatrixType & t_Tf2InterRefl,
+                                             const MatrixType & t_Lambda,
+                                             const MatrixType & t_Tf1)
     {
-        const auto TinterRefl = t_Tf2 * t_InterRefl;
         const auto lambdaTf1 = t_Lambda * t_Tf1;
-        return TinterRefl * lambdaTf1;
+        return t_Tf2InterRefl * lambdaTf1;
     }
 
-    SquareMatrix CBSDFDoubleLayer::equivalentR(const SquareMatrix & t_Rf1,
-                                               const SquareMatrix & t_Tf1,
-                                               const SquareMatrix & t_Tb1,
-                                               const SquareMatrix & t_Rf2,
-                                               const SquareMatrix & t_InterRefl,
-                                               const SquareMatrix & t_Lambda)
+    template<typename MatrixType>
+    MatrixType CBSDFDoubleLayer::equivalentR(const MatrixType & t_Rf1,
+                                             const MatrixType & t_Tf1,
+                                             const MatrixType & t_Tb1InterRefl,
+                                             const MatrixType & t_Rf2,
+                                             const MatrixType & t_Lambda)
     {
-        auto TinterRefl = t_Tb1 * t_InterRefl;
         const auto lambdaRf2 = t_Lambda * t_Rf2;
         const auto lambdaTf1 = t_Lambda * t_Tf1;
-        TinterRefl = TinterRefl * lambdaRf2;
+        auto TinterRefl = t_Tb1InterRefl * lambdaRf2;
         TinterRefl = TinterRefl * lambdaTf1;
         return t_Rf1 + TinterRefl;
     }
@@ -97,7 +232,11 @@ namespace MultiLayerOptics
     //  CEquivalentBSDFLayerSingleBand
     //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    CEquivalentBSDFLayerSingleBand::CEquivalentBSDFLayerSingleBand(const std::shared_ptr<CBSDFIntegrator> & t_Layer) : m_PropertiesCalculated(false)
+    CEquivalentBSDFLayerSingleBand::CEquivalentBSDFLayerSingleBand(const std::shared_ptr<CBSDFIntegrator> & t_Layer) :
+        m_PropertiesCalculated(false),
+        m_Lambda(t_Layer->structuredLambdaMatrix()),
+        m_InterReflectanceTolerance(0),
+        m_FloatStorage(false)
     {
         m_EquivalentLayer = std::make_shared<CBSDFIntegrator>(t_Layer);
         for(Side aSide : EnumSide())
@@ -105,13 +244,13 @@ namespace MultiLayerOptics
             m_A[aSide] = std::vector<std::vector<double>>();
         }
         m_Layers.push_back(t_Layer);
-        m_Lambda = t_Layer->lambdaMatrix();
     }
 
     SquareMatrix CEquivalentBSDFLayerSingleBand::getMatrix(const Side t_Side, const PropertySimple t_Property)
     {
         calcEquivalentProperties();
-        return m_EquivalentLayer->getMatrix(t_Side, t_Property);
+        // Copy is expanded from single precision storage without changing equivalent layer
+        return m_EquivalentLayer->matrix(t_Side, t_Property);
     }
 
     SquareMatrix CEquivalentBSDFLayerSingleBand::getProperty(const Side t_Side, const PropertySimple t_Property)
@@ -130,6 +269,47 @@ namespace MultiLayerOptics
         return m_Layers.size();
     }
 
+    void CEquivalentBSDFLayerSingleBand::setInterReflectanceTolerance(const double t_Tolerance)
+    {
+        m_InterReflectanceTolerance = t_Tolerance;
+        m_PropertiesCalculated = false;
+        for(Side aSide : EnumSide())
+        {
+            m_A.at(aSide).clear();
+        }
+    }
+
+    void CEquivalentBSDFLayerSingleBand::setFloatStorage(const bool t_FloatStorage)
+    {
+        m_FloatStorage = t_FloatStorage;
+        if(m_FloatStorage && m_PropertiesCalculated)
+        {
+            compactLayers();
+        }
+    }
+
+    bool CEquivalentBSDFLayerSingleBand::isComposed(
+      const std::shared_ptr<CBSDFIntegrator> & t_Layer) const
+    {
+        return std::find(m_Layers.begin(), m_Layers.end(), t_Layer) == m_Layers.end();
+    }
+
+    void CEquivalentBSDFLayerSingleBand::compactLayers()
+    {
+        // Equivalent layer is the last forward layer. First forward and last backward layers are
+        // added layers which are shared with the caller and are never compacted.
+        for(const auto & aLayers : {&m_Forward, &m_Backward})
+        {
+            for(const auto & aLayer : *aLayers)
+            {
+                if(isComposed(aLayer))
+                {
+                    aLayer->compact();
+                }
+            }
+        }
+    }
+
     void CEquivalentBSDFLayerSingleBand::addLayer(const std::shared_ptr<CBSDFIntegrator> & t_Layer)
     {
         m_Layers.push_back(t_Layer);
@@ -149,6 +329,8 @@ namespace MultiLayerOptics
         // Absorptance calculations need to observe every layer in isolation. For that purpose
         // code bellow will create m_Forward and m_Backward layers
         size_t size = m_Layers.size();
+        m_Forward.clear();
+        m_Backward.clear();
         m_EquivalentLayer = m_Layers[0];
         m_Forward.push_back(m_EquivalentLayer);
         for(size_t i = 1; i < size; ++i)
@@ -183,14 +365,10 @@ namespace MultiLayerOptics
             }
             else
             {
-                CBSDFIntegrator & Layer1 = *m_Backward[i + 1];
-                CBSDFIntegrator & Layer2 = *m_Forward[i];
-                CInterReflectance InterRefl2 =
-                  CInterReflectance(m_Lambda, Layer1.at(Side::Front, PropertySimple::R), Layer2.at(Side::Back, PropertySimple::R));
                 const std::vector<double> Ab = m_Layers[i]->Abs(Side::Back);
-                Ap1b = absTerm1(Ab, InterRefl2.value(), Layer1.getMatrix(Side::Back, PropertySimple::T));
-                Ap2f = absTerm2(
-                  Ab, InterRefl2.value(), Layer1.getMatrix(Side::Front, PropertySimple::R), Layer2.getMatrix(Side::Front, PropertySimple::T));
+                const auto aTerms = absorptanceTerms(Ab, *m_Backward[i + 1], *m_Forward[i], Side::Back);
+                Ap1b = aTerms.first;
+                Ap2f = aTerms.second;
             }
 
             if(i == 0)
@@ -200,14 +378,10 @@ namespace MultiLayerOptics
             }
             else
             {
-                CBSDFIntegrator & Layer1 = *m_Forward[i - 1];
-                CBSDFIntegrator & Layer2 = *m_Backward[i];
-                CInterReflectance InterRefl1 =
-                  CInterReflectance(m_Lambda, Layer1.at(Side::Back, PropertySimple::R), Layer2.at(Side::Front, PropertySimple::R));
-                std::vector<double> Af = m_Layers[i]->Abs(Side::Front);
-                Ap1f = absTerm1(Af, InterRefl1.value(), Layer1.at(Side::Front, PropertySimple::T));
-                Ap2b = absTerm2(
-                  Af, InterRefl1.value(), Layer1.at(Side::Back, PropertySimple::R), Layer2.at(Side::Back, PropertySimple::T));
+                const std::vector<double> Af = m_Layers[i]->Abs(Side::Front);
+                const auto aTerms = absorptanceTerms(Af, *m_Forward[i - 1], *m_Backward[i], Side::Front);
+                Ap1f = aTerms.first;
+                Ap2b = aTerms.second;
             }
 
             std::map<Side, std::vector<double>> aTotal;
@@ -226,27 +400,69 @@ namespace MultiLayerOptics
                 m_A.at(aSide).push_back(aTotal.at(aSide));
             }
         }
+        if(m_FloatStorage)
+        {
+            compactLayers();
+        }
         m_PropertiesCalculated = true;
     }
 
-    std::vector<double>
-      CEquivalentBSDFLayerSingleBand::absTerm1(const std::vector<double> & t_Alpha, const SquareMatrix & t_InterRefl, const SquareMatrix & t_T) const
+    std::pair<std::vector<double>, std::vector<double>>
+      CEquivalentBSDFLayerSingleBand::absorptanceTerms(const std::vector<double> & t_Alpha,
+                                                       const CBSDFIntegrator & t_Layer1,
+                                                       const CBSDFIntegrator & t_Layer2,
+                                                       const Side t_Side) const
     {
-        auto part1 = t_Alpha * t_InterRefl;
-        const auto part2 = m_Lambda * t_T;
-        part1 = part1 * part2;
-        return part1;
+        const auto oppSide = oppositeSide(t_Side);
+        if(t_Layer1.isAxisymmetric() && t_Layer2.isAxisymmetric())
+        {
+            const auto aLambda = t_Layer1.axisymmetricLambdaMatrix();
+            const auto & aRings = aLambda.ringSizes();
+            const AxisymmetricMatrix I(aRings, std::vector<double>(aRings.size(), 1));
+            const auto interRefl = (I
+                                    - aLambda * t_Layer1.axisymmetricAt(oppSide, PropertySimple::R)
+                                        * aLambda * t_Layer2.axisymmetricAt(t_Side, PropertySimple::R))
+                                     .inverse();
+            const auto alphaInterRefl = t_Alpha * interRefl;
+            return std::make_pair(
+              absTerm1(alphaInterRefl, aLambda, t_Layer1.axisymmetricAt(t_Side, PropertySimple::T)),
+              absTerm2(alphaInterRefl,
+                       aLambda,
+                       t_Layer1.axisymmetricAt(oppSide, PropertySimple::R),
+                       t_Layer2.axisymmetricAt(oppSide, PropertySimple::T)));
+        }
+
+        const CInterReflectance interRefl(m_Lambda,
+                                          t_Layer1.structuredAt(oppSide, PropertySimple::R),
+                                          t_Layer2.structuredAt(t_Side, PropertySimple::R),
+                                          m_InterReflectanceTolerance);
+        const auto alphaInterRefl = interRefl.leftMultiply(t_Alpha);
+        return std::make_pair(
+          absTerm1(alphaInterRefl, m_Lambda, t_Layer1.structuredAt(t_Side, PropertySimple::T)),
+          absTerm2(alphaInterRefl,
+                   m_Lambda,
+                   t_Layer1.structuredAt(oppSide, PropertySimple::R),
+                   t_Layer2.structuredAt(oppSide, PropertySimple::T)));
+    }
+
+    template<typename MatrixType>
+    std::vector<double> CEquivalentBSDFLayerSingleBand::absTerm1(const std::vector<double> & t_AlphaInterRefl,
+                                                                 const MatrixType & t_Lambda,
+                                                                 const MatrixType & t_T)
+    {
+        const auto part2 = t_Lambda * t_T;
+        return t_AlphaInterRefl * part2;
     }
 
-    std::vector<double> CEquivalentBSDFLayerSingleBand::absTerm2(const std::vector<double> & t_Alpha,
-                                                                 const SquareMatrix & t_InterRefl,
-                                                                 const SquareMatrix & t_R,
-                                                                 const SquareMatrix & t_T) const
+    template<typename MatrixType>
+    std::vector<double> CEquivalentBSDFLayerSingleBand::absTerm2(const std::vector<double> & t_AlphaInterRefl,
+                                                                 const MatrixType & t_Lambda,
+                                                                 const MatrixType & t_R,
+                                                                 const MatrixType & t_T)
     {
-        auto part1 = t_Alpha * t_InterRefl;
-        const auto part2 = m_Lambda * t_R;
-        const auto part3 = m_Lambda * t_T;
-        part1 = part1 * part2;
+        const auto part2 = t_Lambda * t_R;
+        const auto part3 = t_Lambda * t_T;
+        auto part1 = t_AlphaInterRefl * part2;
         part1 = part1 * part3;
         return part1;
     }
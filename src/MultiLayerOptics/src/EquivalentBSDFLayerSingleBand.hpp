@@ -25,11 +25,45 @@ namespace MultiLayerOptics {
 		                   const FenestrationCommon::SquareMatrix& t_Rb,
 		                   const FenestrationCommon::SquareMatrix& t_Rf );
 
-            FenestrationCommon::SquareMatrix value() const;
+		// Inverse is calculated element by element when both reflectances are diagonal and with
+		// Sherman-Morrison-Woodbury formula when they are diagonal plus low rank.
+		//
+		// With non zero tolerance and dense reflectances, products of vectors with interreflectance
+		// are calculated as truncated series I + A + A^2 + ... (A = Lambda * Rb * Lambda * Rf)
+		// until a-posteriori bound of the remainder, relative to the sum, drops below tolerance.
+		// Every term costs two vector-matrix products (O(n^2)) while inverse costs O(n^3), so
+		// series pays off as long as it converges in far less than n terms. Series is used only
+		// if it converges (norm of A is smaller than one) and inverse has not been calculated.
+		// Products of matrices always use inverse since every matrix term costs two dense matrix
+		// products, which is more than inverse itself.
+		CInterReflectance( const FenestrationCommon::StructuredMatrix& t_Lambda,
+		                   const FenestrationCommon::StructuredMatrix& t_Rb,
+		                   const FenestrationCommon::StructuredMatrix& t_Rf,
+		                   double t_Tolerance = 0 );
+
+		FenestrationCommon::SquareMatrix value() const;
+		const FenestrationCommon::StructuredMatrix& structuredValue() const;
+
+		// t_Matrix * (I - Lambda * Rb * Lambda * Rf)^-1
+		FenestrationCommon::StructuredMatrix leftMultiply( const FenestrationCommon::StructuredMatrix& t_Matrix ) const;
+		std::vector< double > leftMultiply( const std::vector< double >& t_Vector ) const;
+
+		bool isSeries() const;
 
 	private:
-		FenestrationCommon::SquareMatrix m_InterRefl;
-
+		// Returns number of terms (without identity) needed to reach tolerance or zero if
+		// series did not converge within maximum number of terms
+		size_t sumSeries( std::vector< double >& t_Sum ) const;
+
+		FenestrationCommon::StructuredMatrix m_LambdaRb;
+		FenestrationCommon::StructuredMatrix m_LambdaRf;
+		double m_Tolerance;
+		// Upper bound of norm of Lambda * Rb * Lambda * Rf
+		double m_Norm;
+		bool m_Series;
+
+		mutable bool m_InverseCalculated;
+		mutable FenestrationCommon::StructuredMatrix m_InterRefl;
 	};
 
 	// Class to calculate equivalent BSDF transmittance and reflectances. This will be used by
@@ -42,26 +76,28 @@ namespace MultiLayerOptics {
 		std::shared_ptr< SingleLayerOptics::CBSDFIntegrator > value() const;
 
 	private:
-            static FenestrationCommon::SquareMatrix equivalentT(
-                const FenestrationCommon::SquareMatrix & t_Tf2,
-                const FenestrationCommon::SquareMatrix & t_InterRefl,
-                const FenestrationCommon::SquareMatrix & t_Lambda,
-                const FenestrationCommon::SquareMatrix & t_Tf1);
-
-            static FenestrationCommon::SquareMatrix equivalentR(
-                const FenestrationCommon::SquareMatrix & t_Rf1,
-                const FenestrationCommon::SquareMatrix & t_Tf1,
-                const FenestrationCommon::SquareMatrix & t_Tb1,
-                const FenestrationCommon::SquareMatrix & t_Rf2,
-                const FenestrationCommon::SquareMatrix & t_InterRefl,
-                const FenestrationCommon::SquareMatrix & t_Lambda);
+		// Layers are composed either per ring (both layers are axisymmetric) or with structure
+		// aware (diagonal or dense) full matrices
+		void composeAxisymmetric( const SingleLayerOptics::CBSDFIntegrator& t_FrontLayer,
+		                         const SingleLayerOptics::CBSDFIntegrator& t_BackLayer );
+		void composeStructured( const SingleLayerOptics::CBSDFIntegrator& t_FrontLayer,
+		                       const SingleLayerOptics::CBSDFIntegrator& t_BackLayer );
+
+		// Transmittance of the second layer is already multiplied with interreflectance
+		// (t_TInterRefl). It is shared between transmittance and reflectance.
+		template< typename MatrixType >
+		static MatrixType equivalentT( const MatrixType& t_Tf2InterRefl,
+		                               const MatrixType& t_Lambda,
+		                               const MatrixType& t_Tf1 );
+
+		template< typename MatrixType >
+		static MatrixType equivalentR( const MatrixType& t_Rf1,
+		                               const MatrixType& t_Tf1,
+		                               const MatrixType& t_Tb1InterRefl,
+		                               const MatrixType& t_Rf2,
+		                               const MatrixType& t_Lambda );
 
 		std::shared_ptr< SingleLayerOptics::CBSDFIntegrator > m_Results;
-
-		FenestrationCommon::SquareMatrix m_Tf;
-		FenestrationCommon::SquareMatrix m_Tb;
-		FenestrationCommon::SquareMatrix m_Rf;
-		FenestrationCommon::SquareMatrix m_Rb;
 	};
 
 	// Class for equivalent BSDF layer for single material properties (or single wavelength)
@@ -70,28 +106,50 @@ namespace MultiLayerOptics {
 		explicit CEquivalentBSDFLayerSingleBand( const std::shared_ptr< SingleLayerOptics::CBSDFIntegrator >& t_Layer );
 		void addLayer( const std::shared_ptr< SingleLayerOptics::CBSDFIntegrator >& t_Layer );
 
-            FenestrationCommon::SquareMatrix getMatrix(FenestrationCommon::Side t_Side,
-                                                       FenestrationCommon::PropertySimple t_Property);
+		FenestrationCommon::SquareMatrix getMatrix( FenestrationCommon::Side t_Side,
+		                                            FenestrationCommon::PropertySimple t_Property );
 
-            FenestrationCommon::SquareMatrix getProperty(FenestrationCommon::Side t_Side,
-                                                         FenestrationCommon::PropertySimple t_Property);
+		FenestrationCommon::SquareMatrix getProperty( FenestrationCommon::Side t_Side,
+		                                              FenestrationCommon::PropertySimple t_Property );
 
-            std::vector<double> getLayerAbsorptances(size_t Index,
-                                                     FenestrationCommon::Side t_Side);
+		std::vector< double > getLayerAbsorptances( size_t Index, FenestrationCommon::Side t_Side );
 
 		size_t getNumberOfLayers() const;
 
-	private:
-		void calcEquivalentProperties();
+		// Interreflectances used for layer absorptances are calculated as truncated series
+		// (see CInterReflectance)
+		void setInterReflectanceTolerance( double t_Tolerance );
 
-            std::vector<double> absTerm1(const std::vector<double> & t_Alpha,
-                                         const FenestrationCommon::SquareMatrix & t_InterRefl,
-                                         const FenestrationCommon::SquareMatrix & t_T) const;
+		// Intermediate (forward and backward) layers and equivalent layer are compacted once they
+		// are composed (see CBSDFIntegrator::compact). Added layers are not changed.
+		void setFloatStorage( bool t_FloatStorage );
 
-            std::vector<double> absTerm2(const std::vector<double> & t_Alpha,
-                                         const FenestrationCommon::SquareMatrix & t_InterRefl,
-                                         const FenestrationCommon::SquareMatrix & t_R,
-                                         const FenestrationCommon::SquareMatrix & t_T) const;
+	private:
+		void calcEquivalentProperties();
+		void compactLayers();
+		// True for layers created by composition (not added to this object)
+		bool isComposed( const std::shared_ptr< SingleLayerOptics::CBSDFIntegrator >& t_Layer ) const;
+
+		// Absorptance of the layer which is seen through t_Layer1 from given side (first) and
+		// absorptance after reflection from t_Layer1 of radiation transmitted through t_Layer2
+		// (second)
+		std::pair< std::vector< double >, std::vector< double > >
+		absorptanceTerms( const std::vector< double >& t_Alpha,
+		                  const SingleLayerOptics::CBSDFIntegrator& t_Layer1,
+		                  const SingleLayerOptics::CBSDFIntegrator& t_Layer2,
+		                  FenestrationCommon::Side t_Side ) const;
+
+		// Absorptance is already multiplied with interreflectance (t_AlphaInterRefl)
+		template< typename MatrixType >
+		static std::vector< double > absTerm1( const std::vector< double >& t_AlphaInterRefl,
+		                                       const MatrixType& t_Lambda,
+		                                       const MatrixType& t_T );
+
+		template< typename MatrixType >
+		static std::vector< double > absTerm2( const std::vector< double >& t_AlphaInterRefl,
+		                                       const MatrixType& t_Lambda,
+		                                       const MatrixType& t_R,
+		                                       const MatrixType& t_T );
 
 		std::shared_ptr< SingleLayerOptics::CBSDFIntegrator > m_EquivalentLayer;
 		std::vector< std::shared_ptr< SingleLayerOptics::CBSDFIntegrator > > m_Layers;
@@ -106,7 +164,9 @@ namespace MultiLayerOptics {
 
 		bool m_PropertiesCalculated;
 
-		FenestrationCommon::SquareMatrix m_Lambda;
+		FenestrationCommon::StructuredMatrix m_Lambda;
+		double m_InterReflectanceTolerance;
+		bool m_FloatStorage;
 	};
 
 }
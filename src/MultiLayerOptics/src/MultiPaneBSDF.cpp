@@ -20,13 +20,15 @@ namespace MultiLayerOptics
       const FenestrationCommon::CSeries & t_DetectorData,
       const std::vector<double> & t_CommonWavelengths) :
         m_Layer(t_CommonWavelengths, t_Layer[0]),
-        m_Results(
-          std::make_shared<CBSDFIntegrator>(t_Layer[0]->getDirections(BSDFDirection::Incoming))),
+        m_Results(std::make_shared<CBSDFIntegrator>(
+          t_Layer[0]->getSharedDirections(BSDFDirection::Incoming))),
         m_Calculated(false),
         m_MinLambdaCalculated(0),
         m_MaxLambdaCalculated(0),
         m_Integrator(IntegrationType::Trapezoidal),
-        m_NormalizationCoefficient(1)
+        m_NormalizationCoefficient(1),
+        m_MinLambda(t_Layer[0]->getCell()->getMinLambda()),
+        m_MaxLambda(t_Layer[0]->getCell()->getMaxLambda())
     {
         initialize(t_Layer, t_SolarRadiation, t_DetectorData);
     }
@@ -36,13 +38,15 @@ namespace MultiLayerOptics
       const FenestrationCommon::CSeries & t_SolarRadiation,
       const std::vector<double> & t_CommonWavelengths) :
         m_Layer(t_CommonWavelengths, t_Layer[0]),
-        m_Results(
-          std::make_shared<CBSDFIntegrator>(t_Layer[0]->getDirections(BSDFDirection::Incoming))),
+        m_Results(std::make_shared<CBSDFIntegrator>(
+          t_Layer[0]->getSharedDirections(BSDFDirection::Incoming))),
         m_Calculated(false),
         m_MinLambdaCalculated(0),
         m_MaxLambdaCalculated(0),
         m_Integrator(IntegrationType::Trapezoidal),
-        m_NormalizationCoefficient(1)
+        m_NormalizationCoefficient(1),
+        m_MinLambda(t_Layer[0]->getCell()->getMinLambda()),
+        m_MaxLambda(t_Layer[0]->getCell()->getMaxLambda())
     {
         initialize(t_Layer, t_SolarRadiation);
     }
@@ -59,12 +63,15 @@ namespace MultiLayerOptics
             solarRadiation = solarRadiation * t_DetectorData.interpolate(commonWavelengths);
         }
         m_SolarRadiationInit = solarRadiation;
+        m_DetectorData = t_DetectorData;
+        m_SolarRadiation = t_SolarRadiation;
         for(Side aSide : EnumSide())
         {
             this->m_AbsHem[aSide] = std::make_shared<std::vector<double>>();
         }
 
-        // This will initialize layer material data with given spectral distribution
+        // This will initialize layer material data with given spectral distribution. Since it
+        // includes detector, bands are merged with source and detector weights as well.
         this->m_Layer.setSolarRadiation(this->m_SolarRadiationInit);
 
         size_t directionsSize = t_Layer[0]->getDirections(BSDFDirection::Incoming).size();
@@ -135,15 +142,24 @@ namespace MultiLayerOptics
         if(!m_Calculated || minLambda != m_MinLambdaCalculated
            || maxLambda != m_MaxLambdaCalculated)
         {
+            WCE_SCOPED_TIMER("CMultiPaneBSDF::calculate");
             m_IncomingSolar.clear();
 
-            for(CSeries & aSpectra : *m_IncomingSpectra)
+            // Equivalent layer is composed only at wavelengths needed for the range
+            const auto lowLambda = isRangeLocal() ? minLambda : 0;
+            const auto highLambda = isRangeLocal() ? maxLambda : 0;
+            const auto wavelengths = m_Layer.getCommonWavelengths(lowLambda, highLambda);
+
+            std::vector<CSeries> aIncomingSpectra;
+            aIncomingSpectra.reserve(m_IncomingSpectra->size());
+            for(const CSeries & aSpectra : *m_IncomingSpectra)
             {
                 // each incoming spectra must be intepolated to same wavelengths as this IGU is
                 // using
-                aSpectra = aSpectra.interpolate(m_Layer.getCommonWavelengths());
+                aIncomingSpectra.push_back(aSpectra.interpolate(wavelengths));
 
-                CSeries iTotalSolar = *aSpectra.integrate(m_Integrator, m_NormalizationCoefficient);
+                CSeries iTotalSolar =
+                  *aIncomingSpectra.back().integrate(m_Integrator, m_NormalizationCoefficient);
                 m_IncomingSolar.push_back(iTotalSolar.sum(minLambda, maxLambda));
             }
 
@@ -154,16 +170,17 @@ namespace MultiLayerOptics
             {
                 // It is important to take a copy of aTotalA because it will be used to
                 // multiply and integrate later and local values will change
-                CMatrixSeries aTotalA = *m_Layer.getTotalA(aSide);
-                aTotalA.mMult(*m_IncomingSpectra);
+                CMatrixSeries aTotalA = *m_Layer.getTotalA(lowLambda, highLambda, aSide);
+                aTotalA.mMult(aIncomingSpectra);
                 aTotalA.integrate(m_Integrator, m_NormalizationCoefficient);
                 m_Abs[aSide] = aTotalA.getSums(minLambda, maxLambda, m_IncomingSolar);
                 for(PropertySimple aProprerty : EnumPropertySimple())
                 {
                     // Same as for aTotalA. Copy need to be taken because of multiplication
                     // and integration
-                    CMatrixSeries aTot = *m_Layer.getTotal(aSide, aProprerty);
-                    aTot.mMult(*m_IncomingSpectra);
+                    CMatrixSeries aTot =
+                      *m_Layer.getTotal(lowLambda, highLambda, aSide, aProprerty);
+                    aTot.mMult(aIncomingSpectra);
                     aTot.integrate(m_Integrator, m_NormalizationCoefficient);
                     aResults[std::make_pair(aSide, aProprerty)] =
                       aTot.getSquaredMatrixSums(minLambda, maxLambda, m_IncomingSolar);
@@ -187,6 +204,15 @@ namespace MultiLayerOptics
         }
     }
 
+    bool CMultiPaneBSDF::isRangeLocal() const
+    {
+        // TrapezoidalA and TrapezoidalB add contributions at the ends of the spectrum and
+        // PreWeighted does not use wavelengths. These need whole spectrum regardless of range.
+        return m_Integrator == IntegrationType::Rectangular
+               || m_Integrator == IntegrationType::RectangularCentroid
+               || m_Integrator == IntegrationType::Trapezoidal;
+    }
+
     void CMultiPaneBSDF::calcHemisphericalAbs(const Side t_Side)
     {
         using ConstantsData::WCE_PI;
@@ -245,6 +271,194 @@ namespace MultiLayerOptics
         return DirHem(minLambda, maxLambda, t_Side, t_Property)[Index];
     }
 
+    std::vector<double> CMultiPaneBSDF::DirHem(const double minLambda,
+                                               const double maxLambda,
+                                               const Side t_Side,
+                                               const PropertySimple t_Property,
+                                               const double t_Theta,
+                                               const double t_Phi,
+                                               const std::vector<CSeries> & t_Sources)
+    {
+        const auto lowLambda = isRangeLocal() ? minLambda : 0;
+        const auto highLambda = isRangeLocal() ? maxLambda : 0;
+        const auto wavelengths = m_Layer.getCommonWavelengths(lowLambda, highLambda);
+
+        std::vector<CSeries> aWeights;
+        aWeights.reserve(t_Sources.size());
+        for(const auto & source : t_Sources)
+        {
+            auto aSource = source.interpolate(wavelengths);
+            if(m_DetectorData.size() > 0)
+            {
+                aSource = aSource * m_DetectorData.interpolate(wavelengths);
+            }
+            aWeights.push_back(aSource);
+        }
+
+        const auto aIndex = m_Results->getNearestBeamIndex(t_Theta, t_Phi);
+        return integrateProperty(minLambda,
+                                 maxLambda,
+                                 spectralDirHem(minLambda, maxLambda, t_Side, t_Property, aIndex),
+                                 aWeights);
+    }
+
+    double CMultiPaneBSDF::getPropertySimple(const PropertySimple t_Property,
+                                             const Side t_Side,
+                                             const Scattering t_Scattering,
+                                             const double t_Theta,
+                                             const double t_Phi)
+    {
+        double result{0};
+        switch(t_Scattering)
+        {
+            case Scattering::DirectDirect:
+                result =
+                  DirDir(getMinLambda(), getMaxLambda(), t_Side, t_Property, t_Theta, t_Phi);
+                break;
+            case Scattering::DirectDiffuse:
+                result =
+                  DirHem(getMinLambda(), getMaxLambda(), t_Side, t_Property, t_Theta, t_Phi)
+                  - DirDir(getMinLambda(), getMaxLambda(), t_Side, t_Property, t_Theta, t_Phi);
+                break;
+            case Scattering::DiffuseDiffuse:
+                result = DiffDiff(getMinLambda(), getMaxLambda(), t_Side, t_Property);
+                break;
+        }
+        return result;
+    }
+
+    std::vector<double>
+      CMultiPaneBSDF::getPropertiesSimple(const PropertySimple t_Property,
+                                          const Side t_Side,
+                                          const Scattering t_Scattering,
+                                          const std::vector<CSeries> & t_Detectors,
+                                          const double t_Theta,
+                                          const double t_Phi)
+    {
+        const auto lowLambda = isRangeLocal() ? getMinLambda() : 0;
+        const auto highLambda = isRangeLocal() ? getMaxLambda() : 0;
+        const auto wavelengths = m_Layer.getCommonWavelengths(lowLambda, highLambda);
+
+        std::vector<CSeries> aWeights;
+        aWeights.reserve(t_Detectors.size());
+        for(const auto & detector : t_Detectors)
+        {
+            auto aSource = m_SolarRadiation.interpolate(wavelengths);
+            if(detector.size() > 0)
+            {
+                aSource = aSource * detector.interpolate(wavelengths);
+            }
+            aWeights.push_back(aSource);
+        }
+
+        const auto aIndex = m_Results->getNearestBeamIndex(t_Theta, t_Phi);
+        return integrateProperty(
+          getMinLambda(),
+          getMaxLambda(),
+          spectralProperty(
+            getMinLambda(), getMaxLambda(), t_Side, t_Property, t_Scattering, aIndex),
+          aWeights);
+    }
+
+    std::vector<double> CMultiPaneBSDF::getWavelengths() const
+    {
+        return m_Layer.getCommonWavelengths();
+    }
+
+    double CMultiPaneBSDF::getMinLambda() const
+    {
+        return m_MinLambda;
+    }
+
+    double CMultiPaneBSDF::getMaxLambda() const
+    {
+        return m_MaxLambda;
+    }
+
+    std::vector<double> CMultiPaneBSDF::spectralProperty(const double minLambda,
+                                                         const double maxLambda,
+                                                         const Side t_Side,
+                                                         const PropertySimple t_Property,
+                                                         const Scattering t_Scattering,
+                                                         const size_t t_Index)
+    {
+        using ConstantsData::WCE_PI;
+        const auto lowLambda = isRangeLocal() ? minLambda : 0;
+        const auto highLambda = isRangeLocal() ? maxLambda : 0;
+        auto & aTot = *m_Layer.getTotal(lowLambda, highLambda, t_Side, t_Property);
+        const auto & aLambdas = m_Results->lambdaVector();
+        const auto size = aTot[t_Index][t_Index].size();
+
+        std::vector<double> result(size, 0);
+        switch(t_Scattering)
+        {
+            case Scattering::DirectDirect:
+                for(size_t k = 0; k < size; ++k)
+                {
+                    result[k] = aLambdas[t_Index] * aTot[t_Index][t_Index][k].value();
+                }
+                break;
+            case Scattering::DirectDiffuse:
+                result = spectralDirHem(minLambda, maxLambda, t_Side, t_Property, t_Index);
+                for(size_t k = 0; k < size; ++k)
+                {
+                    result[k] -= aLambdas[t_Index] * aTot[t_Index][t_Index][k].value();
+                }
+                break;
+            case Scattering::DiffuseDiffuse:
+                for(size_t i = 0; i < aLambdas.size(); ++i)
+                {
+                    for(size_t j = 0; j < aLambdas.size(); ++j)
+                    {
+                        const auto & aSeries = aTot[i][j];
+                        const auto lambda = aLambdas[i] * aLambdas[j] / WCE_PI;
+                        for(size_t k = 0; k < size; ++k)
+                        {
+                            result[k] += lambda * aSeries[k].value();
+                        }
+                    }
+                }
+                break;
+        }
+
+        return result;
+    }
+
+    std::vector<double> CMultiPaneBSDF::spectralDirHem(const double minLambda,
+                                                       const double maxLambda,
+                                                       const Side t_Side,
+                                                       const PropertySimple t_Property,
+                                                       const size_t t_Index)
+    {
+        const auto lowLambda = isRangeLocal() ? minLambda : 0;
+        const auto highLambda = isRangeLocal() ? maxLambda : 0;
+        auto & aTot = *m_Layer.getTotal(lowLambda, highLambda, t_Side, t_Property);
+        const auto & aLambdas = m_Results->lambdaVector();
+
+        std::vector<double> result(aTot[t_Index][t_Index].size(), 0);
+        for(size_t i = 0; i < aLambdas.size(); ++i)
+        {
+            const auto & aSeries = aTot[i][t_Index];
+            for(size_t k = 0; k < result.size(); ++k)
+            {
+                result[k] += aLambdas[i] * aSeries[k].value();
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<double>
+      CMultiPaneBSDF::integrateProperty(const double minLambda,
+                                        const double maxLambda,
+                                        const std::vector<double> & t_Property,
+                                        const std::vector<CSeries> & t_Weights) const
+    {
+        const CSpectralWeights aSpectralWeights(
+          t_Weights, m_Integrator, m_NormalizationCoefficient, minLambda, maxLambda);
+        return aSpectralWeights.average(t_Property);
+    }
+
     double CMultiPaneBSDF::Abs(const double minLambda,
                                const double maxLambda,
                                const Side t_Side,
@@ -316,6 +530,7 @@ namespace MultiLayerOptics
     {
         m_NormalizationCoefficient = normalizationCoefficient;
         m_Integrator = t_type;
+        m_Calculated = false;
     }
 
     void CMultiPaneBSDF::addLayer(const std::shared_ptr<SingleLayerOptics::CBSDFLayer> & t_Layer)
@@ -324,6 +539,34 @@ namespace MultiLayerOptics
         m_Layer.setSolarRadiation(m_SolarRadiationInit);
     }
 
+    void CMultiPaneBSDF::setSpectralTolerance(const double t_Tolerance)
+    {
+        m_Layer.setSpectralTolerance(t_Tolerance);
+        m_Calculated = false;
+    }
+
+    void CMultiPaneBSDF::setInterReflectanceTolerance(const double t_Tolerance)
+    {
+        m_Layer.setInterReflectanceTolerance(t_Tolerance);
+        m_Calculated = false;
+    }
+
+    void CMultiPaneBSDF::setFloatStorage(const bool t_FloatStorage)
+    {
+        m_Layer.setFloatStorage(t_FloatStorage);
+        m_Calculated = false;
+    }
+
+    size_t CMultiPaneBSDF::getNumberOfSpectralBands()
+    {
+        return m_Layer.getNumberOfBands();
+    }
+
+    double CMultiPaneBSDF::getSpectralBandError()
+    {
+        return m_Layer.getBandError();
+    }
+
     std::unique_ptr<CMultiPaneBSDF>
       CMultiPaneBSDF::create(const std::shared_ptr<SingleLayerOptics::CBSDFLayer> & t_Layer,
                              const FenestrationCommon::CSeries & t_SolarRadiation,
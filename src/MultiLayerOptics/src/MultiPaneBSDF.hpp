@@ -5,6 +5,7 @@
 #include <vector>
 #include <map>
 #include <WCECommon.hpp>
+#include <WCESingleLayerOptics.hpp>
 
 #include "EquivalentBSDFLayer.hpp"
 
@@ -16,6 +17,7 @@ namespace FenestrationCommon
 
     enum class Side;
     enum class PropertySimple;
+    enum class Scattering;
 
 }   // namespace FenestrationCommon
 
@@ -30,7 +32,7 @@ namespace MultiLayerOptics
 
     typedef std::shared_ptr<std::vector<FenestrationCommon::CSeries>> p_VectorSeries;
 
-    class CMultiPaneBSDF
+    class CMultiPaneBSDF : public SingleLayerOptics::IMultiDetectorScatteringLayer
     {
     public:
         static std::unique_ptr<CMultiPaneBSDF>
@@ -78,6 +80,22 @@ namespace MultiLayerOptics
 
         void addLayer(const std::shared_ptr<SingleLayerOptics::CBSDFLayer> & t_Layer);
 
+        // Merges wavelengths into bands in which multilayer properties do not change more than
+        // given tolerance (see CEquivalentBSDFLayer::setSpectralTolerance). Wavelengths are
+        // weighted with solar radiation multiplied with detector data.
+        void setSpectralTolerance(double t_Tolerance);
+        size_t getNumberOfSpectralBands();
+        // See CEquivalentBSDFLayer::getBandError
+        double getSpectralBandError();
+
+        // Interreflectances for layer absorptances are calculated as truncated series with given
+        // relative tolerance (see CEquivalentBSDFLayer::setInterReflectanceTolerance)
+        void setInterReflectanceTolerance(double t_Tolerance);
+
+        // Per-wavelength BSDF matrices are stored in single precision
+        // (see CEquivalentBSDFLayer::setFloatStorage)
+        void setFloatStorage(bool t_FloatStorage);
+
         // Whole matrix results
         FenestrationCommon::SquareMatrix getMatrix(double minLambda,
                                                    double maxLambda,
@@ -123,6 +141,39 @@ namespace MultiLayerOptics
                       FenestrationCommon::PropertySimple t_Property,
                       size_t Index);
 
+        // Directional hemispherical results for each of given sources (instead of solar radiation
+        // that is used for the layer). Equivalent layer is not recalculated; results for all
+        // sources are obtained from single weight matrix product.
+        std::vector<double> DirHem(double minLambda,
+                                   double maxLambda,
+                                   FenestrationCommon::Side t_Side,
+                                   FenestrationCommon::PropertySimple t_Property,
+                                   double t_Theta,
+                                   double t_Phi,
+                                   const std::vector<FenestrationCommon::CSeries> & t_Sources);
+
+        // Properties over whole wavelength range of the layer (see getMinLambda and
+        // getMaxLambda). Direct diffuse is directional hemispherical without direct direct part.
+        double getPropertySimple(FenestrationCommon::PropertySimple t_Property,
+                                 FenestrationCommon::Side t_Side,
+                                 FenestrationCommon::Scattering t_Scattering,
+                                 double t_Theta = 0,
+                                 double t_Phi = 0) override;
+
+        // Same as above for each of given detectors. Solar radiation is multiplied with each
+        // detector instead of detector data given at creation.
+        std::vector<double>
+          getPropertiesSimple(FenestrationCommon::PropertySimple t_Property,
+                              FenestrationCommon::Side t_Side,
+                              FenestrationCommon::Scattering t_Scattering,
+                              const std::vector<FenestrationCommon::CSeries> & t_Detectors,
+                              double t_Theta = 0,
+                              double t_Phi = 0) override;
+
+        std::vector<double> getWavelengths() const override;
+        double getMinLambda() const override;
+        double getMaxLambda() const override;
+
         double Abs(double minLambda,
                    double maxLambda,
                    FenestrationCommon::Side t_Side,
@@ -186,12 +237,41 @@ namespace MultiLayerOptics
 
         void calculate(double minLambda, double maxLambda);
 
+        // True if integration over wavelength range needs only wavelengths inside of the range
+        bool isRangeLocal() const;
+
         void calcHemisphericalAbs(FenestrationCommon::Side t_Side);
 
+        // Property at each common wavelength in range for incoming direction with given index
+        std::vector<double> spectralProperty(double minLambda,
+                                             double maxLambda,
+                                             FenestrationCommon::Side t_Side,
+                                             FenestrationCommon::PropertySimple t_Property,
+                                             FenestrationCommon::Scattering t_Scattering,
+                                             size_t t_Index);
+
+        // Directional hemispherical property at each common wavelength in range
+        std::vector<double> spectralDirHem(double minLambda,
+                                           double maxLambda,
+                                           FenestrationCommon::Side t_Side,
+                                           FenestrationCommon::PropertySimple t_Property,
+                                           size_t t_Index);
+
+        // Spectral property averaged with each of weighting functions (source and detector
+        // products)
+        std::vector<double>
+          integrateProperty(double minLambda,
+                            double maxLambda,
+                            const std::vector<double> & t_Property,
+                            const std::vector<FenestrationCommon::CSeries> & t_Weights) const;
+
         CEquivalentBSDFLayer m_Layer;
 
         // Solar radiation for initialization
         FenestrationCommon::CSeries m_SolarRadiationInit;
+        FenestrationCommon::CSeries m_DetectorData;
+        // Solar radiation without detector data. Used as source for multiple detectors.
+        FenestrationCommon::CSeries m_SolarRadiation;
 
         p_VectorSeries m_IncomingSpectra;
         std::vector<double> m_IncomingSolar;
@@ -209,6 +289,9 @@ namespace MultiLayerOptics
 
         FenestrationCommon::IntegrationType m_Integrator;
         double m_NormalizationCoefficient;
+
+        double m_MinLambda;
+        double m_MaxLambda;
     };
 
 }   // namespace MultiLayerOptics
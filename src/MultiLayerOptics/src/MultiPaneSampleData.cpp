@@ -18,6 +18,7 @@ namespace MultiLayerOptics
     std::vector<double> CMultiPaneSampleData::getWavelengths() const
     {
         CCommonWavelengths aWavelengths;
+        aWavelengths.setTolerance(ConstantsData::wavelengthTolerance);
 
         for(auto it = m_MeasuredSamples.begin(); it < m_MeasuredSamples.end(); ++it)
         {
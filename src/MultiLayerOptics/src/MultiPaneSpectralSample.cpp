@@ -75,7 +75,7 @@ namespace MultiLayerOptics
         CSeries aAbs = t_Absorptances;
         if(m_WavelengthSet != WavelengthSet::Data)
         {
-            aAbs = aAbs.interpolate(m_Wavelengths);
+            aAbs = aAbs.interpolate(m_WavelengthGrid);
         }
         aAbs = aAbs * m_IncomingSource;
         aAbs = *aAbs.integrate(m_IntegrationType, m_NormalizationCoefficient);
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <cmath>
 #include <utility>
+#include <stdexcept>
 
 #include "MultiPaneSpecular.hpp"
 #include "WCESingleLayerOptics.hpp"
@@ -61,6 +62,7 @@ namespace MultiLayerOptics
         m_DetectorData(t_DetectorData)
     {
         CCommonWavelengths aCommonWL;
+        aCommonWL.setTolerance(ConstantsData::wavelengthTolerance);
         for(auto & layer : m_Layers)
         {
             aCommonWL.addWavelength(layer->getBandWavelengths());
@@ -69,12 +71,13 @@ namespace MultiLayerOptics
         // Finds combination of two wavelength sets without going outside of wavelenght range for
         // any of spectral samples.
         m_CommonWavelengths = aCommonWL.getCombinedWavelengths(Combine::Interpolate);
+        m_CommonGrid = CWavelengthGrid::intern(m_CommonWavelengths);
 
-        m_SolarRadiation = m_SolarRadiation.interpolate(m_CommonWavelengths);
+        m_SolarRadiation = m_SolarRadiation.interpolate(m_CommonGrid);
 
         if(m_DetectorData.size() > 0)
         {
-            m_DetectorData.interpolate(m_CommonWavelengths);
+            m_DetectorData.interpolate(m_CommonGrid);
         }
 
         for(auto & layer : m_Layers)
@@ -87,9 +90,10 @@ namespace MultiLayerOptics
                                            const CSeries & t_SolarRadiation,
                                            const std::shared_ptr<SpecularLayer> & t_Layer) :
         m_CommonWavelengths(t_CommonWavelength),
+        m_CommonGrid(CWavelengthGrid::intern(t_CommonWavelength)),
         m_SolarRadiation(t_SolarRadiation)
     {
-        m_SolarRadiation = m_SolarRadiation.interpolate(m_CommonWavelengths);
+        m_SolarRadiation = m_SolarRadiation.interpolate(m_CommonGrid);
         addLayer(t_Layer);
     }
 
@@ -149,6 +153,37 @@ namespace MultiLayerOptics
         return m_CommonWavelengths;
     }
 
+    std::vector<double>
+      CMultiPaneSpecular::getPropertiesSimple(PropertySimple t_Property,
+                                              Side t_Side,
+                                              Scattering t_Scattering,
+                                              const std::vector<CSeries> & t_Detectors,
+                                              double t_Theta,
+                                              double)
+    {
+        std::vector<double> result(t_Detectors.size(), 0);
+        const auto prop(toProperty(t_Property));
+        switch(t_Scattering)
+        {
+            case Scattering::DirectDirect:
+                result = getProperties(
+                  t_Side, prop, t_Theta, getMinLambda(), getMaxLambda(), t_Detectors);
+                break;
+            case Scattering::DiffuseDiffuse:
+                result = getHemisphericalProperties(t_Side,
+                                                    prop,
+                                                    {0, 10, 20, 30, 40, 50, 60, 70, 80, 90},
+                                                    getMinLambda(),
+                                                    getMaxLambda(),
+                                                    t_Detectors);
+                break;
+            case Scattering::DirectDiffuse:
+                break;
+        }
+
+        return result;
+    }
+
     double CMultiPaneSpecular::getProperty(const Side t_Side,
                                            const Property t_Property,
                                            const double t_Angle,
@@ -157,10 +192,6 @@ namespace MultiLayerOptics
                                            const IntegrationType t_IntegrationType,
                                            double normalizationCoefficient)
     {
-        CEquivalentLayerSingleComponentMWAngle aAngularProperties = getAngular(t_Angle);
-
-        auto aProperties = aAngularProperties.getProperties(t_Side, t_Property);
-
         auto solarRadiation = m_SolarRadiation;
 
         if(m_DetectorData.size() > 0)
@@ -168,20 +199,115 @@ namespace MultiLayerOptics
             solarRadiation = solarRadiation * m_DetectorData;
         }
 
-        auto aMult = aProperties * solarRadiation;
+        return integrateProperty(t_Side,
+                                 t_Property,
+                                 t_Angle,
+                                 minLambda,
+                                 maxLambda,
+                                 {solarRadiation},
+                                 t_IntegrationType,
+                                 normalizationCoefficient)[0];
+    }
 
-        const auto iIntegrated = aMult.integrate(t_IntegrationType, normalizationCoefficient);
+    std::vector<double> CMultiPaneSpecular::getProperties(const Side t_Side,
+                                                          const Property t_Property,
+                                                          const double t_Angle,
+                                                          const double minLambda,
+                                                          const double maxLambda,
+                                                          const std::vector<CSeries> & t_Detectors,
+                                                          const IntegrationType t_IntegrationType,
+                                                          double normalizationCoefficient)
+    {
+        return integrateProperty(t_Side,
+                                 t_Property,
+                                 t_Angle,
+                                 minLambda,
+                                 maxLambda,
+                                 detectorWeights(t_Detectors),
+                                 t_IntegrationType,
+                                 normalizationCoefficient);
+    }
 
-        // TODO: Check detector data here and multiply with it if necessary
+    std::vector<double>
+      CMultiPaneSpecular::integrateProperty(const Side t_Side,
+                                            const Property t_Property,
+                                            const double t_Angle,
+                                            const double minLambda,
+                                            const double maxLambda,
+                                            const std::vector<CSeries> & t_Weights,
+                                            const IntegrationType t_IntegrationType,
+                                            double normalizationCoefficient)
+    {
+        CEquivalentLayerSingleComponentMWAngle aAngularProperties = getAngular(t_Angle);
 
-        const double totalProperty = iIntegrated->sum(minLambda, maxLambda);
+        auto aProperties = aAngularProperties.getProperties(t_Side, t_Property);
 
-        double totalSolar = solarRadiation.integrate(t_IntegrationType, normalizationCoefficient)
-                              ->sum(minLambda, maxLambda);
+        const CSpectralWeights aWeights(
+          t_Weights, t_IntegrationType, normalizationCoefficient, minLambda, maxLambda);
+        const auto & aTotals = aWeights.getTotals();
+        if(std::any_of(aTotals.begin(), aTotals.end(), [](const double total) {
+               return !(total > 0);
+           }))
+        {
+            throw std::runtime_error("Source and detector must have positive integrated energy "
+                                     "over the wavelength range.");
+        }
 
-        assert(totalSolar > 0);
+        return aWeights.average(aProperties);
+    }
 
-        return totalProperty / totalSolar;
+    std::vector<double>
+      CMultiPaneSpecular::getSourceProperties(const Side t_Side,
+                                              const Property t_Property,
+                                              const double t_Angle,
+                                              const double minLambda,
+                                              const double maxLambda,
+                                              const std::vector<CSeries> & t_Sources,
+                                              const IntegrationType t_IntegrationType,
+                                              double normalizationCoefficient)
+    {
+        return integrateProperty(t_Side,
+                                 t_Property,
+                                 t_Angle,
+                                 minLambda,
+                                 maxLambda,
+                                 sourceWeights(t_Sources),
+                                 t_IntegrationType,
+                                 normalizationCoefficient);
+    }
+
+    std::vector<CSeries>
+      CMultiPaneSpecular::sourceWeights(const std::vector<CSeries> & t_Sources) const
+    {
+        std::vector<CSeries> result;
+        result.reserve(t_Sources.size());
+        for(const auto & source : t_Sources)
+        {
+            auto aSource = source.interpolate(m_CommonGrid);
+            if(m_DetectorData.size() > 0)
+            {
+                aSource = aSource * m_DetectorData.interpolate(m_CommonGrid);
+            }
+            result.push_back(aSource);
+        }
+        return result;
+    }
+
+    std::vector<CSeries>
+      CMultiPaneSpecular::detectorWeights(const std::vector<CSeries> & t_Detectors) const
+    {
+        std::vector<CSeries> result;
+        result.reserve(t_Detectors.size());
+        for(const auto & detector : t_Detectors)
+        {
+            auto solarRadiation = m_SolarRadiation;
+            if(detector.size() > 0)
+            {
+                solarRadiation = solarRadiation * detector.interpolate(m_CommonGrid);
+            }
+            result.push_back(solarRadiation);
+        }
+        return result;
     }
 
     double
@@ -212,6 +338,45 @@ namespace MultiLayerOptics
         return aIntegrator.value();
     }
 
+    std::vector<double> CMultiPaneSpecular::getHemisphericalProperties(
+      Side t_Side,
+      Property t_Property,
+      const std::vector<double> & t_IntegrationAngles,
+      double minLambda,
+      double maxLambda,
+      const std::vector<CSeries> & t_Detectors,
+      IntegrationType t_IntegrationType,
+      double normalizationCoefficient)
+    {
+        const auto weights = detectorWeights(t_Detectors);
+        std::vector<CSeries> aAngularProperties(weights.size());
+        for(const auto angle : t_IntegrationAngles)
+        {
+            const auto aProperties = integrateProperty(t_Side,
+                                                       t_Property,
+                                                       angle,
+                                                       minLambda,
+                                                       maxLambda,
+                                                       weights,
+                                                       t_IntegrationType,
+                                                       normalizationCoefficient);
+            for(size_t i = 0u; i < weights.size(); ++i)
+            {
+                aAngularProperties[i].addProperty(angle, aProperties[i]);
+            }
+        }
+
+        std::vector<double> result;
+        result.reserve(weights.size());
+        for(const auto & angularProperties : aAngularProperties)
+        {
+            CHemispherical2DIntegrator aIntegrator = CHemispherical2DIntegrator(
+              angularProperties, t_IntegrationType, normalizationCoefficient);
+            result.push_back(aIntegrator.value());
+        }
+        return result;
+    }
+
     double CMultiPaneSpecular::getAbsorptanceLayer(size_t index,
                                                    FenestrationCommon::Side,
                                                    FenestrationCommon::ScatteringSimple scattering,
@@ -367,9 +532,9 @@ namespace MultiLayerOptics
             result.Rb.addProperty(wl[j], Rbv[j]);
         }
 
-        result.T = result.T.interpolate(m_CommonWavelengths);
-        result.Rf = result.Rf.interpolate(m_CommonWavelengths);
-        result.Rb = result.Rb.interpolate(m_CommonWavelengths);
+        result.T = result.T.interpolate(m_CommonGrid);
+        result.Rf = result.Rf.interpolate(m_CommonGrid);
+        result.Rb = result.Rb.interpolate(m_CommonGrid);
 
         return result;
     }
@@ -48,7 +48,7 @@ namespace MultiLayerOptics
     ///////////////////////////////////////////////////////////////////////////////////////
 
     // Handles equivalent properties of MultiLayerOptics glass consists only of specular layers
-    class CMultiPaneSpecular : public SingleLayerOptics::IScatteringLayer
+    class CMultiPaneSpecular : public SingleLayerOptics::IMultiDetectorScatteringLayer
     {
     protected:
         CMultiPaneSpecular(
@@ -74,6 +74,14 @@ namespace MultiLayerOptics
                                  double t_Theta = 0,
                                  double t_Phi = 0) override;
 
+        std::vector<double>
+          getPropertiesSimple(FenestrationCommon::PropertySimple t_Property,
+                              FenestrationCommon::Side t_Side,
+                              FenestrationCommon::Scattering t_Scattering,
+                              const std::vector<FenestrationCommon::CSeries> & t_Detectors,
+                              double t_Theta = 0,
+                              double t_Phi = 0) override;
+
         double getMinLambda() const override;
 
         double getMaxLambda() const override;
@@ -98,6 +106,44 @@ namespace MultiLayerOptics
                                           FenestrationCommon::IntegrationType::Trapezoidal,
                                         double normalizationCoefficient = 1);
 
+        // Equivalent layer is calculated once and then weighted with each detector. Empty
+        // detector means that property is weighted with solar radiation only.
+        std::vector<double>
+          getProperties(FenestrationCommon::Side t_Side,
+                        FenestrationCommon::Property t_Property,
+                        double t_Angle,
+                        double minLambda,
+                        double maxLambda,
+                        const std::vector<FenestrationCommon::CSeries> & t_Detectors,
+                        FenestrationCommon::IntegrationType t_IntegrationType =
+                          FenestrationCommon::IntegrationType::Trapezoidal,
+                        double normalizationCoefficient = 1);
+
+        // Equivalent layer is calculated once and then weighted with each of the sources instead
+        // of solar radiation (detector data are still applied). Sources are integrated as single
+        // weight matrix so that properties for all sources are obtained with one product.
+        std::vector<double>
+          getSourceProperties(FenestrationCommon::Side t_Side,
+                              FenestrationCommon::Property t_Property,
+                              double t_Angle,
+                              double minLambda,
+                              double maxLambda,
+                              const std::vector<FenestrationCommon::CSeries> & t_Sources,
+                              FenestrationCommon::IntegrationType t_IntegrationType =
+                                FenestrationCommon::IntegrationType::Trapezoidal,
+                              double normalizationCoefficient = 1);
+
+        std::vector<double> getHemisphericalProperties(
+          FenestrationCommon::Side t_Side,
+          FenestrationCommon::Property t_Property,
+          const std::vector<double> & t_IntegrationAngles,
+          double minLambda,
+          double maxLambda,
+          const std::vector<FenestrationCommon::CSeries> & t_Detectors,
+          FenestrationCommon::IntegrationType t_IntegrationType =
+            FenestrationCommon::IntegrationType::Trapezoidal,
+          double normalizationCoefficient = 1);
+
         size_t size() const;
 
         double getAbsorptanceLayer(size_t index,
@@ -151,11 +197,32 @@ namespace MultiLayerOptics
         // creates equivalent layer properties for certain angle
         CEquivalentLayerSingleComponentMWAngle createNewAngular(double t_Angle);
 
+        // Integrates equivalent layer property with each of weighting functions
+        std::vector<double>
+          integrateProperty(FenestrationCommon::Side t_Side,
+                            FenestrationCommon::Property t_Property,
+                            double t_Angle,
+                            double minLambda,
+                            double maxLambda,
+                            const std::vector<FenestrationCommon::CSeries> & t_Weights,
+                            FenestrationCommon::IntegrationType t_IntegrationType,
+                            double normalizationCoefficient);
+
+        // Solar radiation multiplied with each of detectors
+        std::vector<FenestrationCommon::CSeries>
+          detectorWeights(const std::vector<FenestrationCommon::CSeries> & t_Detectors) const;
+
+        // Each of sources multiplied with detector
+        std::vector<FenestrationCommon::CSeries>
+          sourceWeights(const std::vector<FenestrationCommon::CSeries> & t_Sources) const;
+
         // Contains all specular layers (cells) that are added to the model. This way program will
         // be able to recalculate equivalent properties for any angle
         std::vector<std::shared_ptr<SingleLayerOptics::SpecularLayer>> m_Layers;
 
         std::vector<double> m_CommonWavelengths;
+        // Interned common wavelengths so that interpolation to them does not intern again
+        std::shared_ptr<const FenestrationCommon::CWavelengthGrid> m_CommonGrid;
         FenestrationCommon::CSeries m_SolarRadiation;
         FenestrationCommon::CSeries m_DetectorData;
 
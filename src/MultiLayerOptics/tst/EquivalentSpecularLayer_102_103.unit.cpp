@@ -1,4 +1,5 @@
 #include <memory>
+#include <stdexcept>
 #include <gtest/gtest.h>
 
 #include "WCESpectralAveraging.hpp"
@@ -19,6 +20,7 @@ class EquivalentSpecularLayer_102_103 : public testing::Test
 private:
     std::shared_ptr<CMultiPaneSpecular> m_Layer;
 
+protected:
     CSeries loadSolarRadiationFile() const
     {
         // Full ASTM E891-87 Table 1 (Solar radiation)
@@ -183,10 +185,13 @@ private:
 protected:
     virtual void SetUp()
     {
-        const auto aSolarRadiation = loadSolarRadiationFile();
+        m_Layer = createLayer(loadSolarRadiationFile());
+    }
 
+    std::shared_ptr<CMultiPaneSpecular> createLayer(const CSeries & t_SolarRadiation) const
+    {
         // Wavelength data set according to NFRC 2003 standard is from solar radiation file
-        const auto wl = aSolarRadiation.getXArray();
+        const auto wl = loadSolarRadiationFile().getXArray();
 
         double thickness = 3.048e-3;   // [m]
         const auto aMaterial_102 = Material::nBandMaterial(
@@ -203,7 +208,18 @@ protected:
         const auto layer102 = SpecularLayer::createLayer(aMaterial_102);
         const auto layer103 = SpecularLayer::createLayer(aMaterial_103);
 
-        m_Layer = CMultiPaneSpecular::create({layer102, layer103}, loadSolarRadiationFile());
+        return CMultiPaneSpecular::create({layer102, layer103}, t_SolarRadiation);
+    }
+
+    // Solar radiation weighted by wavelength. Has different spectral shape than solar radiation.
+    static CSeries tiltedSource(const CSeries & t_SolarRadiation)
+    {
+        CSeries aSource;
+        for(const auto & aPoint : t_SolarRadiation)
+        {
+            aSource.addProperty(aPoint->x(), aPoint->value() * aPoint->x());
+        }
+        return aSource;
     }
 
 public:
@@ -456,3 +472,53 @@ TEST_F(EquivalentSpecularLayer_102_103, TestHemispherical)
     EXPECT_NEAR(0.126861, Abs2, 1e-6);
     EXPECT_NEAR(0.126861, absorptances[1], 1e-6);
 }
+
+TEST_F(EquivalentSpecularLayer_102_103, TestManySources)
+{
+    SCOPED_TRACE("Begin Test: Specular MultiLayerOptics layer - many sources at once.");
+
+    const double angle = 0;
+
+    CMultiPaneSpecular aLayer = *getLayer();
+
+    const auto aSolar = loadSolarRadiationFile();
+    const std::vector<CSeries> aSources{aSolar, tiltedSource(aSolar)};
+
+    for(auto aProperty : {Property::T, Property::R})
+    {
+        const auto aResults = aLayer.getSourceProperties(
+          Side::Front, aProperty, angle, aLayer.getMinLambda(), aLayer.getMaxLambda(), aSources);
+        ASSERT_EQ(aSources.size(), aResults.size());
+
+        // Each source must give the same result as the layer created with that source only
+        for(size_t i = 0; i < aSources.size(); ++i)
+        {
+            auto aSingleSource = createLayer(aSources[i]);
+            const auto aCorrect = aSingleSource->getProperty(Side::Front,
+                                                             aProperty,
+                                                             angle,
+                                                             aSingleSource->getMinLambda(),
+                                                             aSingleSource->getMaxLambda());
+            EXPECT_NEAR(aCorrect, aResults[i], 1e-12);
+        }
+    }
+
+    const auto T = aLayer.getSourceProperties(
+      Side::Front, Property::T, angle, aLayer.getMinLambda(), aLayer.getMaxLambda(), aSources);
+    EXPECT_NEAR(0.652311, T[0], 1e-6);
+    EXPECT_NEAR(0.624845, T[1], 1e-6);
+
+    // Source without energy cannot be used as weighting function
+    CSeries aDark;
+    for(const auto & aPoint : aSolar)
+    {
+        aDark.addProperty(aPoint->x(), 0);
+    }
+    EXPECT_THROW(aLayer.getSourceProperties(Side::Front,
+                                            Property::T,
+                                            angle,
+                                            aLayer.getMinLambda(),
+                                            aLayer.getMaxLambda(),
+                                            {aSolar, aDark}),
+                 std::runtime_error);
+}
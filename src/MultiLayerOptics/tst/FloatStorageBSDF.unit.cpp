@@ -0,0 +1,238 @@
+#include <memory>
+#include <cmath>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "WCESpectralAveraging.hpp"
+#include "WCEMultiLayerOptics.hpp"
+#include "WCESingleLayerOptics.hpp"
+#include "WCECommon.hpp"
+
+using namespace FenestrationCommon;
+using namespace SingleLayerOptics;
+using namespace SpectralAveraging;
+using namespace MultiLayerOptics;
+
+// Multilayer with matrices stored in single precision must match double precision results and
+// must not change results of layers that are shared with other multilayers
+class TestFloatStorageBSDF : public testing::Test
+{
+private:
+    std::shared_ptr<CBSDFLayer> m_Specular;
+    std::shared_ptr<CBSDFLayer> m_Venetian;
+
+protected:
+    void SetUp() override
+    {
+        const auto aBSDF = CBSDFHemisphere::create(BSDFBasis::Quarter);
+
+        // NFRC 102 measurements at reduced number of wavelengths
+        const auto aMeasurements_102 = CSpectralSampleData::create(
+          {{0.300, 0.0020, 0.0470, 0.0480}, {0.320, 0.1000, 0.0470, 0.0480},
+           {0.340, 0.6160, 0.0670, 0.0670}, {0.360, 0.8470, 0.0840, 0.0840},
+           {0.380, 0.8560, 0.0840, 0.0840}, {0.400, 0.8930, 0.0860, 0.0860},
+           {0.450, 0.8960, 0.0850, 0.0850}, {0.500, 0.9050, 0.0840, 0.0840},
+           {0.550, 0.9030, 0.0830, 0.0830}, {0.600, 0.8930, 0.0810, 0.0810},
+           {0.650, 0.8750, 0.0790, 0.0790}, {0.700, 0.8540, 0.0760, 0.0770},
+           {0.750, 0.8310, 0.0740, 0.0740}, {0.800, 0.8080, 0.0720, 0.0720},
+           {0.900, 0.7760, 0.0720, 0.0720}, {1.000, 0.7620, 0.0660, 0.0670},
+           {1.200, 0.7650, 0.0660, 0.0660}, {1.400, 0.7950, 0.0670, 0.0680},
+           {1.600, 0.8360, 0.0700, 0.0700}, {1.800, 0.8410, 0.0700, 0.0700},
+           {2.000, 0.8390, 0.0690, 0.0690}, {2.200, 0.8300, 0.0700, 0.0700},
+           {2.500, 0.8220, 0.0680, 0.0680}});
+        const double thickness = 3.048e-3;   // [m]
+        const auto aMaterial_102 = Material::nBandMaterial(
+          aMeasurements_102, thickness, MaterialType::Monolithic, WavelengthRange::Solar);
+        m_Specular = CBSDFLayerMaker::getSpecularLayer(aMaterial_102, aBSDF);
+
+        // Directional diffuse venetian blind has dense BSDF matrices
+        const auto aSlat = Material::singleBandMaterial(0.1, 0.1, 0.7, 0.7, WavelengthRange::Solar);
+        const auto slatWidth = 0.016;     // m
+        const auto slatSpacing = 0.012;   // m
+        const auto slatTiltAngle = 45;
+        const auto curvatureRadius = 0.0;
+        const size_t numOfSlatSegments = 5;
+        m_Venetian = CBSDFLayerMaker::getVenetianLayer(aSlat,
+                                                       aBSDF,
+                                                       slatWidth,
+                                                       slatSpacing,
+                                                       slatTiltAngle,
+                                                       curvatureRadius,
+                                                       numOfSlatSegments,
+                                                       DistributionMethod::DirectionalDiffuse);
+    }
+
+    static CSeries solarRadiation()
+    {
+        return CSeries({{0.30, 0.0},
+                        {0.40, 556.0},
+                        {0.50, 1026.7},
+                        {0.70, 1002.4},
+                        {1.00, 582.9},
+                        {1.50, 167.1},
+                        {2.00, 84.9},
+                        {2.50, 17.0}});
+    }
+
+    std::unique_ptr<CMultiPaneBSDF> createSystem(const bool t_FloatStorage) const
+    {
+        auto aSystem = CMultiPaneBSDF::create({m_Specular, m_Venetian}, solarRadiation());
+        aSystem->setFloatStorage(t_FloatStorage);
+        return aSystem;
+    }
+
+    // Integrated results of the system (diffuse, directional and layer absorptances)
+    static std::vector<double> results(CMultiPaneBSDF & t_System)
+    {
+        const double minLambda = 0.3;
+        const double maxLambda = 2.5;
+        std::vector<double> aResults;
+        for(auto aSide : EnumSide())
+        {
+            for(auto aProperty : EnumPropertySimple())
+            {
+                aResults.push_back(t_System.DiffDiff(minLambda, maxLambda, aSide, aProperty));
+                for(const auto theta : {0.0, 40.0})
+                {
+                    aResults.push_back(
+                      t_System.DirHem(minLambda, maxLambda, aSide, aProperty, theta, 0));
+                    aResults.push_back(
+                      t_System.DirDir(minLambda, maxLambda, aSide, aProperty, theta, 0));
+                }
+            }
+            for(size_t layer = 1; layer <= 2; ++layer)
+            {
+                aResults.push_back(t_System.AbsDiff(minLambda, maxLambda, aSide, layer));
+                aResults.push_back(t_System.Abs(minLambda, maxLambda, aSide, layer, 40, 0));
+            }
+        }
+        return aResults;
+    }
+
+    CBSDFLayer & specular() const
+    {
+        return *m_Specular;
+    }
+
+    CBSDFLayer & venetian() const
+    {
+        return *m_Venetian;
+    }
+};
+
+TEST_F(TestFloatStorageBSDF, CompactLayer)
+{
+    SCOPED_TRACE("Begin Test: Layer matrices released and expanded from single precision.");
+
+    const auto & aVenetian = *venetian().getResults();
+    const auto & aSpecular = *specular().getResults();
+    CBSDFIntegrator aCompactVenetian(aVenetian);
+    CBSDFIntegrator aCompactSpecular(aSpecular);
+
+    aCompactVenetian.compact();
+    aCompactSpecular.compact();
+
+    EXPECT_EQ(MatrixStructure::Dense, aCompactVenetian.structure(Side::Front, PropertySimple::T));
+    EXPECT_EQ(MatrixStructure::Diagonal, aCompactSpecular.structure(Side::Front, PropertySimple::T));
+    EXPECT_FALSE(aCompactVenetian.isAxisymmetric());
+    EXPECT_TRUE(aCompactSpecular.isAxisymmetric());
+
+    const auto tolerance = FloatMatrix::roundingError();
+    for(auto aSide : EnumSide())
+    {
+        for(auto aProperty : EnumPropertySimple())
+        {
+            const auto & aCorrect = aVenetian.at(aSide, aProperty);
+            const auto aMatrix = aCompactVenetian.matrix(aSide, aProperty);
+            for(size_t i = 0; i < aCorrect.size(); ++i)
+            {
+                for(size_t j = 0; j < aCorrect.size(); ++j)
+                {
+                    EXPECT_NEAR(aCorrect(i, j), aMatrix(i, j), tolerance * aCorrect(i, j));
+                }
+            }
+            EXPECT_NEAR(aVenetian.DirDir(aSide, aProperty, size_t(0)),
+                        aCompactVenetian.DirDir(aSide, aProperty, size_t(0)),
+                        tolerance);
+
+            // Reading of matrices does not release single precision storage
+            EXPECT_TRUE(aCompactVenetian.isCompacted(aSide, aProperty));
+            EXPECT_THROW(aCompactVenetian.at(aSide, aProperty), std::runtime_error);
+            // Specular layer is kept as per-ring data in double precision
+            EXPECT_EQ(aSpecular.DirDir(aSide, aProperty, size_t(0)),
+                      aCompactSpecular.DirDir(aSide, aProperty, size_t(0)));
+        }
+    }
+}
+
+TEST_F(TestFloatStorageBSDF, FloatStorage)
+{
+    SCOPED_TRACE("Begin Test: Multilayer with matrices stored in single precision.");
+
+    const auto aDouble = createSystem(false);
+    const auto aCorrect = results(*aDouble);
+
+    const auto aFloat = createSystem(true);
+    const auto aResults = results(*aFloat);
+
+    // Only stored composed matrices are rounded and integration is done in double precision
+    const double tolerance = 1e-6;
+    ASSERT_EQ(aCorrect.size(), aResults.size());
+    for(size_t i = 0; i < aCorrect.size(); ++i)
+    {
+        EXPECT_NEAR(aCorrect[i], aResults[i], tolerance * std::abs(aCorrect[i]));
+    }
+}
+
+TEST_F(TestFloatStorageBSDF, SharedLayers)
+{
+    SCOPED_TRACE("Begin Test: Single precision storage does not change shared layer results.");
+
+    const auto aBaseline = results(*createSystem(false));
+
+    // Multilayer keeps wavelength results of the layer which are also available to the caller
+    const auto aFloat = createSystem(true);
+    const auto aWavelengthResults = venetian().getWavelengthResults();
+    std::vector<SquareMatrix> aLayerMatrices;
+    for(const auto & aResult : *aWavelengthResults)
+    {
+        for(auto aSide : EnumSide())
+        {
+            for(auto aProperty : EnumPropertySimple())
+            {
+                aLayerMatrices.push_back(aResult->at(aSide, aProperty));
+            }
+        }
+    }
+
+    results(*aFloat);
+
+    size_t index = 0;
+    for(const auto & aResult : *aWavelengthResults)
+    {
+        for(auto aSide : EnumSide())
+        {
+            for(auto aProperty : EnumPropertySimple())
+            {
+                const auto & aCorrect = aLayerMatrices[index++];
+                const auto & aMatrix = aResult->at(aSide, aProperty);
+                for(size_t i = 0; i < aMatrix.size(); ++i)
+                {
+                    for(size_t j = 0; j < aMatrix.size(); ++j)
+                    {
+                        EXPECT_EQ(aCorrect(i, j), aMatrix(i, j));
+                    }
+                }
+            }
+        }
+    }
+
+    // Double precision multilayer built from the same layers after single precision one must
+    // reproduce baseline exactly
+    const auto aResults = results(*createSystem(false));
+    ASSERT_EQ(aBaseline.size(), aResults.size());
+    for(size_t i = 0; i < aBaseline.size(); ++i)
+    {
+        EXPECT_EQ(aBaseline[i], aResults[i]);
+    }
+}
@@ -0,0 +1,122 @@
+#include <memory>
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "WCEMultiLayerOptics.hpp"
+#include "WCESingleLayerOptics.hpp"
+#include "WCECommon.hpp"
+
+using namespace FenestrationCommon;
+using namespace SingleLayerOptics;
+using namespace MultiLayerOptics;
+
+// Interreflectance calculated as truncated series must match result obtained with inverse
+class TestInterReflectanceSeries : public testing::Test
+{
+protected:
+    // Dense (directional diffuse like) layer with given diffuse transmittance and reflectance
+    static std::shared_ptr<CBSDFIntegrator>
+      createLayer(const CBSDFHemisphere & t_BSDF, const double t_Tau, const double t_Rho, const double t_Shift)
+    {
+        using ConstantsData::WCE_PI;
+
+        auto aLayer = std::make_shared<CBSDFIntegrator>(t_BSDF.getDirections(BSDFDirection::Incoming));
+        const auto & aLambda = aLayer->lambdaVector();
+        const auto size = aLambda.size();
+        for(auto aSide : EnumSide())
+        {
+            SquareMatrix aTau{size};
+            SquareMatrix aRho{size};
+            for(size_t i = 0; i < size; ++i)
+            {
+                for(size_t j = 0; j < size; ++j)
+                {
+                    const auto variation = 1 + 0.2 * std::sin(double(i * j) + t_Shift);
+                    aTau(i, j) = t_Tau * variation / WCE_PI;
+                    aRho(i, j) = t_Rho * variation / WCE_PI;
+                }
+                aTau(i, i) += 0.3 / aLambda[i];
+            }
+            aLayer->setResultMatrices(aTau, aRho, aSide);
+        }
+        return aLayer;
+    }
+
+    static void compareMatrices(const SquareMatrix & t_Correct, const SquareMatrix & t_Matrix, const double t_Tolerance)
+    {
+        ASSERT_EQ(t_Correct.size(), t_Matrix.size());
+        for(size_t i = 0; i < t_Correct.size(); ++i)
+        {
+            for(size_t j = 0; j < t_Correct.size(); ++j)
+            {
+                EXPECT_NEAR(t_Correct(i, j), t_Matrix(i, j), t_Tolerance);
+            }
+        }
+    }
+};
+
+TEST_F(TestInterReflectanceSeries, InterReflectance)
+{
+    SCOPED_TRACE("Begin Test: Interreflectance products calculated with truncated series.");
+
+    const auto aBSDF = CBSDFHemisphere::create(BSDFBasis::Quarter);
+    const auto aLayer1 = createLayer(aBSDF, 0.3, 0.4, 0);
+    const auto aLayer2 = createLayer(aBSDF, 0.2, 0.5, 1);
+
+    const auto aLambda = aLayer1->structuredLambdaMatrix();
+    const auto Rb = aLayer1->structuredAt(Side::Back, PropertySimple::R);
+    const auto Rf = aLayer2->structuredAt(Side::Front, PropertySimple::R);
+    const auto T = aLayer2->structuredAt(Side::Front, PropertySimple::T);
+
+    const CInterReflectance aInverse(aLambda, Rb, Rf);
+    const CInterReflectance aSeries(aLambda, Rb, Rf, 1e-10);
+    EXPECT_FALSE(aInverse.isSeries());
+    EXPECT_TRUE(aSeries.isSeries());
+
+    // Vectors are multiplied with series while inverse is not calculated
+    const auto aAlpha = aLayer2->Abs(Side::Front);
+    const auto aCorrect = aInverse.leftMultiply(aAlpha);
+    const auto aResult = aSeries.leftMultiply(aAlpha);
+    for(size_t i = 0; i < aCorrect.size(); ++i)
+    {
+        EXPECT_NEAR(aCorrect[i], aResult[i], 1e-9);
+    }
+
+    // Matrices are always multiplied with inverse
+    compareMatrices(aInverse.leftMultiply(T).matrix(), aSeries.leftMultiply(T).matrix(), 1e-12);
+}
+
+TEST_F(TestInterReflectanceSeries, TripleLayer)
+{
+    SCOPED_TRACE("Begin Test: Equivalent layer calculated with truncated interreflectance series.");
+
+    const auto aBSDF = CBSDFHemisphere::create(BSDFBasis::Quarter);
+
+    CEquivalentBSDFLayerSingleBand aInverse(createLayer(aBSDF, 0.3, 0.4, 0));
+    CEquivalentBSDFLayerSingleBand aSeries(createLayer(aBSDF, 0.3, 0.4, 0));
+    aSeries.setInterReflectanceTolerance(1e-10);
+    for(const auto shift : {1.0, 2.0})
+    {
+        aInverse.addLayer(createLayer(aBSDF, 0.2, 0.5, shift));
+        aSeries.addLayer(createLayer(aBSDF, 0.2, 0.5, shift));
+    }
+
+    for(auto aSide : EnumSide())
+    {
+        for(auto aProperty : EnumPropertySimple())
+        {
+            compareMatrices(aInverse.getMatrix(aSide, aProperty),
+                            aSeries.getMatrix(aSide, aProperty),
+                            1e-8);
+        }
+        for(size_t layer = 1; layer <= 3; ++layer)
+        {
+            const auto aCorrect = aInverse.getLayerAbsorptances(layer, aSide);
+            const auto aResult = aSeries.getLayerAbsorptances(layer, aSide);
+            for(size_t i = 0; i < aCorrect.size(); ++i)
+            {
+                EXPECT_NEAR(aCorrect[i], aResult[i], 1e-8);
+            }
+        }
+    }
+}
@@ -19,6 +19,7 @@ class MultiPaneBSDF_102_103 : public testing::Test
 private:
     std::unique_ptr<CMultiPaneBSDF> m_Layer;
 
+protected:
     CSeries loadSolarRadiationFile()
     {
         // Full ASTM E891-87 Table 1 (Solar radiation)
@@ -182,6 +183,11 @@ private:
 
 protected:
     virtual void SetUp()
+    {
+        m_Layer = createLayer(loadSolarRadiationFile());
+    }
+
+    std::unique_ptr<CMultiPaneBSDF> createLayer(const CSeries & t_SolarRadiation)
     {
         // Create material from samples
         auto thickness = 3.048e-3;   // [m]
@@ -204,8 +210,30 @@ protected:
 
         auto commonWavelengths = aCommonWL.getCombinedWavelengths(Combine::Interpolate);
 
-        m_Layer = CMultiPaneBSDF::create(
-          {Layer_102, Layer_103}, loadSolarRadiationFile(), commonWavelengths);
+        return CMultiPaneBSDF::create({Layer_102, Layer_103}, t_SolarRadiation, commonWavelengths);
+    }
+
+    // Front side results for normal incidence over given wavelength range
+    static std::vector<double>
+      visibleResults(CMultiPaneBSDF & t_Layer, const double minLambda, const double maxLambda)
+    {
+        return {t_Layer.DirHem(minLambda, maxLambda, Side::Front, PropertySimple::T, 0, 0),
+                t_Layer.DirHem(minLambda, maxLambda, Side::Front, PropertySimple::R, 0, 0),
+                t_Layer.DirDir(minLambda, maxLambda, Side::Front, PropertySimple::T, 0, 0),
+                t_Layer.DiffDiff(minLambda, maxLambda, Side::Front, PropertySimple::T),
+                t_Layer.Abs(minLambda, maxLambda, Side::Front, 1, 0, 0),
+                t_Layer.Abs(minLambda, maxLambda, Side::Front, 2, 0, 0)};
+    }
+
+    // Solar radiation weighted by wavelength. Has different spectral shape than solar radiation.
+    static CSeries tiltedSource(const CSeries & t_SolarRadiation)
+    {
+        CSeries aSource;
+        for(const auto & aPoint : t_SolarRadiation)
+        {
+            aSource.addProperty(aPoint->x(), aPoint->value() * aPoint->x());
+        }
+        return aSource;
     }
 
 public:
@@ -591,3 +619,129 @@ TEST_F(MultiPaneBSDF_102_103, TestSpecular1)
         EXPECT_NEAR(correctResults[i], aAbsB[i], 1e-6);
     }
 }
+
+TEST_F(MultiPaneBSDF_102_103, TestManySources)
+{
+    SCOPED_TRACE("Begin Test: Specular layer - BSDF with many sources at once.");
+
+    const double minLambda = 0.3;
+    const double maxLambda = 2.5;
+
+    CMultiPaneBSDF & aLayer = getLayer();
+
+    const auto aSolar = loadSolarRadiationFile();
+    const std::vector<CSeries> aSources{aSolar, tiltedSource(aSolar)};
+
+    for(auto aProperty : EnumPropertySimple())
+    {
+        const auto aResults =
+          aLayer.DirHem(minLambda, maxLambda, Side::Front, aProperty, 45, 78, aSources);
+        ASSERT_EQ(aSources.size(), aResults.size());
+
+        // Each source must give the same result as the layer created with that source only
+        for(size_t i = 0; i < aSources.size(); ++i)
+        {
+            auto aSingleSource = createLayer(aSources[i]);
+            const auto aCorrect =
+              aSingleSource->DirHem(minLambda, maxLambda, Side::Front, aProperty, 45, 78);
+            EXPECT_NEAR(aCorrect, aResults[i], 1e-12);
+        }
+    }
+
+    const auto tauHem =
+      aLayer.DirHem(minLambda, maxLambda, Side::Front, PropertySimple::T, 0, 0, aSources);
+    EXPECT_NEAR(0.6523021, tauHem[0], 1e-6);
+    EXPECT_NEAR(0.6248360, tauHem[1], 1e-6);
+}
+
+TEST_F(MultiPaneBSDF_102_103, TestManyDetectors)
+{
+    SCOPED_TRACE("Begin Test: Specular layer - BSDF with many detectors at once.");
+
+    CMultiPaneBSDF & aLayer = getLayer();
+    const auto minLambda = aLayer.getMinLambda();
+    const auto maxLambda = aLayer.getMaxLambda();
+
+    // Detector with different spectral shape than solar radiation and empty detector that stands
+    // for solar radiation only
+    const auto aSolar = loadSolarRadiationFile();
+    const auto wavelengths = aLayer.getWavelengths();
+    const auto aTilted = tiltedSource(aSolar.interpolate(wavelengths));
+    CSeries aDetector;
+    for(const auto & aPoint : aTilted)
+    {
+        aDetector.addProperty(aPoint->x(), aPoint->x());
+    }
+    const std::vector<CSeries> aDetectors{aDetector, CSeries()};
+    const std::vector<CSeries> aSources{aTilted, aSolar};
+
+    for(auto aScattering : EnumScattering())
+    {
+        for(auto aProperty : EnumPropertySimple())
+        {
+            const auto aResults = aLayer.getPropertiesSimple(
+              aProperty, Side::Front, aScattering, aDetectors, 45, 78);
+            ASSERT_EQ(aDetectors.size(), aResults.size());
+
+            // Each detector must give the same result as the layer created with solar radiation
+            // multiplied with that detector
+            for(size_t i = 0; i < aSources.size(); ++i)
+            {
+                auto aSingleSource = createLayer(aSources[i]);
+                const auto aCorrect =
+                  aSingleSource->getPropertySimple(aProperty, Side::Front, aScattering, 45, 78);
+                EXPECT_NEAR(aCorrect, aResults[i], 1e-12);
+            }
+        }
+    }
+
+    const auto tauHem = aLayer.DirHem(minLambda, maxLambda, Side::Front, PropertySimple::T, 0, 0);
+    const auto tauDir = aLayer.getPropertiesSimple(
+      PropertySimple::T, Side::Front, Scattering::DirectDirect, aDetectors, 0, 0);
+    const auto tauDif = aLayer.getPropertiesSimple(
+      PropertySimple::T, Side::Front, Scattering::DirectDiffuse, aDetectors, 0, 0);
+    EXPECT_NEAR(tauHem, tauDir[1] + tauDif[1], 1e-12);
+}
+
+TEST_F(MultiPaneBSDF_102_103, TestWavelengthRanges)
+{
+    SCOPED_TRACE("Begin Test: Specular layer - BSDF over different wavelength ranges.");
+
+    const double minVisible = 0.38;
+    const double maxVisible = 0.78;
+
+    // Visible range is calculated first (only wavelengths inside of the range are composed) and
+    // then extended to whole solar range
+    CMultiPaneBSDF & aLayer = getLayer();
+    const auto aVisible = visibleResults(aLayer, minVisible, maxVisible);
+
+    ASSERT_EQ(6u, aVisible.size());
+    EXPECT_NEAR(0.7548552, aVisible[0], 1e-6);   // DirHem T
+    EXPECT_NEAR(0.1415597, aVisible[1], 1e-6);   // DirHem R
+    EXPECT_NEAR(0.7548552, aVisible[2], 1e-6);   // DirDir T
+    EXPECT_NEAR(0.6406572, aVisible[3], 1e-6);   // DiffDiff T
+    EXPECT_NEAR(0.0410740, aVisible[4], 1e-6);   // Abs layer 1
+    EXPECT_NEAR(0.0625111, aVisible[5], 1e-6);   // Abs layer 2
+
+    double tauHem = aLayer.DirHem(0.3, 2.5, Side::Front, PropertySimple::T, 0, 0);
+    EXPECT_NEAR(0.6523021, tauHem, 1e-6);
+
+    double abs2 = aLayer.Abs(0.3, 2.5, Side::Front, 2, 0, 0);
+    EXPECT_NEAR(0.1268566, abs2, 1e-6);
+
+    // Composing other wavelengths does not change results of visible range
+    const auto aVisibleAfterSolar = visibleResults(aLayer, minVisible, maxVisible);
+
+    // Layer with all wavelengths composed first must give the same results for visible range
+    auto aFullLayer = createLayer(loadSolarRadiationFile());
+    EXPECT_NEAR(tauHem, aFullLayer->DirHem(0.3, 2.5, Side::Front, PropertySimple::T, 0, 0), 1e-12);
+    EXPECT_NEAR(abs2, aFullLayer->Abs(0.3, 2.5, Side::Front, 2, 0, 0), 1e-12);
+    const auto aFullVisible = visibleResults(*aFullLayer, minVisible, maxVisible);
+
+    ASSERT_EQ(aVisible.size(), aFullVisible.size());
+    for(size_t i = 0; i < aVisible.size(); ++i)
+    {
+        EXPECT_NEAR(aFullVisible[i], aVisible[i], 1e-12);
+        EXPECT_NEAR(aFullVisible[i], aVisibleAfterSolar[i], 1e-12);
+    }
+}
@@ -292,7 +292,7 @@ TEST_F(MultiPaneBSDF_102_103_SmallBasis, TestSpecular1)
     EXPECT_NEAR(472.9787789, energyTransmitted, 1e-6);
 
     energyTransmitted = aLayer.energy(0.5, 0.8, Side::Front, PropertySimple::T, theta, phi);
-    EXPECT_NEAR(186.8455475, energyTransmitted, 1e-6);
+    EXPECT_NEAR(212.0901745, energyTransmitted, 1e-6);
 
     // repeatability test
     energyTransmitted =
@@ -10,6 +10,7 @@ class TestNFRC_5439_SB70XL_Colors_MultiPaneSpecular : public testing::Test
 {
 private:
     std::shared_ptr<SingleLayerOptics::ColorProperties> m_Color;
+    std::shared_ptr<SingleLayerOptics::ColorProperties> m_ColorSinglePass;
 
     std::vector<double> loadWavelengths() const
     {
@@ -353,6 +354,9 @@ protected:
 
         m_Color = std::make_shared<SingleLayerOptics::ColorProperties>(
           std::move(LayerX), std::move(LayerY), std::move(LayerZ), solarRadiation, DX, DY, DZ, wl);
+
+        m_ColorSinglePass = std::make_shared<SingleLayerOptics::ColorProperties>(
+          createLayer(ASTM_E308_1964_Y()), solarRadiation, DX, DY, DZ, wl);
     }
 
 public:
@@ -360,6 +364,11 @@ public:
     {
         return m_Color;
     }
+
+    std::shared_ptr<SingleLayerOptics::ColorProperties> getSinglePassLayer() const
+    {
+        return m_ColorSinglePass;
+    }
 };
 
 TEST_F(TestNFRC_5439_SB70XL_Colors_MultiPaneSpecular, TestTrichromatic_T)
@@ -392,6 +401,27 @@ TEST_F(TestNFRC_5439_SB70XL_Colors_MultiPaneSpecular, TestTrichromatic_R)
     EXPECT_NEAR(10.159147, T.Z, 1e-6);
 }
 
+TEST_F(TestNFRC_5439_SB70XL_Colors_MultiPaneSpecular, TestTrichromatic_SinglePass)
+{
+    SCOPED_TRACE("Begin Test: Trichromatic (single pass over detectors).");
+
+    std::shared_ptr<SingleLayerOptics::ColorProperties> aLayer = getSinglePassLayer();
+
+    FenestrationCommon::Side aSide = FenestrationCommon::Side::Front;
+
+    SingleLayerOptics::Trichromatic T = aLayer->getTrichromatic(
+      FenestrationCommon::PropertySimple::T, aSide, FenestrationCommon::Scattering::DirectDirect);
+    EXPECT_NEAR(66.393144, T.X, 1e-6);
+    EXPECT_NEAR(71.662457, T.Y, 1e-6);
+    EXPECT_NEAR(71.768345, T.Z, 1e-6);
+
+    SingleLayerOptics::Trichromatic R = aLayer->getTrichromatic(
+      FenestrationCommon::PropertySimple::R, aSide, FenestrationCommon::Scattering::DirectDirect);
+    EXPECT_NEAR(6.971494, R.X, 1e-6);
+    EXPECT_NEAR(7.635557, R.Y, 1e-6);
+    EXPECT_NEAR(10.159147, R.Z, 1e-6);
+}
+
 TEST_F(TestNFRC_5439_SB70XL_Colors_MultiPaneSpecular, TestRGB_T)
 {
     SCOPED_TRACE("Begin Test: RGB.");
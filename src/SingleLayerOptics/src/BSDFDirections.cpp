@@ -1,5 +1,6 @@
 #include <cassert>
 #include <algorithm>
+#include <array>
 
 #include "BSDFDirections.hpp"
 #include "BSDFPatch.hpp"
@@ -44,6 +45,7 @@ namespace SingleLayerOptics
             thetaAngles.push_back((*it).theta());
             numPhiAngles.push_back((*it).numOfPhis());
         }
+        m_RingSizes = numPhiAngles;
 
         CThetaLimits ThetaLimits(thetaAngles);
         std::vector<double> thetaLimits = *ThetaLimits.getThetaLimits();
@@ -70,6 +72,11 @@ namespace SingleLayerOptics
             {
                 lowerPhi += 180;
             }
+
+            m_RingThetaHigh.push_back(upperTheta);
+            m_RingFirstIndex.push_back(m_Patches.size());
+            m_RingPhiLow.push_back(lowerPhi);
+            m_RingPhiDelta.push_back(360.0 / double(numPhiAngles[i - 1]));
             for(size_t j = 1; j < phiLimits.size(); ++j)
             {
                 double upperPhi = phiLimits[j];
@@ -116,7 +123,7 @@ namespace SingleLayerOptics
         return m_Patches.end();
     }
 
-    std::vector<double> CBSDFDirections::lambdaVector() const
+    const std::vector<double> & CBSDFDirections::lambdaVector() const
     {
         return m_LambdaVector;
     }
@@ -126,15 +133,66 @@ namespace SingleLayerOptics
         return m_LambdaMatrix;
     }
 
+    const std::vector<size_t> & CBSDFDirections::ringSizes() const
+    {
+        return m_RingSizes;
+    }
+
     size_t CBSDFDirections::getNearestBeamIndex(const double t_Theta, const double t_Phi) const
     {
-        auto it = std::find_if(
-          m_Patches.begin(), m_Patches.end(), [&](const CBSDFPatch & a) {
-              return a.isInPatch(t_Theta, t_Phi);
-          });
+        // Patch limits are inclusive and the first patch containing the direction is returned.
+        // Lower rings have precedence on theta limits, which is what lower_bound gives.
+        const auto it = std::lower_bound(m_RingThetaHigh.begin(), m_RingThetaHigh.end(), t_Theta);
+        for(auto ring = size_t(std::distance(m_RingThetaHigh.begin(), it));
+            ring < m_RingThetaHigh.size();
+            ++ring)
+        {
+            const auto index = findInRing(ring, t_Theta, t_Phi);
+            if(index != m_Patches.size())
+            {
+                return index;
+            }
+        }
 
-        size_t index = size_t(std::distance(m_Patches.begin(), it));
-        return index;
+        return m_Patches.size();
+    }
+
+    size_t CBSDFDirections::findInRing(const size_t t_Ring,
+                                       const double t_Theta,
+                                       const double t_Phi) const
+    {
+        const auto first = m_RingFirstIndex[t_Ring];
+        const auto numOfPhis = m_RingSizes[t_Ring];
+        const auto phiLow = m_RingPhiLow[t_Ring];
+
+        if(t_Phi >= phiLow && t_Phi <= phiLow + 360)
+        {
+            // Only patches next to the computed one can contain phi. Checking them in order of
+            // indexes keeps precedence of lower index on the patch limits.
+            const auto bin = size_t((t_Phi - phiLow) / m_RingPhiDelta[t_Ring]) % numOfPhis;
+            std::array<size_t, 3> candidates{
+              {(bin + numOfPhis - 1) % numOfPhis, bin, (bin + 1) % numOfPhis}};
+            std::sort(candidates.begin(), candidates.end());
+            for(const auto candidate : candidates)
+            {
+                if(m_Patches[first + candidate].isInPatch(t_Theta, t_Phi))
+                {
+                    return first + candidate;
+                }
+            }
+        }
+        else
+        {
+            for(size_t i = 0; i < numOfPhis; ++i)
+            {
+                if(m_Patches[first + i].isInPatch(t_Theta, t_Phi))
+                {
+                    return first + i;
+                }
+            }
+        }
+
+        return m_Patches.size();
     }
 
     /////////////////////////////////////////////////////////////////
@@ -170,26 +228,60 @@ namespace SingleLayerOptics
             default:
                 throw std::runtime_error("Incorrect definition of the basis.");
         }
-        m_Directions.insert(std::make_pair(BSDFDirection::Incoming,
-                                           CBSDFDirections(aDefinitions, BSDFDirection::Incoming)));
-        m_Directions.insert(std::make_pair(BSDFDirection::Outgoing,
-                                           CBSDFDirections(aDefinitions, BSDFDirection::Outgoing)));
+        m_Directions = {
+          {BSDFDirection::Incoming,
+           std::make_shared<const CBSDFDirections>(aDefinitions, BSDFDirection::Incoming)},
+          {BSDFDirection::Outgoing,
+           std::make_shared<const CBSDFDirections>(aDefinitions, BSDFDirection::Outgoing)}};
     }
 
     CBSDFHemisphere::CBSDFHemisphere(const std::vector<CBSDFDefinition> & t_Definitions) :
         m_Directions(
-          {{BSDFDirection::Incoming, CBSDFDirections(t_Definitions, BSDFDirection::Incoming)},
-           {BSDFDirection::Outgoing, CBSDFDirections(t_Definitions, BSDFDirection::Outgoing)}})
+          {{BSDFDirection::Incoming,
+            std::make_shared<const CBSDFDirections>(t_Definitions, BSDFDirection::Incoming)},
+           {BSDFDirection::Outgoing,
+            std::make_shared<const CBSDFDirections>(t_Definitions, BSDFDirection::Outgoing)}})
     {}
 
     const CBSDFDirections & CBSDFHemisphere::getDirections(const BSDFDirection tDirection) const
+    {
+        return *m_Directions.at(tDirection);
+    }
+
+    std::shared_ptr<const CBSDFDirections>
+      CBSDFHemisphere::getSharedDirections(const BSDFDirection tDirection) const
     {
         return m_Directions.at(tDirection);
     }
 
     CBSDFHemisphere CBSDFHemisphere::create(BSDFBasis t_Basis)
     {
-        return CBSDFHemisphere(t_Basis);
+        // Initialization of local statics is thread safe. Only the requested basis is built.
+        switch(t_Basis)
+        {
+            case BSDFBasis::Small:
+            {
+                static const CBSDFHemisphere aHemisphere(BSDFBasis::Small);
+                return aHemisphere;
+            }
+            case BSDFBasis::Quarter:
+            {
+                static const CBSDFHemisphere aHemisphere(BSDFBasis::Quarter);
+                return aHemisphere;
+            }
+            case BSDFBasis::Half:
+            {
+                static const CBSDFHemisphere aHemisphere(BSDFBasis::Half);
+                return aHemisphere;
+            }
+            case BSDFBasis::Full:
+            {
+                static const CBSDFHemisphere aHemisphere(BSDFBasis::Full);
+                return aHemisphere;
+            }
+            default:
+                throw std::runtime_error("Incorrect definition of the basis.");
+        }
     }
 
     CBSDFHemisphere CBSDFHemisphere::create(const std::vector<CBSDFDefinition> & t_Definitions)
@@ -39,14 +39,28 @@ namespace SingleLayerOptics
         std::vector<CBSDFPatch>::iterator begin();
         std::vector<CBSDFPatch>::iterator end();
 
-        std::vector<double> lambdaVector() const;
+        const std::vector<double> & lambdaVector() const;
         const FenestrationCommon::SquareMatrix & lambdaMatrix() const;
 
+        // Number of patches in every ring of constant theta
+        const std::vector<size_t> & ringSizes() const;
+
         // returns index of element that is closest to given Theta and Phi angles
         size_t getNearestBeamIndex(double t_Theta, double t_Phi) const;
 
     private:
+        size_t findInRing(size_t t_Ring, double t_Theta, double t_Phi) const;
+
         std::vector<CBSDFPatch> m_Patches;
+        std::vector<size_t> m_RingSizes;
+
+        // Lookup data for nearest beam search. Ring is found by binary search over upper theta
+        // limits and patch within ring from phi step.
+        std::vector<double> m_RingThetaHigh;
+        std::vector<size_t> m_RingFirstIndex;
+        std::vector<double> m_RingPhiLow;
+        std::vector<double> m_RingPhiDelta;
+
         std::vector<double> m_LambdaVector;
         FenestrationCommon::SquareMatrix m_LambdaMatrix;
     };
@@ -59,6 +73,8 @@ namespace SingleLayerOptics
         Full
     };
 
+    // Directions are immutable and shared between copies of hemisphere. Standard bases are built
+    // once per process and every hemisphere created from them shares the same directions.
     class CBSDFHemisphere
     {
     public:
@@ -66,6 +82,7 @@ namespace SingleLayerOptics
         static CBSDFHemisphere create(const std::vector<CBSDFDefinition> & t_Definitions);
 
         const CBSDFDirections & getDirections(BSDFDirection t_Side) const;
+        std::shared_ptr<const CBSDFDirections> getSharedDirections(BSDFDirection t_Side) const;
 
     private:
         // Construction for pre-defined basis
@@ -73,7 +90,7 @@ namespace SingleLayerOptics
         // Construction for custom basis
         explicit CBSDFHemisphere(const std::vector<CBSDFDefinition> & t_Definitions);
 
-        std::map<BSDFDirection, CBSDFDirections> m_Directions;
+        std::map<BSDFDirection, std::shared_ptr<const CBSDFDirections>> m_Directions;
     };
 
 }   // namespace SingleLayerOptics
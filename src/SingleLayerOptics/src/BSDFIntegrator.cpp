@@ -1,3 +1,5 @@
+#include <stdexcept>
+
 #include "BSDFIntegrator.hpp"
 #include "BSDFDirections.hpp"
 #include "BSDFPatch.hpp"
@@ -9,7 +11,7 @@ namespace SingleLayerOptics
 {
     CBSDFIntegrator::CBSDFIntegrator(const std::shared_ptr<const CBSDFIntegrator> & t_Integrator) :
         m_Directions(t_Integrator->m_Directions),
-        m_DimMatrices(m_Directions.size()),
+        m_DimMatrices(m_Directions->size()),
         m_HemisphericalCalculated(false),
         m_DiffuseDiffuseCalculated(false)
     {
@@ -24,8 +26,12 @@ namespace SingleLayerOptics
     }
 
     CBSDFIntegrator::CBSDFIntegrator(const CBSDFDirections & t_Directions) :
+        CBSDFIntegrator(std::make_shared<const CBSDFDirections>(t_Directions))
+    {}
+
+    CBSDFIntegrator::CBSDFIntegrator(const std::shared_ptr<const CBSDFDirections> & t_Directions) :
         m_Directions(t_Directions),
-        m_DimMatrices(m_Directions.size()),
+        m_DimMatrices(m_Directions->size()),
         m_HemisphericalCalculated(false),
         m_DiffuseDiffuseCalculated(false)
     {
@@ -47,14 +53,31 @@ namespace SingleLayerOptics
 
     SquareMatrix & CBSDFIntegrator::getMatrix(const Side t_Side, const PropertySimple t_Property)
     {
-        return m_Matrix[std::make_pair(t_Side, t_Property)];
+        const auto aKey = std::make_pair(t_Side, t_Property);
+        expandMatrix(aKey);
+        // Caller can change any element of the matrix
+        resetStructure(aKey);
+        return m_Matrix[aKey];
     }
 
     const FenestrationCommon::SquareMatrix &
       CBSDFIntegrator::at(const FenestrationCommon::Side t_Side,
                           const FenestrationCommon::PropertySimple t_Property) const
     {
-        return m_Matrix.at(std::make_pair(t_Side, t_Property));
+        const auto aKey = std::make_pair(t_Side, t_Property);
+        if(!m_Compacted.empty() && m_Compacted.count(aKey) > 0)
+        {
+            throw std::runtime_error("BSDF matrix is released by compact. Use matrix() to get "
+                                     "its expanded copy.");
+        }
+        expandMatrix(aKey);
+        return m_Matrix.at(aKey);
+    }
+
+    SquareMatrix CBSDFIntegrator::matrix(const Side t_Side, const PropertySimple t_Property) const
+    {
+        SquareMatrix aExpanded;
+        return lookup(std::make_pair(t_Side, t_Property), aExpanded);
     }
 
     void CBSDFIntegrator::setResultMatrices(const SquareMatrix & t_Tau,
@@ -63,6 +86,227 @@ namespace SingleLayerOptics
     {
         m_Matrix[std::make_pair(t_Side, PropertySimple::T)] = t_Tau;
         m_Matrix[std::make_pair(t_Side, PropertySimple::R)] = t_Rho;
+        resetStructure(std::make_pair(t_Side, PropertySimple::T));
+        resetStructure(std::make_pair(t_Side, PropertySimple::R));
+        m_HemisphericalCalculated = false;
+        m_DiffuseDiffuseCalculated = false;
+    }
+
+    void CBSDFIntegrator::setResultMatrices(const StructuredMatrix & t_Tau,
+                                            const StructuredMatrix & t_Rho,
+                                            Side t_Side)
+    {
+        m_Matrix[std::make_pair(t_Side, PropertySimple::T)] = t_Tau.matrix();
+        m_Matrix[std::make_pair(t_Side, PropertySimple::R)] = t_Rho.matrix();
+        resetStructure(std::make_pair(t_Side, PropertySimple::T));
+        resetStructure(std::make_pair(t_Side, PropertySimple::R));
+        setStructure(std::make_pair(t_Side, PropertySimple::T), t_Tau);
+        setStructure(std::make_pair(t_Side, PropertySimple::R), t_Rho);
+        m_HemisphericalCalculated = false;
+        m_DiffuseDiffuseCalculated = false;
+    }
+
+    void CBSDFIntegrator::setResultMatrices(const AxisymmetricMatrix & t_Tau,
+                                            const AxisymmetricMatrix & t_Rho,
+                                            Side t_Side)
+    {
+        const auto aTauKey = std::make_pair(t_Side, PropertySimple::T);
+        const auto aRhoKey = std::make_pair(t_Side, PropertySimple::R);
+        resetStructure(aTauKey);
+        resetStructure(aRhoKey);
+        m_Axisymmetric.erase(aTauKey);
+        m_Axisymmetric.erase(aRhoKey);
+        m_Axisymmetric.emplace(aTauKey, t_Tau);
+        m_Axisymmetric.emplace(aRhoKey, t_Rho);
+        m_IsAxisymmetric[aTauKey] = true;
+        m_IsAxisymmetric[aRhoKey] = true;
+        m_Unexpanded.insert(aTauKey);
+        m_Unexpanded.insert(aRhoKey);
+        m_HemisphericalCalculated = false;
+        m_DiffuseDiffuseCalculated = false;
+    }
+
+    bool CBSDFIntegrator::isAxisymmetric() const
+    {
+        for(auto t_Side : EnumSide())
+        {
+            for(auto t_Property : EnumPropertySimple())
+            {
+                if(!isAxisymmetric(std::make_pair(t_Side, t_Property)))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    const AxisymmetricMatrix & CBSDFIntegrator::axisymmetricAt(const Side t_Side,
+                                                              const PropertySimple t_Property) const
+    {
+        const auto aKey = std::make_pair(t_Side, t_Property);
+        if(!isAxisymmetric(aKey))
+        {
+            throw std::runtime_error("BSDF matrix is not axisymmetric.");
+        }
+        return m_Axisymmetric.at(aKey);
+    }
+
+    bool CBSDFIntegrator::isAxisymmetric(const pair_Side_PropertySimple & t_Key) const
+    {
+        const auto it = m_IsAxisymmetric.find(t_Key);
+        if(it != m_IsAxisymmetric.end())
+        {
+            return it->second;
+        }
+        SquareMatrix aExpanded;
+        const auto & aMatrix = lookup(t_Key, aExpanded);
+        const auto & aRings = m_Directions->ringSizes();
+        const auto result = AxisymmetricMatrix::isAxisymmetric(aMatrix, aRings);
+        if(result)
+        {
+            m_Axisymmetric.emplace(t_Key, AxisymmetricMatrix(aMatrix, aRings));
+        }
+        m_IsAxisymmetric[t_Key] = result;
+        return result;
+    }
+
+    void CBSDFIntegrator::resetStructure(const pair_Side_PropertySimple & t_Key)
+    {
+        if(!m_Structure.empty())
+        {
+            m_Structure.erase(t_Key);
+            m_LowRank.erase(t_Key);
+        }
+        if(!m_IsAxisymmetric.empty())
+        {
+            m_IsAxisymmetric.erase(t_Key);
+            m_Axisymmetric.erase(t_Key);
+        }
+        m_Unexpanded.erase(t_Key);
+        if(!m_Compacted.empty())
+        {
+            m_Compact.erase(t_Key);
+            m_Compacted.erase(t_Key);
+        }
+    }
+
+    void CBSDFIntegrator::expandMatrix(const pair_Side_PropertySimple & t_Key) const
+    {
+        if(!m_Unexpanded.empty() && m_Unexpanded.count(t_Key) > 0)
+        {
+            m_Matrix[t_Key] = expanded(t_Key);
+            m_Unexpanded.erase(t_Key);
+        }
+    }
+
+    SquareMatrix CBSDFIntegrator::expanded(const pair_Side_PropertySimple & t_Key) const
+    {
+        const auto it = m_Compact.find(t_Key);
+        if(it != m_Compact.end())
+        {
+            return it->second.matrix();
+        }
+        if(m_Axisymmetric.count(t_Key) > 0)
+        {
+            return m_Axisymmetric.at(t_Key).expand();
+        }
+        // Copy of factors is expanded so that stored factors do not keep full matrix
+        return StructuredMatrix(m_LowRank.at(t_Key)).matrix();
+    }
+
+    const SquareMatrix & CBSDFIntegrator::lookup(const pair_Side_PropertySimple & t_Key,
+                                                 SquareMatrix & t_Expanded) const
+    {
+        if(m_Compacted.empty() || m_Compacted.count(t_Key) == 0)
+        {
+            // Per-ring and low rank matrices set by the caller are expanded once and kept
+            expandMatrix(t_Key);
+            return m_Matrix.at(t_Key);
+        }
+        t_Expanded = expanded(t_Key);
+        return t_Expanded;
+    }
+
+    void CBSDFIntegrator::compact()
+    {
+        for(auto t_Side : EnumSide())
+        {
+            for(auto t_Property : EnumPropertySimple())
+            {
+                const auto aKey = std::make_pair(t_Side, t_Property);
+                if(m_Unexpanded.count(aKey) > 0)
+                {
+                    continue;
+                }
+                // Structure is detected before release since detection needs full matrix
+                const auto aStructure = structure(t_Side, t_Property);
+                if(!isAxisymmetric(aKey) && aStructure != MatrixStructure::LowRank)
+                {
+                    m_Compact.emplace(aKey, FloatMatrix(m_Matrix.at(aKey)));
+                }
+                m_Matrix.erase(aKey);
+                m_Unexpanded.insert(aKey);
+                m_Compacted.insert(aKey);
+            }
+        }
+    }
+
+    bool CBSDFIntegrator::isCompacted(const Side t_Side, const PropertySimple t_Property) const
+    {
+        return m_Compacted.count(std::make_pair(t_Side, t_Property)) > 0;
+    }
+
+    MatrixStructure CBSDFIntegrator::structure(const Side t_Side,
+                                               const PropertySimple t_Property) const
+    {
+        const auto aKey = std::make_pair(t_Side, t_Property);
+        const auto it = m_Structure.find(aKey);
+        if(it != m_Structure.end())
+        {
+            return it->second;
+        }
+        SquareMatrix aExpanded;
+        const auto & aMatrix = lookup(aKey, aExpanded);
+        if(aMatrix.isDiagonal())
+        {
+            m_Structure[aKey] = MatrixStructure::Diagonal;
+        }
+        else if(StructuredMatrix::hasConstantColumns(aMatrix))
+        {
+            setStructure(aKey, StructuredMatrix::fromConstantColumns(aMatrix));
+        }
+        else
+        {
+            m_Structure[aKey] = MatrixStructure::Dense;
+        }
+        return m_Structure.at(aKey);
+    }
+
+    StructuredMatrix CBSDFIntegrator::structuredAt(const Side t_Side,
+                                                   const PropertySimple t_Property) const
+    {
+        const auto aStructure = structure(t_Side, t_Property);
+        if(aStructure == MatrixStructure::LowRank)
+        {
+            return m_LowRank.at(std::make_pair(t_Side, t_Property));
+        }
+        SquareMatrix aExpanded;
+        return StructuredMatrix(lookup(std::make_pair(t_Side, t_Property), aExpanded), aStructure);
+    }
+
+    void CBSDFIntegrator::setStructure(const pair_Side_PropertySimple & t_Key,
+                                       const StructuredMatrix & t_Matrix) const
+    {
+        m_Structure[t_Key] = t_Matrix.structure();
+        if(t_Matrix.isLowRank())
+        {
+            // Only factors are kept since full matrix is already stored
+            m_LowRank.erase(t_Key);
+            m_LowRank.emplace(
+              t_Key,
+              StructuredMatrix(t_Matrix.diagonal(), t_Matrix.leftFactors(), t_Matrix.rightFactors()));
+        }
     }
 
     double CBSDFIntegrator::DirDir(const Side t_Side,
@@ -70,18 +314,17 @@ namespace SingleLayerOptics
                                    const double t_Theta,
                                    const double t_Phi) const
     {
-        const auto index = m_Directions.getNearestBeamIndex(t_Theta, t_Phi);
-        const auto lambda = m_Directions.lambdaVector()[index];
-        const auto tau = at(t_Side, t_Property)(index, index);
-        return tau * lambda;
+        const auto index = m_Directions->getNearestBeamIndex(t_Theta, t_Phi);
+        return DirDir(t_Side, t_Property, index);
     }
 
     double CBSDFIntegrator::DirDir(const Side t_Side,
                                    const PropertySimple t_Property,
                                    const size_t Index) const
     {
-        const auto lambda = m_Directions.lambdaVector()[Index];
-        const auto tau = at(t_Side, t_Property)(Index, Index);
+        const auto lambda = m_Directions->lambdaVector()[Index];
+        SquareMatrix aExpanded;
+        const auto tau = lookup(std::make_pair(t_Side, t_Property), aExpanded)(Index, Index);
         return tau * lambda;
     }
 
@@ -103,13 +346,13 @@ namespace SingleLayerOptics
                                    const double t_Theta,
                                    const double t_Phi)
     {
-        const auto index = m_Directions.getNearestBeamIndex(t_Theta, t_Phi);
+        const auto index = m_Directions->getNearestBeamIndex(t_Theta, t_Phi);
         return DirHem(t_Side, t_Property)[index];
     }
 
     double CBSDFIntegrator::Abs(const Side t_Side, const double t_Theta, const double t_Phi)
     {
-        const auto index = m_Directions.getNearestBeamIndex(t_Theta, t_Phi);
+        const auto index = m_Directions->getNearestBeamIndex(t_Theta, t_Phi);
         return Abs(t_Side)[index];
     }
 
@@ -118,25 +361,50 @@ namespace SingleLayerOptics
         return Abs(t_Side)[Index];
     }
 
-    std::vector<double> CBSDFIntegrator::lambdaVector() const
+    const std::vector<double> & CBSDFIntegrator::lambdaVector() const
+    {
+        return m_Directions->lambdaVector();
+    }
+
+    std::shared_ptr<const CBSDFDirections> CBSDFIntegrator::getDirections() const
+    {
+        return m_Directions;
+    }
+
+    const SquareMatrix & CBSDFIntegrator::lambdaMatrix() const
     {
-        return m_Directions.lambdaVector();
+        return m_Directions->lambdaMatrix();
     }
 
-    SquareMatrix CBSDFIntegrator::lambdaMatrix() const
+    StructuredMatrix CBSDFIntegrator::structuredLambdaMatrix() const
     {
-        return m_Directions.lambdaMatrix();
+        return StructuredMatrix(m_Directions->lambdaVector());
+    }
+
+    AxisymmetricMatrix CBSDFIntegrator::axisymmetricLambdaMatrix() const
+    {
+        // Lambda depends on theta only and it is therefore constant over every ring
+        const auto & aRings = m_Directions->ringSizes();
+        std::vector<double> aLambdas;
+        size_t index = 0;
+        for(const auto ringSize : aRings)
+        {
+            aLambdas.push_back((*m_Directions)[index].lambda());
+            index += ringSize;
+        }
+        return AxisymmetricMatrix(aRings, aLambdas);
     }
 
     double CBSDFIntegrator::integrate(SquareMatrix const & t_Matrix) const
     {
         using ConstantsData::WCE_PI;
+        const auto & aDirections = *m_Directions;
         double sum = 0;
         for(size_t i = 0; i < m_DimMatrices; ++i)
         {
             for(size_t j = 0; j < m_DimMatrices; ++j)
             {
-                sum += t_Matrix(i, j) * m_Directions[i].lambda() * m_Directions[j].lambda();
+                sum += t_Matrix(i, j) * aDirections[i].lambda() * aDirections[j].lambda();
             }
         }
         return sum / WCE_PI;
@@ -150,7 +418,9 @@ namespace SingleLayerOptics
             {
                 for(auto t_Property : EnumPropertySimple())
                 {
-                    m_MapDiffDiff(t_Side, t_Property) = integrate(getMatrix(t_Side, t_Property));
+                    SquareMatrix aExpanded;
+                    m_MapDiffDiff(t_Side, t_Property) =
+                      integrate(lookup(std::make_pair(t_Side, t_Property), aExpanded));
                 }
             }
             m_DiffuseDiffuseCalculated = true;
@@ -159,7 +429,7 @@ namespace SingleLayerOptics
 
     size_t CBSDFIntegrator::getNearestBeamIndex(const double t_Theta, const double t_Phi) const
     {
-        return m_Directions.getNearestBeamIndex(t_Theta, t_Phi);
+        return m_Directions->getNearestBeamIndex(t_Theta, t_Phi);
     }
 
     void CBSDFIntegrator::calcHemispherical()
@@ -170,8 +440,9 @@ namespace SingleLayerOptics
             {
                 for(PropertySimple t_Property : EnumPropertySimple())
                 {
-                    m_Hem[std::make_pair(t_Side, t_Property)] =
-                      m_Directions.lambdaVector() * m_Matrix.at(std::make_pair(t_Side, t_Property));
+                    const auto aKey = std::make_pair(t_Side, t_Property);
+                    SquareMatrix aExpanded;
+                    m_Hem[aKey] = m_Directions->lambdaVector() * lookup(aKey, aExpanded);
                 }
                 m_Abs[t_Side] = std::vector<double>();
             }
@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 #include <map>
+#include <set>
 #include <WCECommon.hpp>
 
 #include "BSDFDirections.hpp"
@@ -11,6 +12,10 @@
 namespace FenestrationCommon
 {
     class SquareMatrix;
+    class StructuredMatrix;
+    class AxisymmetricMatrix;
+    class FloatMatrix;
+    enum class MatrixStructure;
     enum class Side;
     enum class PropertySimple;
 
@@ -21,22 +26,63 @@ namespace SingleLayerOptics
     typedef std::pair<FenestrationCommon::Side, FenestrationCommon::PropertySimple> pair_Side_PropertySimple;
 
     // Layer results from BSDF directions.
+    //
+    // Const members fill mutable caches on first request (structure and axisymmetry of matrices,
+    // full matrices expanded from per-ring or low rank data). Integrator is therefore not safe for
+    // concurrent use, even if all threads only call const members. Threads that share integrator
+    // need to synchronise access or fill the caches before sharing by calling structure and
+    // isAxisymmetric for every matrix.
     class CBSDFIntegrator
     {
     public:
         explicit CBSDFIntegrator(const std::shared_ptr<const CBSDFIntegrator> & t_Integrator);
         explicit CBSDFIntegrator(const CBSDFDirections & t_Directions);
-
-        // Result matrices
+        // Directions are shared with hemisphere and other integrators instead of being copied
+        explicit CBSDFIntegrator(const std::shared_ptr<const CBSDFDirections> & t_Directions);
+
+        // Result matrices. Structure, axisymmetry and compact form of the matrix are cached and
+        // getMatrix resets these caches only when it is called. Returned reference may be used
+        // to change the matrix only until the next call to any other member of the integrator
+        // (structure queries, composition or compact would otherwise use stale caches, and
+        // compact releases the matrix). Call getMatrix again for every new set of changes.
         FenestrationCommon::SquareMatrix & getMatrix(FenestrationCommon::Side t_Side,
             FenestrationCommon::PropertySimple t_Property);
 
+        // Returned reference is invalidated by compact. Throws for matrices released by compact
+        // (use matrix for these).
         const FenestrationCommon::SquareMatrix & at(FenestrationCommon::Side t_Side,
             FenestrationCommon::PropertySimple t_Property) const;
 
+        // Copy of result matrix. Matrix released by compact is expanded into the copy and stays
+        // in compact form.
+        FenestrationCommon::SquareMatrix matrix(FenestrationCommon::Side t_Side,
+            FenestrationCommon::PropertySimple t_Property) const;
+
         void setResultMatrices(const FenestrationCommon::SquareMatrix & t_Tau,
                                const FenestrationCommon::SquareMatrix & t_Rho,
                                FenestrationCommon::Side t_Side);
+        void setResultMatrices(const FenestrationCommon::StructuredMatrix & t_Tau,
+                               const FenestrationCommon::StructuredMatrix & t_Rho,
+                               FenestrationCommon::Side t_Side);
+
+        // Structure of result matrix (diagonal for specular layers, diagonal plus rank one for
+        // uniform diffuse layers). It is detected on first request and reset whenever matrix is
+        // accessed through getMatrix.
+        FenestrationCommon::MatrixStructure structure(FenestrationCommon::Side t_Side,
+            FenestrationCommon::PropertySimple t_Property) const;
+
+        // Result matrix together with its structure. Used by multilayer composition.
+        FenestrationCommon::StructuredMatrix structuredAt(FenestrationCommon::Side t_Side,
+            FenestrationCommon::PropertySimple t_Property) const;
+
+        // Rotationally symmetric layers (specular, perfectly diffuse, circular perforated) are
+        // described with per-ring data only. Full matrices are expanded when requested.
+        void setResultMatrices(const FenestrationCommon::AxisymmetricMatrix & t_Tau,
+                               const FenestrationCommon::AxisymmetricMatrix & t_Rho,
+                               FenestrationCommon::Side t_Side);
+        bool isAxisymmetric() const;
+        const FenestrationCommon::AxisymmetricMatrix & axisymmetricAt(FenestrationCommon::Side t_Side,
+            FenestrationCommon::PropertySimple t_Property) const;
 
         // Direct-direct components
         double DirDir(FenestrationCommon::Side t_Side,
@@ -44,11 +90,11 @@ namespace SingleLayerOptics
                       double t_Theta = 0,
                       double t_Phi = 0) const;
         double DirDir(FenestrationCommon::Side t_Side,
-        	FenestrationCommon::PropertySimple t_Property, size_t Index) const;
+            FenestrationCommon::PropertySimple t_Property, size_t Index) const;
 
         // Directional hemispherical results for every direction in BSDF definition
         std::vector<double> DirHem(FenestrationCommon::Side t_Side,
-        	FenestrationCommon::PropertySimple t_Property);
+            FenestrationCommon::PropertySimple t_Property);
         std::vector<double> Abs(FenestrationCommon::Side t_Side);
 
         // Directional hemispherical results for given Theta and Phi direction
@@ -59,18 +105,29 @@ namespace SingleLayerOptics
         double Abs(FenestrationCommon::Side t_Side, double t_Theta, double t_Phi);
         double Abs(FenestrationCommon::Side t_Side, size_t Index);
 
-        // std::shared_ptr< const CBSDFDirections > getDirections() const;
+        std::shared_ptr<const CBSDFDirections> getDirections() const;
 
         double DiffDiff(FenestrationCommon::Side t_Side, FenestrationCommon::PropertySimple t_Property);
 
         // Lambda values for the layer.
-        std::vector<double> lambdaVector() const;
-        FenestrationCommon::SquareMatrix lambdaMatrix() const;
+        const std::vector<double> & lambdaVector() const;
+        const FenestrationCommon::SquareMatrix & lambdaMatrix() const;
+        FenestrationCommon::StructuredMatrix structuredLambdaMatrix() const;
+        FenestrationCommon::AxisymmetricMatrix axisymmetricLambdaMatrix() const;
 
         size_t getNearestBeamIndex(double t_Theta, double t_Phi) const;
 
+        // Releases double precision result matrices. Dense and diagonal matrices are kept in
+        // single precision, low rank matrices as their factors and axisymmetric matrices as
+        // per-ring data. Reading members (matrix, structuredAt, DirDir, DirHem, ...) expand
+        // temporary double precision copies and keep matrices compact. Only getMatrix, which
+        // allows changes of the matrix, stores it in double precision again.
+        void compact();
+        bool isCompacted(FenestrationCommon::Side t_Side,
+                         FenestrationCommon::PropertySimple t_Property) const;
+
     protected:
-        const CBSDFDirections m_Directions;
+        std::shared_ptr<const CBSDFDirections> m_Directions;
         size_t m_DimMatrices;
 
     private:
@@ -80,7 +137,31 @@ namespace SingleLayerOptics
         void calcDiffuseDiffuse();
         void calcHemispherical();
 
-        std::map<pair_Side_PropertySimple, FenestrationCommon::SquareMatrix> m_Matrix;
+        // Clears everything that is known about matrix structure
+        void resetStructure(const pair_Side_PropertySimple & t_Key);
+        void setStructure(const pair_Side_PropertySimple & t_Key,
+                          const FenestrationCommon::StructuredMatrix & t_Matrix) const;
+        void expandMatrix(const pair_Side_PropertySimple & t_Key) const;
+        // Full matrix from per-ring data, low rank factors or single precision values
+        FenestrationCommon::SquareMatrix expanded(const pair_Side_PropertySimple & t_Key) const;
+        // Stored full matrix or, if matrix is released by compact, its expansion into t_Expanded
+        const FenestrationCommon::SquareMatrix &
+          lookup(const pair_Side_PropertySimple & t_Key,
+                 FenestrationCommon::SquareMatrix & t_Expanded) const;
+        bool isAxisymmetric(const pair_Side_PropertySimple & t_Key) const;
+
+        mutable std::map<pair_Side_PropertySimple, FenestrationCommon::SquareMatrix> m_Matrix;
+        mutable std::map<pair_Side_PropertySimple, FenestrationCommon::MatrixStructure> m_Structure;
+        // Factors of diagonal plus low rank matrices
+        mutable std::map<pair_Side_PropertySimple, FenestrationCommon::StructuredMatrix> m_LowRank;
+        mutable std::map<pair_Side_PropertySimple, bool> m_IsAxisymmetric;
+        mutable std::map<pair_Side_PropertySimple, FenestrationCommon::AxisymmetricMatrix> m_Axisymmetric;
+        // Matrices that are set through per-ring data or released by compact and not yet expanded
+        // to full size
+        mutable std::set<pair_Side_PropertySimple> m_Unexpanded;
+        mutable std::map<pair_Side_PropertySimple, FenestrationCommon::FloatMatrix> m_Compact;
+        // Matrices released by compact
+        std::set<pair_Side_PropertySimple> m_Compacted;
         std::map<pair_Side_PropertySimple, std::vector<double>> m_Hem;
         std::map<FenestrationCommon::Side, std::vector<double>> m_Abs;
 
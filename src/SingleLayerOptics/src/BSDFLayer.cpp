@@ -1,3 +1,5 @@
+#include <stdexcept>
+
 #include "BSDFLayer.hpp"
 #include "BaseCell.hpp"
 #include "BSDFDirections.hpp"
@@ -21,7 +23,7 @@ namespace SingleLayerOptics
         // TODO: Maybe to refactor results to incoming and outgoing if not affecting speed.
         // This is not necessary before axisymmetry is introduced
         m_Results = std::make_shared<CBSDFIntegrator>(
-          m_BSDFHemisphere.getDirections(BSDFDirection::Incoming));
+          m_BSDFHemisphere.getSharedDirections(BSDFDirection::Incoming));
     }
 
     void CBSDFLayer::setSourceData(CSeries &t_SourceData)
@@ -29,6 +31,7 @@ namespace SingleLayerOptics
         m_Cell->setSourceData(t_SourceData);
         m_Calculated = false;
         m_CalculatedWV = false;
+        m_BandResults.clear();
     }
 
     const CBSDFDirections & CBSDFLayer::getDirections(const BSDFDirection t_Side) const
@@ -36,6 +39,12 @@ namespace SingleLayerOptics
         return m_BSDFHemisphere.getDirections(t_Side);
     }
 
+    std::shared_ptr<const CBSDFDirections>
+      CBSDFLayer::getSharedDirections(const BSDFDirection t_Side) const
+    {
+        return m_BSDFHemisphere.getSharedDirections(t_Side);
+    }
+
     std::shared_ptr<CBSDFIntegrator> CBSDFLayer::getResults()
     {
         if(!m_Calculated)
@@ -56,6 +65,31 @@ namespace SingleLayerOptics
         return m_WVResults;
     }
 
+    std::shared_ptr<CBSDFIntegrator> CBSDFLayer::getBandResults(const size_t t_BandIndex)
+    {
+        if(m_CalculatedWV)
+        {
+            return m_WVResults->at(t_BandIndex);
+        }
+        const auto size = m_Cell->getBandSize();
+        if(t_BandIndex >= size)
+        {
+            throw std::runtime_error("Band index for BSDF results is out of range.");
+        }
+        m_BandResults.resize(size);
+        if(m_BandResults[t_BandIndex] == nullptr)
+        {
+            m_BandResults[t_BandIndex] = calculateBand(t_BandIndex);
+        }
+        return m_BandResults[t_BandIndex];
+    }
+
+    bool CBSDFLayer::isBandCalculated(const size_t t_BandIndex) const
+    {
+        return m_CalculatedWV
+               || (t_BandIndex < m_BandResults.size() && m_BandResults[t_BandIndex] != nullptr);
+    }
+
     int CBSDFLayer::getBandIndex(const double t_Wavelength)
     {
         return m_Cell->getBandIndex(t_Wavelength);
@@ -68,13 +102,14 @@ namespace SingleLayerOptics
 
 	void CBSDFLayer::setBandWavelengths( const std::vector< double > & wavelengths ) {
 		m_Cell->setBandWavelengths(wavelengths);
+		m_BandResults.clear();
 	}
 
     void CBSDFLayer::calc_dir_dir()
     {
         for(Side t_Side : EnumSide())
         {
-            CBSDFDirections aDirections = m_BSDFHemisphere.getDirections(BSDFDirection::Incoming);
+            const auto & aDirections = m_BSDFHemisphere.getDirections(BSDFDirection::Incoming);
             size_t size = aDirections.size();
             SquareMatrix tau{size};
             SquareMatrix rho{size};
@@ -89,7 +124,11 @@ namespace SingleLayerOptics
                 tau(i, i) += aTau / Lambda;
                 rho(i, i) += aRho / Lambda;
             }
-            m_Results->setResultMatrices(tau, rho, t_Side);
+            // Diffuse distribution (if any) is added later through getMatrix, which resets
+            // diagonal structure of the results.
+            m_Results->setResultMatrices(StructuredMatrix(tau, MatrixStructure::Diagonal),
+                                         StructuredMatrix(rho, MatrixStructure::Diagonal),
+                                         t_Side);
         }
     }
 
@@ -118,6 +157,28 @@ namespace SingleLayerOptics
         }
     }
 
+    void CBSDFLayer::calc_dir_dir_band(const size_t t_BandIndex, CBSDFIntegrator & t_Results)
+    {
+        for(Side t_Side : EnumSide())
+        {
+            const auto & aDirections = m_BSDFHemisphere.getDirections(BSDFDirection::Incoming);
+            size_t size = aDirections.size();
+            SquareMatrix tau{size};
+            SquareMatrix rho{size};
+            for(size_t i = 0; i < size; ++i)
+            {
+                const CBeamDirection aDirection = aDirections[i].centerPoint();
+                const double Lambda = aDirections[i].lambda();
+
+                tau(i, i) += m_Cell->T_dir_dir_at_band(t_Side, aDirection, t_BandIndex) / Lambda;
+                rho(i, i) += m_Cell->R_dir_dir_at_band(t_Side, aDirection, t_BandIndex) / Lambda;
+            }
+            t_Results.setResultMatrices(StructuredMatrix(tau, MatrixStructure::Diagonal),
+                                        StructuredMatrix(rho, MatrixStructure::Diagonal),
+                                        t_Side);
+        }
+    }
+
     void CBSDFLayer::calc_dir_dif()
     {
         for(Side aSide : EnumSide())
@@ -148,6 +209,21 @@ namespace SingleLayerOptics
         }
     }
 
+    void CBSDFLayer::calc_dir_dif_band(const size_t t_BandIndex, CBSDFIntegrator & t_Results)
+    {
+        for(Side aSide : EnumSide())
+        {
+            const auto & aDirections = m_BSDFHemisphere.getDirections(BSDFDirection::Incoming);
+
+            size_t size = aDirections.size();
+            for(size_t i = 0; i < size; ++i)
+            {
+                const CBeamDirection aDirection = aDirections[i].centerPoint();
+                calcDiffuseDistribution_band(aSide, aDirection, i, t_BandIndex, t_Results);
+            }
+        }
+    }
+
     void CBSDFLayer::fillWLResultsFromMaterialCell()
     {
         m_WVResults = std::make_shared<std::vector<std::shared_ptr<CBSDFIntegrator>>>();
@@ -155,13 +231,14 @@ namespace SingleLayerOptics
         for(size_t i = 0; i < size; ++i)
         {
             std::shared_ptr<CBSDFIntegrator> aResults = std::make_shared<CBSDFIntegrator>(
-              m_BSDFHemisphere.getDirections(BSDFDirection::Incoming));
+              m_BSDFHemisphere.getSharedDirections(BSDFDirection::Incoming));
             m_WVResults->push_back(aResults);
         }
     }
 
     void CBSDFLayer::calculate()
     {
+        WCE_SCOPED_TIMER("CBSDFLayer::calculate");
         fillWLResultsFromMaterialCell();
         calc_dir_dir();
         calc_dir_dif();
@@ -169,11 +246,22 @@ namespace SingleLayerOptics
 
     void CBSDFLayer::calculate_wv()
     {
+        WCE_SCOPED_TIMER("CBSDFLayer::calculate_wv");
         fillWLResultsFromMaterialCell();
         calc_dir_dir_wv();
         calc_dir_dif_wv();
     }
 
+    std::shared_ptr<CBSDFIntegrator> CBSDFLayer::calculateBand(const size_t t_BandIndex)
+    {
+        WCE_SCOPED_TIMER("CBSDFLayer::calculateBand");
+        auto aResults = std::make_shared<CBSDFIntegrator>(
+          m_BSDFHemisphere.getSharedDirections(BSDFDirection::Incoming));
+        calc_dir_dir_band(t_BandIndex, *aResults);
+        calc_dir_dif_band(t_BandIndex, *aResults);
+        return aResults;
+    }
+
     std::shared_ptr<CBaseCell> CBSDFLayer::getCell() const
     {
         return m_Cell;
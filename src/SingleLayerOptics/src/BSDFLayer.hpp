@@ -40,10 +40,18 @@ namespace SingleLayerOptics
         std::shared_ptr<CBSDFIntegrator> getResults();
 
         const CBSDFDirections & getDirections(BSDFDirection t_Side) const;
+        std::shared_ptr<const CBSDFDirections> getSharedDirections(BSDFDirection t_Side) const;
 
         // BSDF results for each wavelenght given in specular cell
         std::shared_ptr<BSDF_Results> getWavelengthResults();
 
+        // BSDF results for single band of the material. Only requested band is calculated and
+        // results are kept until source data or band wavelengths are changed.
+        std::shared_ptr<CBSDFIntegrator> getBandResults(size_t t_BandIndex);
+
+        // True if results of given band are already calculated
+        bool isBandCalculated(size_t t_BandIndex) const;
+
         int getBandIndex(double t_Wavelength);
 
         std::vector<double> getBandWavelengths() const;
@@ -63,12 +71,23 @@ namespace SingleLayerOptics
                                                 const CBeamDirection & t_Direction,
                                                 const size_t t_DirectionIndex) = 0;
 
+        virtual void calcDiffuseDistribution_band(const FenestrationCommon::Side aSide,
+                                                  const CBeamDirection & t_Direction,
+                                                  const size_t t_DirectionIndex,
+                                                  const size_t t_BandIndex,
+                                                  CBSDFIntegrator & t_Results) = 0;
+
         // BSDF layer is not calculated by default because it is time consuming process and in some
         // cases this call is not necessary. However, refactoring is needed since there is no reason
         // to create CBSDFLayer if it will not be calculated
         void calculate();
         void calculate_wv();
 
+        // Loops over incoming directions and calls diffuse distribution for each of them
+        virtual void calc_dir_dif();
+        virtual void calc_dir_dif_wv();
+        virtual void calc_dir_dif_band(size_t t_BandIndex, CBSDFIntegrator & t_Results);
+
         const CBSDFHemisphere m_BSDFHemisphere;
         std::shared_ptr<CBaseCell> m_Cell;
         std::shared_ptr<CBSDFIntegrator> m_Results;
@@ -77,7 +96,6 @@ namespace SingleLayerOptics
 
     private:
         void calc_dir_dir();
-        void calc_dir_dif();
         void fillWLResultsFromMaterialCell();
         // Keeps state of the object. Calculations are not done by defult (in constructor)
         // becuase they are time consuming.
@@ -85,9 +103,14 @@ namespace SingleLayerOptics
 
         // Calculation of results over each wavelength
         void calc_dir_dir_wv();
-        void calc_dir_dif_wv();
         // State to hold information of wavelength results are already calculated
         bool m_CalculatedWV;
+
+        // Calculation of results for single band
+        std::shared_ptr<CBSDFIntegrator> calculateBand(size_t t_BandIndex);
+        void calc_dir_dir_band(size_t t_BandIndex, CBSDFIntegrator & t_Results);
+        // Results of bands requested through getBandResults (nullptr if band is not calculated)
+        std::vector<std::shared_ptr<CBSDFIntegrator>> m_BandResults;
     };
 
 }   // namespace SingleLayerOptics
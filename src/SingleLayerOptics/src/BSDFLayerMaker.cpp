@@ -17,6 +17,9 @@
 #include "WovenCellDescription.hpp"
 #include "WovenCell.hpp"
 #include "PerfectDiffuseCellDescription.hpp"
+#include "BSDFDirections.hpp"
+#include "BSDFPatch.hpp"
+#include "BeamDirection.hpp"
 #include <WCECommon.hpp>
 
 namespace SingleLayerOptics
@@ -72,9 +75,25 @@ namespace SingleLayerOptics
 										 size_t numOfSlatSegments,
 										 DistributionMethod method )
     {
-        std::shared_ptr<ICellDescription> aCellDescription =
-          std::make_shared<CVenetianCellDescription>(
-            slatWidth, slatSpacing, slatTiltAngle, curvatureRadius, numOfSlatSegments);
+        auto aVenetianDescription = std::make_shared<CVenetianCellDescription>(
+          slatWidth, slatSpacing, slatTiltAngle, curvatureRadius, numOfSlatSegments);
+
+        // Beam view factors of all basis directions are calculated in single sweep. Back side
+        // directions are asked with opposite profile angle.
+        std::vector<double> aProfileAngles;
+        for(auto aSide : {BSDFDirection::Incoming, BSDFDirection::Outgoing})
+        {
+            const auto & aDirections = t_BSDF.getDirections(aSide);
+            for(size_t i = 0; i < aDirections.size(); ++i)
+            {
+                const auto aProfileAngle = aDirections[i].centerPoint().profileAngle();
+                aProfileAngles.push_back(aProfileAngle);
+                aProfileAngles.push_back(-aProfileAngle);
+            }
+        }
+        aVenetianDescription->setBeamProfileAngles(aProfileAngles);
+
+        std::shared_ptr<ICellDescription> aCellDescription = aVenetianDescription;
 
         if(method == DistributionMethod::UniformDiffuse)
         {
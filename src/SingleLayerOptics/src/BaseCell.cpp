@@ -61,6 +61,20 @@ namespace SingleLayerOptics
         return aResults;
     }
 
+    double CBaseCell::T_dir_dir_at_band(const Side t_Side,
+                                        const CBeamDirection & t_Direction,
+                                        const size_t t_BandIndex)
+    {
+        return T_dir_dir_band(t_Side, t_Direction).at(t_BandIndex);
+    }
+
+    double CBaseCell::R_dir_dir_at_band(const Side t_Side,
+                                        const CBeamDirection & t_Direction,
+                                        const size_t t_BandIndex)
+    {
+        return R_dir_dir_band(t_Side, t_Direction).at(t_BandIndex);
+    }
+
     std::vector<double> CBaseCell::getBandWavelengths() const
     {
         assert(m_Material != nullptr);
@@ -40,6 +40,16 @@ namespace SingleLayerOptics
         virtual std::vector<double> R_dir_dir_band(const FenestrationCommon::Side t_Side,
                                                    const CBeamDirection & t_Direction);
 
+        // Direct to direct component for single band of the material. Default implementation
+        // picks value from properties of all bands.
+        virtual double T_dir_dir_at_band(const FenestrationCommon::Side t_Side,
+                                         const CBeamDirection & t_Direction,
+                                         size_t t_BandIndex);
+
+        virtual double R_dir_dir_at_band(const FenestrationCommon::Side t_Side,
+                                         const CBeamDirection & t_Direction,
+                                         size_t t_BandIndex);
+
         std::vector<double> getBandWavelengths() const;
         void setBandWavelengths(const std::vector<double> & wavelengths);
         int getBandIndex(double t_Wavelength);
@@ -28,7 +28,32 @@ namespace SingleLayerOptics
         m_LayerY(std::move(layerY)),
         m_LayerZ(std::move(layerZ))
     {
-        auto wavelengths = m_LayerX->getWavelengths();
+        calculateSourceDetectorSums(
+          *m_LayerX, t_Source, t_DetectorX, t_DetectorY, t_DetectorZ, t_wavelengths);
+    }
+
+    ColorProperties::ColorProperties(std::unique_ptr<IMultiDetectorScatteringLayer> && layer,
+                                     const FenestrationCommon::CSeries & t_Source,
+                                     const FenestrationCommon::CSeries & t_DetectorX,
+                                     const FenestrationCommon::CSeries & t_DetectorY,
+                                     const FenestrationCommon::CSeries & t_DetectorZ,
+                                     const std::vector<double> & t_wavelengths) :
+        m_Layer(std::move(layer)),
+        m_Detectors({t_DetectorX, t_DetectorY, t_DetectorZ})
+    {
+        calculateSourceDetectorSums(
+          *m_Layer, t_Source, t_DetectorX, t_DetectorY, t_DetectorZ, t_wavelengths);
+    }
+
+    void ColorProperties::calculateSourceDetectorSums(
+      const IScatteringLayer & layer,
+      const FenestrationCommon::CSeries & t_Source,
+      const FenestrationCommon::CSeries & t_DetectorX,
+      const FenestrationCommon::CSeries & t_DetectorY,
+      const FenestrationCommon::CSeries & t_DetectorZ,
+      const std::vector<double> & t_wavelengths)
+    {
+        auto wavelengths = layer.getWavelengths();
         if(!t_wavelengths.empty())
         {
             wavelengths = t_wavelengths;
@@ -42,9 +67,26 @@ namespace SingleLayerOptics
         DY = DY.interpolate(wavelengths);
         DZ = DZ.interpolate(wavelengths);
 
-        m_SDx = (aSolar * DX).sum(m_LayerX->getMinLambda(), m_LayerX->getMaxLambda());
-        m_SDy = (aSolar * DY).sum(m_LayerX->getMinLambda(), m_LayerX->getMaxLambda());
-        m_SDz = (aSolar * DZ).sum(m_LayerX->getMinLambda(), m_LayerX->getMaxLambda());
+        m_SDx = (aSolar * DX).sum(layer.getMinLambda(), layer.getMaxLambda());
+        m_SDy = (aSolar * DY).sum(layer.getMinLambda(), layer.getMaxLambda());
+        m_SDz = (aSolar * DZ).sum(layer.getMinLambda(), layer.getMaxLambda());
+    }
+
+    std::vector<double> ColorProperties::getXYZ(const FenestrationCommon::PropertySimple t_Property,
+                                                const FenestrationCommon::Side t_Side,
+                                                const FenestrationCommon::Scattering t_Scattering,
+                                                double const t_Theta,
+                                                double const t_Phi)
+    {
+        if(m_Layer != nullptr)
+        {
+            return m_Layer->getPropertiesSimple(
+              t_Property, t_Side, t_Scattering, m_Detectors, t_Theta, t_Phi);
+        }
+
+        return {m_LayerX->getPropertySimple(t_Property, t_Side, t_Scattering, t_Theta, t_Phi),
+                m_LayerY->getPropertySimple(t_Property, t_Side, t_Scattering, t_Theta, t_Phi),
+                m_LayerZ->getPropertySimple(t_Property, t_Side, t_Scattering, t_Theta, t_Phi)};
     }
 
     Trichromatic
@@ -54,12 +96,10 @@ namespace SingleLayerOptics
                                        double const t_Theta,
                                        double const t_Phi)
     {
-        auto X = m_SDx / m_SDy * 100
-                 * m_LayerX->getPropertySimple(t_Property, t_Side, t_Scattering, t_Theta, t_Phi);
-        auto Y =
-          100 * m_LayerY->getPropertySimple(t_Property, t_Side, t_Scattering, t_Theta, t_Phi);
-        auto Z = m_SDz / m_SDy * 100
-                 * m_LayerZ->getPropertySimple(t_Property, t_Side, t_Scattering, t_Theta, t_Phi);
+        const auto XYZ = getXYZ(t_Property, t_Side, t_Scattering, t_Theta, t_Phi);
+        auto X = m_SDx / m_SDy * 100 * XYZ[0];
+        auto Y = 100 * XYZ[1];
+        auto Z = m_SDz / m_SDy * 100 * XYZ[2];
         return Trichromatic(X, Y, Z);
     }
 
@@ -106,11 +146,7 @@ namespace SingleLayerOptics
                                         double const t_Theta,
                                         double const t_Phi)
     {
-        auto X = m_LayerX->getPropertySimple(t_Property, t_Side, t_Scattering, t_Theta, t_Phi);
-        auto Y = m_LayerY->getPropertySimple(t_Property, t_Side, t_Scattering, t_Theta, t_Phi);
-        auto Z = m_LayerZ->getPropertySimple(t_Property, t_Side, t_Scattering, t_Theta, t_Phi);
-
-        std::vector<double> Q{X, Y, Z};
+        auto Q = getXYZ(t_Property, t_Side, t_Scattering, t_Theta, t_Phi);
         for(auto & val : Q)
         {
             val = (val > std::pow(6.0 / 29.0, 3)) ? std::pow(val, 1.0 / 3.0)
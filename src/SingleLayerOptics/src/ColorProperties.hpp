@@ -6,6 +6,7 @@
 
 #include "WCECommon.hpp"
 #include "ScatteringLayer.hpp"
+#include "IScatteringLayer.hpp"
 
 namespace SingleLayerOptics
 {
@@ -49,6 +50,15 @@ namespace SingleLayerOptics
                         const FenestrationCommon::CSeries & t_DetectorZ,
                         const std::vector<double> & t_wavelengths = {});
 
+        /// Single pass mode. Spectral properties of the layer are calculated once and then
+        /// weighted with each of detectors.
+        ColorProperties(std::unique_ptr<IMultiDetectorScatteringLayer> && layer,
+                        const FenestrationCommon::CSeries & t_Source,
+                        const FenestrationCommon::CSeries & t_DetectorX,
+                        const FenestrationCommon::CSeries & t_DetectorY,
+                        const FenestrationCommon::CSeries & t_DetectorZ,
+                        const std::vector<double> & t_wavelengths = {});
+
         Trichromatic getTrichromatic(const FenestrationCommon::PropertySimple t_Property,
                                      const FenestrationCommon::Side t_Side,
                                      const FenestrationCommon::Scattering t_Scattering,
@@ -68,6 +78,22 @@ namespace SingleLayerOptics
                            const double t_Phi = 0);
 
     private:
+        void calculateSourceDetectorSums(const IScatteringLayer & layer,
+                                         const FenestrationCommon::CSeries & t_Source,
+                                         const FenestrationCommon::CSeries & t_DetectorX,
+                                         const FenestrationCommon::CSeries & t_DetectorY,
+                                         const FenestrationCommon::CSeries & t_DetectorZ,
+                                         const std::vector<double> & t_wavelengths);
+
+        // Layer properties weighted with X, Y and Z detectors
+        std::vector<double> getXYZ(const FenestrationCommon::PropertySimple t_Property,
+                                   const FenestrationCommon::Side t_Side,
+                                   const FenestrationCommon::Scattering t_Scattering,
+                                   const double t_Theta,
+                                   const double t_Phi);
+
+        std::unique_ptr<IMultiDetectorScatteringLayer> m_Layer;
+        std::vector<FenestrationCommon::CSeries> m_Detectors;
         std::unique_ptr<IScatteringLayer> m_LayerX;
         std::unique_ptr<IScatteringLayer> m_LayerY;
         std::unique_ptr<IScatteringLayer> m_LayerZ;
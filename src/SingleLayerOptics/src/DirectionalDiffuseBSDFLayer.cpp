@@ -1,6 +1,6 @@
-
 #include <cmath>
 #include <cassert>
+#include <algorithm>
 
 #include "DirectionalDiffuseBSDFLayer.hpp"
 #include "DirectionalDiffuseCell.hpp"
@@ -17,9 +17,15 @@ namespace SingleLayerOptics
     CDirectionalDiffuseBSDFLayer::CDirectionalDiffuseBSDFLayer(
 		const std::shared_ptr< CDirectionalDiffuseCell > & t_Cell,
 		const CBSDFHemisphere & t_Hemisphere ) :
-        CBSDFLayer(t_Cell, t_Hemisphere)
+        CBSDFLayer(t_Cell, t_Hemisphere),
+        m_NumberOfThreads(1)
     {}
 
+    void CDirectionalDiffuseBSDFLayer::setNumberOfThreads(const size_t t_NumberOfThreads)
+    {
+        m_NumberOfThreads = numberOfThreads(t_NumberOfThreads);
+    }
+
     std::shared_ptr<CDirectionalDiffuseCell> CDirectionalDiffuseBSDFLayer::cellAsDirectionalDiffuse() const
     {
         std::shared_ptr<CDirectionalDiffuseCell> aCell = std::dynamic_pointer_cast<CDirectionalDiffuseCell>(m_Cell);
@@ -27,36 +33,140 @@ namespace SingleLayerOptics
         return aCell;
     }
 
-    void CDirectionalDiffuseBSDFLayer::calcDiffuseDistribution(const Side aSide, const CBeamDirection & t_Direction, const size_t t_DirectionIndex)
+    void CDirectionalDiffuseBSDFLayer::calc_dir_dif()
+    {
+        auto aCell = cellAsDirectionalDiffuse();
+        const auto size = m_BSDFHemisphere.getDirections(BSDFDirection::Incoming).size();
+
+        for(Side aSide : EnumSide())
+        {
+            // Matrices are fetched before threads are started because getMatrix can change
+            // structure of the results.
+            auto & tau = m_Results->getMatrix(aSide, PropertySimple::T);
+            auto & rho = m_Results->getMatrix(aSide, PropertySimple::R);
+
+            parallelFor(size, m_NumberOfThreads, [&](const size_t i) {
+                fillColumn(*aCell, aSide, i, tau, rho);
+            });
+        }
+    }
+
+    void CDirectionalDiffuseBSDFLayer::calc_dir_dif_wv()
+    {
+        auto aCell = cellAsDirectionalDiffuse();
+        const auto size = m_BSDFHemisphere.getDirections(BSDFDirection::Incoming).size();
+
+        for(Side aSide : EnumSide())
+        {
+            std::vector<SquareMatrix *> tau;
+            std::vector<SquareMatrix *> rho;
+            for(const auto & aResults : *m_WVResults)
+            {
+                assert(aResults != nullptr);
+                tau.push_back(&aResults->getMatrix(aSide, PropertySimple::T));
+                rho.push_back(&aResults->getMatrix(aSide, PropertySimple::R));
+            }
+
+            parallelFor(size, m_NumberOfThreads, [&](const size_t i) {
+                fillColumn_wv(*aCell, aSide, i, tau, rho);
+            });
+        }
+    }
+
+    void CDirectionalDiffuseBSDFLayer::calc_dir_dif_band(const size_t t_BandIndex,
+                                                         CBSDFIntegrator & t_Results)
     {
-        std::shared_ptr<CDirectionalDiffuseCell> aCell = cellAsDirectionalDiffuse();
+        auto aCell = cellAsDirectionalDiffuse();
+        const auto size = m_BSDFHemisphere.getDirections(BSDFDirection::Incoming).size();
+
+        for(Side aSide : EnumSide())
+        {
+            auto & tau = t_Results.getMatrix(aSide, PropertySimple::T);
+            auto & rho = t_Results.getMatrix(aSide, PropertySimple::R);
+
+            parallelFor(size, m_NumberOfThreads, [&](const size_t i) {
+                fillColumn_band(*aCell, aSide, i, t_BandIndex, tau, rho);
+            });
+        }
+    }
+
+    void CDirectionalDiffuseBSDFLayer::calcDiffuseDistribution(const Side aSide, const CBeamDirection &, const size_t t_DirectionIndex)
+    {
+        auto aCell = cellAsDirectionalDiffuse();
 
         auto & tau = m_Results->getMatrix(aSide, PropertySimple::T);
         auto & Rho = m_Results->getMatrix(aSide, PropertySimple::R);
 
+        fillColumn(*aCell, aSide, t_DirectionIndex, tau, Rho);
+    }
+
+    void CDirectionalDiffuseBSDFLayer::calcDiffuseDistribution_wv(const Side aSide, const CBeamDirection &, const size_t t_DirectionIndex)
+    {
+        auto aCell = cellAsDirectionalDiffuse();
+
+        std::vector<SquareMatrix *> tau;
+        std::vector<SquareMatrix *> rho;
+        for(const auto & aResults : *m_WVResults)
+        {
+            assert(aResults != nullptr);
+            tau.push_back(&aResults->getMatrix(aSide, PropertySimple::T));
+            rho.push_back(&aResults->getMatrix(aSide, PropertySimple::R));
+        }
+
+        fillColumn_wv(*aCell, aSide, t_DirectionIndex, tau, rho);
+    }
+
+    void CDirectionalDiffuseBSDFLayer::calcDiffuseDistribution_band(const Side aSide,
+                                                                    const CBeamDirection &,
+                                                                    const size_t t_DirectionIndex,
+                                                                    const size_t t_BandIndex,
+                                                                    CBSDFIntegrator & t_Results)
+    {
+        auto aCell = cellAsDirectionalDiffuse();
+
+        auto & tau = t_Results.getMatrix(aSide, PropertySimple::T);
+        auto & rho = t_Results.getMatrix(aSide, PropertySimple::R);
+
+        fillColumn_band(*aCell, aSide, t_DirectionIndex, t_BandIndex, tau, rho);
+    }
+
+    void CDirectionalDiffuseBSDFLayer::fillColumn(CDirectionalDiffuseCell & t_Cell,
+                                                  const Side aSide,
+                                                  const size_t t_DirectionIndex,
+                                                  SquareMatrix & t_Tau,
+                                                  SquareMatrix & t_Rho) const
+    {
+        using ConstantsData::WCE_PI;
+
+        const CBeamDirection aDirection =
+          m_BSDFHemisphere.getDirections(BSDFDirection::Incoming)[t_DirectionIndex].centerPoint();
         const auto & jDirections = m_BSDFHemisphere.getDirections(BSDFDirection::Outgoing);
 
         size_t size = jDirections.size();
 
         for(size_t j = 0; j < size; ++j)
         {
-            using ConstantsData::WCE_PI;
-
             const CBeamDirection jDirection = jDirections[j].centerPoint();
 
-            double aTau = aCell->T_dir_dif(aSide, t_Direction, jDirection);
-            double aRho = aCell->R_dir_dif(aSide, t_Direction, jDirection);
+            double aTau = t_Cell.T_dir_dif(aSide, aDirection, jDirection);
+            double aRho = t_Cell.R_dir_dif(aSide, aDirection, jDirection);
 
-            tau(j, t_DirectionIndex) += aTau / WCE_PI;
-            Rho(j, t_DirectionIndex) += aRho / WCE_PI;
+            t_Tau(j, t_DirectionIndex) += aTau / WCE_PI;
+            t_Rho(j, t_DirectionIndex) += aRho / WCE_PI;
         }
     }
 
-    void CDirectionalDiffuseBSDFLayer::calcDiffuseDistribution_wv(const Side aSide, const CBeamDirection & t_Direction, const size_t t_DirectionIndex)
+    void CDirectionalDiffuseBSDFLayer::fillColumn_wv(CDirectionalDiffuseCell & t_Cell,
+                                                     const Side aSide,
+                                                     const size_t t_DirectionIndex,
+                                                     const std::vector<SquareMatrix *> & t_Tau,
+                                                     const std::vector<SquareMatrix *> & t_Rho) const
     {
-        std::shared_ptr<CDirectionalDiffuseCell> aCell = cellAsDirectionalDiffuse();
+        using ConstantsData::WCE_PI;
 
-        const CBSDFDirections iDirections = m_BSDFHemisphere.getDirections(BSDFDirection::Outgoing);
+        const CBeamDirection aDirection =
+          m_BSDFHemisphere.getDirections(BSDFDirection::Incoming)[t_DirectionIndex].centerPoint();
+        const auto & iDirections = m_BSDFHemisphere.getDirections(BSDFDirection::Outgoing);
 
         size_t size = iDirections.size();
 
@@ -64,23 +174,44 @@ namespace SingleLayerOptics
         {
             const CBeamDirection iDirection = iDirections[i].centerPoint();
 
-            std::shared_ptr<std::vector<double>> aTau = aCell->T_dir_dif_band(aSide, t_Direction, iDirection);
-            std::shared_ptr<std::vector<double>> Ref = aCell->R_dir_dif_band(aSide, t_Direction, iDirection);
+            std::shared_ptr<std::vector<double>> aTau = t_Cell.T_dir_dif_band(aSide, aDirection, iDirection);
+            std::shared_ptr<std::vector<double>> Ref = t_Cell.R_dir_dif_band(aSide, aDirection, iDirection);
 
             size_t numWV = aTau->size();
+            assert(numWV <= t_Tau.size());
             for(size_t j = 0; j < numWV; ++j)
             {
-                using ConstantsData::WCE_PI;
-
-                std::shared_ptr<CBSDFIntegrator> aResults = nullptr;
-                aResults = (*m_WVResults)[j];
-                assert(aResults != nullptr);
-                auto & tau = aResults->getMatrix(aSide, PropertySimple::T);
-                auto & rho = aResults->getMatrix(aSide, PropertySimple::R);
-                tau(i, t_DirectionIndex) += (*aTau)[j] / WCE_PI;
-                rho(i, t_DirectionIndex) += (*Ref)[j] / WCE_PI;
+                (*t_Tau[j])(i, t_DirectionIndex) += (*aTau)[j] / WCE_PI;
+                (*t_Rho[j])(i, t_DirectionIndex) += (*Ref)[j] / WCE_PI;
             }
         }
     }
 
+    void CDirectionalDiffuseBSDFLayer::fillColumn_band(CDirectionalDiffuseCell & t_Cell,
+                                                       const Side aSide,
+                                                       const size_t t_DirectionIndex,
+                                                       const size_t t_BandIndex,
+                                                       SquareMatrix & t_Tau,
+                                                       SquareMatrix & t_Rho) const
+    {
+        using ConstantsData::WCE_PI;
+
+        const CBeamDirection aDirection =
+          m_BSDFHemisphere.getDirections(BSDFDirection::Incoming)[t_DirectionIndex].centerPoint();
+        const auto & jDirections = m_BSDFHemisphere.getDirections(BSDFDirection::Outgoing);
+
+        size_t size = jDirections.size();
+
+        for(size_t j = 0; j < size; ++j)
+        {
+            const CBeamDirection jDirection = jDirections[j].centerPoint();
+
+            double aTau = t_Cell.T_dir_dif_at_band(aSide, aDirection, jDirection, t_BandIndex);
+            double aRho = t_Cell.R_dir_dif_at_band(aSide, aDirection, jDirection, t_BandIndex);
+
+            t_Tau(j, t_DirectionIndex) += aTau / WCE_PI;
+            t_Rho(j, t_DirectionIndex) += aRho / WCE_PI;
+        }
+    }
+
 }   // namespace SingleLayerOptics
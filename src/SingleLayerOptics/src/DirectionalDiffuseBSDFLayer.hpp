@@ -2,9 +2,16 @@
 #define DIRECTIONALDIFFUSEBSDFLAYER_H
 
 #include <memory>
+#include <vector>
 
 #include "BSDFLayer.hpp"
 
+namespace FenestrationCommon {
+
+	class SquareMatrix;
+
+}
+
 namespace SingleLayerOptics {
 
 	class CDirectionalDiffuseCell;
@@ -15,7 +22,16 @@ namespace SingleLayerOptics {
 		CDirectionalDiffuseBSDFLayer( const std::shared_ptr< CDirectionalDiffuseCell > & t_Cell,
 									  const CBSDFHemisphere & t_Hemisphere );
 
+		// Incoming directions are split into contiguous blocks, one for each thread. Every thread
+		// writes only columns of its own incoming directions. Zero means number of hardware
+		// threads. Default is one thread (serial calculation).
+		void setNumberOfThreads( size_t t_NumberOfThreads );
+
 	protected:
+		void calc_dir_dif() override;
+		void calc_dir_dif_wv() override;
+		void calc_dir_dif_band( size_t t_BandIndex, CBSDFIntegrator & t_Results ) override;
+
 		std::shared_ptr< CDirectionalDiffuseCell > cellAsDirectionalDiffuse() const;
 		void calcDiffuseDistribution( const FenestrationCommon::Side aSide,
 		                              const CBeamDirection& t_Direction,
@@ -23,6 +39,31 @@ namespace SingleLayerOptics {
 		void calcDiffuseDistribution_wv( const FenestrationCommon::Side aSide,
 		                                 const CBeamDirection& t_Direction,
 		                                 const size_t t_DirectionIndex );
+		void calcDiffuseDistribution_band( const FenestrationCommon::Side aSide,
+		                                   const CBeamDirection& t_Direction,
+		                                   const size_t t_DirectionIndex,
+		                                   const size_t t_BandIndex,
+		                                   CBSDFIntegrator & t_Results );
+
+	private:
+		void fillColumn( CDirectionalDiffuseCell & t_Cell,
+		                 const FenestrationCommon::Side aSide,
+		                 const size_t t_DirectionIndex,
+		                 FenestrationCommon::SquareMatrix & t_Tau,
+		                 FenestrationCommon::SquareMatrix & t_Rho ) const;
+		void fillColumn_wv( CDirectionalDiffuseCell & t_Cell,
+		                    const FenestrationCommon::Side aSide,
+		                    const size_t t_DirectionIndex,
+		                    const std::vector< FenestrationCommon::SquareMatrix * > & t_Tau,
+		                    const std::vector< FenestrationCommon::SquareMatrix * > & t_Rho ) const;
+		void fillColumn_band( CDirectionalDiffuseCell & t_Cell,
+		                      const FenestrationCommon::Side aSide,
+		                      const size_t t_DirectionIndex,
+		                      const size_t t_BandIndex,
+		                      FenestrationCommon::SquareMatrix & t_Tau,
+		                      FenestrationCommon::SquareMatrix & t_Rho ) const;
+
+		size_t m_NumberOfThreads;
 
 	};
 
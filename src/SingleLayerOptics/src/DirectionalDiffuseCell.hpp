@@ -38,6 +38,17 @@ namespace SingleLayerOptics {
 		                                                                 const CBeamDirection& t_IncomingDirection,
 		                                                                 const CBeamDirection& t_OutgoingDirection ) = 0;
 
+		// Same as above, but only for single band of the material
+		virtual double T_dir_dif_at_band( const FenestrationCommon::Side t_Side,
+		                                  const CBeamDirection& t_IncomingDirection,
+		                                  const CBeamDirection& t_OutgoingDirection,
+		                                  size_t t_BandIndex ) = 0;
+
+		virtual double R_dir_dif_at_band( const FenestrationCommon::Side t_Side,
+		                                  const CBeamDirection& t_IncomingDirection,
+		                                  const CBeamDirection& t_OutgoingDirection,
+		                                  size_t t_BandIndex ) = 0;
+
 	};
 
 }
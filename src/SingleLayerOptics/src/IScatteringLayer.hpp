@@ -8,6 +8,7 @@ namespace FenestrationCommon {
 	enum class PropertySimple;
 	enum class Side;
 	enum class Scattering;
+	class CSeries;
 
 }
 
@@ -31,6 +32,21 @@ namespace SingleLayerOptics {
 
 	};
 
+	// Layer that calculates its spectral properties once and weights them with several detectors.
+	class IMultiDetectorScatteringLayer : public IScatteringLayer {
+	public:
+		// Returns integrated property for each detector. Empty detector means that property is
+		// weighted with the source only.
+		virtual std::vector< double > getPropertiesSimple(
+				const FenestrationCommon::PropertySimple t_Property,
+				const FenestrationCommon::Side t_Side,
+				const FenestrationCommon::Scattering t_Scattering,
+				const std::vector< FenestrationCommon::CSeries > & t_Detectors,
+				const double t_Theta = 0,
+				const double t_Phi = 0 ) = 0;
+
+	};
+
 }
 
 
@@ -30,4 +30,9 @@ namespace SingleLayerOptics {
 		// No diffuse calculations are necessary for specular layer.
 	}
 
+	void CSpecularBSDFLayer::calcDiffuseDistribution_band( const Side, const CBeamDirection&, const size_t,
+	                                                       const size_t, CBSDFIntegrator& ) {
+		// No diffuse calculations are necessary for specular layer.
+	}
+
 }
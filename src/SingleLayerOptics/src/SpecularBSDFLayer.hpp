@@ -25,6 +25,11 @@ namespace SingleLayerOptics
         void calcDiffuseDistribution_wv(FenestrationCommon::Side aSide,
                                         const CBeamDirection & t_Direction,
                                         size_t t_DirectionIndex) override;
+        void calcDiffuseDistribution_band(FenestrationCommon::Side aSide,
+                                          const CBeamDirection & t_Direction,
+                                          size_t t_DirectionIndex,
+                                          size_t t_BandIndex,
+                                          CBSDFIntegrator & t_Results) override;
     };
 
 }   // namespace SingleLayerOptics
@@ -36,7 +36,7 @@ namespace SingleLayerOptics
         double aTau = aCell->T_dir_dif(aSide, t_Direction);
         double Ref = aCell->R_dir_dif(aSide, t_Direction);
 
-        const CBSDFDirections aDirections = m_BSDFHemisphere.getDirections(BSDFDirection::Incoming);
+        const auto & aDirections = m_BSDFHemisphere.getDirections(BSDFDirection::Incoming);
         size_t size = aDirections.size();
 
         for(size_t j = 0; j < size; ++j)
@@ -55,7 +55,7 @@ namespace SingleLayerOptics
         std::vector<double> aTau = aCell->T_dir_dif_band(aSide, t_Direction);
         std::vector<double> Ref = aCell->R_dir_dif_band(aSide, t_Direction);
 
-        const CBSDFDirections aDirections = m_BSDFHemisphere.getDirections(BSDFDirection::Incoming);
+        const auto & aDirections = m_BSDFHemisphere.getDirections(BSDFDirection::Incoming);
         size_t size = aDirections.size();
 
         for(size_t i = 0; i < size; ++i)
@@ -76,4 +76,28 @@ namespace SingleLayerOptics
         }
     }
 
+    void CUniformDiffuseBSDFLayer::calcDiffuseDistribution_band(const Side aSide,
+                                                                const CBeamDirection & t_Direction,
+                                                                const size_t t_DirectionIndex,
+                                                                const size_t t_BandIndex,
+                                                                CBSDFIntegrator & t_Results)
+    {
+        using ConstantsData::WCE_PI;
+
+        std::shared_ptr<CUniformDiffuseCell> aCell = cellAsUniformDiffuse();
+
+        auto & Tau = t_Results.getMatrix(aSide, PropertySimple::T);
+        auto & Rho = t_Results.getMatrix(aSide, PropertySimple::R);
+
+        double aTau = aCell->T_dir_dif_at_band(aSide, t_Direction, t_BandIndex);
+        double Ref = aCell->R_dir_dif_at_band(aSide, t_Direction, t_BandIndex);
+
+        size_t size = m_BSDFHemisphere.getDirections(BSDFDirection::Incoming).size();
+        for(size_t j = 0; j < size; ++j)
+        {
+            Tau(j, t_DirectionIndex) += aTau / WCE_PI;
+            Rho(j, t_DirectionIndex) += Ref / WCE_PI;
+        }
+    }
+
 }   // namespace SingleLayerOptics
@@ -31,6 +31,16 @@ namespace SingleLayerOptics {
     return getMaterialProperties( Property::R, t_Side, t_Direction );
   }
 
+  double CUniformDiffuseCell::T_dir_dif_at_band( const Side t_Side,
+    const CBeamDirection& t_Direction, const size_t t_BandIndex ) {
+    return T_dir_dif_band( t_Side, t_Direction ).at( t_BandIndex );
+  }
+
+  double CUniformDiffuseCell::R_dir_dif_at_band( const Side t_Side,
+    const CBeamDirection& t_Direction, const size_t t_BandIndex ) {
+    return R_dir_dif_band( t_Side, t_Direction ).at( t_BandIndex );
+  }
+
   double CUniformDiffuseCell::getMaterialProperty( const Property t_Property, const Side t_Side, 
     const CBeamDirection& t_Direction ) {
     return ( ( 1 - T_dir_dir( t_Side, t_Direction ) ) * m_Material->getProperty( t_Property, t_Side ) );
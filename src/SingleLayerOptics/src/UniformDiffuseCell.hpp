@@ -37,6 +37,13 @@ namespace SingleLayerOptics {
 		virtual std::vector< double > R_dir_dif_band( const FenestrationCommon::Side t_Side,
 		                                              const CBeamDirection& t_Direction );
 
+		// Property of the cell for single band. Default picks value from the whole range.
+		virtual double T_dir_dif_at_band( const FenestrationCommon::Side t_Side,
+		                                  const CBeamDirection& t_Direction, size_t t_BandIndex );
+
+		virtual double R_dir_dif_at_band( const FenestrationCommon::Side t_Side,
+		                                  const CBeamDirection& t_Direction, size_t t_BandIndex );
+
 	private:
 		double getMaterialProperty( const FenestrationCommon::Property t_Property,
 		                            const FenestrationCommon::Side t_Side, const CBeamDirection& t_Direction );
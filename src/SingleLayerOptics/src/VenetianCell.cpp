@@ -84,15 +84,16 @@ namespace SingleLayerOptics
     CVenetianCellEnergy::CSlatEnergyResults::CSlatEnergyResults()
     {}
 
-    std::shared_ptr<CVenetianSlatEnergies> CVenetianCellEnergy::CSlatEnergyResults::getEnergies(
-      const CBeamDirection & t_BeamDirection) const
+    std::shared_ptr<const CVenetianSlatEnergies>
+      CVenetianCellEnergy::CSlatEnergyResults::getEnergies(
+        const CBeamDirection & t_BeamDirection) const
     {
-        std::shared_ptr<CVenetianSlatEnergies> Energies = nullptr;
+        std::shared_ptr<const CVenetianSlatEnergies> Energies = nullptr;
 
-        std::vector<std::shared_ptr<CVenetianSlatEnergies>>::const_iterator it;
+        std::vector<std::shared_ptr<const CVenetianSlatEnergies>>::const_iterator it;
         it = find_if(m_Energies.begin(),
                      m_Energies.end(),
-                     [&t_BeamDirection](const std::shared_ptr<CVenetianSlatEnergies> & obj) {
+                     [&t_BeamDirection](const std::shared_ptr<const CVenetianSlatEnergies> & obj) {
                          return *(obj->direction()) == t_BeamDirection;
                      });
 
@@ -104,12 +105,19 @@ namespace SingleLayerOptics
         return Energies;
     }
 
-    std::shared_ptr<CVenetianSlatEnergies> CVenetianCellEnergy::CSlatEnergyResults::append(
+    std::shared_ptr<const CVenetianSlatEnergies> CVenetianCellEnergy::CSlatEnergyResults::append(
 		const CBeamDirection & t_BeamDirection,
 		const std::vector< SegmentIrradiance > & t_SlatIrradiances,
 		const std::vector< double > & t_SlatRadiances )
     {
-        std::shared_ptr<CVenetianSlatEnergies> aEnergy = std::make_shared<CVenetianSlatEnergies>(
+        // Another thread could have stored the same direction in the meantime. Entries are
+        // never replaced so that pointers already handed out stay valid.
+        auto aExisting = getEnergies(t_BeamDirection);
+        if(aExisting != nullptr)
+        {
+            return aExisting;
+        }
+        std::shared_ptr<const CVenetianSlatEnergies> aEnergy = std::make_shared<CVenetianSlatEnergies>(
           t_BeamDirection, t_SlatIrradiances, t_SlatRadiances);
         m_Energies.push_back(aEnergy);
         return aEnergy;
@@ -141,7 +149,6 @@ namespace SingleLayerOptics
     {
         createSlatsMapping();
         formEnergyMatrix();
-        m_CurrentSlatEnergies = nullptr;
     }
 
     double CVenetianCellEnergy::T_dir_dir(const CBeamDirection & t_Direction)
@@ -151,28 +158,25 @@ namespace SingleLayerOptics
 
     double CVenetianCellEnergy::T_dir_dif(const CBeamDirection & t_Direction)
     {
-        calculateSlatEnergiesFromBeam(t_Direction);
-        assert(m_CurrentSlatEnergies != nullptr);
+        const auto aSlatEnergies = calculateSlatEnergiesFromBeam(t_Direction);
         size_t numSeg = int(m_Cell->numberOfSegments() / 2);
 
         // Total energy accounts for direct to direct component. That needs to be substracted since
         // only direct to diffuse is of interest
-        return m_CurrentSlatEnergies->irradiances(numSeg).E_f - T_dir_dir(t_Direction);
+        return aSlatEnergies->irradiances(numSeg).E_f - T_dir_dir(t_Direction);
     }
 
     double CVenetianCellEnergy::R_dir_dif(const CBeamDirection & t_Direction)
     {
-        calculateSlatEnergiesFromBeam(t_Direction);
-        assert(m_CurrentSlatEnergies != nullptr);
+        const auto aSlatEnergies = calculateSlatEnergiesFromBeam(t_Direction);
 
-        return m_CurrentSlatEnergies->irradiances(0).E_b;
+        return aSlatEnergies->irradiances(0).E_b;
     }
 
     double CVenetianCellEnergy::T_dir_dif(const CBeamDirection & t_IncomingDirection,
                                           const CBeamDirection & t_OutgoingDirection)
     {
-        calculateSlatEnergiesFromBeam(t_IncomingDirection);
-        assert(m_CurrentSlatEnergies != nullptr);
+        const auto aSlatEnergies = calculateSlatEnergiesFromBeam(t_IncomingDirection);
 
         std::vector<BeamSegmentView> BVF = beamVector(t_OutgoingDirection, Side::Back);
 
@@ -180,9 +184,9 @@ namespace SingleLayerOptics
 
         // Counting starts from one because this should exclude beam to beam energy.
         // double totalSegmentsLength = 0;
-        for(size_t i = 1; i < m_CurrentSlatEnergies->size(); ++i)
+        for(size_t i = 1; i < aSlatEnergies->size(); ++i)
         {
-            aResult += m_CurrentSlatEnergies->radiances(i) * BVF[i].percentViewed
+            aResult += aSlatEnergies->radiances(i) * BVF[i].percentViewed
                        * BVF[i].viewFactor / m_Cell->segmentLength(i);
         }
 
@@ -198,16 +202,15 @@ namespace SingleLayerOptics
     double CVenetianCellEnergy::R_dir_dif(const CBeamDirection & t_IncomingDirection,
                                           const CBeamDirection & t_OutgoingDirection)
     {
-        calculateSlatEnergiesFromBeam(t_IncomingDirection);
-        assert(m_CurrentSlatEnergies != nullptr);
+        const auto aSlatEnergies = calculateSlatEnergiesFromBeam(t_IncomingDirection);
 
         std::vector<BeamSegmentView> BVF = beamVector(t_OutgoingDirection, Side::Front);
 
         double aResult = 0;
 
-        for(size_t i = 1; i < m_CurrentSlatEnergies->size(); ++i)
+        for(size_t i = 1; i < aSlatEnergies->size(); ++i)
         {
-            aResult += m_CurrentSlatEnergies->radiances(i) * BVF[i].percentViewed
+            aResult += aSlatEnergies->radiances(i) * BVF[i].percentViewed
                        * BVF[i].viewFactor / m_Cell->segmentLength(i);
         }
 
@@ -459,23 +462,25 @@ namespace SingleLayerOptics
         }
     }
 
-    void CVenetianCellEnergy::calculateSlatEnergiesFromBeam(const CBeamDirection & t_Direction)
+    std::shared_ptr<const CVenetianSlatEnergies>
+      CVenetianCellEnergy::calculateSlatEnergiesFromBeam(const CBeamDirection & t_Direction)
     {
-        if(m_CurrentSlatEnergies != nullptr)
         {
-            if(*m_CurrentSlatEnergies->direction() != t_Direction)
+            std::lock_guard<std::mutex> lock(m_SlatEnergiesMutex);
+            const auto aEnergies = m_SlatEnergyResults.getEnergies(t_Direction);
+            if(aEnergies != nullptr)
             {
-                m_CurrentSlatEnergies = m_SlatEnergyResults.getEnergies(t_Direction);
+                return aEnergies;
             }
         }
-        if(m_CurrentSlatEnergies == nullptr)
-        {
-            std::vector<SegmentIrradiance> aIrradiances = slatIrradiances(t_Direction);
-            std::vector<double> aRadiances = slatRadiances(aIrradiances);
 
-            m_CurrentSlatEnergies =
-              m_SlatEnergyResults.append(t_Direction, aIrradiances, aRadiances);
-        }
+        // Solve outside of the lock so that threads working on different directions do not
+        // wait for each other.
+        std::vector<SegmentIrradiance> aIrradiances = slatIrradiances(t_Direction);
+        std::vector<double> aRadiances = slatRadiances(aIrradiances);
+
+        std::lock_guard<std::mutex> lock(m_SlatEnergiesMutex);
+        return m_SlatEnergyResults.append(t_Direction, aIrradiances, aRadiances);
     }
 
     std::shared_ptr<std::vector<double>> CVenetianCellEnergy::diffuseVector()
@@ -639,12 +644,19 @@ namespace SingleLayerOptics
         std::vector<double> aProperties;
         for(size_t i = 0; i < size; ++i)
         {
-            CVenetianCellEnergy aCell = *m_EnergiesBand[i].getCell(t_Side);
+            auto & aCell = *m_EnergiesBand[i].getCell(t_Side);
             aProperties.push_back(aCell.T_dir_dir(t_Direction));
         }
         return aProperties;
     }
 
+    double CVenetianCell::T_dir_dir_at_band(const Side t_Side,
+                                            const CBeamDirection & t_Direction,
+                                            const size_t t_BandIndex)
+    {
+        return m_EnergiesBand.at(t_BandIndex).getCell(t_Side)->T_dir_dir(t_Direction);
+    }
+
     double CVenetianCell::T_dir_dif(const Side t_Side, const CBeamDirection & t_Direction)
     {
         std::shared_ptr<CVenetianCellEnergy> aCell = m_Energy.getCell(t_Side);
@@ -658,7 +670,7 @@ namespace SingleLayerOptics
         std::vector<double> aProperties;
         for(size_t i = 0; i < size; ++i)
         {
-            CVenetianCellEnergy aCell = *m_EnergiesBand[i].getCell(t_Side);
+            auto & aCell = *m_EnergiesBand[i].getCell(t_Side);
             aProperties.push_back(aCell.T_dir_dif(t_Direction));
         }
         return aProperties;
@@ -683,6 +695,20 @@ namespace SingleLayerOptics
         return aProperties;
     }
 
+    double CVenetianCell::T_dir_dif_at_band(const Side t_Side,
+                                            const CBeamDirection & t_Direction,
+                                            const size_t t_BandIndex)
+    {
+        return m_EnergiesBand.at(t_BandIndex).getCell(t_Side)->T_dir_dif(t_Direction);
+    }
+
+    double CVenetianCell::R_dir_dif_at_band(const Side t_Side,
+                                            const CBeamDirection & t_Direction,
+                                            const size_t t_BandIndex)
+    {
+        return m_EnergiesBand.at(t_BandIndex).getCell(t_Side)->R_dir_dif(t_Direction);
+    }
+
     double CVenetianCell::T_dir_dif(const Side t_Side,
                                     const CBeamDirection & t_IncomingDirection,
                                     const CBeamDirection & t_OutgoingDirection)
@@ -729,6 +755,26 @@ namespace SingleLayerOptics
         return aProperties;
     }
 
+    double CVenetianCell::T_dir_dif_at_band(const Side t_Side,
+                                            const CBeamDirection & t_IncomingDirection,
+                                            const CBeamDirection & t_OutgoingDirection,
+                                            const size_t t_BandIndex)
+    {
+        return m_EnergiesBand.at(t_BandIndex)
+          .getCell(t_Side)
+          ->T_dir_dif(t_IncomingDirection, t_OutgoingDirection);
+    }
+
+    double CVenetianCell::R_dir_dif_at_band(const Side t_Side,
+                                            const CBeamDirection & t_IncomingDirection,
+                                            const CBeamDirection & t_OutgoingDirection,
+                                            const size_t t_BandIndex)
+    {
+        return m_EnergiesBand.at(t_BandIndex)
+          .getCell(t_Side)
+          ->R_dir_dif(t_IncomingDirection, t_OutgoingDirection);
+    }
+
     double CVenetianCell::T_dif_dif(const Side t_Side)
     {
         std::shared_ptr<CVenetianCellEnergy> aCell = m_Energy.getCell(t_Side);
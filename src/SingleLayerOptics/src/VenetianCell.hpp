@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 #include <map>
+#include <mutex>
 
 #include "UniformDiffuseCell.hpp"
 #include "DirectionalDiffuseCell.hpp"
@@ -104,16 +105,16 @@ namespace SingleLayerOptics
         public:
             CSlatEnergyResults();
 
-            std::shared_ptr<CVenetianSlatEnergies>
+            std::shared_ptr<const CVenetianSlatEnergies>
               getEnergies(const CBeamDirection & t_BeamDirection) const;
 
-            std::shared_ptr<CVenetianSlatEnergies>
+            std::shared_ptr<const CVenetianSlatEnergies>
               append( const CBeamDirection & t_BeamDirection,
 					  const std::vector< SegmentIrradiance > & t_SlatIrradiances,
 					  const std::vector< double > & t_SlatRadiances );
 
         private:
-            std::vector<std::shared_ptr<CVenetianSlatEnergies>> m_Energies;
+            std::vector<std::shared_ptr<const CVenetianSlatEnergies>> m_Energies;
         };
 
         // Create mapping from view factors matrix to front and back slats (fills b and f
@@ -124,8 +125,10 @@ namespace SingleLayerOptics
         // caluculated only once and stored into m_Energy field
         void formEnergyMatrix();
 
-        // calculate slat irradiances and radiances based on incoming beam
-        void calculateSlatEnergiesFromBeam(const CBeamDirection & t_Direction);
+        // calculate slat irradiances and radiances based on incoming beam. Only lookup and insert
+        // into cache are guarded so that cell can be evaluated from several threads at once.
+        std::shared_ptr<const CVenetianSlatEnergies>
+          calculateSlatEnergiesFromBeam(const CBeamDirection & t_Direction);
 
         // Irradiances for given incoming direction
 		std::vector< SegmentIrradiance >
@@ -153,15 +156,13 @@ namespace SingleLayerOptics
         std::vector<size_t> b;
         std::vector<size_t> f;
 
-        // Keeps pointer to valid slat energies (for given direction). If result is not valid, it
-        // must be pulled out of m_SlatEnergyResults and assigned to this pointer.
-        std::shared_ptr<CVenetianSlatEnergies> m_CurrentSlatEnergies;
-
         // Keep results for slat radiances and irradiances for different directions.
         // Once radiances and irradiances are calculated for certain direction, results are stored
         // here. That reduces necessity to recalculate results multiple times for same direction.
-        // Note that direction is always incoming direction.
+        // Note that direction is always incoming direction. Stored results are never modified.
         CSlatEnergyResults m_SlatEnergyResults;
+
+        std::mutex m_SlatEnergiesMutex;
     };
 
     class CVenetianEnergy
@@ -201,6 +202,9 @@ namespace SingleLayerOptics
         double T_dir_dir(const FenestrationCommon::Side t_Side, const CBeamDirection & t_Direction);
         std::vector<double> T_dir_dir_band(const FenestrationCommon::Side t_Side,
                                            const CBeamDirection & t_Direction);
+        double T_dir_dir_at_band(const FenestrationCommon::Side t_Side,
+                                 const CBeamDirection & t_Direction,
+                                 size_t t_BandIndex);
 
         /////////////////////////////////////////////////////////////////////////////////////////////
         // Uniform diffuse components
@@ -212,6 +216,14 @@ namespace SingleLayerOptics
         std::vector<double> R_dir_dif_band(const FenestrationCommon::Side t_Side,
                                            const CBeamDirection & t_Direction);
 
+        // Single band properties are calculated only from energy state of that band
+        double T_dir_dif_at_band(const FenestrationCommon::Side t_Side,
+                                 const CBeamDirection & t_Direction,
+                                 size_t t_BandIndex);
+        double R_dir_dif_at_band(const FenestrationCommon::Side t_Side,
+                                 const CBeamDirection & t_Direction,
+                                 size_t t_BandIndex);
+
         /////////////////////////////////////////////////////////////////////////////////////////////
         // Directional diffuse components
         /////////////////////////////////////////////////////////////////////////////////////////////
@@ -232,6 +244,15 @@ namespace SingleLayerOptics
                          const CBeamDirection & t_IncomingDirection,
                          const CBeamDirection & t_OutgoingDirection);
 
+        double T_dir_dif_at_band(const FenestrationCommon::Side t_Side,
+                                 const CBeamDirection & t_IncomingDirection,
+                                 const CBeamDirection & t_OutgoingDirection,
+                                 size_t t_BandIndex);
+        double R_dir_dif_at_band(const FenestrationCommon::Side t_Side,
+                                 const CBeamDirection & t_IncomingDirection,
+                                 const CBeamDirection & t_OutgoingDirection,
+                                 size_t t_BandIndex);
+
         // Functions specific only for Venetian cell. Diffuse to diffuse component based only on
         // view factors
         double T_dif_dif(const FenestrationCommon::Side t_Side);
@@ -62,6 +62,7 @@ namespace SingleLayerOptics {
 		std::shared_ptr< CVenetianCellDescription > aBackwardCell =
 			std::make_shared< CVenetianCellDescription >( slatWidth, slatSpacing, slatTiltAngle,
 			                                         curvatureRadius, m_NumOfSlatSegments );
+		aBackwardCell->setBeamProfileAngles( m_BeamProfileAngles );
 
 		return aBackwardCell;
 	}
@@ -76,6 +77,17 @@ namespace SingleLayerOptics {
 		return m_BeamGeometry->beamViewFactors( -t_ProfileAngle, t_Side );
 	}
 
+	void CVenetianCellDescription::setBeamProfileAngles( const std::vector< double >& t_ProfileAngles ) {
+		assert( m_BeamGeometry != nullptr );
+		m_BeamProfileAngles = t_ProfileAngles;
+		// Cell is asked for beam view factors at negative profile angles
+		std::vector< double > aAngles;
+		for ( auto angle : t_ProfileAngles ) {
+			aAngles.push_back( -angle );
+		}
+		m_BeamGeometry->setProfileAngles( aAngles );
+	}
+
 	double CVenetianCellDescription::T_dir_dir( const Side t_Side, const CBeamDirection& t_Direction ) {
 		assert( m_BeamGeometry != nullptr );
 		double aProfileAngle = t_Direction.profileAngle();
@@ -42,6 +42,10 @@ namespace SingleLayerOptics {
 		std::shared_ptr< std::vector< Viewer::BeamViewFactor > >
 		beamViewFactors( const double t_ProfileAngle, const FenestrationCommon::Side t_Side );
 
+		// Profile angles for which beam view factors will be needed. All of them are calculated
+		// together on the first request for beam view factors.
+		void setBeamProfileAngles( const std::vector< double >& t_ProfileAngles );
+
 		// Direct to direct component of the ray
 		double T_dir_dir( const FenestrationCommon::Side t_Side, const CBeamDirection& t_Direction );
 		double R_dir_dir( const FenestrationCommon::Side t_Side, const CBeamDirection& t_Direction );
@@ -56,6 +60,7 @@ namespace SingleLayerOptics {
 
 		// Geometry to handle direct to direct beam component
 		std::shared_ptr< Viewer::CGeometry2DBeam > m_BeamGeometry;
+		std::vector< double > m_BeamProfileAngles;
 	};
 
 }
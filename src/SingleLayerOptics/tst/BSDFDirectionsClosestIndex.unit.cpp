@@ -89,3 +89,30 @@ TEST_F(TestBSDFDirectionsClosestIndex, TestClosestIndex5)
 
     EXPECT_EQ(33, int(beamIndex));
 }
+
+TEST_F(TestBSDFDirectionsClosestIndex, TestClosestIndexAgainstPatches)
+{
+    SCOPED_TRACE("Begin Test: Find closest index against linear search over patches.");
+
+    for(const auto side : {BSDFDirection::Incoming, BSDFDirection::Outgoing})
+    {
+        const auto & aDirections = GetDirections(side);
+
+        // Includes patch limits, where patch with lower index must be returned, and directions
+        // outside of the hemisphere
+        for(auto theta = -4.5; theta <= 94.5; theta += 1.5)
+        {
+            for(auto phi = -45.0; phi <= 585.0; phi += 3.75)
+            {
+                size_t expected = 0;
+                while(expected < aDirections.size()
+                      && !aDirections[expected].isInPatch(theta, phi))
+                {
+                    ++expected;
+                }
+
+                EXPECT_EQ(expected, aDirections.getNearestBeamIndex(theta, phi));
+            }
+        }
+    }
+}
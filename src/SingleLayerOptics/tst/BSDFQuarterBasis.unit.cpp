@@ -106,3 +106,26 @@ TEST_F(TestBSDFQuarterBasis, TestQuarterBasisLambdas)
         EXPECT_NEAR(lambdaValues[i], correctResults[i], 1e-6);
     }
 }
+
+TEST_F(TestBSDFQuarterBasis, TestSharedBasis)
+{
+    SCOPED_TRACE("Begin Test: Standard basis directions are shared between hemispheres.");
+
+    const auto aHemisphere = CBSDFHemisphere::create(BSDFBasis::Quarter);
+
+    for(const auto side : {BSDFDirection::Incoming, BSDFDirection::Outgoing})
+    {
+        EXPECT_EQ(&GetDirections(side), &aHemisphere.getDirections(side));
+        EXPECT_EQ(&GetDirections(side), aHemisphere.getSharedDirections(side).get());
+    }
+
+    CBSDFIntegrator aIntegrator(aHemisphere.getSharedDirections(BSDFDirection::Incoming));
+    EXPECT_EQ(&GetDirections(BSDFDirection::Incoming), aIntegrator.getDirections().get());
+    EXPECT_EQ(&GetDirections(BSDFDirection::Incoming).lambdaMatrix(),
+              &aIntegrator.lambdaMatrix());
+
+    const auto aCustomHemisphere =
+      CBSDFHemisphere::create({{0, 1}, {18, 8}, {36, 12}, {54, 12}, {76.5, 8}});
+    EXPECT_NE(&GetDirections(BSDFDirection::Incoming),
+              &aCustomHemisphere.getDirections(BSDFDirection::Incoming));
+}
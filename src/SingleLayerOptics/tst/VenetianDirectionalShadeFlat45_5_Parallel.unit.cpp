@@ -0,0 +1,101 @@
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "WCECommon.hpp"
+#include "WCESingleLayerOptics.hpp"
+
+
+using namespace SingleLayerOptics;
+using namespace FenestrationCommon;
+
+// Directional diffuse venetian layer calculated with several threads must give exactly the same
+// results as serial calculation.
+class TestVenetianDirectionalShadeFlat45_5_Parallel : public testing::Test
+{
+protected:
+    static std::shared_ptr<CBSDFLayer> createLayer(const size_t t_NumberOfThreads)
+    {
+        // Solar range material
+        const auto Tsol = 0.1;
+        const auto Rfsol = 0.7;
+        const auto Rbsol = 0.7;
+        // Visible range
+        const auto Tvis = 0.2;
+        const auto Rfvis = 0.6;
+        const auto Rbvis = 0.6;
+
+        const auto aMaterial =
+          Material::dualBandMaterial(Tsol, Tsol, Rfsol, Rbsol, Tvis, Tvis, Rfvis, Rbvis);
+
+        // make cell geometry
+        double slatWidth = 0.016;     // m
+        double slatSpacing = 0.012;   // m
+        double slatTiltAngle = 45;
+        double curvatureRadius = 0;
+        const size_t numOfSlatSegments = 5;
+
+        // create BSDF
+        const auto aBSDF = CBSDFHemisphere::create(BSDFBasis::Quarter);
+
+        // make layer
+        auto aLayer = CBSDFLayerMaker::getVenetianLayer(aMaterial,
+                                                        aBSDF,
+                                                        slatWidth,
+                                                        slatSpacing,
+                                                        slatTiltAngle,
+                                                        curvatureRadius,
+                                                        numOfSlatSegments,
+                                                        DistributionMethod::DirectionalDiffuse);
+
+        auto aDirectionalLayer = std::dynamic_pointer_cast<CDirectionalDiffuseBSDFLayer>(aLayer);
+        EXPECT_TRUE(aDirectionalLayer != nullptr);
+        aDirectionalLayer->setNumberOfThreads(t_NumberOfThreads);
+
+        return aLayer;
+    }
+
+    static void compareResults(CBSDFIntegrator & t_Serial, CBSDFIntegrator & t_Parallel)
+    {
+        for(auto aSide : EnumSide())
+        {
+            for(auto aProperty : EnumPropertySimple())
+            {
+                const auto & aSerial = t_Serial.getMatrix(aSide, aProperty);
+                const auto & aParallel = t_Parallel.getMatrix(aSide, aProperty);
+                ASSERT_EQ(aSerial.size(), aParallel.size());
+                for(size_t i = 0; i < aSerial.size(); ++i)
+                {
+                    for(size_t j = 0; j < aSerial.size(); ++j)
+                    {
+                        EXPECT_EQ(aSerial(i, j), aParallel(i, j));
+                    }
+                }
+            }
+        }
+    }
+};
+
+TEST_F(TestVenetianDirectionalShadeFlat45_5_Parallel, TestSolarRange)
+{
+    SCOPED_TRACE("Begin Test: Venetian layer (directional diffuse) - serial vs. parallel BSDF.");
+
+    auto aSerial = createLayer(1);
+    auto aParallel = createLayer(4);
+
+    compareResults(*aSerial->getResults(), *aParallel->getResults());
+}
+
+TEST_F(TestVenetianDirectionalShadeFlat45_5_Parallel, TestMultiWavelength)
+{
+    SCOPED_TRACE("Begin Test: Venetian layer (directional diffuse, multi range) - serial vs. "
+                 "parallel BSDF.");
+
+    auto aSerial = createLayer(1)->getWavelengthResults();
+    auto aParallel = createLayer(3)->getWavelengthResults();
+
+    ASSERT_EQ(aSerial->size(), aParallel->size());
+    for(size_t i = 0; i < aSerial->size(); ++i)
+    {
+        compareResults(*(*aSerial)[i], *(*aParallel)[i]);
+    }
+}
@@ -281,3 +281,31 @@ TEST_F(TestVenetianUniformShadeFlat0_1, TestVenetian1)
         EXPECT_NEAR(correctResults[i], aRb(i, i), 1e-5);
     }
 }
+
+TEST_F(TestVenetianUniformShadeFlat0_1, TestVenetianMatrixStructure)
+{
+    SCOPED_TRACE("Begin Test: Venetian cell (Flat, 0 degrees slats) - uniform diffuse matrices "
+                 "are diagonal plus rank one.");
+
+    std::shared_ptr<CBSDFLayer> aShade = GetShade();
+    const auto aResults = aShade->getResults();
+
+    for(auto aSide : EnumSide())
+    {
+        for(auto aProperty : EnumPropertySimple())
+        {
+            EXPECT_EQ(MatrixStructure::LowRank, aResults->structure(aSide, aProperty));
+
+            const auto aStructured = aResults->structuredAt(aSide, aProperty);
+            const auto & aMatrix = aResults->at(aSide, aProperty);
+            EXPECT_EQ(1u, aStructured.rank());
+            for(size_t i = 0; i < aMatrix.size(); ++i)
+            {
+                for(size_t j = 0; j < aMatrix.size(); ++j)
+                {
+                    EXPECT_NEAR(aMatrix(i, j), aStructured(i, j), 1e-12);
+                }
+            }
+        }
+    }
+}
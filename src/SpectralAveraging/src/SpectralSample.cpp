@@ -91,6 +91,7 @@ namespace SpectralAveraging
     {
         m_DetectorData = t_Sample->m_DetectorData;
         m_Wavelengths = t_Sample->m_Wavelengths;
+        m_WavelengthGrid = t_Sample->m_WavelengthGrid;
         m_WavelengthSet = t_Sample->m_WavelengthSet;
     }
 
@@ -118,6 +119,10 @@ namespace SpectralAveraging
                 throw std::runtime_error("Incorrect definition of wavelength set source.");
                 break;
         }
+        if(m_WavelengthGrid == nullptr || m_WavelengthGrid->values() != m_Wavelengths)
+        {
+            m_WavelengthGrid = CWavelengthGrid::intern(m_Wavelengths);
+        }
         reset();
     }
 
@@ -177,6 +182,7 @@ namespace SpectralAveraging
     {
         if(!m_StateCalculated)
         {
+            WCE_SCOPED_TIMER("CSample::calculateState");
             if(m_WavelengthSet != WavelengthSet::Custom)
             {
                 setWavelengths(m_WavelengthSet);
@@ -186,12 +192,12 @@ namespace SpectralAveraging
             // Otherwise, just use measured data.
             if(m_SourceData.size() > 0)
             {
-                m_IncomingSource = m_SourceData.interpolate(m_Wavelengths);
+                m_IncomingSource = m_SourceData.interpolate(m_WavelengthGrid);
 
 
                 if(m_DetectorData.size() > 0)
                 {
-                    const auto interpolatedDetector = m_DetectorData.interpolate(m_Wavelengths);
+                    const auto interpolatedDetector = m_DetectorData.interpolate(m_WavelengthGrid);
                     m_IncomingSource = m_IncomingSource * interpolatedDetector;
                 }
 
@@ -275,6 +281,32 @@ namespace SpectralAveraging
         return m_Property.at(std::make_pair(t_Property, t_Side));
     }
 
+    std::vector<double>
+      CSpectralSample::getSourceProperties(const double minLambda,
+                                           const double maxLambda,
+                                           const Property t_Property,
+                                           const Side t_Side,
+                                           const std::vector<CSeries> & t_Sources)
+    {
+        calculateState();
+
+        std::vector<CSeries> aWeights;
+        aWeights.reserve(t_Sources.size());
+        for(const auto & source : t_Sources)
+        {
+            auto aSource = source.interpolate(m_WavelengthGrid);
+            if(m_DetectorData.size() > 0)
+            {
+                aSource = aSource * m_DetectorData.interpolate(m_WavelengthGrid);
+            }
+            aWeights.push_back(aSource);
+        }
+
+        const CSpectralWeights aSpectralWeights(
+          aWeights, m_IntegrationType, m_NormalizationCoefficient, minLambda, maxLambda);
+        return aSpectralWeights.average(m_Property.at(std::make_pair(t_Property, t_Side)));
+    }
+
     void CSpectralSample::calculateProperties()
     {
         for(const auto & prop : EnumProperty())
@@ -286,7 +318,7 @@ namespace SpectralAveraging
                 if(m_WavelengthSet != WavelengthSet::Data)
                 {
                     m_Property[std::make_pair(prop, side)] =
-                      m_Property[std::make_pair(prop, side)].interpolate(m_Wavelengths);
+                      m_Property[std::make_pair(prop, side)].interpolate(m_WavelengthGrid);
                 }
             }
         }
@@ -92,6 +92,8 @@ namespace SpectralAveraging
         FenestrationCommon::CSeries m_DetectorData;
 
         std::vector<double> m_Wavelengths;
+        // Interned m_Wavelengths. Series are interpolated to it without interning on every call.
+        std::shared_ptr<const FenestrationCommon::CWavelengthGrid> m_WavelengthGrid;
         WavelengthSet m_WavelengthSet;
 
         // Keep energy for current state of the sample. Energy is calculated for each wavelength.
@@ -130,6 +132,16 @@ namespace SpectralAveraging
           getWavelengthsProperty(const FenestrationCommon::Property t_Property,
                                  const FenestrationCommon::Side t_Side);
 
+        // Sample property integrated with each of given sources instead of source data (detector
+        // data are still applied). Sample is not recalculated for new sources; all sources are
+        // integrated at once as single weight matrix.
+        std::vector<double>
+          getSourceProperties(double minLambda,
+                              double maxLambda,
+                              FenestrationCommon::Property t_Property,
+                              FenestrationCommon::Side t_Side,
+                              const std::vector<FenestrationCommon::CSeries> & t_Sources);
+
         std::vector<double> getWavelengthsFromSample() const override;
 
         void cutExtraData(double minLambda, double maxLambda);
@@ -657,6 +657,17 @@ protected:
         m_Sample = std::make_shared<CSpectralSample>(sampleMeasurements, solarRadiation);
     }
 
+    // Solar radiation weighted by wavelength. Has different spectral shape than solar radiation.
+    static CSeries tiltedSource(const CSeries & t_SolarRadiation)
+    {
+        CSeries aSource;
+        for(const auto & aPoint : t_SolarRadiation)
+        {
+            aSource.addProperty(aPoint->x(), aPoint->value() * aPoint->x());
+        }
+        return aSource;
+    }
+
 public:
     std::shared_ptr<CSpectralSample> getSample() const
     {
@@ -710,3 +721,34 @@ TEST_F(TestSampleNFRC_1042, TestSampleProperties)
     auto absorptance = aSample->getProperty(lowLambda, highLambda, Property::Abs, Side::Front);
     EXPECT_NEAR(0.189115, absorptance, 1e-6);
 }
+
+TEST_F(TestSampleNFRC_1042, TestSampleManySources)
+{
+    auto lowLambda = 0.3;
+    auto highLambda = 2.5;
+
+    auto aSample = getSample();
+    const auto aSolar = getSolarRadiation();
+    const std::vector<CSeries> aSources{aSolar, tiltedSource(aSolar)};
+
+    for(auto aProperty : {Property::T, Property::R, Property::Abs})
+    {
+        const auto aResults =
+          aSample->getSourceProperties(lowLambda, highLambda, aProperty, Side::Front, aSources);
+        ASSERT_EQ(aSources.size(), aResults.size());
+
+        // Each source must give the same result as the sample created with that source only
+        for(size_t i = 0; i < aSources.size(); ++i)
+        {
+            CSpectralSample aSingleSource(getMeasurements(), aSources[i]);
+            const auto aCorrect =
+              aSingleSource.getProperty(lowLambda, highLambda, aProperty, Side::Front);
+            EXPECT_NEAR(aCorrect, aResults[i], 1e-12);
+        }
+    }
+
+    auto transmittance = aSample->getSourceProperties(
+      lowLambda, highLambda, Property::T, Side::Front, aSources);
+    EXPECT_NEAR(0.451635, transmittance[0], 1e-6);
+    EXPECT_NEAR(0.352522, transmittance[1], 1e-6);
+}
@@ -3,8 +3,10 @@
 
 #include "../src/BaseIGULayer.hpp"
 #include "../src/BaseLayer.hpp"
+#include "../src/BalanceMatrix.hpp"
 #include "../src/BaseShade.hpp"
 #include "../src/CalculationModels.hpp"
+#include "../src/CompiledIGU.hpp"
 #include "../src/Environment.hpp"
 #include "../src/Environments.hpp"
 #include "../src/HeatFlowBalance.hpp"
@@ -26,5 +28,6 @@
 #include "../src/System.hpp"
 #include "../src/TarcogConstants.hpp"
 #include "../src/IGUEN673.hpp"
+#include "../src/IGUEN673Batch.hpp"
 
 #endif
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include <stdexcept>
+#include <algorithm>
+
+#include "BalanceMatrix.hpp"
+
+namespace Tarcog
+{
+    namespace ISO15099
+    {
+        CBalanceMatrix::CBalanceMatrix(const size_t t_Size) :
+            m_Size(t_Size),
+            m_Matrix(isFixed() ? 0 : t_Size)
+        {
+            m_FixedMatrix.fill(0);
+        }
+
+        size_t CBalanceMatrix::size() const
+        {
+            return m_Size;
+        }
+
+        void CBalanceMatrix::setZeros()
+        {
+            if(isFixed())
+            {
+                std::fill(m_FixedMatrix.begin(), m_FixedMatrix.begin() + m_Size * m_Size, 0.0);
+            }
+            else
+            {
+                m_Matrix.setZeros();
+            }
+        }
+
+        double & CBalanceMatrix::operator()(const size_t i, const size_t j)
+        {
+            return isFixed() ? m_FixedMatrix[i * m_Size + j] : m_Matrix(i, j);
+        }
+
+        void CBalanceMatrix::solveInPlace(std::vector<double> & t_VectorB)
+        {
+            if(t_VectorB.size() != m_Size)
+            {
+                throw std::runtime_error(
+                  "Matrix and vector for system of linear equations are not same size.");
+            }
+
+            switch(m_Size)
+            {
+                case 4:
+                    FenestrationCommon::solveFixedSystem<4>(m_FixedMatrix.data(), t_VectorB.data());
+                    break;
+                case 8:
+                    FenestrationCommon::solveFixedSystem<8>(m_FixedMatrix.data(), t_VectorB.data());
+                    break;
+                case 12:
+                    FenestrationCommon::solveFixedSystem<12>(m_FixedMatrix.data(), t_VectorB.data());
+                    break;
+                case 16:
+                    FenestrationCommon::solveFixedSystem<16>(m_FixedMatrix.data(), t_VectorB.data());
+                    break;
+                default:
+                    m_LinearSolver.solveSystemInPlace(m_Matrix, t_VectorB);
+            }
+        }
+
+        bool CBalanceMatrix::isFixed() const
+        {
+            return m_Size > 0 && m_Size <= MaxFixedSize && m_Size % 4 == 0;
+        }
+
+    }   // namespace ISO15099
+
+}   // namespace Tarcog
@@ -0,0 +1,45 @@
+#ifndef TARCOGBALANCEMATRIX_H
+#define TARCOGBALANCEMATRIX_H
+
+#include <array>
+#include <vector>
+
+#include "WCECommon.hpp"
+
+namespace Tarcog
+{
+    namespace ISO15099
+    {
+        // Heat balance system matrix (four unknowns per solid layer). IGUs with up to four solid
+        // layers are stored in fixed size storage inside of the object and solved with elimination
+        // specialised for layer count. Larger IGUs use generic square matrix and linear solver.
+        class CBalanceMatrix
+        {
+        public:
+            explicit CBalanceMatrix(size_t t_Size = 0);
+
+            size_t size() const;
+            void setZeros();
+
+            double & operator()(size_t i, size_t j);
+
+            // Solution is stored into t_VectorB. Matrix content is destroyed.
+            void solveInPlace(std::vector<double> & t_VectorB);
+
+        private:
+            static const size_t MaxFixedLayers = 4;
+            static const size_t MaxFixedSize = 4 * MaxFixedLayers;
+
+            bool isFixed() const;
+
+            size_t m_Size;
+            std::array<double, MaxFixedSize * MaxFixedSize> m_FixedMatrix;
+            FenestrationCommon::SquareMatrix m_Matrix;
+            FenestrationCommon::CLinearSolver m_LinearSolver;
+        };
+
+    }   // namespace ISO15099
+
+}   // namespace Tarcog
+
+#endif
@@ -82,18 +82,24 @@ namespace Tarcog
                                        const std::shared_ptr<Tarcog::ISO15099::ISurface> & t_FrontSurface,
                                        const std::shared_ptr<Tarcog::ISO15099::ISurface> & t_BackSurface) :
             CIGUSolidLayer(t_Thickness, t_Conductivity, t_FrontSurface, t_BackSurface),
-            m_ShadeOpenings(t_ShadeOpenings)
+            m_ShadeOpenings(t_ShadeOpenings),
+            m_AirflowCoupling(AirflowCoupling::Nested),
+            m_AirflowSteps(0)
         {}
 
         CIGUShadeLayer::CIGUShadeLayer(std::shared_ptr<CIGUSolidLayer> & t_Layer,
                                        std::shared_ptr<CShadeOpenings> & t_ShadeOpenings) :
             CIGUSolidLayer(*t_Layer),
-            m_ShadeOpenings(t_ShadeOpenings)
+            m_ShadeOpenings(t_ShadeOpenings),
+            m_AirflowCoupling(AirflowCoupling::Nested),
+            m_AirflowSteps(0)
         {}
 
         CIGUShadeLayer::CIGUShadeLayer(double t_Thickness, double t_Conductivity) :
             CIGUSolidLayer(t_Thickness, t_Conductivity),
-            m_ShadeOpenings(std::make_shared<CShadeOpenings>())
+            m_ShadeOpenings(std::make_shared<CShadeOpenings>()),
+            m_AirflowCoupling(AirflowCoupling::Nested),
+            m_AirflowSteps(0)
         {}
 
         std::shared_ptr<CBaseLayer> CIGUShadeLayer::clone() const
@@ -101,6 +107,18 @@ namespace Tarcog
             return std::make_shared<CIGUShadeLayer>(*this);
         }
 
+        void CIGUShadeLayer::setAirflowCoupling(const AirflowCoupling t_Coupling)
+        {
+            m_AirflowCoupling = t_Coupling;
+            m_AirflowSteps = 0;
+            resetCalculated();
+        }
+
+        size_t CIGUShadeLayer::airflowSteps() const
+        {
+            return m_AirflowSteps;
+        }
+
         void CIGUShadeLayer::calculateConvectionOrConductionFlow()
         {
             CIGUSolidLayer::calculateConvectionOrConductionFlow();
@@ -111,6 +129,22 @@ namespace Tarcog
             // nextLayer property.
             setCalculated();
 
+            if(m_AirflowCoupling == AirflowCoupling::Coupled)
+            {
+                // Airflow state is set by nonlinear solver. Only energy gains of gaps need to be
+                // smoothed for the current state.
+                const auto aGap1 = previousVentilatedGap();
+                const auto aGap2 = nextVentilatedGap();
+                if(aGap1 != nullptr && aGap2 != nullptr)
+                {
+                    double qv1 = aGap1->getGainFlow();
+                    double qv2 = aGap2->getGainFlow();
+                    aGap1->smoothEnergyGain(qv1, qv2);
+                    aGap2->smoothEnergyGain(qv1, qv2);
+                }
+                return;
+            }
+
             if(std::dynamic_pointer_cast<CIGUGapLayer>(m_PreviousLayer) != nullptr
                && std::dynamic_pointer_cast<CIGUGapLayer>(m_NextLayer) != nullptr)
             {
@@ -133,6 +167,215 @@ namespace Tarcog
             }
         }
 
+        std::shared_ptr<CIGUVentilatedGapLayer> CIGUShadeLayer::previousVentilatedGap() const
+        {
+            return std::dynamic_pointer_cast<CIGUVentilatedGapLayer>(m_PreviousLayer);
+        }
+
+        std::shared_ptr<CIGUVentilatedGapLayer> CIGUShadeLayer::nextVentilatedGap() const
+        {
+            return std::dynamic_pointer_cast<CIGUVentilatedGapLayer>(m_NextLayer);
+        }
+
+        std::shared_ptr<CEnvironment> CIGUShadeLayer::edgeEnvironment() const
+        {
+            if(nextVentilatedGap() != nullptr)
+            {
+                return std::dynamic_pointer_cast<CEnvironment>(m_PreviousLayer);
+            }
+            if(previousVentilatedGap() != nullptr)
+            {
+                return std::dynamic_pointer_cast<CEnvironment>(m_NextLayer);
+            }
+            return nullptr;
+        }
+
+        std::shared_ptr<CIGUVentilatedGapLayer> CIGUShadeLayer::edgeGap() const
+        {
+            if(std::dynamic_pointer_cast<CEnvironment>(m_PreviousLayer) != nullptr)
+            {
+                return nextVentilatedGap();
+            }
+            if(std::dynamic_pointer_cast<CEnvironment>(m_NextLayer) != nullptr)
+            {
+                return previousVentilatedGap();
+            }
+            return nullptr;
+        }
+
+        size_t CIGUShadeLayer::airflowStateSize() const
+        {
+            if(previousVentilatedGap() != nullptr && nextVentilatedGap() != nullptr)
+            {
+                return 3;
+            }
+            if(edgeGap() != nullptr && edgeEnvironment() != nullptr)
+            {
+                return 2;
+            }
+            return 0;
+        }
+
+        void CIGUShadeLayer::setInBetweenFlowGeometry(CIGUVentilatedGapLayer & t_Gap1,
+                                                      CIGUVentilatedGapLayer & t_Gap2)
+        {
+            if(t_Gap1.layerTemperature() > t_Gap2.layerTemperature())
+            {
+                t_Gap1.setFlowGeometry(
+                  m_ShadeOpenings->Aeq_bot(), m_ShadeOpenings->Aeq_top(), AirVerticalDirection::Up);
+                t_Gap2.setFlowGeometry(m_ShadeOpenings->Aeq_top(),
+                                       m_ShadeOpenings->Aeq_bot(),
+                                       AirVerticalDirection::Down);
+            }
+            else
+            {
+                t_Gap1.setFlowGeometry(m_ShadeOpenings->Aeq_top(),
+                                       m_ShadeOpenings->Aeq_bot(),
+                                       AirVerticalDirection::Down);
+                t_Gap2.setFlowGeometry(
+                  m_ShadeOpenings->Aeq_bot(), m_ShadeOpenings->Aeq_top(), AirVerticalDirection::Up);
+            }
+        }
+
+        void CIGUShadeLayer::setEdgeFlowGeometry(CEnvironment & t_Environment,
+                                                 CIGUVentilatedGapLayer & t_Gap)
+        {
+            if(t_Gap.layerTemperature() > t_Environment.getGasTemperature())
+            {
+                t_Gap.setFlowGeometry(
+                  m_ShadeOpenings->Aeq_bot(), m_ShadeOpenings->Aeq_top(), AirVerticalDirection::Up);
+            }
+            else
+            {
+                t_Gap.setFlowGeometry(m_ShadeOpenings->Aeq_top(),
+                                      m_ShadeOpenings->Aeq_bot(),
+                                      AirVerticalDirection::Down);
+            }
+        }
+
+        void CIGUShadeLayer::calcAirflowTarget(double * t_Target)
+        {
+            ++m_AirflowSteps;
+            const auto aGap1 = previousVentilatedGap();
+            const auto aGap2 = nextVentilatedGap();
+            if(aGap1 != nullptr && aGap2 != nullptr)
+            {
+                // Same equations as in single step of calcInBetweenShadeFlow
+                const double tempGap1 = aGap1->layerTemperature();
+                const double tempGap2 = aGap2->layerTemperature();
+                const double Tav1 = aGap1->averageTemperature();
+                const double Tav2 = aGap2->averageTemperature();
+                setInBetweenFlowGeometry(*aGap1, *aGap2);
+                const double drivingPressure = aGap1->getAirflowReferencePoint(tempGap2);
+                const double ratio = aGap1->getThickness() / aGap2->getThickness();
+                const double A1 = aGap1->bernoullyPressureTerm() + aGap1->pressureLossTerm();
+                const double A2 = aGap2->bernoullyPressureTerm() + aGap2->pressureLossTerm();
+                const double B1 = aGap1->hagenPressureTerm();
+                const double B2 = aGap2->hagenPressureTerm();
+                const double A = A1 + pow(ratio, 2) * A2;
+                const double B = B1 + ratio * B2;
+                const double speed1 =
+                  (sqrt(std::abs(pow(B, 2.0) + 4 * A * drivingPressure)) - B) / (2.0 * A);
+                aGap1->setFlowSpeed(speed1);
+                aGap2->setFlowSpeed(speed1 / ratio);
+
+                const double beta1 = aGap1->betaCoeff();
+                const double beta2 = aGap2->betaCoeff();
+                const double alpha1 = 1 - beta1;
+                const double alpha2 = 1 - beta2;
+
+                double Tup = 0;
+                double Tdown = 0;
+                if(tempGap1 > tempGap2)
+                {
+                    Tup = (alpha1 * Tav1 + beta1 * alpha2 * Tav2) / (1 - beta1 * beta2);
+                    Tdown = alpha2 * Tav2 + beta2 * Tup;
+                }
+                else
+                {
+                    Tdown = (alpha1 * Tav1 + beta1 * alpha2 * Tav2) / (1 - beta1 * beta2);
+                    Tup = alpha2 * Tav2 + beta2 * Tdown;
+                }
+
+                t_Target[0] = speed1;
+                t_Target[1] = Tup;
+                t_Target[2] = Tdown;
+                return;
+            }
+
+            const auto aEnvironment = edgeEnvironment();
+            const auto aGap = edgeGap();
+            if(aEnvironment != nullptr && aGap != nullptr)
+            {
+                // Same equations as in single step of calcEdgeShadeFlow
+                const double tempEnvironment = aEnvironment->getGasTemperature();
+                const double TavGap = aGap->averageTemperature();
+                setEdgeFlowGeometry(*aEnvironment, *aGap);
+                const double drivingPressure = aGap->getAirflowReferencePoint(tempEnvironment);
+                const double A = aGap->bernoullyPressureTerm() + aGap->pressureLossTerm();
+                const double B = aGap->hagenPressureTerm();
+                const double speed =
+                  (sqrt(std::abs(pow(B, 2) + 4 * A * drivingPressure)) - B) / (2 * A);
+                aGap->setFlowSpeed(speed);
+                const double beta = aGap->betaCoeff();
+                const double alpha = 1 - beta;
+
+                t_Target[0] = speed;
+                t_Target[1] = alpha * TavGap + beta * tempEnvironment;
+            }
+        }
+
+        void CIGUShadeLayer::setAirflowState(const double * t_State)
+        {
+            const auto aGap1 = previousVentilatedGap();
+            const auto aGap2 = nextVentilatedGap();
+            if(aGap1 != nullptr && aGap2 != nullptr)
+            {
+                const double speed1 = t_State[0];
+                const double Tup = t_State[1];
+                const double Tdown = t_State[2];
+
+                AirVerticalDirection gap1Direction = AirVerticalDirection::Down;
+                AirVerticalDirection gap2Direction = AirVerticalDirection::Up;
+                if(aGap1->layerTemperature() > aGap2->layerTemperature())
+                {
+                    gap1Direction = AirVerticalDirection::Up;
+                    gap2Direction = AirVerticalDirection::Down;
+                }
+                setInBetweenFlowGeometry(*aGap1, *aGap2);
+
+                const double ratio = aGap1->getThickness() / aGap2->getThickness();
+                aGap1->setFlowSpeed(speed1);
+                aGap2->setFlowSpeed(speed1 / ratio);
+                aGap1->setFlowTemperatures(Tup, Tdown, gap1Direction);
+                aGap2->setFlowTemperatures(Tup, Tdown, gap2Direction);
+            }
+            else
+            {
+                const auto aEnvironment = edgeEnvironment();
+                const auto aGap = edgeGap();
+                if(aEnvironment != nullptr && aGap != nullptr)
+                {
+                    const double tempEnvironment = aEnvironment->getGasTemperature();
+                    const double TgapOut = t_State[1];
+                    setEdgeFlowGeometry(*aEnvironment, *aGap);
+                    aGap->setFlowSpeed(t_State[0]);
+                    if(TgapOut > tempEnvironment)
+                    {
+                        aGap->setFlowTemperatures(TgapOut, tempEnvironment, AirVerticalDirection::Up);
+                    }
+                    else
+                    {
+                        aGap->setFlowTemperatures(
+                          tempEnvironment, TgapOut, AirVerticalDirection::Down);
+                    }
+                }
+            }
+
+            // Energy gains of gaps are smoothed when shade is calculated next time
+            resetCalculated();
+        }
+
         void CIGUShadeLayer::calcInBetweenShadeFlow(std::shared_ptr<CIGUVentilatedGapLayer> t_Gap1,
                                                     std::shared_ptr<CIGUVentilatedGapLayer> t_Gap2)
         {
@@ -148,24 +391,7 @@ namespace Tarcog
                 double tempGap2 = t_Gap2->layerTemperature();
                 double Tav1 = t_Gap1->averageTemperature();
                 double Tav2 = t_Gap2->averageTemperature();
-                if(tempGap1 > tempGap2)
-                {
-                    t_Gap1->setFlowGeometry(m_ShadeOpenings->Aeq_bot(),
-                                            m_ShadeOpenings->Aeq_top(),
-                                            AirVerticalDirection::Up);
-                    t_Gap2->setFlowGeometry(m_ShadeOpenings->Aeq_top(),
-                                            m_ShadeOpenings->Aeq_bot(),
-                                            AirVerticalDirection::Down);
-                }
-                else
-                {
-                    t_Gap1->setFlowGeometry(m_ShadeOpenings->Aeq_top(),
-                                            m_ShadeOpenings->Aeq_bot(),
-                                            AirVerticalDirection::Down);
-                    t_Gap2->setFlowGeometry(m_ShadeOpenings->Aeq_bot(),
-                                            m_ShadeOpenings->Aeq_top(),
-                                            AirVerticalDirection::Up);
-                }
+                setInBetweenFlowGeometry(*t_Gap1, *t_Gap2);
                 double drivingPressure = t_Gap1->getAirflowReferencePoint(tempGap2);
                 double ratio = t_Gap1->getThickness() / t_Gap2->getThickness();
                 double A1 = t_Gap1->bernoullyPressureTerm() + t_Gap1->pressureLossTerm();
@@ -225,6 +451,7 @@ namespace Tarcog
                 t_Gap2->setFlowTemperatures(Tup, Tdown, gap2Direction);
 
                 ++iterationStep;
+                ++m_AirflowSteps;
                 if(iterationStep > IterationConstants::NUMBER_OF_STEPS)
                 {
                     converged = true;
@@ -252,18 +479,7 @@ namespace Tarcog
             {
                 double tempEnvironment = t_Environment->getGasTemperature();
                 double TavGap = t_Gap->averageTemperature();
-                if(tempGap > tempEnvironment)
-                {
-                    t_Gap->setFlowGeometry(m_ShadeOpenings->Aeq_bot(),
-                                           m_ShadeOpenings->Aeq_top(),
-                                           AirVerticalDirection::Up);
-                }
-                else
-                {
-                    t_Gap->setFlowGeometry(m_ShadeOpenings->Aeq_top(),
-                                           m_ShadeOpenings->Aeq_bot(),
-                                           AirVerticalDirection::Down);
-                }
+                setEdgeFlowGeometry(*t_Environment, *t_Gap);
                 double drivingPressure = t_Gap->getAirflowReferencePoint(tempEnvironment);
                 double A = t_Gap->bernoullyPressureTerm() + t_Gap->pressureLossTerm();
                 double B = t_Gap->hagenPressureTerm();
@@ -296,6 +512,7 @@ namespace Tarcog
                             < IterationConstants::CONVERGENCE_TOLERANCE_AIRFLOW;
 
                 ++iterationStep;
+                ++m_AirflowSteps;
                 if(iterationStep > IterationConstants::NUMBER_OF_STEPS)
                 {
                     RelaxationParameter -= IterationConstants::RELAXATION_PARAMETER_AIRFLOW_STEP;
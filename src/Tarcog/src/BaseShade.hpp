@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "IGUSolidLayer.hpp"
+#include "CalculationModels.hpp"
 
 namespace Gases
 {
@@ -58,9 +59,36 @@ namespace Tarcog
 
             std::shared_ptr<CBaseLayer> clone() const override;
 
+            void setAirflowCoupling(AirflowCoupling t_Coupling);
+
+            // Number of airflow unknowns of ventilated gaps next to shade. In between shade has
+            // air speed in first gap with top and bottom temperatures. Edge shade has air speed
+            // and gap outlet temperature. Zero if shade is not next to ventilated gap.
+            size_t airflowStateSize() const;
+
+            // Airflow state that satisfies airflow equations for current surface temperatures.
+            // Gap state is changed by this call and needs to be set back with setAirflowState.
+            void calcAirflowTarget(double * t_Target);
+            void setAirflowState(const double * t_State);
+
+            // Airflow evaluations since coupling mode was set. These are steps of nested airflow
+            // loops or airflow targets calculated for nonlinear solver in coupled mode.
+            size_t airflowSteps() const;
+
         private:
             void calculateConvectionOrConductionFlow() override;
 
+            std::shared_ptr<CIGUVentilatedGapLayer> previousVentilatedGap() const;
+            std::shared_ptr<CIGUVentilatedGapLayer> nextVentilatedGap() const;
+            std::shared_ptr<CEnvironment> edgeEnvironment() const;
+
+            // Ventilated gap next to edge shade (nullptr if shade is not next to environment)
+            std::shared_ptr<CIGUVentilatedGapLayer> edgeGap() const;
+
+            void setInBetweenFlowGeometry(CIGUVentilatedGapLayer & t_Gap1,
+                                          CIGUVentilatedGapLayer & t_Gap2);
+            void setEdgeFlowGeometry(CEnvironment & t_Environment, CIGUVentilatedGapLayer & t_Gap);
+
             void calcInBetweenShadeFlow(std::shared_ptr<CIGUVentilatedGapLayer> t_Gap1,
                                         std::shared_ptr<CIGUVentilatedGapLayer> t_Gap2);
 
@@ -68,6 +96,8 @@ namespace Tarcog
                                    std::shared_ptr<CIGUVentilatedGapLayer> t_Gap);
 
             std::shared_ptr<CShadeOpenings> m_ShadeOpenings;
+            AirflowCoupling m_AirflowCoupling;
+            size_t m_AirflowSteps;
         };
 
     }   // namespace ISO15099
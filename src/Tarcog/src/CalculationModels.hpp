@@ -11,6 +11,15 @@ namespace Tarcog
             DeflectionPressureTemperature,
             MeasuredDeflection
         };
+
+        // Nested: airflow of ventilated gaps is iterated to convergence inside every iteration of
+        // heat balance. Coupled: airflow unknowns are part of the nonlinear solver state and only
+        // one airflow update is made per iteration.
+        enum class AirflowCoupling
+        {
+            Nested,
+            Coupled
+        };
     }
 }   // namespace Tarcog
 
@@ -0,0 +1,302 @@
+#include <cmath>
+#include <cassert>
+#include <typeinfo>
+#include <algorithm>
+
+#include "CompiledIGU.hpp"
+#include "IGUSolidLayer.hpp"
+#include "IGUGapLayer.hpp"
+#include "OutdoorEnvironment.hpp"
+#include "IndoorEnvironment.hpp"
+#include "Surface.hpp"
+
+using FenestrationCommon::Side;
+
+namespace
+{
+    // CGas equality includes gas state and identity of property storage, so mixtures are
+    // compared through their properties at reference temperatures instead.
+    bool sameMixture(Gases::CGas t_Gas1, Gases::CGas t_Gas2)
+    {
+        const double pressure = 101325;
+        for(const auto temperature : {250.0, 350.0})
+        {
+            t_Gas1.setTemperatureAndPressure(temperature, pressure);
+            t_Gas2.setTemperatureAndPressure(temperature, pressure);
+            if(!(t_Gas1.getGasProperties() == t_Gas2.getGasProperties()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}   // namespace
+
+namespace Tarcog
+{
+    namespace ISO15099
+    {
+        CCompiledIGU::CCompiledIGU() :
+            m_Compiled(false),
+            m_OutdoorCoefficient(0),
+            m_OutdoorIR(0),
+            m_OutdoorAirTemperature(0),
+            m_IndoorConvection(IndoorConvection::Constant),
+            m_IndoorCoefficient(0),
+            m_IndoorIR(0),
+            m_IndoorAirTemperature(0),
+            m_IndoorPressure(0),
+            m_IndoorHeight(0),
+            m_IndoorTilt(0)
+        {}
+
+        bool CCompiledIGU::compile(const std::vector<std::shared_ptr<CIGUSolidLayer>> & t_SolidLayers)
+        {
+            m_Compiled = false;
+            m_SolidCoefficient.clear();
+            m_SolarGain.clear();
+            m_EmissivityFront.clear();
+            m_EmissivityBack.clear();
+            m_ReflectanceFront.clear();
+            m_ReflectanceBack.clear();
+            m_TransmittanceFront.clear();
+            m_TransmittanceBack.clear();
+            m_GapThickness.clear();
+            m_GapPressure.clear();
+            m_GapTilt.clear();
+            m_GapHeight.clear();
+            m_GapGasIndex.clear();
+            m_Gases.clear();
+
+            if(t_SolidLayers.empty())
+            {
+                return false;
+            }
+
+            for(size_t i = 0; i < t_SolidLayers.size(); ++i)
+            {
+                auto & aLayer = *t_SolidLayers[i];
+                if(typeid(aLayer) != typeid(CIGUSolidLayer))
+                {
+                    return false;
+                }
+
+                // Surface properties that depend on temperature (e.g. thermochromics) cannot be
+                // copied
+                const auto aFront = aLayer.getSurface(Side::Front);
+                const auto aBack = aLayer.getSurface(Side::Back);
+                if(typeid(*aFront) != typeid(CSurface) || typeid(*aBack) != typeid(CSurface))
+                {
+                    return false;
+                }
+
+                m_SolidCoefficient.push_back(aLayer.getConductionConvectionCoefficient());
+                m_SolarGain.push_back(aLayer.getGainFlow());
+                m_EmissivityFront.push_back(aFront->getEmissivity());
+                m_EmissivityBack.push_back(aBack->getEmissivity());
+                m_ReflectanceFront.push_back(aFront->getReflectance());
+                m_ReflectanceBack.push_back(aBack->getReflectance());
+                m_TransmittanceFront.push_back(aFront->getTransmittance());
+                m_TransmittanceBack.push_back(aBack->getTransmittance());
+
+                if(i + 1 < t_SolidLayers.size())
+                {
+                    const auto aGap = std::dynamic_pointer_cast<CIGUGapLayer>(aLayer.getNextLayer());
+                    if(aGap == nullptr || typeid(*aGap) != typeid(CIGUGapLayer))
+                    {
+                        return false;
+                    }
+                    m_GapThickness.push_back(aGap->getThickness());
+                    m_GapPressure.push_back(aGap->getPressure());
+                    m_GapTilt.push_back(aGap->getTilt());
+                    m_GapHeight.push_back(aGap->getHeight());
+
+                    const auto & aGas = aGap->getGas();
+                    const auto it = std::find_if(
+                      m_Gases.begin(), m_Gases.end(), [&aGas](const Gases::CGas & t_Gas) {
+                          return sameMixture(t_Gas, aGas);
+                      });
+                    m_GapGasIndex.push_back(size_t(std::distance(m_Gases.begin(), it)));
+                    if(it == m_Gases.end())
+                    {
+                        m_Gases.push_back(aGas);
+                    }
+                }
+            }
+
+            const auto aOutdoor =
+              std::dynamic_pointer_cast<COutdoorEnvironment>(t_SolidLayers.front()->getPreviousLayer());
+            const auto aIndoor =
+              std::dynamic_pointer_cast<CIndoorEnvironment>(t_SolidLayers.back()->getNextLayer());
+            if(aOutdoor == nullptr || aIndoor == nullptr
+               || aOutdoor->getHCoeffModel() == BoundaryConditionsCoeffModel::HPrescribed
+               || aIndoor->getHCoeffModel() == BoundaryConditionsCoeffModel::HPrescribed)
+            {
+                return false;
+            }
+
+            // Outdoor convection does not depend on surface temperature
+            m_OutdoorCoefficient = aOutdoor->getConductionConvectionCoefficient();
+            m_OutdoorIR = aOutdoor->getEnvironmentIR();
+            m_OutdoorAirTemperature = aOutdoor->getAirTemperature();
+
+            // Calculated indoor convection is natural unless room air is moving, in which case it
+            // does not depend on surface temperature (same as CIndoorEnvironment::calculateHc)
+            m_IndoorConvection = IndoorConvection::Constant;
+            if(aIndoor->getHCoeffModel() == BoundaryConditionsCoeffModel::CalculateH)
+            {
+                if(aIndoor->getAirSpeed() > 0)
+                {
+                    m_IndoorCoefficient =
+                      CIndoorEnvironment::forcedConvectionCoefficient(aIndoor->getAirSpeed());
+                }
+                else
+                {
+                    m_IndoorConvection = IndoorConvection::Natural;
+                    m_IndoorCoefficient = 0;
+                }
+            }
+            else
+            {
+                m_IndoorCoefficient = aIndoor->getConductionConvectionCoefficient();
+            }
+            m_IndoorIR = aIndoor->getEnvironmentIR();
+            m_IndoorAirTemperature = aIndoor->getAirTemperature();
+            m_IndoorPressure = aIndoor->getPressure();
+            m_IndoorHeight = aIndoor->getHeight();
+            m_IndoorTilt = aIndoor->getTilt();
+            m_IndoorGas = aIndoor->getGas();
+
+            const auto stateSize = 4 * t_SolidLayers.size();
+            if(m_MatrixA.size() != stateSize)
+            {
+                m_MatrixA = CBalanceMatrix(stateSize);
+            }
+            m_VectorB.resize(stateSize);
+            m_GapCoefficient.resize(m_GapThickness.size());
+
+            m_Compiled = true;
+            return m_Compiled;
+        }
+
+        bool CCompiledIGU::isCompiled() const
+        {
+            return m_Compiled;
+        }
+
+        size_t CCompiledIGU::numberOfGasMixtures() const
+        {
+            return m_Gases.size();
+        }
+
+        double CCompiledIGU::indoorCoefficient(const double t_SurfaceTemperature)
+        {
+            if(m_IndoorConvection == IndoorConvection::Natural)
+            {
+                return CIndoorEnvironment::naturalConvectionCoefficient(m_IndoorGas,
+                                                                        m_IndoorPressure,
+                                                                        m_IndoorHeight,
+                                                                        m_IndoorTilt,
+                                                                        m_IndoorAirTemperature,
+                                                                        t_SurfaceTemperature);
+            }
+            return m_IndoorCoefficient;
+        }
+
+        const std::vector<double> & CCompiledIGU::calcBalanceMatrix(const std::vector<double> & t_State)
+        {
+            using ConstantsData::STEFANBOLTZMANN;
+
+            assert(m_Compiled);
+            const size_t numSolids = m_SolidCoefficient.size();
+            assert(t_State.size() >= 4 * numSolids);
+
+            for(size_t i = 0; i < m_GapCoefficient.size(); ++i)
+            {
+                const auto Tfront = t_State[4 * i + 3];
+                const auto Tback = t_State[4 * (i + 1)];
+                m_GapCoefficient[i] = CIGUGapLayer::convectiveCoefficient(m_Gases[m_GapGasIndex[i]],
+                                                                          m_GapPressure[i],
+                                                                          m_GapTilt[i],
+                                                                          m_GapHeight[i],
+                                                                          m_GapThickness[i],
+                                                                          (Tfront + Tback) / 2,
+                                                                          std::abs(Tback - Tfront));
+            }
+
+            m_MatrixA.setZeros();
+            std::fill(m_VectorB.begin(), m_VectorB.end(), 0);
+
+            // Same cells as in CHeatFlowBalance::buildCell
+            for(size_t i = 0; i < numSolids; ++i)
+            {
+                const size_t sP = 4 * i;
+                const bool isFirst = i == 0;
+                const bool isLast = i + 1 == numSolids;
+
+                const double hgl = m_SolidCoefficient[i];
+                const double hgap_prev = isFirst ? m_OutdoorCoefficient : m_GapCoefficient[i - 1];
+                const double hgap_next =
+                  isLast ? indoorCoefficient(t_State[sP + 3]) : m_GapCoefficient[i];
+                const double emissPowerFront =
+                  STEFANBOLTZMANN * m_EmissivityFront[i] * pow(t_State[sP], 3);
+                const double emissPowerBack =
+                  STEFANBOLTZMANN * m_EmissivityBack[i] * pow(t_State[sP + 3], 3);
+                const double solarRadiation = m_SolarGain[i];
+
+                // first row
+                m_MatrixA(sP, sP) = hgap_prev + hgl;
+                m_MatrixA(sP, sP + 1) = 1;
+                m_MatrixA(sP, sP + 3) = -hgl;
+                m_VectorB[sP] = solarRadiation / 2;
+
+                // second row
+                m_MatrixA(sP + 1, sP) = emissPowerFront;
+                m_MatrixA(sP + 1, sP + 1) = -1;
+
+                // third row
+                m_MatrixA(sP + 2, sP + 2) = -1;
+                m_MatrixA(sP + 2, sP + 3) = emissPowerBack;
+
+                // fourth row
+                m_MatrixA(sP + 3, sP) = hgl;
+                m_MatrixA(sP + 3, sP + 2) = -1;
+                m_MatrixA(sP + 3, sP + 3) = -hgap_next - hgl;
+                m_VectorB[sP + 3] = -solarRadiation / 2;
+
+                if(!isFirst)
+                {
+                    m_MatrixA(sP, sP - 2) = -1;
+                    m_MatrixA(sP, sP - 1) = -hgap_prev;
+                    m_MatrixA(sP + 1, sP - 2) = m_ReflectanceFront[i];
+                    m_MatrixA(sP + 2, sP - 2) = m_TransmittanceFront[i];
+                }
+                else
+                {
+                    m_VectorB[sP] += m_OutdoorIR + hgap_prev * m_OutdoorAirTemperature;
+                    m_VectorB[sP + 1] -= m_ReflectanceFront[i] * m_OutdoorIR;
+                    m_VectorB[sP + 2] -= m_TransmittanceFront[i] * m_OutdoorIR;
+                }
+
+                if(!isLast)
+                {
+                    m_MatrixA(sP + 1, sP + 5) = m_TransmittanceBack[i];
+                    m_MatrixA(sP + 2, sP + 5) = m_ReflectanceBack[i];
+                    m_MatrixA(sP + 3, sP + 4) = hgap_next;
+                    m_MatrixA(sP + 3, sP + 5) = 1;
+                }
+                else
+                {
+                    m_VectorB[sP + 1] -= m_TransmittanceBack[i] * m_IndoorIR;
+                    m_VectorB[sP + 2] -= m_ReflectanceBack[i] * m_IndoorIR;
+                    m_VectorB[sP + 3] -= (m_IndoorIR + hgap_next * m_IndoorAirTemperature);
+                }
+            }
+
+            m_MatrixA.solveInPlace(m_VectorB);
+            return m_VectorB;
+        }
+
+    }   // namespace ISO15099
+
+}   // namespace Tarcog
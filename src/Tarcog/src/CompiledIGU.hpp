@@ -0,0 +1,94 @@
+#ifndef TARCOGCOMPILEDIGU_H
+#define TARCOGCOMPILEDIGU_H
+
+#include <memory>
+#include <vector>
+
+#include "WCECommon.hpp"
+#include "WCEGases.hpp"
+#include "BalanceMatrix.hpp"
+
+namespace Tarcog
+{
+    namespace ISO15099
+    {
+        class CIGUSolidLayer;
+
+        // Flat representation of IGU used by nonlinear solver. Layer properties that do not change
+        // during iterations are copied into per-layer arrays so that heat balance is built without
+        // walking linked list of layers and without virtual calls. Only IGUs made of solid layers
+        // with constant surface properties and sealed gaps are compiled (these layers have no
+        // energy gain other than absorbed solar radiation). Shades, ventilated gaps, deflection,
+        // support pillars, thermochromic surfaces and environments with prescribed total film
+        // coefficient are solved with object model.
+        class CCompiledIGU
+        {
+        public:
+            CCompiledIGU();
+
+            // Returns false (and leaves IGU uncompiled) if any of the layers is not supported
+            bool compile(const std::vector<std::shared_ptr<CIGUSolidLayer>> & t_SolidLayers);
+            bool isCompiled() const;
+
+            // Same system as CHeatFlowBalance::calcBalanceMatrix for given state (Tf, Jf, Jb, Tb of
+            // every solid layer). Solution is stored in workspace vector.
+            const std::vector<double> & calcBalanceMatrix(const std::vector<double> & t_State);
+
+            size_t numberOfGasMixtures() const;
+
+        private:
+            enum class IndoorConvection
+            {
+                Constant,
+                Natural
+            };
+
+            double indoorCoefficient(double t_SurfaceTemperature);
+
+            bool m_Compiled;
+
+            // Solid layers
+            std::vector<double> m_SolidCoefficient;
+            std::vector<double> m_SolarGain;
+            std::vector<double> m_EmissivityFront;
+            std::vector<double> m_EmissivityBack;
+            std::vector<double> m_ReflectanceFront;
+            std::vector<double> m_ReflectanceBack;
+            std::vector<double> m_TransmittanceFront;
+            std::vector<double> m_TransmittanceBack;
+
+            // Gaps (gap i is between solid layers i and i + 1)
+            std::vector<double> m_GapThickness;
+            std::vector<double> m_GapPressure;
+            std::vector<double> m_GapTilt;
+            std::vector<double> m_GapHeight;
+            std::vector<size_t> m_GapGasIndex;
+            std::vector<double> m_GapCoefficient;
+
+            // Distinct gas mixtures used in gaps
+            std::vector<Gases::CGas> m_Gases;
+
+            // Outdoor boundary
+            double m_OutdoorCoefficient;
+            double m_OutdoorIR;
+            double m_OutdoorAirTemperature;
+
+            // Indoor boundary
+            IndoorConvection m_IndoorConvection;
+            double m_IndoorCoefficient;
+            double m_IndoorIR;
+            double m_IndoorAirTemperature;
+            double m_IndoorPressure;
+            double m_IndoorHeight;
+            double m_IndoorTilt;
+            Gases::CGas m_IndoorGas;
+
+            CBalanceMatrix m_MatrixA;
+            std::vector<double> m_VectorB;
+        };
+
+    }   // namespace ISO15099
+
+}   // namespace Tarcog
+
+#endif
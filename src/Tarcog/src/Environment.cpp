@@ -56,6 +56,11 @@ namespace Tarcog
             resetCalculated();
         }
 
+        BoundaryConditionsCoeffModel CEnvironment::getHCoeffModel() const
+        {
+            return m_HCoefficientModel;
+        }
+
         void CEnvironment::setForcedVentilation(ForcedVentilation const & t_ForcedVentilation)
         {
             m_ForcedVentilation = t_ForcedVentilation;
@@ -34,6 +34,7 @@ namespace Tarcog
             ~CEnvironment();
 
             void setHCoeffModel(BoundaryConditionsCoeffModel t_BCModel, double t_HCoeff = 0);
+            BoundaryConditionsCoeffModel getHCoeffModel() const;
             void setForcedVentilation(const ForcedVentilation & t_ForcedVentilation);
             void setEnvironmentIR(double t_InfraRed);
             void setEmissivity(double t_Emissivity);
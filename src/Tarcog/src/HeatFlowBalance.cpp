@@ -24,18 +24,49 @@ namespace Tarcog
 			m_IGU(t_IGU)
         {}
 
-        std::vector<double> CHeatFlowBalance::calcBalanceMatrix()
+        void CHeatFlowBalance::initialize()
         {
-            auto aSolidLayers = m_IGU.getSolidLayers();
+            m_SolidLayers = m_IGU.getSolidLayers();
+            m_Cells.clear();
+            for(const auto & layer : m_SolidLayers)
+            {
+                const auto previous = layer->getPreviousLayer();
+                const auto next = layer->getNextLayer();
+                m_Cells.push_back({layer.get(),
+                                   previous.get(),
+                                   next.get(),
+                                   dynamic_cast<CEnvironment *>(previous.get()),
+                                   dynamic_cast<CEnvironment *>(next.get())});
+            }
+            if(m_MatrixA.size() != 4 * m_SolidLayers.size())
+            {
+                m_MatrixA = CBalanceMatrix(4 * m_SolidLayers.size());
+                m_VectorB.resize(4 * m_SolidLayers.size());
+            }
+        }
+
+        const std::vector<double> & CHeatFlowBalance::calcBalanceMatrix()
+        {
+            if(m_Cells.empty())
+            {
+                initialize();
+            }
             m_MatrixA.setZeros();
             std::fill(m_VectorB.begin(), m_VectorB.end(), 0);
-			for ( size_t i = 0; i < aSolidLayers.size(); ++i ) {
-				buildCell(*aSolidLayers[i], i);
+			for ( size_t i = 0; i < m_Cells.size(); ++i ) {
+				buildCell(m_Cells[i], i);
 			}
-            return FenestrationCommon::CLinearSolver::solveSystem(m_MatrixA, m_VectorB);
+            m_MatrixA.solveInPlace(m_VectorB);
+            return m_VectorB;
+        }
+
+        const std::vector<std::shared_ptr<CIGUSolidLayer>> &
+          CHeatFlowBalance::getSolidLayers() const
+        {
+            return m_SolidLayers;
         }
 
-        void CHeatFlowBalance::buildCell( Tarcog::ISO15099::CBaseLayer & t_Current,
+        void CHeatFlowBalance::buildCell( const CCell & t_Cell,
 										  const size_t t_Index )
         {
             // Routine is used to build matrix "cell" around solid layer.
@@ -43,22 +74,23 @@ namespace Tarcog
             // first determine cell size
             size_t sP = 4 * t_Index;
 
-            auto next = t_Current.getNextLayer();
-			auto previous = t_Current.getPreviousLayer();
+            auto & current = *t_Cell.Layer;
+            auto next = t_Cell.Next;
+			auto previous = t_Cell.Previous;
 
             // First build base cell
-            double hgl = t_Current.getConductionConvectionCoefficient();
+            double hgl = current.getConductionConvectionCoefficient();
             double hgap_prev = previous->getConductionConvectionCoefficient();
             double hgap_next = next->getConductionConvectionCoefficient();
-            std::shared_ptr<ISurface> frontSurface = t_Current.getSurface(Side::Front);
+            std::shared_ptr<ISurface> frontSurface = current.getSurface(Side::Front);
             assert(frontSurface != nullptr);
             double emissPowerFront = frontSurface->emissivePowerTerm();
-            std::shared_ptr<ISurface> backSurface = t_Current.getSurface(Side::Back);
+            std::shared_ptr<ISurface> backSurface = current.getSurface(Side::Back);
             assert(backSurface != nullptr);
             double emissPowerBack = backSurface->emissivePowerTerm();
             double qv_prev = previous->getGainFlow();
             double qv_next = next->getGainFlow();
-            double solarRadiation = t_Current.getGainFlow();
+            double solarRadiation = current.getGainFlow();
 
             // first row
             m_MatrixA(sP, sP) = hgap_prev + hgl;
@@ -80,7 +112,7 @@ namespace Tarcog
             m_MatrixA(sP + 3, sP + 3) = -hgap_next - hgl;
             m_VectorB[sP + 3] = -solarRadiation / 2 - qv_next / 2;
 
-            if( std::dynamic_pointer_cast<CEnvironment>(previous) == nullptr)
+            if(t_Cell.PreviousEnvironment == nullptr)
             {
                 // first row
                 m_MatrixA(sP, sP - 2) = -1;
@@ -95,16 +127,15 @@ namespace Tarcog
             else
             {
                 const double environmentRadiosity =
-                  std::dynamic_pointer_cast<CEnvironment>(previous)->getEnvironmentIR();
-                const double airTemperature =
-                  std::dynamic_pointer_cast<CEnvironment>(previous)->getGasTemperature();
+                  t_Cell.PreviousEnvironment->getEnvironmentIR();
+                const double airTemperature = t_Cell.PreviousEnvironment->getGasTemperature();
 
                 m_VectorB[sP] += environmentRadiosity + hgap_prev * airTemperature;
                 m_VectorB[sP + 1] -= frontSurface->getReflectance() * environmentRadiosity;
                 m_VectorB[sP + 2] -= frontSurface->getTransmittance() * environmentRadiosity;
             }
 
-            if(std::dynamic_pointer_cast<CEnvironment>(next) == nullptr)
+            if(t_Cell.NextEnvironment == nullptr)
             {
                 // second row
                 m_MatrixA(sP + 1, sP + 5) = backSurface->getTransmittance();
@@ -118,10 +149,8 @@ namespace Tarcog
             }
             else
             {
-                const double environmentRadiosity =
-                  std::dynamic_pointer_cast<CEnvironment>(next)->getEnvironmentIR();
-                const double airTemperature =
-                  std::dynamic_pointer_cast<CEnvironment>(next)->getGasTemperature();
+                const double environmentRadiosity = t_Cell.NextEnvironment->getEnvironmentIR();
+                const double airTemperature = t_Cell.NextEnvironment->getGasTemperature();
 
                 m_VectorB[sP + 1] -= backSurface->getTransmittance() * environmentRadiosity;
                 m_VectorB[sP + 2] -= backSurface->getReflectance() * environmentRadiosity;
@@ -5,34 +5,50 @@
 #include <vector>
 #include "WCECommon.hpp"
 #include "IGU.hpp"
-
-namespace FenestrationCommon
-{
-    class SquareMatrix;
-    class CLinearSolver;
-
-}   // namespace FenestrationCommon
+#include "BalanceMatrix.hpp"
 
 namespace Tarcog
 {
     namespace ISO15099
     {
         class CBaseLayer;
+        class CEnvironment;
 
         class CHeatFlowBalance
         {
         public:
             explicit CHeatFlowBalance(CIGU & t_IGU);
 
-            std::vector<double> calcBalanceMatrix();
+            // Collects solid layers of IGU together with their neighbours. Needs to be called
+            // before iterations whenever layers of IGU are changed.
+            void initialize();
+
+            // Solution is stored in workspace vector that is reused between iterations
+            const std::vector<double> & calcBalanceMatrix();
+
+            const std::vector<std::shared_ptr<CIGUSolidLayer>> & getSolidLayers() const;
 
         private:
-            void buildCell( Tarcog::ISO15099::CBaseLayer & t_Current,
+            // Solid layer with its neighbours. Environment pointers are set only when neighbour
+            // is environment, so that matrix can be built without casting of layers.
+            struct CCell
+            {
+                CIGUSolidLayer * Layer;
+                CBaseLayer * Previous;
+                CBaseLayer * Next;
+                CEnvironment * PreviousEnvironment;
+                CEnvironment * NextEnvironment;
+            };
+
+            void buildCell( const CCell & t_Cell,
 							size_t t_Index );
 
-            FenestrationCommon::SquareMatrix m_MatrixA;
+            CBalanceMatrix m_MatrixA;
             std::vector<double> m_VectorB;
 
+            std::vector<std::shared_ptr<CIGUSolidLayer>> m_SolidLayers;
+            std::vector<CCell> m_Cells;
+
             CIGU & m_IGU;
         };
 
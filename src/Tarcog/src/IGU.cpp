@@ -130,6 +130,24 @@ namespace Tarcog
             }
         }
 
+        void CIGU::enableGasLookupTables(double const t_MinTemperature,
+                                         double const t_MaxTemperature,
+                                         double const t_Tolerance)
+        {
+            for(auto & layer : getGapLayers())
+            {
+                layer->enableGasLookupTable(t_MinTemperature, t_MaxTemperature, t_Tolerance);
+            }
+        }
+
+        void CIGU::disableGasLookupTables()
+        {
+            for(auto & layer : getGapLayers())
+            {
+                layer->disableGasLookupTable();
+            }
+        }
+
         void CIGU::setSolarRadiation(double const t_SolarRadiation) const
         {
             for(auto & layer : getSolidLayers())
@@ -170,9 +188,15 @@ namespace Tarcog
         }
 
         void CIGU::setState(const std::vector<double> & t_State) const
+        {
+            setState(getSolidLayers(), t_State);
+        }
+
+        void CIGU::setState(const std::vector<std::shared_ptr<CIGUSolidLayer>> & t_SolidLayers,
+                            const std::vector<double> & t_State)
         {
             size_t i = 0;
-            for(const auto & aLayer : getSolidLayers())
+            for(const auto & aLayer : t_SolidLayers)
             {
                 const auto Tf = t_State[4 * i];
                 const auto Jf = t_State[4 * i + 1];
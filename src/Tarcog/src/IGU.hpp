@@ -43,6 +43,9 @@ namespace Tarcog
 
             std::vector<double> getState() const;
             void setState(const std::vector<double> & t_State) const;
+            // Same as above for already collected solid layers (no need to search IGU layers)
+            static void setState(const std::vector<std::shared_ptr<CIGUSolidLayer>> & t_SolidLayers,
+                                 const std::vector<double> & t_State);
 
             std::vector<double> getTemperatures() const;
             std::vector<double> getRadiosities() const;
@@ -63,6 +66,13 @@ namespace Tarcog
             void setDeflectionProperties(double t_Tini, double t_Pini);
             void setDeflectionProperties(const std::vector<double> & t_MeasuredDeflections);
 
+            // Gases of existing gap layers are switched to tabulated properties. Copies of IGU
+            // keep the tables.
+            void enableGasLookupTables(double t_MinTemperature,
+                                       double t_MaxTemperature,
+                                       double t_Tolerance = 1e-6);
+            void disableGasLookupTables();
+
         private:
             // Replces layer in existing construction and keeps correct connections in linked list
             void replaceLayer(const std::shared_ptr<CBaseIGULayer> & t_Original,
@@ -82,7 +82,10 @@ namespace Tarcog
         IGU::SolidLayer::SolidLayer(const Glass & glass, double & t1, double & t2) :
             BaseLayer(glass.Thickness, t1, t2),
             m_Conductivity(glass.Conductivity)
-        {}
+        {
+            EmissivityFront = glass.EmissFront;
+            EmissivityBack = glass.EmissBack;
+        }
 
         double IGU::SolidLayer::thermalConductance()
         {
@@ -0,0 +1,308 @@
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+#include "IGUEN673Batch.hpp"
+#include "WCECommon.hpp"
+
+namespace Tarcog
+{
+    namespace EN673
+    {
+        namespace
+        {
+            //! Per thread workspace. Layers are stored in order glass, gap, glass, ..., glass.
+            class BatchKernel
+            {
+            public:
+                BatchKernel(const GlazingTable & table,
+                            const Environment & interior,
+                            const Environment & exterior) :
+                    m_Table(table),
+                    m_Gases(table.GapGases),
+                    m_Interior(interior),
+                    m_Exterior(exterior),
+                    m_NumOfLayers(2 * table.NumberOfGlasses - 1),
+                    m_Conductance(m_NumOfLayers),
+                    m_Temperature(m_NumOfLayers + 1),
+                    m_ThermalResistance(m_NumOfLayers + 2),
+                    m_RadiationFactor(table.NumberOfGlasses - 1),
+                    m_GapThickness(table.NumberOfGlasses - 1),
+                    m_GapPressure(table.NumberOfGlasses - 1),
+                    m_GapGas(table.NumberOfGlasses - 1)
+                {}
+
+                void calculate(size_t index, double & uValue, double & shgc)
+                {
+                    load(index);
+                    uValue = Uvalue();
+                    // Same as IGU::shgc which repeats U-value iterations from current state
+                    Uvalue();
+                    shgc = solarGain(index);
+                }
+
+            private:
+                void load(size_t index)
+                {
+                    using ConstantsData::STEFANBOLTZMANN;
+
+                    const auto numOfGlasses = m_Table.NumberOfGlasses;
+                    const auto glass = index * numOfGlasses;
+                    const auto gap = index * (numOfGlasses - 1);
+                    for(size_t i = 0u; i < numOfGlasses; ++i)
+                    {
+                        m_Conductance[2 * i] =
+                          m_Table.Conductivity[glass + i] / m_Table.Thickness[glass + i];
+                    }
+                    for(size_t i = 0u; i + 1 < numOfGlasses; ++i)
+                    {
+                        m_RadiationFactor[i] = 4 * STEFANBOLTZMANN * 1
+                                               / (1 / m_Table.EmissBack[glass + i]
+                                                  + 1 / m_Table.EmissFront[glass + i + 1] - 1);
+                        m_GapThickness[i] = m_Table.GapThickness[gap + i];
+                        m_GapPressure[i] = m_Table.GapPressure[gap + i];
+                        m_GapGas[i] = m_Table.GapGasIndex[gap + i];
+                        if(m_GapGas[i] >= m_Gases.size())
+                        {
+                            throw std::runtime_error("Gap gas index is out of range.");
+                        }
+                    }
+
+                    // Same initial guess as in IGU
+                    m_Temperature[0] = 3;
+                    m_Temperature[1] = m_Exterior.Temperature + 6;
+                    for(size_t i = 2u; i < m_Temperature.size(); ++i)
+                    {
+                        m_Temperature[i] = m_Temperature[i - 1] + 3;
+                    }
+                }
+
+                void updateGapConductances()
+                {
+                    for(size_t i = 0u; i < m_GapThickness.size(); ++i)
+                    {
+                        const auto layer = 2 * i + 1;
+                        const double Tm = (m_Temperature[layer] + m_Temperature[layer + 1]) / 2.0;
+                        auto & aGas = m_Gases[m_GapGas[i]];
+                        aGas.setTemperatureAndPressure(Tm, m_GapPressure[i]);
+                        const auto convection =
+                          aGas.getGasProperties().m_ThermalConductivity / m_GapThickness[i];
+                        m_Conductance[layer] = convection + m_RadiationFactor[i] * std::pow(Tm, 3);
+                    }
+                }
+
+                double conductanceSum() const
+                {
+                    double sum = 0.0;
+                    for(size_t i = 0u; i < m_NumOfLayers; ++i)
+                    {
+                        sum += m_Conductance[i];
+                    }
+                    return sum;
+                }
+
+                double Uvalue()
+                {
+                    const double he = m_Exterior.filmCoefficient;
+                    const double hi = m_Interior.filmCoefficient;
+
+                    updateGapConductances();
+                    double condSum = conductanceSum();
+                    double condSumNew = 0;
+                    double ug = 0;
+
+                    while(std::abs(condSum - condSumNew) > 1e-4)
+                    {
+                        condSum = condSumNew;
+                        double resistance = 1 / he + 1 / hi;
+                        for(size_t i = 0u; i < m_NumOfLayers; ++i)
+                        {
+                            resistance += 1 / m_Conductance[i];
+                        }
+                        ug = 1 / resistance;
+
+                        const double scaleFactor =
+                          ug * (m_Interior.Temperature - m_Exterior.Temperature);
+                        m_Temperature[0] = scaleFactor / he + m_Exterior.Temperature;
+                        m_Temperature[m_NumOfLayers] = m_Interior.Temperature - scaleFactor / hi;
+                        for(size_t i = 0u; i < m_NumOfLayers - 1; ++i)
+                        {
+                            m_Temperature[i + 1] = scaleFactor / m_Conductance[i] + m_Temperature[i];
+                        }
+
+                        updateGapConductances();
+                        m_ThermalResistance[0] = 1 / he;
+                        for(size_t i = 0u; i < m_NumOfLayers; ++i)
+                        {
+                            m_ThermalResistance[i + 1] = 1 / m_Conductance[i];
+                        }
+                        m_ThermalResistance[m_NumOfLayers + 1] = 1 / hi;
+                        condSumNew = conductanceSum();
+                    }
+
+                    return ug;
+                }
+
+                double solarGain(size_t index) const
+                {
+                    const auto numOfSolidLayers = m_Table.NumberOfGlasses;
+                    const auto absorptance = m_Table.SolarAbsorptance.data() + index * numOfSolidLayers;
+                    const auto & R = m_ThermalResistance;
+
+                    double cNom{0};
+                    double cDen{0};
+                    double cAbs{0};
+                    for(size_t i = numOfSolidLayers - 1; i-- > 0;)
+                    {
+                        const auto j = 2u * (i + 1u);
+                        const double k1 = i == 0 ? 1 : 0.5;
+                        const double k2 = i == (numOfSolidLayers - 2) ? 1 : 0.5;
+
+                        cAbs += absorptance[i];
+
+                        const double lambdaCoeff = 1 / (k1 * R[j - 1] + R[j] + k2 * R[j + 1]);
+
+                        cNom += cAbs / lambdaCoeff;
+                        cDen += 1 / lambdaCoeff;
+                    }
+
+                    cAbs += absorptance[0];
+                    const double flowin = (cAbs * R[0] + cNom)
+                                          / (R[0] + R[2 * numOfSolidLayers] + cDen);
+
+                    return flowin + m_Table.SolarTransmittance[index];
+                }
+
+                const GlazingTable & m_Table;
+                std::vector<Gases::CGas> m_Gases;
+                const Environment & m_Interior;
+                const Environment & m_Exterior;
+                size_t m_NumOfLayers;
+
+                std::vector<double> m_Conductance;
+                std::vector<double> m_Temperature;
+                std::vector<double> m_ThermalResistance;
+
+                std::vector<double> m_RadiationFactor;
+                std::vector<double> m_GapThickness;
+                std::vector<double> m_GapPressure;
+                std::vector<size_t> m_GapGas;
+            };
+
+            void checkColumn(const size_t columnSize, const size_t expectedSize)
+            {
+                if(columnSize != expectedSize)
+                {
+                    throw std::runtime_error("Glazing table columns are not same size.");
+                }
+            }
+        }   // namespace
+
+        GlazingTable::GlazingTable(const size_t numberOfGlasses,
+                                   const std::vector<Gases::CGas> & gapGases) :
+            NumberOfGlasses(numberOfGlasses),
+            GapGases(gapGases)
+        {
+            if(NumberOfGlasses == 0)
+            {
+                throw std::runtime_error("Glazing table must have at least one glass layer.");
+            }
+        }
+
+        size_t GlazingTable::size() const
+        {
+            return SolarTransmittance.size();
+        }
+
+        void GlazingTable::resize(const size_t numberOfConfigurations)
+        {
+            const auto glasses = numberOfConfigurations * NumberOfGlasses;
+            const auto gaps = numberOfConfigurations * (NumberOfGlasses - 1);
+            Conductivity.resize(glasses);
+            Thickness.resize(glasses);
+            EmissFront.resize(glasses);
+            EmissBack.resize(glasses);
+            SolarAbsorptance.resize(glasses);
+            GapThickness.resize(gaps);
+            GapPressure.resize(gaps, 101325);
+            GapGasIndex.resize(gaps);
+            SolarTransmittance.resize(numberOfConfigurations);
+        }
+
+        void GlazingTable::addConfiguration(const std::vector<Glass> & glasses,
+                                            const std::vector<double> & gapThickness,
+                                            const std::vector<size_t> & gapGas,
+                                            const double solarTransmittance,
+                                            const double gapPressure)
+        {
+            if(glasses.size() != NumberOfGlasses || gapThickness.size() != NumberOfGlasses - 1
+               || gapGas.size() != NumberOfGlasses - 1)
+            {
+                throw std::runtime_error(
+                  "Configuration does not match number of glass layers in glazing table.");
+            }
+            for(const auto & glass : glasses)
+            {
+                Conductivity.push_back(glass.Conductivity);
+                Thickness.push_back(glass.Thickness);
+                EmissFront.push_back(glass.EmissFront);
+                EmissBack.push_back(glass.EmissBack);
+                SolarAbsorptance.push_back(glass.SolarAbsorptance);
+            }
+            for(size_t i = 0u; i < gapThickness.size(); ++i)
+            {
+                GapThickness.push_back(gapThickness[i]);
+                GapPressure.push_back(gapPressure);
+                GapGasIndex.push_back(gapGas[i]);
+            }
+            SolarTransmittance.push_back(solarTransmittance);
+        }
+
+        IGUBatch::IGUBatch(const Environment & interior, const Environment & exterior) :
+            m_Interior(interior),
+            m_Exterior(exterior),
+            m_NumberOfThreads(1)
+        {}
+
+        void IGUBatch::setNumberOfThreads(const size_t numberOfThreads)
+        {
+            m_NumberOfThreads = FenestrationCommon::numberOfThreads(numberOfThreads);
+        }
+
+        BatchResults IGUBatch::calculate(const GlazingTable & table) const
+        {
+            const auto size = table.size();
+            const auto glasses = size * table.NumberOfGlasses;
+            const auto gaps = size * (table.NumberOfGlasses - 1);
+            checkColumn(table.Conductivity.size(), glasses);
+            checkColumn(table.Thickness.size(), glasses);
+            checkColumn(table.EmissFront.size(), glasses);
+            checkColumn(table.EmissBack.size(), glasses);
+            checkColumn(table.SolarAbsorptance.size(), glasses);
+            checkColumn(table.GapThickness.size(), gaps);
+            checkColumn(table.GapPressure.size(), gaps);
+            checkColumn(table.GapGasIndex.size(), gaps);
+
+            BatchResults results;
+            results.Uvalue.resize(size);
+            results.SHGC.resize(size);
+
+            // Every block of configurations has its own workspace and copy of gases since gas
+            // keeps state of last property calculation.
+            const auto numBlocks = std::min(m_NumberOfThreads, size);
+            const auto blockSize = numBlocks > 0 ? (size + numBlocks - 1) / numBlocks : 0;
+            FenestrationCommon::parallelFor(numBlocks, numBlocks, [&](const size_t k) {
+                BatchKernel kernel(table, m_Interior, m_Exterior);
+                const auto end = std::min(size, (k + 1) * blockSize);
+                for(size_t i = k * blockSize; i < end; ++i)
+                {
+                    kernel.calculate(i, results.Uvalue[i], results.SHGC[i]);
+                }
+            });
+
+            return results;
+        }
+
+    }   // namespace EN673
+
+}   // namespace Tarcog
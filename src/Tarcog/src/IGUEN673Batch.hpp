@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+
+#include "WCEGases.hpp"
+#include "IGUEN673.hpp"
+
+namespace Tarcog
+{
+    namespace EN673
+    {
+        //! \brief Columnar table of glazing configurations.
+        //!
+        //! All configurations in the table have the same number of glass layers. Value of glass j
+        //! in configuration i is stored at index i * NumberOfGlasses + j and value of gap j at
+        //! index i * (NumberOfGlasses - 1) + j.
+        struct GlazingTable
+        {
+            //! Creates empty table. Gap fills are given as list of gases and gaps refer to them
+            //! by index (defaulted to Air only).
+            explicit GlazingTable(size_t numberOfGlasses,
+                                  const std::vector<Gases::CGas> & gapGases = {Gases::CGas()});
+
+            //! Number of configurations
+            size_t size() const;
+
+            //! Resizes all columns to given number of configurations
+            void resize(size_t numberOfConfigurations);
+
+            //! Appends configuration. Sizes of vectors must match number of glasses and gaps.
+            void addConfiguration(const std::vector<Glass> & glasses,
+                                  const std::vector<double> & gapThickness,
+                                  const std::vector<size_t> & gapGas,
+                                  double solarTransmittance = 0.0,
+                                  double gapPressure = 101325);
+
+            size_t NumberOfGlasses;
+            std::vector<Gases::CGas> GapGases;
+
+            // Glass columns
+            std::vector<double> Conductivity;
+            std::vector<double> Thickness;
+            std::vector<double> EmissFront;
+            std::vector<double> EmissBack;
+            std::vector<double> SolarAbsorptance;
+
+            // Gap columns
+            std::vector<double> GapThickness;
+            std::vector<double> GapPressure;
+            std::vector<size_t> GapGasIndex;
+
+            // Configuration columns
+            std::vector<double> SolarTransmittance;
+        };
+
+        struct BatchResults
+        {
+            std::vector<double> Uvalue;
+            std::vector<double> SHGC;
+        };
+
+        //! \brief Calculates U-values and SHGCs of all configurations in glazing table.
+        //!
+        //! Results are same as from IGU::Uvalue and IGU::shgc (called in that order) for every
+        //! configuration. Configurations are solved on flat per layer arrays that are reused
+        //! between configurations and gases are shared between all configurations solved by the
+        //! same thread.
+        class IGUBatch
+        {
+        public:
+            IGUBatch(const Environment & interior, const Environment & exterior);
+
+            //! Configurations are split between threads (0 stands for all hardware threads)
+            void setNumberOfThreads(size_t numberOfThreads);
+
+            BatchResults calculate(const GlazingTable & table) const;
+
+        private:
+            Environment m_Interior;
+            Environment m_Exterior;
+            size_t m_NumberOfThreads;
+        };
+
+    }   // namespace EN673
+
+}   // namespace Tarcog
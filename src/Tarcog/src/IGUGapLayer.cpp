@@ -67,54 +67,63 @@ namespace Tarcog
             return averageTemperature();
         }
 
-        double CIGUGapLayer::calculateRayleighNumber()
+        double CIGUGapLayer::calculateRayleighNumber(const Gases::GasProperties & t_Properties,
+                                                     const double t_Thickness,
+                                                     const double t_GapTemperature,
+                                                     const double t_DeltaTemperature)
         {
             using ConstantsData::GRAVITYCONSTANT;
 
-            const auto tGapTemperature = layerTemperature();
-            const auto deltaTemp = std::abs(getSurface(Side::Back)->getTemperature()
-                                            - getSurface(Side::Front)->getTemperature());
-
-            const auto aProperties = m_Gas.getGasProperties();
-
             double ra = 0;
-            if(aProperties.m_Viscosity != 0)
+            if(t_Properties.m_Viscosity != 0)
             {   // if viscosity is zero then it is vacuum
-                ra =
-                  GRAVITYCONSTANT * pow(getThickness(), 3) * deltaTemp * aProperties.m_SpecificHeat
-                  * pow(aProperties.m_Density, 2)
-                  / (tGapTemperature * aProperties.m_Viscosity * aProperties.m_ThermalConductivity);
+                ra = GRAVITYCONSTANT * pow(t_Thickness, 3) * t_DeltaTemperature
+                     * t_Properties.m_SpecificHeat * pow(t_Properties.m_Density, 2)
+                     / (t_GapTemperature * t_Properties.m_Viscosity
+                        * t_Properties.m_ThermalConductivity);
             }
 
             return ra;
         }
 
-        double CIGUGapLayer::aspectRatio() const
+        double CIGUGapLayer::aspectRatio(const double t_Height, const double t_Thickness)
         {
-            if(getThickness() == 0)
+            if(t_Thickness == 0)
             {
                 throw std::runtime_error("Gap thickness is set to zero.");
             }
-            return m_Height / getThickness();
+            return t_Height / t_Thickness;
         }
 
-        double CIGUGapLayer::convectiveH()
+        double CIGUGapLayer::convectiveCoefficient(Gases::CGas & t_Gas,
+                                                   const double t_Pressure,
+                                                   const double t_Tilt,
+                                                   const double t_Height,
+                                                   const double t_Thickness,
+                                                   const double t_GapTemperature,
+                                                   const double t_DeltaTemperature)
         {
-            const auto tGapTemperature = layerTemperature();
-            m_Gas.setTemperatureAndPressure(tGapTemperature, getPressure());
-            const auto Ra = calculateRayleighNumber();
-            const auto Asp = aspectRatio();
+            t_Gas.setTemperatureAndPressure(t_GapTemperature, t_Pressure);
+            const auto & aProperties = t_Gas.getGasProperties();
+            const auto Ra =
+              calculateRayleighNumber(aProperties, t_Thickness, t_GapTemperature, t_DeltaTemperature);
+            const auto Asp = aspectRatio(t_Height, t_Thickness);
             CNusseltNumber nusseltNumber{};
-            const auto aProperties = m_Gas.getGasProperties();
             if(aProperties.m_Viscosity != 0)
             {
-                m_ConductiveConvectiveCoeff = nusseltNumber.calculate(m_Tilt, Ra, Asp)
-                                              * aProperties.m_ThermalConductivity / getThickness();
-            }
-            else
-            {   // vacuum state
-                m_ConductiveConvectiveCoeff = aProperties.m_ThermalConductivity;
+                return nusseltNumber.calculate(t_Tilt, Ra, Asp) * aProperties.m_ThermalConductivity
+                       / t_Thickness;
             }
+            // vacuum state
+            return aProperties.m_ThermalConductivity;
+        }
+
+        double CIGUGapLayer::convectiveH()
+        {
+            const auto deltaTemp = std::abs(getSurface(Side::Back)->getTemperature()
+                                            - getSurface(Side::Front)->getTemperature());
+            m_ConductiveConvectiveCoeff = convectiveCoefficient(
+              m_Gas, getPressure(), m_Tilt, m_Height, getThickness(), layerTemperature(), deltaTemp);
             if(m_AirSpeed != 0)
             {
                 m_ConductiveConvectiveCoeff = m_ConductiveConvectiveCoeff + 2 * m_AirSpeed;
@@ -33,14 +33,26 @@ namespace Tarcog
 
 			std::shared_ptr< CBaseLayer > clone() const override;
 
+			// Conduction/convection coefficient of sealed gap (without airflow). Gas state is
+			// changed to the gap temperature.
+			static double convectiveCoefficient( Gases::CGas & t_Gas,
+			                                     double t_Pressure,
+			                                     double t_Tilt,
+			                                     double t_Height,
+			                                     double t_Thickness,
+			                                     double t_GapTemperature,
+			                                     double t_DeltaTemperature );
 
 		protected:
 			void initializeStateVariables() override;
 			void calculateConvectionOrConductionFlow() override;
 
 		private:
-			double calculateRayleighNumber();
-			double aspectRatio() const;
+			static double calculateRayleighNumber( const Gases::GasProperties & t_Properties,
+			                                       double t_Thickness,
+			                                       double t_GapTemperature,
+			                                       double t_DeltaTemperature );
+			static double aspectRatio( double t_Height, double t_Thickness );
 			double convectiveH();
 
 			double getGasTemperature() override;
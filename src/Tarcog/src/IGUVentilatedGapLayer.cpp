@@ -100,7 +100,7 @@ namespace Tarcog
 
             const auto tiltAngle = WCE_PI / 180 * (m_Tilt - 90);
             const auto gapTemperature = layerTemperature();
-            const auto aProperties = m_ReferenceGas.getGasProperties();
+            const auto & aProperties = m_ReferenceGas.getGasProperties();
             const auto temperatureMultiplier =
               std::abs(gapTemperature - t_GapTemperature) / (gapTemperature * t_GapTemperature);
             return aProperties.m_Density * ReferenceTemperature * GRAVITYCONSTANT * m_Height
@@ -109,19 +109,19 @@ namespace Tarcog
 
         double CIGUVentilatedGapLayer::bernoullyPressureTerm()
         {
-            const auto aGasProperties = m_Gas.getGasProperties();
+            const auto & aGasProperties = m_Gas.getGasProperties();
             return 0.5 * aGasProperties.m_Density;
         }
 
         double CIGUVentilatedGapLayer::hagenPressureTerm()
         {
-            const auto aGasProperties = m_Gas.getGasProperties();
+            const auto & aGasProperties = m_Gas.getGasProperties();
             return 12 * aGasProperties.m_Viscosity * m_Height / pow(getThickness(), 2);
         }
 
         double CIGUVentilatedGapLayer::pressureLossTerm()
         {
-            const auto aGasProperties = m_Gas.getGasProperties();
+            const auto & aGasProperties = m_Gas.getGasProperties();
             return 0.5 * aGasProperties.m_Density * (m_Zin + m_Zout);
         }
 
@@ -141,6 +141,20 @@ namespace Tarcog
             }
         }
 
+        void CIGUVentilatedGapLayer::enableGasLookupTable(double const t_MinTemperature,
+                                                          double const t_MaxTemperature,
+                                                          double const t_Tolerance)
+        {
+            CGasLayer::enableGasLookupTable(t_MinTemperature, t_MaxTemperature, t_Tolerance);
+            m_ReferenceGas.enableLookupTable(t_MinTemperature, t_MaxTemperature, t_Tolerance);
+        }
+
+        void CIGUVentilatedGapLayer::disableGasLookupTable()
+        {
+            CGasLayer::disableGasLookupTable();
+            m_ReferenceGas.disableLookupTable();
+        }
+
         void CIGUVentilatedGapLayer::calculateConvectionOrConductionFlow()
         {
             CIGUGapLayer::calculateConvectionOrConductionFlow();
@@ -152,7 +166,7 @@ namespace Tarcog
 
         double CIGUVentilatedGapLayer::characteristicHeight()
         {
-            const auto aProperties = m_Gas.getGasProperties();
+            const auto & aProperties = m_Gas.getGasProperties();
             double cHeight = 0;
             // Characteristic height can only be calculated after initialization is performed
             if(m_ConductiveConvectiveCoeff != 0)
@@ -177,7 +191,7 @@ namespace Tarcog
 
         void CIGUVentilatedGapLayer::ventilatedFlow()
         {
-            const auto aProperties = m_Gas.getGasProperties();
+            const auto & aProperties = m_Gas.getGasProperties();
             m_LayerGainFlow = aProperties.m_Density * aProperties.m_SpecificHeat * m_AirSpeed
                               * getThickness() * m_Width * (m_inTemperature - m_outTemperature);
         }
@@ -33,6 +33,11 @@ namespace Tarcog
 
 			void smoothEnergyGain( double qv1, double qv2 );
 
+			void enableGasLookupTable( double t_MinTemperature,
+									   double t_MaxTemperature,
+									   double t_Tolerance ) override;
+			void disableGasLookupTable() override;
+
 		private:
 			void calculateConvectionOrConductionFlow() override;
 			double characteristicHeight();
@@ -108,58 +108,73 @@ namespace Tarcog
         {
             if(m_AirSpeed > 0)
             {
-                m_ConductiveConvectiveCoeff = 4 + 4 * m_AirSpeed;
+                m_ConductiveConvectiveCoeff = forcedConvectionCoefficient(m_AirSpeed);
             }
             else
             {
-                using ConstantsData::GRAVITYCONSTANT;
-                using ConstantsData::WCE_PI;
-
                 assert(m_Surface.at(Side::Front) != nullptr);
-                assert(m_Surface.at(Side::Back) != nullptr);
-
-                auto tiltRadians = m_Tilt * WCE_PI / 180;
-                auto tMean =
-                  getGasTemperature()
-                  + 0.25 * (m_Surface.at(Side::Front)->getTemperature() - getGasTemperature());
-                if(tMean < 0)
-                    tMean = 0.1;
-                auto deltaTemp =
-                  std::abs(m_Surface.at(Side::Front)->getTemperature() - getGasTemperature());
-                m_Gas.setTemperatureAndPressure(tMean, m_Pressure);
-                auto aProperties = m_Gas.getGasProperties();
-                auto gr = GRAVITYCONSTANT * pow(m_Height, 3) * deltaTemp
-                          * pow(aProperties.m_Density, 2)
-                          / (tMean * pow(aProperties.m_Viscosity, 2));
-                auto RaCrit = 2.5e5 * pow(exp(0.72 * m_Tilt) / sin(tiltRadians), 0.2);
-                auto RaL = gr * aProperties.m_PrandlNumber;
-                auto Gnui = 0.0;
-                if((0.0 <= m_Tilt) && (m_Tilt < 15.0))
-                {
-                    Gnui = 0.13 * pow(RaL, 1 / 3.0);
-                }
-                else if((15.0 <= m_Tilt) && (m_Tilt <= 90.0))
-                {
-                    if(RaL <= RaCrit)
-                    {
-                        Gnui = 0.56 * pow(RaL * sin(tiltRadians), 0.25);
-                    }
-                    else
-                    {
-                        Gnui = 0.13 * pow(RaL, 1 / 3.0) - pow(RaCrit, 1 / 3.0)
-                               + 0.56 * pow(RaCrit * sin(tiltRadians), 0.25);
-                    }
-                }
-                else if((90.0 < m_Tilt) && (m_Tilt <= 179.0))
+                m_ConductiveConvectiveCoeff =
+                  naturalConvectionCoefficient(m_Gas,
+                                               m_Pressure,
+                                               m_Height,
+                                               m_Tilt,
+                                               getGasTemperature(),
+                                               m_Surface.at(Side::Front)->getTemperature());
+            }
+        }
+
+        double CIndoorEnvironment::forcedConvectionCoefficient(const double t_AirSpeed)
+        {
+            return 4 + 4 * t_AirSpeed;
+        }
+
+        double CIndoorEnvironment::naturalConvectionCoefficient(Gases::CGas & t_Gas,
+                                                                const double t_Pressure,
+                                                                const double t_Height,
+                                                                const double t_Tilt,
+                                                                const double t_AirTemperature,
+                                                                const double t_SurfaceTemperature)
+        {
+            using ConstantsData::GRAVITYCONSTANT;
+            using ConstantsData::WCE_PI;
+
+            auto tiltRadians = t_Tilt * WCE_PI / 180;
+            auto tMean = t_AirTemperature + 0.25 * (t_SurfaceTemperature - t_AirTemperature);
+            if(tMean < 0)
+                tMean = 0.1;
+            auto deltaTemp = std::abs(t_SurfaceTemperature - t_AirTemperature);
+            t_Gas.setTemperatureAndPressure(tMean, t_Pressure);
+            const auto & aProperties = t_Gas.getGasProperties();
+            auto gr = GRAVITYCONSTANT * pow(t_Height, 3) * deltaTemp * pow(aProperties.m_Density, 2)
+                      / (tMean * pow(aProperties.m_Viscosity, 2));
+            auto RaCrit = 2.5e5 * pow(exp(0.72 * t_Tilt) / sin(tiltRadians), 0.2);
+            auto RaL = gr * aProperties.m_PrandlNumber;
+            auto Gnui = 0.0;
+            if((0.0 <= t_Tilt) && (t_Tilt < 15.0))
+            {
+                Gnui = 0.13 * pow(RaL, 1 / 3.0);
+            }
+            else if((15.0 <= t_Tilt) && (t_Tilt <= 90.0))
+            {
+                if(RaL <= RaCrit)
                 {
                     Gnui = 0.56 * pow(RaL * sin(tiltRadians), 0.25);
                 }
-                else if((179.0 < m_Tilt) && (m_Tilt <= 180.0))
+                else
                 {
-                    Gnui = 0.58 * pow(RaL, 1 / 3.0);
+                    Gnui = 0.13 * pow(RaL, 1 / 3.0) - pow(RaCrit, 1 / 3.0)
+                           + 0.56 * pow(RaCrit * sin(tiltRadians), 0.25);
                 }
-                m_ConductiveConvectiveCoeff = Gnui * aProperties.m_ThermalConductivity / m_Height;
             }
+            else if((90.0 < t_Tilt) && (t_Tilt <= 179.0))
+            {
+                Gnui = 0.56 * pow(RaL * sin(tiltRadians), 0.25);
+            }
+            else if((179.0 < t_Tilt) && (t_Tilt <= 180.0))
+            {
+                Gnui = 0.58 * pow(RaL, 1 / 3.0);
+            }
+            return Gnui * aProperties.m_ThermalConductivity / t_Height;
         }
 
         double CIndoorEnvironment::getHr()
@@ -21,6 +21,18 @@ namespace Tarcog
             std::shared_ptr<CBaseLayer> clone() const override;
             std::shared_ptr<CEnvironment> cloneEnvironment() const override;
 
+            // Natural convection coefficient between room air and interior surface. Gas state is
+            // changed to mean film temperature.
+            static double naturalConvectionCoefficient(Gases::CGas & t_Gas,
+                                                       double t_Pressure,
+                                                       double t_Height,
+                                                       double t_Tilt,
+                                                       double t_AirTemperature,
+                                                       double t_SurfaceTemperature);
+
+            // Convection coefficient between room air and interior surface when room air is moving
+            static double forcedConvectionCoefficient(double t_AirSpeed);
+
         private:
             double getGasTemperature() override;
             double calculateIRFromVariables() override;
@@ -42,6 +42,21 @@ namespace Tarcog
             resetCalculated();
         }
 
+        double CLayerGeometry::getWidth() const
+        {
+            return m_Width;
+        }
+
+        double CLayerGeometry::getHeight() const
+        {
+            return m_Height;
+        }
+
+        double CLayerGeometry::getTilt() const
+        {
+            return m_Tilt;
+        }
+
         //////////////////////////////////////////////////////////////////////////
         ///      CLayerHeatFlow
         //////////////////////////////////////////////////////////////////////////
@@ -194,6 +209,28 @@ namespace Tarcog
             return m_Pressure;
         }
 
+        double CGasLayer::getAirSpeed() const
+        {
+            return m_AirSpeed;
+        }
+
+        const Gases::CGas & CGasLayer::getGas() const
+        {
+            return m_Gas;
+        }
+
+        void CGasLayer::enableGasLookupTable(double const t_MinTemperature,
+                                             double const t_MaxTemperature,
+                                             double const t_Tolerance)
+        {
+            m_Gas.enableLookupTable(t_MinTemperature, t_MaxTemperature, t_Tolerance);
+        }
+
+        void CGasLayer::disableGasLookupTable()
+        {
+            m_Gas.disableLookupTable();
+        }
+
         void CGasLayer::initializeStateVariables()
         {
             m_Gas.setTemperatureAndPressure(getGasTemperature(), m_Pressure);
@@ -38,6 +38,10 @@ namespace Tarcog
             virtual void setHeight(double t_Height) final;
             virtual void setTilt(double t_Tilt) final;
 
+            double getWidth() const;
+            double getHeight() const;
+            double getTilt() const;
+
         protected:
             double m_Width;
             double m_Height;
@@ -102,8 +106,19 @@ namespace Tarcog
 
             virtual double getPressure();
 
+            double getAirSpeed() const;
+
             virtual double getGasTemperature() = 0;
 
+            const Gases::CGas & getGas() const;
+
+            // Gas properties are interpolated from table precomputed over temperature range (see
+            // Gases::CGas::enableLookupTable)
+            virtual void enableGasLookupTable(double t_MinTemperature,
+                                              double t_MaxTemperature,
+                                              double t_Tolerance);
+            virtual void disableGasLookupTable();
+
         protected:
             void initializeStateVariables() override;
 
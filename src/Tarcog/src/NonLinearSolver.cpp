@@ -7,6 +7,7 @@
 #include "TarcogConstants.hpp"
 #include "HeatFlowBalance.hpp"
 #include "IGU.hpp"
+#include "BaseShade.hpp"
 
 namespace Tarcog
 {
@@ -15,6 +16,7 @@ namespace Tarcog
         CNonLinearSolver::CNonLinearSolver(CIGU & t_IGU) :
             m_IGU(t_IGU),
             m_QBalance(m_IGU),
+            m_AirflowCoupling(AirflowCoupling::Nested),
             m_Tolerance(IterationConstants::CONVERGENCE_TOLERANCE),
             m_Iterations(0),
             m_RelaxParam(IterationConstants::RELAXATION_PARAMETER_MAX),
@@ -46,14 +48,107 @@ namespace Tarcog
             m_Tolerance = t_Tolerance;
         }
 
+        void CNonLinearSolver::setAirflowCoupling(const AirflowCoupling t_Coupling)
+        {
+            m_AirflowCoupling = t_Coupling;
+        }
+
+        AirflowCoupling CNonLinearSolver::airflowCoupling() const
+        {
+            return m_AirflowCoupling;
+        }
+
+        void CNonLinearSolver::initializeAirflow(
+          const std::vector<std::shared_ptr<CIGUShadeLayer>> & t_Shades,
+          const AirflowCoupling t_Coupling)
+        {
+            m_Shades = t_Shades;
+            m_AirflowShades.clear();
+            m_AirflowOffsets.clear();
+            auto offset = m_IGUState.size();
+            for(const auto & aShade : t_Shades)
+            {
+                aShade->setAirflowCoupling(t_Coupling);
+                const auto aSize = aShade->airflowStateSize();
+                if(t_Coupling == AirflowCoupling::Coupled && aSize > 0)
+                {
+                    m_AirflowShades.push_back(aShade);
+                    m_AirflowOffsets.push_back(offset);
+                    offset += aSize;
+                }
+            }
+            m_IGUState.resize(offset);
+        }
+
+        void CNonLinearSolver::calcAirflowTargets(std::vector<double> & t_Solution) const
+        {
+            for(size_t i = 0; i < m_AirflowShades.size(); ++i)
+            {
+                m_AirflowShades[i]->calcAirflowTarget(&t_Solution[m_AirflowOffsets[i]]);
+            }
+        }
+
+        void CNonLinearSolver::setAirflowState(const std::vector<double> & t_State) const
+        {
+            for(size_t i = 0; i < m_AirflowShades.size(); ++i)
+            {
+                m_AirflowShades[i]->setAirflowState(&t_State[m_AirflowOffsets[i]]);
+            }
+        }
+
+        bool CNonLinearSolver::isAirflowDiverged(const double t_Tolerance) const
+        {
+            return !std::isfinite(t_Tolerance)
+                   || t_Tolerance
+                        > IterationConstants::DIVERGENCE_FACTOR_AIRFLOW * m_SolutionTolerance
+                   || m_Iterations > IterationConstants::NUMBER_OF_STEPS;
+        }
+
         size_t CNonLinearSolver::getNumOfIterations() const
         {
             return m_Iterations;
         }
 
+        size_t CNonLinearSolver::getNumOfAirflowSteps() const
+        {
+            size_t result = 0;
+            for(const auto & aShade : m_Shades)
+            {
+                result += aShade->airflowSteps();
+            }
+            return result;
+        }
+
         void CNonLinearSolver::solve()
         {
+            WCE_SCOPED_TIMER("CNonLinearSolver::solve");
+            // Workspace is prepared once so that iterations do not allocate any memory
+            m_QBalance.initialize();
+            const auto & aSolidLayers = m_QBalance.getSolidLayers();
+
             m_IGUState = m_IGU.getState();
+            const auto heatBalanceState = m_IGUState;
+
+            std::vector<std::shared_ptr<CIGUShadeLayer>> aShades;
+            for(const auto & aLayer : aSolidLayers)
+            {
+                const auto aShade = std::dynamic_pointer_cast<CIGUShadeLayer>(aLayer);
+                if(aShade != nullptr)
+                {
+                    aShades.push_back(aShade);
+                }
+            }
+            initializeAirflow(aShades, m_AirflowCoupling);
+            // Airflow starts from the state that satisfies airflow equations for initial
+            // temperatures
+            calcAirflowTargets(m_IGUState);
+            setAirflowState(m_IGUState);
+            m_Solution.resize(m_IGUState.size());
+
+            // Layer objects are not updated during iterations of compiled IGU. Final state is set
+            // to layers once iterations are finished.
+            const auto isCompiled = m_CompiledIGU.compile(aSolidLayers);
+
             std::vector<double> initialState(m_IGUState);
             std::vector<double> bestSolution(m_IGUState.size());
             auto achievedTolerance = 1000.0;
@@ -65,13 +160,47 @@ namespace Tarcog
             while(iterate)
             {
                 ++m_Iterations;
-                std::vector<double> aSolution = m_QBalance.calcBalanceMatrix();
+                WCE_COUNT("CNonLinearSolver::iterations", 1);
+                if(!m_AirflowShades.empty())
+                {
+                    // Airflow targets change gap state which is restored before heat balance
+                    calcAirflowTargets(m_Solution);
+                    setAirflowState(m_IGUState);
+                }
+                const auto & aBalance = isCompiled ? m_CompiledIGU.calcBalanceMatrix(m_IGUState)
+                                                   : m_QBalance.calcBalanceMatrix();
+                assert(aBalance.size() <= m_Solution.size());
+                std::copy(aBalance.begin(), aBalance.end(), m_Solution.begin());
+
+                achievedTolerance = calculateTolerance(m_Solution);
 
-                achievedTolerance = calculateTolerance(aSolution);
+                estimateNewState(m_Solution);
 
-                estimateNewState(aSolution);
+                if(!isCompiled)
+                {
+                    CIGU::setState(aSolidLayers, m_IGUState);
+                }
+                setAirflowState(m_IGUState);
 
-                m_IGU.setState(m_IGUState);
+                if(!m_AirflowShades.empty() && isAirflowDiverged(achievedTolerance))
+                {
+                    // Coupled airflow failed. Solution restarts from initial state with airflow
+                    // solved in nested loops.
+                    WCE_COUNT("CNonLinearSolver::airflowCouplingFallbacks", 1);
+                    m_IGUState = heatBalanceState;
+                    if(!isCompiled)
+                    {
+                        CIGU::setState(aSolidLayers, m_IGUState);
+                    }
+                    initializeAirflow(aShades, AirflowCoupling::Nested);
+                    m_Solution.resize(m_IGUState.size());
+                    initialState = m_IGUState;
+                    bestSolution = m_IGUState;
+                    m_SolutionTolerance = 1000.0;
+                    m_Iterations = 0;
+                    m_RelaxParam = IterationConstants::RELAXATION_PARAMETER_MAX;
+                    continue;
+                }
 
                 if(achievedTolerance < m_SolutionTolerance)
                 {
@@ -82,11 +211,16 @@ namespace Tarcog
 
                 if(m_Iterations > IterationConstants::NUMBER_OF_STEPS)
                 {
+                    WCE_COUNT("CNonLinearSolver::relaxationRestarts", 1);
                     m_Iterations = 0;
                     m_RelaxParam -= IterationConstants::RELAXATION_PARAMETER_STEP;
 
-                    m_IGU.setState(initialState);
+                    if(!isCompiled)
+                    {
+                        CIGU::setState(aSolidLayers, initialState);
+                    }
                     m_IGUState = initialState;
+                    setAirflowState(m_IGUState);
                 }
 
                 iterate = achievedTolerance > m_Tolerance;
@@ -96,6 +230,10 @@ namespace Tarcog
                     iterate = false;
                 }
             }
+            if(isCompiled)
+            {
+                CIGU::setState(aSolidLayers, m_IGUState);
+            }
             m_IGUState = bestSolution;
         }
 
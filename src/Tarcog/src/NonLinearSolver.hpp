@@ -6,11 +6,15 @@
 
 #include <WCECommon.hpp>
 #include "HeatFlowBalance.hpp"
+#include "CompiledIGU.hpp"
 #include "IGU.hpp"
+#include "CalculationModels.hpp"
 
 namespace Tarcog {
 
 	namespace ISO15099 {
+		class CIGUShadeLayer;
+
 		class CNonLinearSolver {
 		public:
 			explicit CNonLinearSolver( CIGU & t_IGU );
@@ -18,8 +22,16 @@ namespace Tarcog {
 			// sets tolerance for solution
 			void setTolerance( double t_Tolerance );
 
+			// In coupled mode airflow unknowns of shaded ventilated gaps are appended to the IGU
+			// state and solved together with heat balance. If coupled iterations diverge or do not
+			// converge within one relaxation pass, solution restarts with nested airflow.
+			void setAirflowCoupling( AirflowCoupling t_Coupling );
+			AirflowCoupling airflowCoupling() const;
+
 			// returns number of iterations for current solution.
 			size_t getNumOfIterations() const;
+			// returns number of airflow evaluations of shades for current solution.
+			size_t getNumOfAirflowSteps() const;
 
 			void solve();
 
@@ -30,10 +42,26 @@ namespace Tarcog {
 			double calculateTolerance( const std::vector< double > & t_Solution ) const;
 			void estimateNewState( const std::vector< double > & t_Solution );
 
+			// Collects shade layers with airflow and sets their coupling mode
+			void initializeAirflow( const std::vector< std::shared_ptr< CIGUShadeLayer > > & t_Shades,
+				AirflowCoupling t_Coupling );
+			bool isAirflowDiverged( double t_Tolerance ) const;
+			void calcAirflowTargets( std::vector< double > & t_Solution ) const;
+			void setAirflowState( const std::vector< double > & t_State ) const;
+
 			CIGU & m_IGU;
 			FenestrationCommon::CLinearSolver m_LinearSolver;
 			CHeatFlowBalance m_QBalance;
+			// Used instead of m_QBalance when IGU can be compiled into flat arrays
+			CCompiledIGU m_CompiledIGU;
 			std::vector< double > m_IGUState;
+			// Heat balance solution followed by airflow targets
+			std::vector< double > m_Solution;
+			AirflowCoupling m_AirflowCoupling;
+			std::vector< std::shared_ptr< CIGUShadeLayer > > m_Shades;
+			// Shade layers with airflow unknowns and position of their unknowns in state vector
+			std::vector< std::shared_ptr< CIGUShadeLayer > > m_AirflowShades;
+			std::vector< size_t > m_AirflowOffsets;
 			double m_Tolerance;
 			size_t m_Iterations;
 			double m_RelaxParam;
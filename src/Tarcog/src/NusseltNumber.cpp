@@ -59,10 +59,10 @@ namespace Tarcog
         {
             using ConstantsData::WCE_PI;
 
-            std::shared_ptr<CNusseltNumber60> nusselt60 = std::make_shared<CNusseltNumber60>();
-            const double Nu60 = nusselt60->calculate(t_Tilt, t_Ra, t_Asp);
-            std::shared_ptr<CNusseltNumber90> nusselt90 = std::make_shared<CNusseltNumber90>();
-            const double Nu90 = nusselt90->calculate(t_Tilt, t_Ra, t_Asp);
+            CNusseltNumber60 nusselt60;
+            const double Nu60 = nusselt60.calculate(t_Tilt, t_Ra, t_Asp);
+            CNusseltNumber90 nusselt90;
+            const double Nu90 = nusselt90.calculate(t_Tilt, t_Ra, t_Asp);
 
             // linear interpolation between 60 and 90 degrees
             const double gnu = ((Nu90 - Nu60) / (90.0 - 60.0)) * (t_Tilt * 180 / WCE_PI - 60.0) + Nu60;
@@ -95,8 +95,8 @@ namespace Tarcog
                                                 double const t_Ra,
                                                 double const t_Asp)
         {
-            std::shared_ptr<CNusseltNumber90> nusselt90 = std::make_shared<CNusseltNumber90>();
-            const double Nu90 = nusselt90->calculate(t_Tilt, t_Ra, t_Asp);
+            CNusseltNumber90 nusselt90;
+            const double Nu90 = nusselt90.calculate(t_Tilt, t_Ra, t_Asp);
             const double gnu = 1 + (Nu90 - 1) * sin(t_Tilt);   // equation 53
 
             return gnu;
@@ -109,34 +109,31 @@ namespace Tarcog
             using ConstantsData::WCE_PI;
 
             const double tiltRadians = t_Tilt * WCE_PI / 180;
-            std::unique_ptr<CNusseltNumberStrategy> nusseltNumber;
 
+            // Strategies are stateless and therefore created on stack. Function is called in
+            // every iteration of nonlinear solver and should not allocate memory.
             if(t_Tilt >= 0 && t_Tilt < 60)
             {
-                nusseltNumber = wce::make_unique<CNusseltNumber0To60>();
+                return CNusseltNumber0To60().calculate(tiltRadians, t_Ra, t_Asp);
             }
-            else if(t_Tilt == 60)
+            if(t_Tilt == 60)
             {
-                nusseltNumber = wce::make_unique<CNusseltNumber60>();
+                return CNusseltNumber60().calculate(tiltRadians, t_Ra, t_Asp);
             }
-            else if(t_Tilt > 60 && t_Tilt < 90)
+            if(t_Tilt > 60 && t_Tilt < 90)
             {
-                nusseltNumber = wce::make_unique<CNusseltNumber60To90>();
+                return CNusseltNumber60To90().calculate(tiltRadians, t_Ra, t_Asp);
             }
-            else if(t_Tilt == 90)
+            if(t_Tilt == 90)
             {
-                nusseltNumber = wce::make_unique<CNusseltNumber90>();
+                return CNusseltNumber90().calculate(tiltRadians, t_Ra, t_Asp);
             }
-            else if(t_Tilt > 90 && t_Tilt <= 180)
+            if(t_Tilt > 90 && t_Tilt <= 180)
             {
-                nusseltNumber = wce::make_unique<CNusseltNumber90to180>();
-            }
-            else
-            {
-                std::runtime_error("Window tilt angle is out of range.");
+                return CNusseltNumber90to180().calculate(tiltRadians, t_Ra, t_Asp);
             }
 
-            return nusseltNumber->calculate(tiltRadians, t_Ra, t_Asp);
+            throw std::runtime_error("Window tilt angle is out of range.");
         }
 
 
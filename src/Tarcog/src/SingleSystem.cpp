@@ -87,6 +87,8 @@ namespace Tarcog
             initializeStartValues();
 
             m_NonLinearSolver = std::make_shared<CNonLinearSolver>(m_IGU);
+            m_NonLinearSolver->setAirflowCoupling(
+              t_SingleSystem.m_NonLinearSolver->airflowCoupling());
 
             return *this;
         }
@@ -172,12 +174,30 @@ namespace Tarcog
             m_NonLinearSolver->setTolerance(t_Tolerance);
         }
 
+        void CSingleSystem::setAirflowCoupling(const AirflowCoupling t_Coupling) const
+        {
+            assert(m_NonLinearSolver != nullptr);
+            m_NonLinearSolver->setAirflowCoupling(t_Coupling);
+        }
+
+        AirflowCoupling CSingleSystem::getAirflowCoupling() const
+        {
+            assert(m_NonLinearSolver != nullptr);
+            return m_NonLinearSolver->airflowCoupling();
+        }
+
         size_t CSingleSystem::getNumberOfIterations() const
         {
             assert(m_NonLinearSolver != nullptr);
             return m_NonLinearSolver->getNumOfIterations();
         }
 
+        size_t CSingleSystem::getNumberOfAirflowSteps() const
+        {
+            assert(m_NonLinearSolver != nullptr);
+            return m_NonLinearSolver->getNumOfAirflowSteps();
+        }
+
         double CSingleSystem::solutionTolarance() const
         {
             assert(m_NonLinearSolver != nullptr);
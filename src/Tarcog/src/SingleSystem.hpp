@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "IGU.hpp"
+#include "CalculationModels.hpp"
 
 namespace Tarcog
 {
@@ -55,6 +56,8 @@ namespace Tarcog
 			double getVentilationFlow( Environment t_Environment ) const;
 			double getUValue() const;
 			size_t getNumberOfIterations() const;
+			// Airflow evaluations of shaded ventilated gaps in last solution
+			size_t getNumberOfAirflowSteps() const;
 			double solutionTolarance() const;
 			bool isToleranceAchieved() const;
 
@@ -62,6 +65,9 @@ namespace Tarcog
 
 			// Set solution tolerance
 			void setTolerance( double t_Tolerance ) const;
+			// Airflow in shaded ventilated gaps solved in nested loops or together with heat balance
+			void setAirflowCoupling( AirflowCoupling t_Coupling ) const;
+			AirflowCoupling getAirflowCoupling() const;
 			// Set intial guess for solution.
 			void setInitialGuess( const std::vector< double > & t_Temperatures ) const;
 
@@ -102,6 +102,15 @@ namespace Tarcog
             m_System.at(System::SHGC)->setAbsorptances(absorptances);
         }
 
+        void CSystem::setAirflowCoupling(const AirflowCoupling t_Coupling)
+        {
+            for(auto & aSystem : m_System)
+            {
+                aSystem.second->setAirflowCoupling(t_Coupling);
+                aSystem.second->solve();
+            }
+        }
+
     }   // namespace ISO15099
 
 }   // namespace Tarcog
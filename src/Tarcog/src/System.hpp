@@ -10,6 +10,7 @@ namespace Tarcog
     namespace ISO15099
     {
         enum class Environment;
+        enum class AirflowCoupling;
 
         class CIGU;
 
@@ -54,6 +55,9 @@ namespace Tarcog
 
             void setAbsorptances(const std::vector<double> & absorptances);
 
+            // Sets airflow coupling of both systems and solves them again
+            void setAirflowCoupling(AirflowCoupling t_Coupling);
+
         private:
             std::map<System, std::shared_ptr<CSingleSystem>> m_System;
         };
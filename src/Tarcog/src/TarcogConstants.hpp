@@ -23,6 +23,8 @@ namespace Tarcog
         const double RELAXATION_PARAMETER_AIRFLOW_MIN = 0.1;
         const double RELAXATION_PARAMETER_AIRFLOW_STEP = 0.1;
         const double CONVERGENCE_TOLERANCE_AIRFLOW = 1e-6;
+        // Coupled airflow is abandoned when state change grows this many times over the best one
+        const double DIVERGENCE_FACTOR_AIRFLOW = 1e3;
     }   // namespace IterationConstants
 
     namespace DeflectionConstants
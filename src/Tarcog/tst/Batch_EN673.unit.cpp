@@ -0,0 +1,127 @@
+#include <memory>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "WCETarcog.hpp"
+#include "WCECommon.hpp"
+
+// Batch calculation of glazing configurations compared to calculation of single IGU
+class TestBatch_EN673 : public testing::Test
+{
+protected:
+    static Tarcog::EN673::Environment indoor()
+    {
+        return Tarcog::EN673::Environment(293.15, 8);
+    }
+
+    static Tarcog::EN673::Environment outdoor()
+    {
+        return Tarcog::EN673::Environment(273.15, 23);
+    }
+
+    static Gases::CGas argon()
+    {
+        Gases::CGas aGas;
+        aGas.addGasItem(0.1, Gases::GasDef::Air);
+        aGas.addGasItem(0.9, Gases::GasDef::Argon);
+        return aGas;
+    }
+
+    // Triple glazing configurations with varying coating emissivity, gap width and gas fill
+    static Tarcog::EN673::GlazingTable createTable()
+    {
+        Tarcog::EN673::GlazingTable aTable(3, {Gases::CGas(), argon()});
+        for(size_t i = 0; i < 12; ++i)
+        {
+            const auto emissivity = 0.84 - 0.07 * double(i);
+            const auto gapThickness = 0.0127 - 0.002 * double(i % 4);
+            const auto middleThickness = 0.003 + 0.001 * double(i % 3);
+            const auto gas = i % 2;
+            aTable.addConfiguration({Tarcog::EN673::Glass(1.0, 0.003, 0.84, 0.84, 0.099839858711),
+                                     Tarcog::EN673::Glass(1.0, middleThickness, 0.84, emissivity, 0.076627746224),
+                                     Tarcog::EN673::Glass(1.0, 0.003, emissivity, 0.84, 0.058234799653)},
+                                    {gapThickness, 0.0127},
+                                    {gas, gas},
+                                    0.5984);
+        }
+        return aTable;
+    }
+
+    static std::unique_ptr<Tarcog::EN673::IGU> createIGU(const Tarcog::EN673::GlazingTable & t_Table,
+                                                         const size_t t_Index)
+    {
+        auto aIGU = Tarcog::EN673::IGU::create(indoor(), outdoor());
+        const auto n = t_Table.NumberOfGlasses;
+        for(size_t j = 0; j < n; ++j)
+        {
+            const auto k = t_Index * n + j;
+            if(j > 0)
+            {
+                const auto g = t_Index * (n - 1) + j - 1;
+                aIGU->addGap(Tarcog::EN673::Gap(t_Table.GapThickness[g],
+                                                t_Table.GapPressure[g],
+                                                t_Table.GapGases[t_Table.GapGasIndex[g]]));
+            }
+            aIGU->addGlass(Tarcog::EN673::Glass(t_Table.Conductivity[k],
+                                                t_Table.Thickness[k],
+                                                t_Table.EmissFront[k],
+                                                t_Table.EmissBack[k],
+                                                t_Table.SolarAbsorptance[k]));
+        }
+        return aIGU;
+    }
+};
+
+TEST_F(TestBatch_EN673, SameAsSingleIGU)
+{
+    SCOPED_TRACE("Begin Test: Batch Uvalue and SHGC compared to single IGU");
+
+    const auto aTable = createTable();
+
+    Tarcog::EN673::IGUBatch aBatch(indoor(), outdoor());
+    const auto aResults = aBatch.calculate(aTable);
+
+    ASSERT_EQ(aTable.size(), aResults.Uvalue.size());
+    ASSERT_EQ(aTable.size(), aResults.SHGC.size());
+
+    for(size_t i = 0; i < aTable.size(); ++i)
+    {
+        auto aIGU = createIGU(aTable, i);
+        EXPECT_NEAR(aIGU->Uvalue(), aResults.Uvalue[i], 1e-12);
+        EXPECT_NEAR(aIGU->shgc(aTable.SolarTransmittance[i]), aResults.SHGC[i], 1e-12);
+    }
+
+    // First configuration is triple clear
+    EXPECT_NEAR(1.874193, aResults.Uvalue[0], 1e-4);
+    EXPECT_NEAR(0.7084, aResults.SHGC[0], 1e-4);
+}
+
+TEST_F(TestBatch_EN673, MultipleThreads)
+{
+    SCOPED_TRACE("Begin Test: Batch Uvalue and SHGC - multiple threads");
+
+    const auto aTable = createTable();
+
+    Tarcog::EN673::IGUBatch aBatch(indoor(), outdoor());
+    const auto aSerial = aBatch.calculate(aTable);
+
+    aBatch.setNumberOfThreads(5);
+    const auto aParallel = aBatch.calculate(aTable);
+
+    for(size_t i = 0; i < aTable.size(); ++i)
+    {
+        EXPECT_EQ(aSerial.Uvalue[i], aParallel.Uvalue[i]);
+        EXPECT_EQ(aSerial.SHGC[i], aParallel.SHGC[i]);
+    }
+}
+
+TEST_F(TestBatch_EN673, InconsistentTable)
+{
+    SCOPED_TRACE("Begin Test: Batch calculation - inconsistent table");
+
+    auto aTable = createTable();
+    aTable.GapThickness.pop_back();
+
+    Tarcog::EN673::IGUBatch aBatch(indoor(), outdoor());
+    EXPECT_THROW(aBatch.calculate(aTable), std::runtime_error);
+}
@@ -0,0 +1,233 @@
+#include <memory>
+#include <cmath>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "WCETarcog.hpp"
+#include "WCECommon.hpp"
+
+using FenestrationCommon::Side;
+
+// Indoor environment with moving room air
+class CMovingAirIndoor : public Tarcog::ISO15099::CIndoorEnvironment
+{
+public:
+    CMovingAirIndoor(const double t_AirTemperature, const double t_AirSpeed) :
+        CIndoorEnvironment(t_AirTemperature)
+    {
+        m_AirSpeed = t_AirSpeed;
+    }
+};
+
+class TestCompiledIGU : public testing::Test
+{
+protected:
+    static std::shared_ptr<Tarcog::ISO15099::CSingleSystem>
+      createSystem(std::initializer_list<std::shared_ptr<Tarcog::ISO15099::CBaseIGULayer>> t_Layers)
+    {
+        /////////////////////////////////////////////////////////
+        /// Outdoor
+        /////////////////////////////////////////////////////////
+        auto airTemperature = 255.15;   // Kelvins
+        auto airSpeed = 5.5;            // meters per second
+        auto tSky = 255.15;             // Kelvins
+        auto solarRadiation = 789.0;
+
+        auto Outdoor = Tarcog::ISO15099::Environments::outdoor(
+          airTemperature, airSpeed, solarRadiation, tSky, Tarcog::ISO15099::SkyModel::AllSpecified);
+        Outdoor->setHCoeffModel(Tarcog::ISO15099::BoundaryConditionsCoeffModel::CalculateH);
+
+        /////////////////////////////////////////////////////////
+        /// Indoor
+        /////////////////////////////////////////////////////////
+        auto roomTemperature = 294.15;
+
+        auto Indoor = Tarcog::ISO15099::Environments::indoor(roomTemperature);
+
+        /////////////////////////////////////////////////////////
+        /// IGU
+        /////////////////////////////////////////////////////////
+        auto windowWidth = 1.0;
+        auto windowHeight = 1.0;
+        Tarcog::ISO15099::CIGU aIGU(windowWidth, windowHeight);
+        aIGU.addLayers(t_Layers);
+
+        return std::make_shared<Tarcog::ISO15099::CSingleSystem>(aIGU, Indoor, Outdoor);
+    }
+
+    // Connects environments to IGU in the same way as CSingleSystem does, so that layers of IGU
+    // can be solved with both object model and compiled IGU
+    static void connectEnvironments(Tarcog::ISO15099::CIGU & t_IGU,
+                                    const std::shared_ptr<Tarcog::ISO15099::CEnvironment> & t_Indoor,
+                                    const std::shared_ptr<Tarcog::ISO15099::CEnvironment> & t_Outdoor)
+    {
+        using Tarcog::ISO15099::Environment;
+
+        t_Indoor->connectToIGULayer(t_IGU.getEnvironment(Environment::Indoor));
+        t_Indoor->setTilt(t_IGU.getTilt());
+        t_Indoor->setWidth(t_IGU.getWidth());
+        t_Indoor->setHeight(t_IGU.getHeight());
+
+        t_Outdoor->connectToIGULayer(t_IGU.getEnvironment(Environment::Outdoor));
+        t_Outdoor->setTilt(t_IGU.getTilt());
+        t_Outdoor->setWidth(t_IGU.getWidth());
+        t_Outdoor->setHeight(t_IGU.getHeight());
+
+        t_IGU.setSolarRadiation(t_Outdoor->getDirectSolarRadiation());
+    }
+
+    // Iterates heat balance of triple glazing with object model and with compiled IGU starting
+    // from the same state. Temperatures and radiosities must be the same in every iteration.
+    static void
+      compareWithObjectModel(const std::shared_ptr<Tarcog::ISO15099::CIndoorEnvironment> & t_Indoor)
+    {
+        using ConstantsData::STEFANBOLTZMANN;
+
+        auto Outdoor = Tarcog::ISO15099::Environments::outdoor(
+          255.15, 5.5, 789.0, 255.15, Tarcog::ISO15099::SkyModel::AllSpecified);
+        Outdoor->setHCoeffModel(Tarcog::ISO15099::BoundaryConditionsCoeffModel::CalculateH);
+
+        auto solidLayerThickness = 0.005715;   // [m]
+        auto solidLayerConductance = 1.0;
+
+        auto layer1 = Tarcog::ISO15099::Layers::solid(solidLayerThickness, solidLayerConductance);
+        layer1->setSolarAbsorptance(0.1, 789.0);
+        auto layer2 = Tarcog::ISO15099::Layers::solid(
+          solidLayerThickness, solidLayerConductance, 0.84, 0.0, 0.04, 0.0);
+        layer2->setSolarAbsorptance(0.05, 789.0);
+        auto layer3 = Tarcog::ISO15099::Layers::solid(solidLayerThickness, solidLayerConductance);
+
+        Gases::CGas aArgon;
+        aArgon.addGasItem(0.1, Gases::GasDef::Air);
+        aArgon.addGasItem(0.9, Gases::GasDef::Argon);
+
+        auto gap1 = Tarcog::ISO15099::Layers::gap(0.012, aArgon);
+        auto gap2 = Tarcog::ISO15099::Layers::gap(0.0127);
+
+        Tarcog::ISO15099::CIGU aIGU(1.0, 1.0);
+        aIGU.addLayers({layer1, gap1, layer2, gap2, layer3});
+        connectEnvironments(aIGU, t_Indoor, Outdoor);
+
+        // Initial state is far from solution
+        const auto aSolidLayers = aIGU.getSolidLayers();
+        std::vector<double> aState;
+        for(size_t i = 0; i < aSolidLayers.size(); ++i)
+        {
+            const auto temperature = 260.0 + 10.0 * double(i);
+            const auto radiosity = STEFANBOLTZMANN * std::pow(temperature, 4);
+            aState.insert(aState.end(), {temperature, radiosity, radiosity, temperature + 1});
+        }
+        Tarcog::ISO15099::CIGU::setState(aSolidLayers, aState);
+
+        Tarcog::ISO15099::CCompiledIGU aCompiled;
+        ASSERT_TRUE(aCompiled.compile(aSolidLayers));
+        EXPECT_EQ(2u, aCompiled.numberOfGasMixtures());
+
+        Tarcog::ISO15099::CHeatFlowBalance aObjectModel(aIGU);
+
+        const size_t numberOfIterations = 10;
+        for(size_t iteration = 0; iteration < numberOfIterations; ++iteration)
+        {
+            const auto aCorrect = aObjectModel.calcBalanceMatrix();
+            const auto & aResults = aCompiled.calcBalanceMatrix(aState);
+            ASSERT_EQ(aCorrect.size(), aResults.size());
+            for(size_t i = 0; i < aCorrect.size(); ++i)
+            {
+                EXPECT_NEAR(aCorrect[i], aResults[i], 1e-10);
+            }
+
+            aState = aCorrect;
+            Tarcog::ISO15099::CIGU::setState(aSolidLayers, aState);
+        }
+    }
+
+    static std::vector<double>
+      layersState(const std::vector<std::shared_ptr<Tarcog::ISO15099::CIGUSolidLayer>> & t_Layers)
+    {
+        std::vector<double> aState;
+        for(const auto & aLayer : t_Layers)
+        {
+            aState.push_back(aLayer->getTemperature(Side::Front));
+            aState.push_back(aLayer->J(Side::Front));
+            aState.push_back(aLayer->J(Side::Back));
+            aState.push_back(aLayer->getTemperature(Side::Back));
+        }
+        return aState;
+    }
+};
+
+TEST_F(TestCompiledIGU, TripleClearFixedPoint)
+{
+    SCOPED_TRACE("Begin Test: Compiled IGU - triple clear balance at solution.");
+
+    auto solidLayerThickness = 0.005715;   // [m]
+    auto solidLayerConductance = 1.0;
+
+    auto layer1 = Tarcog::ISO15099::Layers::solid(solidLayerThickness, solidLayerConductance);
+    layer1->setSolarAbsorptance(0.1, 789.0);
+    auto layer2 = Tarcog::ISO15099::Layers::solid(solidLayerThickness, solidLayerConductance);
+    auto layer3 = Tarcog::ISO15099::Layers::solid(solidLayerThickness, solidLayerConductance);
+
+    Gases::CGas aArgon;
+    aArgon.addGasItem(0.1, Gases::GasDef::Air);
+    aArgon.addGasItem(0.9, Gases::GasDef::Argon);
+
+    auto gap1 = Tarcog::ISO15099::Layers::gap(0.012, aArgon);
+    auto gap2 = Tarcog::ISO15099::Layers::gap(0.0127, aArgon);
+
+    auto aSystem = createSystem({layer1, gap1, layer2, gap2, layer3});
+    aSystem->setTolerance(1e-10);
+    aSystem->solve();
+
+    const auto aSolidLayers = aSystem->getSolidLayers();
+    Tarcog::ISO15099::CCompiledIGU aCompiled;
+    ASSERT_TRUE(aCompiled.compile(aSolidLayers));
+    EXPECT_EQ(1u, aCompiled.numberOfGasMixtures());
+
+    // Converged state is fixed point of heat balance
+    const auto aState = layersState(aSolidLayers);
+    const auto & aBalance = aCompiled.calcBalanceMatrix(aState);
+    ASSERT_EQ(aState.size(), aBalance.size());
+    for(size_t i = 0; i < aState.size(); ++i)
+    {
+        EXPECT_NEAR(aState[i], aBalance[i], 1e-6);
+    }
+}
+
+TEST_F(TestCompiledIGU, SameAsObjectModel)
+{
+    SCOPED_TRACE("Begin Test: Compiled IGU - same iterations as object model.");
+
+    compareWithObjectModel(Tarcog::ISO15099::Environments::indoor(294.15));
+}
+
+TEST_F(TestCompiledIGU, SameAsObjectModelMovingIndoorAir)
+{
+    SCOPED_TRACE("Begin Test: Compiled IGU - same iterations as object model with indoor air speed.");
+
+    auto Indoor = std::make_shared<CMovingAirIndoor>(294.15, 1.5);
+    Indoor->setHCoeffModel(Tarcog::ISO15099::BoundaryConditionsCoeffModel::CalculateH);
+
+    compareWithObjectModel(Indoor);
+}
+
+TEST_F(TestCompiledIGU, ShadeIsNotCompiled)
+{
+    SCOPED_TRACE("Begin Test: Compiled IGU - IGU with shade is solved with object model.");
+
+    auto solidLayerThickness = 0.005715;   // [m]
+    auto solidLayerConductance = 1.0;
+
+    auto layer1 = Tarcog::ISO15099::Layers::solid(solidLayerThickness, solidLayerConductance);
+    auto layer2 = Tarcog::ISO15099::Layers::solid(solidLayerThickness, solidLayerConductance);
+    auto shade = Tarcog::ISO15099::Layers::shading(0.01, 160.0, 0.1, 0.1, 0.1, 0.1, 0.2);
+
+    auto gap1 = Tarcog::ISO15099::Layers::gap(0.0127);
+    auto gap2 = Tarcog::ISO15099::Layers::gap(0.0127);
+
+    auto aSystem = createSystem({layer1, gap1, layer2, gap2, shade});
+
+    Tarcog::ISO15099::CCompiledIGU aCompiled;
+    EXPECT_FALSE(aCompiled.compile(aSystem->getSolidLayers()));
+    EXPECT_FALSE(aCompiled.isCompiled());
+}
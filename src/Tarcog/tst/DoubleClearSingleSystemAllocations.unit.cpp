@@ -0,0 +1,159 @@
+#include <memory>
+#include <stdexcept>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <gtest/gtest.h>
+
+#include "WCETarcog.hpp"
+#include "WCECommon.hpp"
+
+// Counter of heap allocations in test executable. Replacement of global operator new is used only
+// to verify that nonlinear iterations do not allocate memory.
+namespace
+{
+    std::atomic<size_t> allocationCounter{0};
+}
+
+void * operator new(std::size_t size)
+{
+    ++allocationCounter;
+    if(void * ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void * ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+class TestDoubleClearSingleSystemAllocations : public testing::Test
+{
+protected:
+    static std::shared_ptr<Tarcog::ISO15099::CSingleSystem>
+      createSystem(std::initializer_list<std::shared_ptr<Tarcog::ISO15099::CBaseIGULayer>> t_Layers)
+    {
+        /////////////////////////////////////////////////////////
+        /// Outdoor
+        /////////////////////////////////////////////////////////
+        auto airTemperature = 255.15;   // Kelvins
+        auto airSpeed = 5.5;            // meters per second
+        auto tSky = 255.15;             // Kelvins
+        auto solarRadiation = 0.0;
+
+        auto Outdoor = Tarcog::ISO15099::Environments::outdoor(
+          airTemperature, airSpeed, solarRadiation, tSky, Tarcog::ISO15099::SkyModel::AllSpecified);
+        Outdoor->setHCoeffModel(Tarcog::ISO15099::BoundaryConditionsCoeffModel::CalculateH);
+
+        /////////////////////////////////////////////////////////
+        /// Indoor
+        /////////////////////////////////////////////////////////
+        auto roomTemperature = 294.15;
+
+        auto Indoor = Tarcog::ISO15099::Environments::indoor(roomTemperature);
+
+        /////////////////////////////////////////////////////////
+        /// IGU
+        /////////////////////////////////////////////////////////
+        auto windowWidth = 1.0;
+        auto windowHeight = 1.0;
+        Tarcog::ISO15099::CIGU aIGU(windowWidth, windowHeight);
+        aIGU.addLayers(t_Layers);
+
+        /////////////////////////////////////////////////////////
+        /// System
+        /////////////////////////////////////////////////////////
+        return std::make_shared<Tarcog::ISO15099::CSingleSystem>(aIGU, Indoor, Outdoor);
+    }
+
+    // Double clear IGU is compiled into flat layer arrays by nonlinear solver
+    static std::shared_ptr<Tarcog::ISO15099::CSingleSystem> createDoubleClearSystem()
+    {
+        auto solidLayerThickness = 0.005715;   // [m]
+        auto solidLayerConductance = 1.0;
+
+        auto layer1 = Tarcog::ISO15099::Layers::solid(solidLayerThickness, solidLayerConductance);
+        auto layer2 = Tarcog::ISO15099::Layers::solid(solidLayerThickness, solidLayerConductance);
+
+        Gases::CGas aGas;
+        aGas.addGasItem(0.1, Gases::GasDef::Air);
+        aGas.addGasItem(0.9, Gases::GasDef::Argon);
+
+        auto gapThickness = 0.012;
+        auto gapLayer = Tarcog::ISO15099::Layers::gap(gapThickness, aGas);
+
+        return createSystem({layer1, gapLayer, layer2});
+    }
+
+    // IGU with closed interior shade cannot be compiled and is iterated with object model
+    static std::shared_ptr<Tarcog::ISO15099::CSingleSystem> createShadeSystem()
+    {
+        auto solidLayerThickness = 0.005715;   // [m]
+        auto solidLayerConductance = 1.0;
+
+        auto layer1 = Tarcog::ISO15099::Layers::solid(solidLayerThickness, solidLayerConductance);
+        auto layer2 = Tarcog::ISO15099::Layers::solid(solidLayerThickness, solidLayerConductance);
+        auto shade = Tarcog::ISO15099::Layers::shading(0.01, 160.0, 0, 0, 0, 0, 0);
+
+        auto gap1 = Tarcog::ISO15099::Layers::gap(0.0127);
+        auto gap2 = Tarcog::ISO15099::Layers::gap(0.0127);
+
+        return createSystem({layer1, gap1, layer2, gap2, shade});
+    }
+
+    // Number of heap allocations performed while solving the system
+    static size_t solveAndCountAllocations(const Tarcog::ISO15099::CSingleSystem & t_System)
+    {
+        const size_t start = allocationCounter;
+        t_System.solve();
+        return allocationCounter - start;
+    }
+};
+
+TEST_F(TestDoubleClearSingleSystemAllocations, IterationsDoNotAllocate)
+{
+    SCOPED_TRACE("Begin Test: Double Clear Single System - Heap allocations per iteration.");
+
+    auto aLooseSystem = createDoubleClearSystem();
+    aLooseSystem->setTolerance(1e-2);
+    auto aTightSystem = createDoubleClearSystem();
+    aTightSystem->setTolerance(1e-10);
+
+    const auto looseAllocations = solveAndCountAllocations(*aLooseSystem);
+    const auto tightAllocations = solveAndCountAllocations(*aTightSystem);
+
+    // Allocations are performed only during setup of the solver and therefore do not depend on
+    // number of iterations.
+    EXPECT_LT(aLooseSystem->getNumberOfIterations(), aTightSystem->getNumberOfIterations());
+    EXPECT_EQ(looseAllocations, tightAllocations);
+
+    Tarcog::ISO15099::CCompiledIGU aCompiled;
+    EXPECT_TRUE(aCompiled.compile(aTightSystem->getSolidLayers()));
+}
+
+TEST_F(TestDoubleClearSingleSystemAllocations, ObjectModelIterationsDoNotAllocate)
+{
+    SCOPED_TRACE("Begin Test: Single System with shade - Heap allocations per iteration.");
+
+    auto aLooseSystem = createShadeSystem();
+    aLooseSystem->setTolerance(1e-2);
+    auto aTightSystem = createShadeSystem();
+    aTightSystem->setTolerance(1e-10);
+
+    const auto looseAllocations = solveAndCountAllocations(*aLooseSystem);
+    const auto tightAllocations = solveAndCountAllocations(*aTightSystem);
+
+    EXPECT_LT(aLooseSystem->getNumberOfIterations(), aTightSystem->getNumberOfIterations());
+    EXPECT_EQ(looseAllocations, tightAllocations);
+
+    Tarcog::ISO15099::CCompiledIGU aCompiled;
+    EXPECT_FALSE(aCompiled.compile(aTightSystem->getSolidLayers()));
+}
@@ -0,0 +1,188 @@
+#include <memory>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "WCEGases.hpp"
+#include "WCETarcog.hpp"
+#include "WCECommon.hpp"
+
+// Airflow around shades solved together with heat balance must give same results as airflow
+// solved in nested loops.
+class TestShadeAirflowCoupling : public testing::Test
+{
+protected:
+    enum class ShadePosition
+    {
+        InBetween,
+        Indoor
+    };
+
+    static std::shared_ptr<Tarcog::ISO15099::CEnvironment> createOutdoor()
+    {
+        auto airTemperature = 255.15;   // Kelvins
+        auto airSpeed = 5.5;            // meters per second
+        auto tSky = 255.15;             // Kelvins
+        auto solarRadiation = 0.0;
+
+        auto Outdoor = Tarcog::ISO15099::Environments::outdoor(
+          airTemperature, airSpeed, solarRadiation, tSky, Tarcog::ISO15099::SkyModel::AllSpecified);
+        Outdoor->setHCoeffModel(Tarcog::ISO15099::BoundaryConditionsCoeffModel::CalculateH);
+        return Outdoor;
+    }
+
+    static std::shared_ptr<Tarcog::ISO15099::CEnvironment> createIndoor()
+    {
+        auto roomTemperature = 295.15;
+        return Tarcog::ISO15099::Environments::indoor(roomTemperature);
+    }
+
+    static Tarcog::ISO15099::CIGU createIGU(const ShadePosition t_Position)
+    {
+        auto solidLayerThickness = 0.005715;   // [m]
+        auto solidLayerConductance = 1.0;
+
+        auto solidLayer1 = Tarcog::ISO15099::Layers::solid(solidLayerThickness, solidLayerConductance);
+        auto solidLayer2 = Tarcog::ISO15099::Layers::solid(solidLayerThickness, solidLayerConductance);
+
+        auto shadeLayerThickness = 0.01;
+        auto shadeLayerConductance = 160.0;
+        auto Atop = 0.1;
+        auto Abot = 0.1;
+        auto Aleft = 0.1;
+        auto Aright = 0.1;
+        auto Afront = 0.2;
+
+        auto shadeLayer = Tarcog::ISO15099::Layers::shading(
+          shadeLayerThickness, shadeLayerConductance, Atop, Abot, Aleft, Aright, Afront);
+
+        auto gapThickness = 0.0127;
+        auto gap1 = Tarcog::ISO15099::Layers::gap(gapThickness);
+        auto gap2 = Tarcog::ISO15099::Layers::gap(gapThickness);
+
+        auto windowWidth = 1.0;
+        auto windowHeight = 1.0;
+        Tarcog::ISO15099::CIGU aIGU(windowWidth, windowHeight);
+        if(t_Position == ShadePosition::InBetween)
+        {
+            aIGU.addLayers({solidLayer1, gap1, shadeLayer, gap2, solidLayer2});
+        }
+        else
+        {
+            aIGU.addLayers({solidLayer1, gap1, solidLayer2, gap2, shadeLayer});
+        }
+        return aIGU;
+    }
+
+    static std::shared_ptr<Tarcog::ISO15099::CSingleSystem>
+      createSystem(const ShadePosition t_Position, const Tarcog::ISO15099::AirflowCoupling t_Coupling)
+    {
+        auto aIGU = createIGU(t_Position);
+        auto aSystem =
+          std::make_shared<Tarcog::ISO15099::CSingleSystem>(aIGU, createIndoor(), createOutdoor());
+        aSystem->setAirflowCoupling(t_Coupling);
+        aSystem->solve();
+
+        return aSystem;
+    }
+
+    static void compareSystems(const ShadePosition t_Position,
+                               const Tarcog::ISO15099::Environment t_Environment)
+    {
+        const auto aNested =
+          createSystem(t_Position, Tarcog::ISO15099::AirflowCoupling::Nested);
+        const auto aCoupled =
+          createSystem(t_Position, Tarcog::ISO15099::AirflowCoupling::Coupled);
+
+        EXPECT_TRUE(aCoupled->isToleranceAchieved());
+
+        const auto nestedTemperature = aNested->getTemperatures();
+        const auto coupledTemperature = aCoupled->getTemperatures();
+        const auto nestedRadiosity = aNested->getRadiosities();
+        const auto coupledRadiosity = aCoupled->getRadiosities();
+
+        ASSERT_EQ(nestedTemperature.size(), coupledTemperature.size());
+        for(size_t i = 0; i < nestedTemperature.size(); ++i)
+        {
+            EXPECT_NEAR(nestedTemperature[i], coupledTemperature[i], 1e-4);
+            EXPECT_NEAR(nestedRadiosity[i], coupledRadiosity[i], 1e-4);
+        }
+
+        EXPECT_NEAR(aNested->getVentilationFlow(t_Environment),
+                    aCoupled->getVentilationFlow(t_Environment),
+                    1e-4);
+
+        // Coupled mode makes single airflow update per heat balance iteration instead of
+        // iterating airflow to convergence inside of every iteration
+        EXPECT_LT(aCoupled->getNumberOfAirflowSteps(), aNested->getNumberOfAirflowSteps());
+    }
+};
+
+TEST_F(TestShadeAirflowCoupling, InBetweenShade)
+{
+    SCOPED_TRACE("Begin Test: InBetween Shade - Air (coupled airflow).");
+
+    compareSystems(ShadePosition::InBetween, Tarcog::ISO15099::Environment::Indoor);
+}
+
+TEST_F(TestShadeAirflowCoupling, IndoorShade)
+{
+    SCOPED_TRACE("Begin Test: Indoor Shade - Air (coupled airflow).");
+
+    compareSystems(ShadePosition::Indoor, Tarcog::ISO15099::Environment::Indoor);
+}
+
+TEST_F(TestShadeAirflowCoupling, CopyKeepsCoupling)
+{
+    SCOPED_TRACE("Begin Test: Copy of system keeps airflow coupling.");
+
+    const auto aCoupled =
+      createSystem(ShadePosition::InBetween, Tarcog::ISO15099::AirflowCoupling::Coupled);
+    const auto aCopy = aCoupled->clone();
+    EXPECT_EQ(Tarcog::ISO15099::AirflowCoupling::Coupled, aCopy->getAirflowCoupling());
+}
+
+TEST_F(TestShadeAirflowCoupling, SystemCoupling)
+{
+    SCOPED_TRACE("Begin Test: Coupled airflow in both U-value and SHGC systems.");
+
+    auto aNestedIGU = createIGU(ShadePosition::InBetween);
+    Tarcog::ISO15099::CSystem aNested(aNestedIGU, createIndoor(), createOutdoor());
+
+    auto aCoupledIGU = createIGU(ShadePosition::InBetween);
+    Tarcog::ISO15099::CSystem aCoupled(aCoupledIGU, createIndoor(), createOutdoor());
+    aCoupled.setAirflowCoupling(Tarcog::ISO15099::AirflowCoupling::Coupled);
+
+    EXPECT_NEAR(aNested.getUValue(), aCoupled.getUValue(), 1e-4);
+    for(const auto aSystem : {Tarcog::ISO15099::System::Uvalue, Tarcog::ISO15099::System::SHGC})
+    {
+        const auto nestedTemperature = aNested.getTemperatures(aSystem);
+        const auto coupledTemperature = aCoupled.getTemperatures(aSystem);
+        ASSERT_EQ(nestedTemperature.size(), coupledTemperature.size());
+        for(size_t i = 0; i < nestedTemperature.size(); ++i)
+        {
+            EXPECT_NEAR(nestedTemperature[i], coupledTemperature[i], 1e-4);
+        }
+    }
+}
+
+TEST_F(TestShadeAirflowCoupling, UnreachableTolerance)
+{
+    SCOPED_TRACE("Begin Test: Coupled airflow that does not converge falls back to nested.");
+
+    auto aIGU = createIGU(ShadePosition::InBetween);
+    auto aSystem =
+      std::make_shared<Tarcog::ISO15099::CSingleSystem>(aIGU, createIndoor(), createOutdoor());
+    aSystem->setAirflowCoupling(Tarcog::ISO15099::AirflowCoupling::Coupled);
+    aSystem->setTolerance(0);
+    aSystem->solve();
+
+    const auto aNested =
+      createSystem(ShadePosition::InBetween, Tarcog::ISO15099::AirflowCoupling::Nested);
+    const auto nestedTemperature = aNested->getTemperatures();
+    const auto temperature = aSystem->getTemperatures();
+    ASSERT_EQ(nestedTemperature.size(), temperature.size());
+    for(size_t i = 0; i < nestedTemperature.size(); ++i)
+    {
+        EXPECT_NEAR(nestedTemperature[i], temperature[i], 1e-4);
+    }
+}
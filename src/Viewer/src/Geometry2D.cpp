@@ -273,6 +273,7 @@ namespace Viewer
     {
         if(!m_ViewFactorsCalculated)
         {
+            WCE_SCOPED_TIMER("CGeometry2D::viewFactors");
             auto size = m_Segments->size();
 
             // View factor matrix. It is already initialized to zeros
@@ -1,4 +1,5 @@
 #include <cassert>
+#include <cmath>
 #include <algorithm>
 
 #include "Geometry2DBeam.hpp"
@@ -14,6 +15,35 @@ using namespace FenestrationCommon;
 
 namespace Viewer {
 
+	namespace {
+
+		// Position of the point in direction perpendicular to the beam. It is constant along the
+		// beam and increases in the same order as PointsProfile2DCompare.
+		double profileKey( CPoint2D const& t_Point, double const t_ProfileAngle, double const t_TanPhi ) {
+			if ( t_ProfileAngle == 0 ) {
+				return -t_Point.y();
+			}
+			const auto key = t_Point.x() - t_Point.y() / t_TanPhi;
+			return t_TanPhi > 0 ? key : -key;
+		}
+
+		// Insertion sort which keeps order from previous profile angle. Order is almost sorted
+		// for close angles.
+		template< typename Key >
+		void updateOrder( std::vector< size_t >& t_Order, Key const& t_Key ) {
+			for ( size_t i = 1; i < t_Order.size(); ++i ) {
+				const auto current = t_Order[ i ];
+				auto j = i;
+				while ( j > 0 && t_Key( current ) < t_Key( t_Order[ j - 1 ] ) ) {
+					t_Order[ j ] = t_Order[ j - 1 ];
+					--j;
+				}
+				t_Order[ j ] = current;
+			}
+		}
+
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////
 	// BeamViewFactor
 	////////////////////////////////////////////////////////////////////////////////////////
@@ -170,12 +200,12 @@ namespace Viewer {
 	std::shared_ptr< CDirect2DRaysResult > CDirect2DRaysResults::getResult( double const t_ProfileAngle ) {
 		std::shared_ptr< CDirect2DRaysResult > Result = nullptr;
 
-		auto it = find_if( m_Results->begin(), m_Results->end(),
-		                   [ &t_ProfileAngle ]( std::shared_ptr< CDirect2DRaysResult > const& obj ) {
-		                   return std::abs( obj->profileAngle() - t_ProfileAngle ) < 1e-6;
-	                   } );
+		auto it = std::lower_bound( m_Results->begin(), m_Results->end(), t_ProfileAngle - 1e-6,
+		                            []( std::shared_ptr< CDirect2DRaysResult > const& obj, double const angle ) {
+		                            return obj->profileAngle() < angle;
+	                            } );
 
-		if ( it != m_Results->end() ) {
+		if ( it != m_Results->end() && std::abs( ( *it )->profileAngle() - t_ProfileAngle ) < 1e-6 ) {
 			Result = *it;
 		}
 
@@ -184,8 +214,19 @@ namespace Viewer {
 
 	std::shared_ptr< CDirect2DRaysResult > CDirect2DRaysResults::append( double const t_ProfileAngle,
 	                                                                     double const t_DirectToDirect, std::shared_ptr< std::vector< BeamViewFactor > > const& t_BeamViewFactor ) const {
+		auto it = std::lower_bound( m_Results->begin(), m_Results->end(), t_ProfileAngle - 1e-6,
+		                            []( std::shared_ptr< CDirect2DRaysResult > const& obj, double const angle ) {
+		                            return obj->profileAngle() < angle;
+	                            } );
+		if ( it != m_Results->end() && std::abs( ( *it )->profileAngle() - t_ProfileAngle ) < 1e-6 ) {
+			return *it;
+		}
 		auto aResult = std::make_shared< CDirect2DRaysResult >( t_ProfileAngle, t_DirectToDirect, t_BeamViewFactor );
-		m_Results->push_back( aResult );
+		it = std::upper_bound( m_Results->begin(), m_Results->end(), t_ProfileAngle,
+		                            []( double const angle, std::shared_ptr< CDirect2DRaysResult > const& obj ) {
+		                            return angle < obj->profileAngle();
+	                            } );
+		m_Results->insert( it, aResult );
 		return aResult;
 	}
 
@@ -197,41 +238,169 @@ namespace Viewer {
 	// CDirect2DRays
 	////////////////////////////////////////////////////////////////////////////////////////
 
+	CDirect2DRays::SweepRays::SweepRays() : lowerRay( nullptr ), upperRay( nullptr ), lowerKey( 0 ), upperKey( 0 ) {
+
+	}
+
 	CDirect2DRays::CDirect2DRays( Side const t_Side ) : m_Side( t_Side ) {
-		m_LowerRay = nullptr;
-		m_UpperRay = nullptr;
-		m_CurrentResult = nullptr;
+
 	}
 
 	void CDirect2DRays::appendGeometry2D( std::shared_ptr< const CGeometry2D > const& t_Geometry2D ) {
+		// Normals are calculated on first request. Requesting them here makes segments read only
+		// while rays are calculated from several threads.
+		for ( auto const& aSegment : *t_Geometry2D->segments() ) {
+			aSegment->getNormal();
+		}
+		std::lock_guard< std::mutex > lock( m_Mutex );
 		m_Geometries2D.push_back( t_Geometry2D );
 		m_Results.clear();
 	}
 
+	void CDirect2DRays::calculate( std::vector< double > const& t_ProfileAngles ) {
+		std::vector< double > aAngles;
+		{
+			std::lock_guard< std::mutex > lock( m_Mutex );
+			aAngles = missingAngles( t_ProfileAngles );
+		}
+		storeResults( calculateProperties( aAngles ) );
+	}
+
+	void CDirect2DRays::setProfileAngles( std::vector< double > const& t_ProfileAngles ) {
+		std::lock_guard< std::mutex > lock( m_Mutex );
+		m_PendingAngles = t_ProfileAngles;
+	}
+
 	std::shared_ptr< std::vector< BeamViewFactor > > CDirect2DRays::beamViewFactors( double const t_ProfileAngle ) {
-		calculateAllProperties( t_ProfileAngle );
-		assert( m_CurrentResult != nullptr );
-		return m_CurrentResult->beamViewFactors();
+		return calculateAllProperties( t_ProfileAngle )->beamViewFactors();
 	}
 
 	double CDirect2DRays::directToDirect( double const t_ProfileAngle ) {
-		calculateAllProperties( t_ProfileAngle );
-		assert( m_CurrentResult != nullptr );
-		return m_CurrentResult->directToDirect();
+		return calculateAllProperties( t_ProfileAngle )->directToDirect();
 	}
 
-	void CDirect2DRays::calculateAllProperties( double const t_ProfileAngle ) {
-		if ( m_CurrentResult != nullptr && m_CurrentResult->profileAngle() != t_ProfileAngle ) {
-			m_CurrentResult = m_Results.getResult( t_ProfileAngle );
+	std::shared_ptr< CDirect2DRaysResult > CDirect2DRays::calculateAllProperties( double const t_ProfileAngle ) {
+		std::vector< double > aAngles;
+		{
+			std::lock_guard< std::mutex > lock( m_Mutex );
+			auto aResult = m_Results.getResult( t_ProfileAngle );
+			if ( aResult != nullptr ) {
+				return aResult;
+			}
+			// Pending angles are taken by the first thread that needs any result. Other threads
+			// asking for the same angles meanwhile calculate them on their own.
+			aAngles = m_PendingAngles;
+			aAngles.push_back( t_ProfileAngle );
+			m_PendingAngles.clear();
+			aAngles = missingAngles( aAngles );
 		}
-		if ( m_CurrentResult == nullptr ) {
-			findRayBoundaries( t_ProfileAngle );
-			findInBetweenRays( t_ProfileAngle );
-			calculateBeamProperties( t_ProfileAngle );
+
+		storeResults( calculateProperties( aAngles ) );
+
+		std::lock_guard< std::mutex > lock( m_Mutex );
+		auto aResult = m_Results.getResult( t_ProfileAngle );
+		assert( aResult != nullptr );
+		return aResult;
+	}
+
+	std::vector< double > CDirect2DRays::missingAngles( std::vector< double > const& t_ProfileAngles ) {
+		std::vector< double > aAngles;
+		for ( auto angle : t_ProfileAngles ) {
+			if ( m_Results.getResult( angle ) == nullptr ) {
+				aAngles.push_back( angle );
+			}
 		}
+		return aAngles;
 	}
 
-	void CDirect2DRays::findRayBoundaries( double const t_ProfileAngle ) {
+	void CDirect2DRays::storeResults( std::vector< std::shared_ptr< CDirect2DRaysResult > > const& t_Results ) {
+		std::lock_guard< std::mutex > lock( m_Mutex );
+		for ( auto const& aResult : t_Results ) {
+			m_Results.append( aResult->profileAngle(), aResult->directToDirect(), aResult->beamViewFactors() );
+		}
+	}
+
+	std::vector< std::shared_ptr< CDirect2DRaysResult > >
+	CDirect2DRays::calculateProperties( std::vector< double > const& t_ProfileAngles ) const {
+		std::vector< std::shared_ptr< CDirect2DRaysResult > > aResults;
+		auto aAngles = t_ProfileAngles;
+		if ( aAngles.empty() ) {
+			return aResults;
+		}
+		std::sort( aAngles.begin(), aAngles.end() );
+
+		// Points and segments of enclosures do not depend on profile angle. Only points that are
+		// in between of boundary rays can create new ray.
+		std::vector< std::shared_ptr< const CPoint2D > > aPoints;
+		std::vector< SweepSegment > aSegments;
+		for ( size_t e = 0; e < m_Geometries2D.size(); ++e ) {
+			auto aEnclosureSegments = m_Geometries2D[ e ]->segments();
+			aPoints.push_back( ( *aEnclosureSegments )[ 0 ]->startPoint() );
+			for ( size_t s = 0; s < aEnclosureSegments->size(); ++s ) {
+				aPoints.push_back( ( *aEnclosureSegments )[ s ]->endPoint() );
+				aSegments.push_back( { ( *aEnclosureSegments )[ s ], e, s, 0, 0 } );
+			}
+		}
+
+		std::vector< size_t > aPointOrder( aPoints.size() );
+		for ( size_t i = 0; i < aPointOrder.size(); ++i ) {
+			aPointOrder[ i ] = i;
+		}
+		std::vector< size_t > aSegmentOrder( aSegments.size() );
+		for ( size_t i = 0; i < aSegmentOrder.size(); ++i ) {
+			aSegmentOrder[ i ] = i;
+		}
+		std::vector< double > aKeys( aPoints.size() );
+		std::vector< std::shared_ptr< const CPoint2D > > inBetweenPoints;
+		std::vector< double > inBetweenKeys;
+		std::vector< SweepSegment > aSortedSegments;
+		SweepRays aRays;
+
+		for ( auto angle : aAngles ) {
+			if ( !aResults.empty() && std::abs( aResults.back()->profileAngle() - angle ) < 1e-6 ) {
+				continue;
+			}
+			findRayBoundaries( angle, aRays );
+
+			const auto tanPhi = std::tan( radians( angle ) );
+			for ( size_t i = 0; i < aPoints.size(); ++i ) {
+				aKeys[ i ] = profileKey( *aPoints[ i ], angle, tanPhi );
+			}
+			for ( auto& aSegment : aSegments ) {
+				const auto startKey = profileKey( *aSegment.segment->startPoint(), angle, tanPhi );
+				const auto endKey = profileKey( *aSegment.segment->endPoint(), angle, tanPhi );
+				aSegment.minKey = std::min( startKey, endKey );
+				aSegment.maxKey = std::max( startKey, endKey );
+			}
+
+			updateOrder( aPointOrder, [&aKeys]( size_t const i ) {
+				return aKeys[ i ];
+			} );
+			updateOrder( aSegmentOrder, [&aSegments]( size_t const i ) {
+				return aSegments[ i ].minKey;
+			} );
+
+			inBetweenPoints.clear();
+			inBetweenKeys.clear();
+			for ( auto index : aPointOrder ) {
+				if ( isInRay( *aPoints[ index ], aRays ) ) {
+					inBetweenPoints.push_back( aPoints[ index ] );
+					inBetweenKeys.push_back( aKeys[ index ] );
+				}
+			}
+
+			aSortedSegments.clear();
+			for ( auto index : aSegmentOrder ) {
+				aSortedSegments.push_back( aSegments[ index ] );
+			}
+
+			createRays( inBetweenPoints, inBetweenKeys, angle, aRays );
+			aResults.push_back( calculateBeamProperties( angle, aSortedSegments, aRays ) );
+		}
+		return aResults;
+	}
+
+	void CDirect2DRays::findRayBoundaries( double const t_ProfileAngle, SweepRays& t_Rays ) const {
 		std::shared_ptr< CViewSegment2D > entryRay = nullptr;
 		for ( auto aGeometry : m_Geometries2D ) {
 			// TODO: Geometry depends on entry or exit points
@@ -248,77 +417,72 @@ namespace Viewer {
 				break;
 			}
 			entryRay = createSubBeam( *aPoint, t_ProfileAngle );
+			const auto entryKey = profileKey( *aPoint, t_ProfileAngle, std::tan( radians( t_ProfileAngle ) ) );
 			if ( aGeometry == *m_Geometries2D.begin() ) {
-				m_LowerRay = entryRay;
-				m_UpperRay = entryRay;
+				t_Rays.lowerRay = entryRay;
+				t_Rays.upperRay = entryRay;
+				t_Rays.lowerKey = entryKey;
+				t_Rays.upperKey = entryKey;
 			}
 			else {
 				// This sets profile angle for point comparison that follows in next lines
 				auto aProfilePoint = PointsProfile2DCompare( t_ProfileAngle );
-				if ( aProfilePoint( m_LowerRay->startPoint(), entryRay->startPoint() ) ) {
-					m_LowerRay = entryRay;
+				if ( aProfilePoint( t_Rays.lowerRay->startPoint(), entryRay->startPoint() ) ) {
+					t_Rays.lowerRay = entryRay;
+					t_Rays.lowerKey = entryKey;
 				}
-				if ( !aProfilePoint( m_UpperRay->startPoint(), entryRay->startPoint() ) ) {
-					m_UpperRay = entryRay;
+				if ( !aProfilePoint( t_Rays.upperRay->startPoint(), entryRay->startPoint() ) ) {
+					t_Rays.upperRay = entryRay;
+					t_Rays.upperKey = entryKey;
 				}
 			}
 		}
 	}
 
-	void CDirect2DRays::findInBetweenRays( double const t_ProfileAngle ) {
-
-		std::vector< std::shared_ptr< const CPoint2D > > inBetweenPoints;
-
-		// m_Beams.push_back( m_UpperRay );
-		for ( auto aEnclosure : m_Geometries2D ) {
-			auto aSegments = aEnclosure->segments();
-			if ( isInRay( *( *aSegments )[ 0 ]->startPoint() ) ) {
-				inBetweenPoints.push_back( ( *aSegments )[ 0 ]->startPoint() );
-			}
-			for ( auto aSegment : *aSegments ) {
-				auto endPoint = aSegment->endPoint();
-				// Ray is alway going from left to right. For point to be in between beam, it must be visible 
-				// for upper ray and invisible for lower ray
-				if ( m_UpperRay->position( *endPoint ) == PointPosition::Visible &&
-					m_LowerRay->position( *endPoint ) == PointPosition::Invisible ) {
-					inBetweenPoints.push_back( endPoint );
-				}
-			}
-		}
-
-		m_Rays.clear();
-
-		sort( inBetweenPoints.begin(), inBetweenPoints.end(), PointsProfile2DCompare( t_ProfileAngle ) );
+	void CDirect2DRays::createRays( std::vector< std::shared_ptr< const CPoint2D > > const& t_Points,
+	                                std::vector< double > const& t_Keys,
+	                                double const t_ProfileAngle,
+	                                SweepRays& t_Rays ) const {
+		t_Rays.rays.clear();
+		t_Rays.rayKeys.clear();
 
 		// Creating incoming rays
-		auto firstBeam = m_UpperRay;
+		auto firstBeam = t_Rays.upperRay;
+		auto firstKey = t_Rays.upperKey;
 		std::shared_ptr< CViewSegment2D > secondBeam = nullptr;
-		for ( auto aPoint : inBetweenPoints ) {
-			secondBeam = createSubBeam( *aPoint, t_ProfileAngle );
+		for ( size_t i = 0; i < t_Points.size(); ++i ) {
+			secondBeam = createSubBeam( *t_Points[ i ], t_ProfileAngle );
 			auto aRay = std::make_shared< CDirect2DRay >( firstBeam, secondBeam );
 
 			// Dont save rays that are smaller than distance tolerance
 			if ( aRay->rayNormalHeight() > ViewerConstants::DISTANCE_TOLERANCE ) {
-				m_Rays.push_back( aRay );
+				t_Rays.rays.push_back( aRay );
+				t_Rays.rayKeys.emplace_back( firstKey, t_Keys[ i ] );
 			}
 			firstBeam = secondBeam;
+			firstKey = t_Keys[ i ];
 		}
-		auto aRay = std::make_shared< CDirect2DRay >( firstBeam, m_LowerRay );
-		m_Rays.push_back( aRay );
+		auto aRay = std::make_shared< CDirect2DRay >( firstBeam, t_Rays.lowerRay );
+		t_Rays.rays.push_back( aRay );
+		t_Rays.rayKeys.emplace_back( firstKey, t_Rays.lowerKey );
 	}
 
-	void CDirect2DRays::calculateBeamProperties( double const t_ProfileAngle ) {
-		// First check all segments and calculte total ray height
+	std::shared_ptr< CDirect2DRaysResult >
+	CDirect2DRays::calculateBeamProperties( double const t_ProfileAngle,
+	                                        std::vector< SweepSegment > const& t_Segments,
+	                                        SweepRays const& t_Rays ) const {
 		auto totalHeight = 0.0;
-		for ( auto beamRay : m_Rays ) {
+		for ( auto beamRay : t_Rays.rays ) {
 			totalHeight += beamRay->rayNormalHeight();
-			for ( auto aEnclosure : m_Geometries2D ) {
-				for ( auto aSegment : ( *aEnclosure->segments() ) ) {
-					beamRay->checkSegment( aSegment );
-				}
-			}
 		}
 
+		// Rays are ordered in profile direction. Segment is hit by the ray when both ray sides
+		// cross it, which is when segment range covers range of the ray. Segments are added to
+		// active ones once sweep reaches their minimum key and removed when ray passes beyond
+		// their maximum key.
+		std::vector< size_t > aActive;
+		size_t nextSegment = 0;
+
 		// Now calculate beam view factors
 		auto aViewFactors = std::make_shared< std::vector< BeamViewFactor > >();
 		double aDirectToDirect = 0;
@@ -326,32 +490,60 @@ namespace Viewer {
 		auto sPoint = std::make_shared< CPoint2D >( 0, 0 );
 		auto ePoint = std::make_shared< CPoint2D >( 1, 0 );
 		auto aNormalBeamDirection = std::make_shared< CViewSegment2D >( sPoint, ePoint );
-		for ( auto beamRay : m_Rays ) {
+		for ( size_t r = 0; r < t_Rays.rays.size(); ++r ) {
+			auto beamRay = t_Rays.rays[ r ];
+			const auto lowKey = std::min( t_Rays.rayKeys[ r ].first, t_Rays.rayKeys[ r ].second );
+			const auto highKey = std::max( t_Rays.rayKeys[ r ].first, t_Rays.rayKeys[ r ].second );
+			while ( nextSegment < t_Segments.size() && t_Segments[ nextSegment ].minKey <= lowKey ) {
+				aActive.push_back( nextSegment );
+				++nextSegment;
+			}
+			aActive.erase( std::remove_if( aActive.begin(), aActive.end(), [&]( size_t const i ) {
+				return t_Segments[ i ].maxKey < highKey;
+			} ), aActive.end() );
+
+			// Closest segment is one with the smallest center point x coordinate. Equal ones are
+			// resolved by enclosure and segment order.
+			const SweepSegment* closestSegment = nullptr;
+			if ( highKey > lowKey ) {
+				for ( auto i : aActive ) {
+					const auto& aSegment = t_Segments[ i ];
+					if ( closestSegment == nullptr ) {
+						closestSegment = &aSegment;
+						continue;
+					}
+					const auto x = aSegment.segment->centerPoint()->x();
+					const auto closestX = closestSegment->segment->centerPoint()->x();
+					if ( x < closestX || ( x == closestX &&
+						std::make_pair( aSegment.enclosureIndex, aSegment.segmentIndex ) <
+						std::make_pair( closestSegment->enclosureIndex, closestSegment->segmentIndex ) ) ) {
+						closestSegment = &aSegment;
+					}
+				}
+			}
+
 			auto currentHeight = beamRay->rayNormalHeight();
 			auto projectedBeamHeight = beamRay->cosAngle( aNormalBeamDirection );
 			auto viewFactor = 0.0;
 			auto percentHit = 0.0;
-			auto closestSegment = beamRay->closestSegmentHit();
-			for ( size_t e = 0; e < m_Geometries2D.size(); ++e ) {
-				for ( size_t s = 0; s < m_Geometries2D[ e ]->segments()->size(); ++s ) {
-					auto currentSegment = ( *m_Geometries2D[ e ]->segments() )[ s ];
-					if ( currentSegment == beamRay->closestSegmentHit() ) {
-						viewFactor = currentHeight / totalHeight;
-						projectedBeamHeight = projectedBeamHeight * currentHeight;
-						auto segmentHitLength = projectedBeamHeight / std::abs( beamRay->cosAngle( currentSegment->getNormal() ) );
-						percentHit = segmentHitLength / currentSegment->length();
-						auto aTest = find( aViewFactors->begin(),
-						                   aViewFactors->end(), BeamViewFactor( e, s, 0, 0 ) );
-						if ( aTest != aViewFactors->end() ) {
-							auto& aVF = *aTest;
-							aVF.value += viewFactor;
-							aVF.percentHit += percentHit;
-						}
-						else {
-							auto aVF = BeamViewFactor( e, s, viewFactor, percentHit );
-							aViewFactors->push_back( aVF );
-						}
-					}
+			if ( closestSegment != nullptr ) {
+				const auto e = closestSegment->enclosureIndex;
+				const auto s = closestSegment->segmentIndex;
+				auto currentSegment = closestSegment->segment;
+				viewFactor = currentHeight / totalHeight;
+				projectedBeamHeight = projectedBeamHeight * currentHeight;
+				auto segmentHitLength = projectedBeamHeight / std::abs( beamRay->cosAngle( currentSegment->getNormal() ) );
+				percentHit = segmentHitLength / currentSegment->length();
+				auto aTest = find( aViewFactors->begin(),
+				                   aViewFactors->end(), BeamViewFactor( e, s, 0, 0 ) );
+				if ( aTest != aViewFactors->end() ) {
+					auto& aVF = *aTest;
+					aVF.value += viewFactor;
+					aVF.percentHit += percentHit;
+				}
+				else {
+					auto aVF = BeamViewFactor( e, s, viewFactor, percentHit );
+					aViewFactors->push_back( aVF );
 				}
 			}
 
@@ -360,14 +552,14 @@ namespace Viewer {
 				aDirectToDirect += currentHeight / totalHeight;
 			}
 		}
-		m_CurrentResult = m_Results.append( t_ProfileAngle, aDirectToDirect, aViewFactors );
+		return std::make_shared< CDirect2DRaysResult >( t_ProfileAngle, aDirectToDirect, aViewFactors );
 	}
 
-	bool CDirect2DRays::isInRay( CPoint2D const& t_Point ) const {
-		assert( m_UpperRay != nullptr );
-		assert( m_LowerRay != nullptr );
-		return m_UpperRay->position( t_Point ) == PointPosition::Visible &&
-			m_LowerRay->position( t_Point ) == PointPosition::Invisible;
+	bool CDirect2DRays::isInRay( CPoint2D const& t_Point, SweepRays const& t_Rays ) {
+		assert( t_Rays.upperRay != nullptr );
+		assert( t_Rays.lowerRay != nullptr );
+		return t_Rays.upperRay->position( t_Point ) == PointPosition::Visible &&
+			t_Rays.lowerRay->position( t_Point ) == PointPosition::Invisible;
 	}
 
 	std::shared_ptr< CViewSegment2D > CDirect2DRays::createSubBeam( CPoint2D const& t_Point,
@@ -396,6 +588,11 @@ namespace Viewer {
 		m_Outgoing.appendGeometry2D( t_Geometry2D );
 	}
 
+	void CGeometry2DBeam::setProfileAngles( std::vector< double > const& t_ProfileAngles ) {
+		m_Incoming.setProfileAngles( t_ProfileAngles );
+		m_Outgoing.setProfileAngles( t_ProfileAngles );
+	}
+
 	// Returns non zero view factors. It also calculates direct to direct component for the beam
 	std::shared_ptr< std::vector< BeamViewFactor > > CGeometry2DBeam::beamViewFactors( double const t_ProfileAngle,
 	                                                                         Side const t_Side ) {
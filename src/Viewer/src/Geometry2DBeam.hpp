@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <vector>
+#include <mutex>
 
 namespace FenestrationCommon {
 
@@ -120,7 +121,7 @@ namespace Viewer {
 	////////////////////////////////////////////////////////////////////////////////////////
 
 	// Keeps result of beam ViewFactors. It is expensive operation to recalculate them every time
-	// so this will just save results for the next call
+	// so this will just save results for the next call. Results are kept sorted by profile angle.
 	class CDirect2DRaysResults {
 	public:
 		CDirect2DRaysResults();
@@ -128,7 +129,7 @@ namespace Viewer {
 		// Beam view factors for given profile angle
 		std::shared_ptr< CDirect2DRaysResult > getResult( double const t_ProfileAngle );
 
-		// append results
+		// append results. If result for the angle already exists, existing one is returned.
 		std::shared_ptr< CDirect2DRaysResult > append( double const t_ProfileAngle, double const t_DirectToDirect,
 		                                               std::shared_ptr< std::vector< BeamViewFactor > > const& t_BeamViewFactor ) const;
 
@@ -150,6 +151,17 @@ namespace Viewer {
 
 		void appendGeometry2D( std::shared_ptr< const CGeometry2D > const& t_Geometry2D );
 
+		// Calculates results for all profile angles with single sweep. Angles are processed in
+		// increasing order and enclosure points and segments are kept sorted in profile direction
+		// from one angle to the next, so only those that changed order between two angles are
+		// moved. Segments hit by rays are then found by sweeping over sorted segments instead of
+		// intersecting every ray with every segment.
+		void calculate( std::vector< double > const& t_ProfileAngles );
+
+		// Profile angles that will be needed. They are calculated with single sweep on the first
+		// request for any of beam results.
+		void setProfileAngles( std::vector< double > const& t_ProfileAngles );
+
 		// Beam view factors for given profile angle
 		std::shared_ptr< std::vector< BeamViewFactor > > beamViewFactors( double const t_ProfileAngle );
 
@@ -157,19 +169,61 @@ namespace Viewer {
 		double directToDirect( double const t_ProfileAngle );
 
 	private:
-		void calculateAllProperties( double const t_ProfileAngle );
+		// Segment of enclosure with its range in profile direction. Range is measured with key
+		// that is constant along the beam (see profileKey in source file).
+		struct SweepSegment {
+			std::shared_ptr< CViewSegment2D > segment;
+			size_t enclosureIndex;
+			size_t segmentIndex;
+			double minKey;
+			double maxKey;
+		};
+
+		// Rays for single profile angle. Kept local to the sweep so that several threads can
+		// calculate different angles at the same time.
+		struct SweepRays {
+			SweepRays();
+			std::shared_ptr< CViewSegment2D > lowerRay;
+			std::shared_ptr< CViewSegment2D > upperRay;
+			double lowerKey;
+			double upperKey;
+			std::vector< std::shared_ptr< CDirect2DRay > > rays;
+			// Keys of both sides of every ray
+			std::vector< std::pair< double, double > > rayKeys;
+		};
+
+		// Results are cached per profile angle. Lock is held only while cache is searched and while
+		// new results are stored. Calculation itself runs without the lock.
+		std::shared_ptr< CDirect2DRaysResult > calculateAllProperties( double const t_ProfileAngle );
+
+		// Angles from the list that are not in the cache. Must be called under the lock.
+		std::vector< double > missingAngles( std::vector< double > const& t_ProfileAngles );
+
+		// Stores results that are not already in the cache. Stored results are never replaced.
+		void storeResults( std::vector< std::shared_ptr< CDirect2DRaysResult > > const& t_Results );
+
+		// Sweep over given profile angles. Does not access the cache.
+		std::vector< std::shared_ptr< CDirect2DRaysResult > >
+		calculateProperties( std::vector< double > const& t_ProfileAngles ) const;
 
 		// Finds lower and upper ray of every enclosure in the system
-		void findRayBoundaries( double const t_ProfileAngle );
+		void findRayBoundaries( double const t_ProfileAngle, SweepRays& t_Rays ) const;
 
-		// Finds all points that are on the path of the ray
-		void findInBetweenRays( double const t_ProfileAngle );
+		// Creates rays between points (sorted in profile direction) that are on the path of the ray.
+		// Keys of points are stored together with rays.
+		void createRays( std::vector< std::shared_ptr< const CPoint2D > > const& t_Points,
+		                 std::vector< double > const& t_Keys,
+		                 double const t_ProfileAngle,
+		                 SweepRays& t_Rays ) const;
 
-		// Calculate beam view factors
-		void calculateBeamProperties( double const t_ProfileAngle );
+		// Calculate beam view factors. Segments must be sorted by their minimum key.
+		std::shared_ptr< CDirect2DRaysResult >
+		calculateBeamProperties( double const t_ProfileAngle,
+		                         std::vector< SweepSegment > const& t_Segments,
+		                         SweepRays const& t_Rays ) const;
 
 		// Check if given point is in possible path of the ray
-		bool isInRay( CPoint2D const& t_Point ) const;
+		static bool isInRay( CPoint2D const& t_Point, SweepRays const& t_Rays );
 
 		std::shared_ptr< CViewSegment2D > createSubBeam( CPoint2D const& t_Point,
 		                                                 double const t_ProfileAngle ) const;
@@ -177,12 +231,11 @@ namespace Viewer {
 		FenestrationCommon::Side m_Side;
 
 		std::vector< std::shared_ptr< const CGeometry2D > > m_Geometries2D;
-		std::shared_ptr< CViewSegment2D > m_LowerRay;
-		std::shared_ptr< CViewSegment2D > m_UpperRay;
-		std::vector< std::shared_ptr< CDirect2DRay > > m_Rays;
 
 		CDirect2DRaysResults m_Results;
-		std::shared_ptr< CDirect2DRaysResult > m_CurrentResult;
+		std::vector< double > m_PendingAngles;
+
+		std::mutex m_Mutex;
 
 	};
 
@@ -197,6 +250,10 @@ namespace Viewer {
 
 		void appendGeometry2D( std::shared_ptr< const CGeometry2D > const& t_Geometry2D );
 
+		// Beam results for all profile angles on both sides are calculated with single sweep
+		// when first of them is requested
+		void setProfileAngles( std::vector< double > const& t_ProfileAngles );
+
 		std::shared_ptr< std::vector< BeamViewFactor > >
 		beamViewFactors( double const t_ProfileAngle, FenestrationCommon::Side const t_Side );
 
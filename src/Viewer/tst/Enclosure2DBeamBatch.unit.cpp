@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "WCECommon.hpp"
+#include "WCEViewer.hpp"
+
+using namespace Viewer;
+using namespace FenestrationCommon;
+
+class TestEnclosure2DBeamBatch : public testing::Test {
+
+protected:
+  // Same enclosures as in TestEnclosure2DBeam1
+  static std::shared_ptr<CGeometry2DBeam> createBeam() {
+    auto aBeam = std::make_shared<CGeometry2DBeam>();
+
+    std::vector<std::vector<std::pair<double, double>>> aPoints = {
+        {{3, 2}, {5, 5}, {8, 4}, {9, 9}}, {{3, 10}, {7, 11}, {6, 14}, {12, 16}}};
+
+    for (auto &enclosurePoints : aPoints) {
+      auto aEnclosure = std::make_shared<CGeometry2D>();
+      for (size_t i = 1; i < enclosurePoints.size(); ++i) {
+        auto aStartPoint = std::make_shared<CPoint2D>(
+            enclosurePoints[i - 1].first, enclosurePoints[i - 1].second);
+        auto aEndPoint = std::make_shared<CPoint2D>(enclosurePoints[i].first,
+                                                    enclosurePoints[i].second);
+        aEnclosure->appendSegment(
+            std::make_shared<CViewSegment2D>(aStartPoint, aEndPoint));
+      }
+      aBeam->appendGeometry2D(aEnclosure);
+    }
+
+    return aBeam;
+  }
+
+  static std::vector<double> profileAngles() {
+    std::vector<double> aAngles;
+    for (int angle = 85; angle >= -85; angle -= 5) {
+      aAngles.push_back(angle);
+    }
+    return aAngles;
+  }
+
+  static void compareResults(CGeometry2DBeam &t_Batch,
+                             CGeometry2DBeam &t_Single) {
+    for (auto aSide : EnumSide()) {
+      for (auto angle : profileAngles()) {
+        auto aSingle = t_Single.beamViewFactors(angle, aSide);
+        auto aBatch = t_Batch.beamViewFactors(angle, aSide);
+
+        EXPECT_NEAR(t_Single.directToDirect(angle, aSide),
+                    t_Batch.directToDirect(angle, aSide), 1e-12);
+        ASSERT_EQ(aSingle->size(), aBatch->size());
+        for (size_t i = 0; i < aSingle->size(); ++i) {
+          EXPECT_EQ((*aSingle)[i].enclosureIndex, (*aBatch)[i].enclosureIndex);
+          EXPECT_EQ((*aSingle)[i].segmentIndex, (*aBatch)[i].segmentIndex);
+          EXPECT_NEAR((*aSingle)[i].value, (*aBatch)[i].value, 1e-12);
+          EXPECT_NEAR((*aSingle)[i].percentHit, (*aBatch)[i].percentHit,
+                      1e-12);
+        }
+      }
+    }
+  }
+};
+
+TEST_F(TestEnclosure2DBeamBatch, RegisteredProfileAngles) {
+  SCOPED_TRACE("Begin Test: 2D Enclosure - Beam results calculated for all "
+               "registered profile angles at once.");
+
+  auto aSingle = createBeam();
+  auto aBatch = createBeam();
+  aBatch->setProfileAngles(profileAngles());
+
+  compareResults(*aBatch, *aSingle);
+}
+
+TEST_F(TestEnclosure2DBeamBatch, KnownResults) {
+  SCOPED_TRACE("Begin Test: 2D Enclosure - Sweep results for angles with known "
+               "view factors.");
+
+  auto aBatch = createBeam();
+  aBatch->setProfileAngles({0, 45, -45});
+
+  EXPECT_NEAR(0.5, aBatch->directToDirect(45, Side::Front), 1e-6);
+  EXPECT_NEAR(0.125, aBatch->directToDirect(0, Side::Front), 1e-6);
+
+  auto aViewFactors = aBatch->beamViewFactors(0, Side::Front);
+  ASSERT_EQ(2u, aViewFactors->size());
+  EXPECT_EQ(2u, (*aViewFactors)[0].segmentIndex);
+  EXPECT_NEAR(0.5, (*aViewFactors)[0].value, 1e-6);
+  EXPECT_NEAR(0.8, (*aViewFactors)[0].percentHit, 1e-6);
+  EXPECT_EQ(0u, (*aViewFactors)[1].segmentIndex);
+  EXPECT_NEAR(0.375, (*aViewFactors)[1].value, 1e-6);
+}